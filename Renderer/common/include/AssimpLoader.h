@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
 #include <memory>
 #include <span>
 #include <unordered_map>
@@ -32,6 +33,14 @@ struct LoadedModelData {
     std::unordered_map<std::string, std::string> texture_paths; // texture name -> file path
 };
 
+// Wall time of the CPU stages of one import
+struct ImportTimings {
+    double read_ms = 0.0;          // File I/O through Assimp, including material libraries
+    double parse_ms = 0.0;         // ReadFile minus the I/O above
+    double post_process_ms = 0.0;  // Assimp post-processing plus conversion to MeshData / Material
+    uint64_t bytes_read = 0;
+};
+
 // Assimp-based loader implementation
 class AssimpLoader {
 public:
@@ -41,10 +50,11 @@ public:
     bool can_load(const std::string& file_path) const;
     
     // Legacy method for backward compatibility
-    void load_model(const std::string& file_path, std::vector<Mesh::Vertex>& vertices, std::vector<Mesh::Indices>& indices);
+    void load_model(const std::string& file_path, std::vector<Mesh::Vertex>& vertices, std::vector<Mesh::Indices>& indices,
+                    ImportTimings* timings = nullptr);
     
     // Enhanced method that loads textures and materials
-    LoadedModelData load_model_with_textures(const std::string& file_path);
+    LoadedModelData load_model_with_textures(const std::string& file_path, ImportTimings* timings = nullptr);
     
     std::vector<std::string> get_supported_extensions() const;
     
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <deque>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <mutex>
@@ -8,6 +11,7 @@
 #include "Model.h"
 #include "Texture.h"
 #include "Material.h"
+#include "ProgramBinaryCache.h"
 #include "Renderable.h"
 #include "Task.h"
 #include "TaskPriority.h"
@@ -37,6 +41,8 @@ public:
     };
 
     std::unique_ptr<Scene> create_simple_scene();
+    // Programs the renderer looks up by name; part of create_simple_scene(). False if any failed.
+    bool create_scene_shaders();
     
     // Load Resource
     template<typename T>
@@ -82,10 +88,32 @@ public:
     // Batch texture loading for models
     void load_model_textures(const std::unordered_map<std::string, std::string>& texture_paths);
 
-    // Shader creation
+    // Material texture arrays. With packing enabled, load_model_textures() stores textures sharing a
+    // size and channel count (a resolution class) as layers of GL_TEXTURE_2D_ARRAYs instead of
+    // separate textures; get<Texture>() does not find those, get_texture_layer() does. Only the
+    // deferred geometry pass samples arrays, the forward path draws packed textures untextured.
+    // At most Material::MAX_TEXTURE_ARRAYS arrays are created, across all models, as that is all the
+    // pass binds; textures of later resolution classes load as separate textures.
+    struct TextureLayer {
+        uint32_t array_index;  // Into get_texture_arrays()
+        uint32_t layer;
+    };
+    static constexpr size_t MIN_TEXTURE_ARRAY_LAYERS = 2;  // Smaller classes load as separate textures
+
+    void set_texture_array_packing_enabled(bool enabled) { texture_array_packing_ = enabled; }
+    bool is_texture_array_packing_enabled() const { return texture_array_packing_; }
+    std::optional<TextureLayer> get_texture_layer(const std::string& path) const;
+    std::vector<std::shared_ptr<Texture>> get_texture_arrays() const;
+
+    // Advances whenever a texture or texture array layer is added to the cache. A material with a
+    // path that did not resolve retries only once it changed, not on every bind.
+    uint64_t get_texture_generation() const { return texture_generation_.load(std::memory_order_acquire); }
+
+    // Shader creation. Programs are linked from the binary cache when it has them.
     std::shared_ptr<Shader> create_shader_sync(
         const std::string& shader_name,
         const std::vector<ShaderSource>& sources);
+    ProgramBinaryCache& get_program_binary_cache() { return program_binary_cache_; }
 
     // Get shader
     std::shared_ptr<Shader> get_shader(const std::string& shader_name) const;
@@ -159,6 +187,41 @@ public:
     StatsObserver get_stats() const;
     void reset_stats();
 
+    // Timings of one import in milliseconds; stages that do not apply to the asset stay 0
+    struct ImportRecord {
+        std::string path;
+        std::string kind;                 // "mesh", "model" or "texture"
+        Async::TaskPriority priority = Async::TaskPriority::k_normal;
+        uint64_t bytes = 0;               // Read from disk
+        double queue_wait_ms = 0.0;       // Submitted until a worker picked it up
+        double read_ms = 0.0;             // File I/O
+        double parse_ms = 0.0;            // Model parsing or image decode
+        double post_process_ms = 0.0;     // Assimp post-processing and conversion to MeshData
+        double upload_ms = 0.0;           // CPU to GPU: texture upload, mesh buffer setup
+        double continuation_ms = 0.0;     // Worker finished until the main thread resumed the load
+        double total_ms = 0.0;            // Request until the asset was ready
+    };
+
+    // Aggregates cover every import since the last reset_stats(); imports keeps the latest few
+    struct LoadTelemetry {
+        std::vector<ImportRecord> imports;  // Oldest first
+        size_t import_count = 0;
+        size_t texture_count = 0;
+        uint64_t total_bytes = 0;
+        double mb_per_second = 0.0;         // Bytes over time spent reading, parsing, post-processing, uploading
+        double textures_per_second = 0.0;   // Textures over time spent reading, decoding and uploading them
+        Async::CoroutineThreadPoolScheduler::Stats scheduler;
+    };
+
+    static constexpr size_t MAX_IMPORT_RECORDS = 256;
+
+    LoadTelemetry get_load_telemetry() const;
+    // Writes get_load_telemetry() as JSON so import regressions can be caught in CI
+    bool export_load_telemetry_json(const std::string& path) const;
+
+    // Adds CPU to GPU time measured by the caller (e.g. mesh buffer setup) to the latest import of path
+    void add_upload_time(const std::string& path, double upload_ms);
+
 private:
     // Resources cache 
     std::unordered_map<std::string, std::shared_ptr<Mesh>> mesh_cache_;
@@ -170,6 +233,11 @@ private:
     std::unordered_map<std::string, std::shared_ptr<class Shader>> shader_cache_;
     std::unordered_map<std::string, std::shared_ptr<Texture>> irradiance_cache_;
     std::unordered_map<std::string, std::shared_ptr<Texture>> prefiltered_cache_;
+    std::vector<std::shared_ptr<Texture>> texture_arrays_;
+    std::unordered_map<std::string, TextureLayer> texture_layer_cache_;
+    bool texture_array_packing_ = false;
+    std::atomic<uint64_t> texture_generation_ = 0;  // Advanced under cache_mutex_, read without it
+    ProgramBinaryCache program_binary_cache_;  // GL thread only, like create_shader_sync()
 
     // Task cache
     std::unordered_map<std::string, std::shared_ptr<Async::Task<std::shared_ptr<Mesh>>>> mesh_task_cache_;
@@ -189,6 +257,20 @@ private:
     // statistics
     mutable Stats stats_;
 
+    // import telemetry
+    mutable std::mutex telemetry_mutex_;
+    std::deque<ImportRecord> import_records_;
+    size_t import_count_ = 0;
+    size_t texture_import_count_ = 0;
+    uint64_t import_bytes_ = 0;
+    double import_busy_ms_ = 0.0;
+    double texture_busy_ms_ = 0.0;
+
+    void record_import(const ImportRecord& record);
+
+    void load_model_texture(const std::string& texture_path);
+    void load_model_textures_packed(const std::unordered_map<std::string, std::string>& texture_paths);
+
     // internal coroutine load functions
     Async::Task<std::shared_ptr<Texture>> load_texture_async(const std::string& path, Async::TaskPriority priority);
 
@@ -374,11 +456,10 @@ template<typename T>
 Async::Task<std::shared_ptr<T>> CoroutineResourceManager::load_async(const std::string& path,
                                                                    std::function<void(float, const std::string&)> progress_callback,
                                                                    Async::TaskPriority priority) {
-    // CRITICAL: This should show up in logs if the function is called!
-    LOG_INFO("load_async template called: {}", path);
+    LOG_DEBUG("load_async template called: {}", path);
     
     if constexpr (std::is_same_v<T, Mesh>) {
-        LOG_INFO("Dispatching to load_mesh_async");
+        LOG_DEBUG("Dispatching to load_mesh_async");
         co_return co_await load_mesh_async(path, progress_callback, priority);
     } else {
         // Other types don't support progress callback yet, return nullptr
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <coroutine>
 #include <memory>
 #include <queue>
@@ -133,30 +134,32 @@ namespace Async {
     private:
         F function_;
         CoroutineThreadPoolScheduler* scheduler_;
+        Async::TaskPriority priority_;
         using ResultType = std::invoke_result_t<F>;
         mutable std::optional<ResultType> result_;
         mutable std::exception_ptr exception_ptr_;
         
     public:
-        SubmitToThreadPoolAwaiter(F&& func, CoroutineThreadPoolScheduler* scheduler)
-          : function_(std::forward<F>(func)), scheduler_(scheduler) {}
+        SubmitToThreadPoolAwaiter(F&& func, CoroutineThreadPoolScheduler* scheduler,
+                                  Async::TaskPriority priority = Async::TaskPriority::k_normal)
+          : function_(std::forward<F>(func)), scheduler_(scheduler), priority_(priority) {}
         
         bool await_ready() const noexcept { return false; }
         
         void await_suspend(std::coroutine_handle<> handle);
         
         ResultType await_resume() {
-            Logger::get_instance().debug("SubmitToThreadPoolAwaiter::await_resume called");
+            LOG_DEBUG("SubmitToThreadPoolAwaiter::await_resume called");
             if (exception_ptr_) {
-                Logger::get_instance().debug("SubmitToThreadPoolAwaiter: Rethrowing exception");
+                LOG_DEBUG("SubmitToThreadPoolAwaiter: Rethrowing exception");
                 std::rethrow_exception(exception_ptr_);
             }
             if constexpr (!std::is_void_v<ResultType>) {
                 if (result_.has_value()) {
-                    Logger::get_instance().debug("SubmitToThreadPoolAwaiter: Returning result");
+                    LOG_DEBUG("SubmitToThreadPoolAwaiter: Returning result");
                     return std::move(result_.value());
                 } else {
-                    Logger::get_instance().error("SubmitToThreadPoolAwaiter: No result available - this is the bug!");
+                    LOG_ERROR("SubmitToThreadPoolAwaiter: No result available - this is the bug!");
                     throw std::runtime_error("SubmitToThreadPoolAwaiter: No result available");
                 }
             }
@@ -188,6 +191,15 @@ namespace Async {
                 size_t high_tasks{0};
                 size_t critical_tasks{0};
             } priority_stats;
+
+            // Thread pool queue wait per priority and the share of wall time each worker was busy
+            std::array<ThreadPool::QueueWaitStats, 4> queue_wait;  // [background, normal, high, critical]
+            std::vector<double> worker_utilization;                // 0..1 per worker
+
+            // Time continuations waited between a worker finishing and the main thread resuming them
+            size_t main_thread_resumes{0};
+            double main_thread_delay_total_ms{0.0};
+            double main_thread_delay_max_ms{0.0};
         };
         
         // Internal statistics structure (atomic for thread safety)
@@ -203,6 +215,10 @@ namespace Async {
                 std::atomic<size_t> high_tasks{0};
                 std::atomic<size_t> critical_tasks{0};
             } priority_stats;
+
+            std::atomic<size_t> main_thread_resumes{0};
+            std::atomic<int64_t> main_thread_delay_total_ns{0};
+            std::atomic<int64_t> main_thread_delay_max_ns{0};
         };
 
         // Constructors and destructor
@@ -236,8 +252,7 @@ namespace Async {
         // Submit functions to thread pool with priority (for compatibility)
         template<typename F>
         auto submit_to_threadpool(Async::TaskPriority priority, F&& func) -> SubmitToThreadPoolAwaiter<F> {
-            // Priority could be handled here if needed in the future
-            return SubmitToThreadPoolAwaiter<F>(std::forward<F>(func), this);
+            return SubmitToThreadPoolAwaiter<F>(std::forward<F>(func), this, priority);
         }
 
         // Async file operations
@@ -271,8 +286,12 @@ namespace Async {
         std::priority_queue<PriorityCoroutine> global_coroutine_queue_;
         mutable std::mutex global_coroutine_mutex_;
         
-        // Main thread coroutine queue
-        std::queue<std::coroutine_handle<>> main_thread_queue_;
+        // Main thread coroutine queue, with the time each handle was queued
+        struct MainThreadContinuation {
+            std::coroutine_handle<> handle;
+            std::chrono::steady_clock::time_point queued_time;
+        };
+        std::queue<MainThreadContinuation> main_thread_queue_;
         mutable std::mutex main_thread_mutex_;
         
         // Control flags
@@ -300,22 +319,25 @@ namespace Async {
         // Internal implementation methods for awaiters
         void schedule_to_main_thread(std::coroutine_handle<> handle);
         void schedule_to_thread_pool(std::coroutine_handle<> handle);
+        void record_main_thread_delay(std::chrono::steady_clock::time_point queued_time);
         
         template<typename F>
-        void execute_in_thread_pool(F&& func, std::coroutine_handle<> continuation, SubmitToThreadPoolAwaiter<F>* awaiter);
+        void execute_in_thread_pool(F&& func, std::coroutine_handle<> continuation, SubmitToThreadPoolAwaiter<F>* awaiter,
+                                    Async::TaskPriority priority);
     };
 
     // Template implementations
     template<typename F>
     void SubmitToThreadPoolAwaiter<F>::await_suspend(std::coroutine_handle<> handle) {
-        scheduler_->execute_in_thread_pool(std::move(function_), handle, this);
+        scheduler_->execute_in_thread_pool(std::move(function_), handle, this, priority_);
     }
 
         template<typename F>
-    void CoroutineThreadPoolScheduler::execute_in_thread_pool(F&& func, std::coroutine_handle<> continuation, SubmitToThreadPoolAwaiter<F>* awaiter) {
+    void CoroutineThreadPoolScheduler::execute_in_thread_pool(F&& func, std::coroutine_handle<> continuation, SubmitToThreadPoolAwaiter<F>* awaiter,
+                                                              Async::TaskPriority priority) {
         if (!thread_pool_) {
             // Thread pool not available - set exception
-            Logger::get_instance().error("CoroutineThreadPoolScheduler: Thread pool not available in execute_in_thread_pool");
+            LOG_ERROR("CoroutineThreadPoolScheduler: Thread pool not available in execute_in_thread_pool");
             awaiter->set_exception(std::make_exception_ptr(std::runtime_error("Thread pool not available")));
             // Schedule continuation to main thread instead of resuming directly
             schedule_to_main_thread(continuation);
@@ -323,7 +345,7 @@ namespace Async {
         }
         
         if (!thread_pool_->isRunning()) {
-            Logger::get_instance().error("CoroutineThreadPoolScheduler: Thread pool not running in execute_in_thread_pool");
+            LOG_ERROR("CoroutineThreadPoolScheduler: Thread pool not running in execute_in_thread_pool");
             awaiter->set_exception(std::make_exception_ptr(std::runtime_error("Thread pool not running")));
             schedule_to_main_thread(continuation);
             return;
@@ -331,7 +353,7 @@ namespace Async {
         
         // Submit function to thread pool
         try {
-            thread_pool_->enqueue([func = std::forward<F>(func), continuation, awaiter, this]() mutable {
+            thread_pool_->enqueue(priority, [func = std::forward<F>(func), continuation, awaiter, this]() mutable {
                 try {
                     if constexpr (std::is_void_v<std::invoke_result_t<F>>) {
                         func();
@@ -347,7 +369,7 @@ namespace Async {
                 }
             });
         } catch (const std::exception& e) {
-            Logger::get_instance().error("CoroutineThreadPoolScheduler: Failed to enqueue task: {}", e.what());
+            LOG_ERROR("CoroutineThreadPoolScheduler: Failed to enqueue task: {}", e.what());
             awaiter->set_exception(std::make_exception_ptr(e));
             schedule_to_main_thread(continuation);
             }
@@ -0,0 +1,43 @@
+#pragma once
+
+#ifndef RENDERER_HEADLESS_ENABLED
+#define RENDERER_HEADLESS_ENABLED 0
+#endif
+
+// OpenGL context without a window or display server, for build farms and batch jobs.
+// Uses EGL on Mesa's surfaceless platform when available (works with llvmpipe and no GPU),
+// otherwise the default EGL display, and renders into framebuffer objects only.
+// Needs RENDERER_ENABLE_HEADLESS; without it initialize() reports the missing support.
+//
+// The shaders need GLSL 4.60. llvmpipe only offers a 4.6 context with the Mesa overrides:
+//   MESA_GL_VERSION_OVERRIDE=4.6 MESA_GLSL_VERSION_OVERRIDE=460 renderer_bench ...
+class HeadlessContext {
+public:
+    static constexpr int REQUIRED_MAJOR_VERSION = 4;
+    static constexpr int REQUIRED_MINOR_VERSION = 6;
+
+    HeadlessContext();
+    ~HeadlessContext();
+
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+    // Creates a GL 4.6 core context and makes it current; false if the driver offers none
+    bool initialize();
+    bool make_current();
+    void destroy();
+
+    int get_major_version() const { return major_version_; }
+    int get_minor_version() const { return minor_version_; }
+
+    // Loader for gladLoadGLLoader
+    static void* get_proc_address(const char* name);
+
+    static constexpr bool is_supported() { return RENDERER_HEADLESS_ENABLED != 0; }
+
+private:
+    void* display_;  // EGLDisplay
+    void* context_;  // EGLContext
+    int major_version_;
+    int minor_version_;
+};
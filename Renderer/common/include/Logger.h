@@ -5,65 +5,116 @@
 #include <memory>
 #include <mutex>
 #include <chrono>
-#include <iomanip>
-#include <sstream>
 #include <format>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string_view>
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/base_sink.h>
+#include <spdlog/details/os.h>
 
+#include "MpscRingBuffer.h"
+#include "MemoryTracker.h"
+
+// Log panel backend. Holds the newest max_entries messages in a fixed ring: a new message
+// overwrites the oldest slot in place, and the GUI copies the ring out under the sink mutex only
+// when it changed, so drawing never races the logging thread.
 template<typename Mutex>
 class ImGuiSink : public spdlog::sinks::base_sink<Mutex> {
 public:
     struct LogEntry {
-        std::string timestamp;
-        spdlog::level::level_enum level;
+        char timestamp[16] = {};  // "HH:MM:SS.mmm"
+        spdlog::level::level_enum level = spdlog::level::info;
         std::string message;
-        
-        LogEntry(spdlog::level::level_enum lvl, const std::string& msg, const std::string& time)
-            : timestamp(time), level(lvl), message(msg) {}
     };
 
 private:
     std::vector<LogEntry> entries_;
-    size_t max_entries_;
-    bool auto_scroll_;
+    size_t head_;       // Oldest entry
+    size_t count_;
+    uint64_t version_;  // Bumped on every change, lets readers skip unchanged snapshots
+    std::atomic<bool> auto_scroll_;
+    size_t tracked_bytes_;  // Entries plus message capacity, reported to the MemoryTracker
+
+    // localtime() once per second; the milliseconds are appended per message
+    std::chrono::seconds cached_second_;
+    char cached_time_[16];
 
 protected:
     void sink_it_(const spdlog::details::log_msg& msg) override {
-        std::string formatted;
-        formatted.resize(msg.payload.size());
-        std::copy(msg.payload.begin(), msg.payload.end(), formatted.begin());
-        
-        auto time_t = std::chrono::system_clock::to_time_t(msg.time);
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            msg.time.time_since_epoch()) % 1000;
-        
-        std::stringstream ss;
-        ss << std::put_time(std::localtime(&time_t), "%H:%M:%S");
-        ss << "." << std::setfill('0') << std::setw(3) << ms.count();
-        
-        if (entries_.size() >= max_entries_) {
-            entries_.erase(entries_.begin());
+        LogEntry& entry = entries_[(head_ + count_) % entries_.size()];
+        if (count_ < entries_.size()) {
+            ++count_;
+        } else {
+            head_ = (head_ + 1) % entries_.size();
         }
-        
-        entries_.emplace_back(msg.level, formatted, ss.str());
+
+        auto since_epoch = msg.time.time_since_epoch();
+        auto second = std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+        if (second != cached_second_) {
+            std::tm local = spdlog::details::os::localtime(std::chrono::system_clock::to_time_t(msg.time));
+            std::snprintf(cached_time_, sizeof(cached_time_), "%02d:%02d:%02d", local.tm_hour, local.tm_min, local.tm_sec);
+            cached_second_ = second;
+        }
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(since_epoch - second).count();
+        std::snprintf(entry.timestamp, sizeof(entry.timestamp), "%.8s.%03d", cached_time_, static_cast<int>(ms));
+
+        entry.level = msg.level;
+        size_t old_capacity = entry.message.capacity();
+        entry.message.assign(msg.payload.data(), msg.payload.size());
+        // Messages only ever grow their capacity, and the tracker never logs, so this is safe under the sink mutex
+        if (entry.message.capacity() > old_capacity) {
+            size_t new_bytes = tracked_bytes_ + entry.message.capacity() - old_capacity;
+            MemoryTracker::get_instance().resize(MemoryCategory::k_log_buffers, tracked_bytes_, new_bytes);
+            tracked_bytes_ = new_bytes;
+        }
+        ++version_;
     }
 
     void flush_() override {}
 
 public:
     explicit ImGuiSink(size_t max_entries = 10000) 
-        : max_entries_(max_entries), auto_scroll_(true) {}
+        : entries_(std::max<size_t>(max_entries, 1)), head_(0), count_(0), version_(1),
+          auto_scroll_(true), tracked_bytes_(entries_.size() * sizeof(LogEntry)), cached_second_(-1), cached_time_{} {
+        MemoryTracker::get_instance().allocate(MemoryCategory::k_log_buffers, tracked_bytes_);
+    }
+
+    ~ImGuiSink() override {
+        MemoryTracker::get_instance().release(MemoryCategory::k_log_buffers, tracked_bytes_);
+    }
     
-    const std::vector<LogEntry>& get_entries() const { return entries_; }
+    // Copies the entries, oldest first, into out if they changed since version was taken.
+    // Strings already in out keep their capacity, so steady-state snapshots do not allocate.
+    bool snapshot(std::vector<LogEntry>& out, uint64_t& version) {
+        std::lock_guard<Mutex> lock(this->mutex_);
+        if (version == version_) {
+            return false;
+        }
+        out.resize(count_);
+        for (size_t i = 0; i < count_; ++i) {
+            const LogEntry& entry = entries_[(head_ + i) % entries_.size()];
+            std::memcpy(out[i].timestamp, entry.timestamp, sizeof(entry.timestamp));
+            out[i].level = entry.level;
+            out[i].message.assign(entry.message);
+        }
+        version = version_;
+        return true;
+    }
     
     void clear() {
         std::lock_guard<Mutex> lock(this->mutex_);
-        entries_.clear();
+        head_ = 0;
+        count_ = 0;
+        ++version_;
     }
     
-    void set_auto_scroll(bool auto_scroll) { auto_scroll_ = auto_scroll; }
-    bool get_auto_scroll() const { return auto_scroll_; }
+    void set_auto_scroll(bool auto_scroll) { auto_scroll_.store(auto_scroll, std::memory_order_relaxed); }
+    bool get_auto_scroll() const { return auto_scroll_.load(std::memory_order_relaxed); }
     
     static void get_level_color(spdlog::level::level_enum level, float* color) {
         switch (level) {
@@ -103,90 +154,184 @@ public:
 using ImGuiSink_mt = ImGuiSink<std::mutex>;
 using ImGuiSink_st = ImGuiSink<spdlog::details::null_mutex>;
 
+// Log levels for LOG_ACTIVE_LEVEL, same values as spdlog::level
+#define LOG_LEVEL_TRACE 0
+#define LOG_LEVEL_DEBUG 1
+#define LOG_LEVEL_INFO  2
+#define LOG_LEVEL_WARN  3
+#define LOG_LEVEL_ERROR 4
+#define LOG_LEVEL_OFF   6
+
+// Calls below this level are compiled out. Release builds drop trace and debug output entirely;
+// define LOG_ACTIVE_LEVEL before including this header (or on the command line) to override.
+#ifndef LOG_ACTIVE_LEVEL
+#ifdef NDEBUG
+#define LOG_ACTIVE_LEVEL LOG_LEVEL_INFO
+#else
+#define LOG_ACTIVE_LEVEL LOG_LEVEL_TRACE
+#endif
+#endif
+
+// Logging front end. The calling thread formats the message straight into a slot of a lock-free
+// ring and returns; a background thread drains the ring into the spdlog sinks (console, log panel),
+// so no caller ever waits on console I/O or a sink mutex. When the ring is full the message is
+// dropped and counted rather than blocking the caller, and the count is reported once it drains.
 class Logger {
+public:
+    // Longer messages are cut off and end in "..."
+    static constexpr size_t MAX_MESSAGE_LENGTH = 480;
+    static constexpr size_t QUEUE_CAPACITY = 4096;
+
 private:
+    struct LogRecord {
+        spdlog::log_clock::time_point time;
+        spdlog::level::level_enum level;
+        size_t length;
+        char text[MAX_MESSAGE_LENGTH];
+    };
+
     std::shared_ptr<spdlog::logger> logger_;
     std::shared_ptr<ImGuiSink_mt> imgui_sink_;
     bool debug_enabled_;
     
+    // Lowest level written at runtime; checked by the LOG_* macros before any argument is evaluated
+    inline static std::atomic<int> runtime_level_{ spdlog::level::info };
+    
+    Async::MpscRingBuffer<LogRecord> queue_;
+    std::atomic<uint32_t> published_;     // Bumped after every push; the writer thread waits on it
+    std::atomic<bool> writer_waiting_;    // Producers only pay for a wake-up while the writer sleeps
+    std::atomic<uint32_t> written_;       // Records handed to the sinks, for flush()
+    std::atomic<bool> running_;
+    std::atomic<uint64_t> dropped_;
+    std::thread writer_thread_;
+    
     static std::unique_ptr<Logger> instance_;
 
+    void writer_loop();
+    size_t drain();
+    void notify_writer() {
+        published_.fetch_add(1, std::memory_order_seq_cst);
+        if (writer_waiting_.load(std::memory_order_seq_cst)) {
+            published_.notify_one();
+        }
+    }
+    
+    static void mark_truncated(LogRecord& record) {
+        record.length = MAX_MESSAGE_LENGTH;
+        std::memcpy(record.text + MAX_MESSAGE_LENGTH - 3, "...", 3);
+    }
+
 public:
     static Logger& get_instance();
     
 
     Logger();
+    ~Logger();
+    
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
     
     std::shared_ptr<spdlog::logger> get_logger() { return logger_; }
+    spdlog::logger* get_raw_logger() const { return logger_.get(); }
     
     std::shared_ptr<ImGuiSink_mt> get_imgui_sink() { return imgui_sink_; }
     
+    static bool should_log(spdlog::level::level_enum level) {
+        return static_cast<int>(level) >= runtime_level_.load(std::memory_order_relaxed);
+    }
+    static void set_level(spdlog::level::level_enum level) {
+        runtime_level_.store(static_cast<int>(level), std::memory_order_relaxed);
+    }
+    
     // Debug control methods
     void set_debug_enabled(bool enabled) { 
         debug_enabled_ = enabled; 
-        logger_->info("DEBUG output {}", enabled ? "ENABLED" : "DISABLED");
+        set_level(enabled ? spdlog::level::debug : spdlog::level::info);
+        log(spdlog::level::info, "DEBUG output {}", enabled ? "ENABLED" : "DISABLED");
     }
     bool is_debug_enabled() const { return debug_enabled_; }
     void toggle_debug() { 
-        debug_enabled_ = !debug_enabled_; 
-        logger_->info("DEBUG output {}", debug_enabled_ ? "ENABLED" : "DISABLED");
+        set_debug_enabled(!debug_enabled_);
     }
     void enable_debug() { 
         if (!debug_enabled_) {
-            debug_enabled_ = true; 
-            logger_->info("DEBUG output ENABLED");
+            set_debug_enabled(true);
         }
     }
     void disable_debug() { 
         if (debug_enabled_) {
-            debug_enabled_ = false; 
-            logger_->info("DEBUG output DISABLED");
+            set_debug_enabled(false);
         }
     }
     
+    // Format strings go to spdlog unchanged and are checked at compile time; nothing is formatted
+    // unless the level is enabled. Prefer the LOG_* macros, which skip argument evaluation too.
     template<typename... Args>
-    void info(const std::string& fmt, Args&&... args) {
-        if constexpr (sizeof...(args) > 0) {
-            std::string formatted = std::vformat(fmt, std::make_format_args(args...));
-            logger_->info(formatted);
-        } else {
-            logger_->info(fmt);
-        }
+    void info(spdlog::format_string_t<Args...> fmt, Args&&... args) {
+        log(spdlog::level::info, fmt, std::forward<Args>(args)...);
     }
+    void info(std::string_view msg) { log(spdlog::level::info, msg); }
     
     template<typename... Args>
-    void warn(const std::string& fmt, Args&&... args) {
-        if constexpr (sizeof...(args) > 0) {
-            std::string formatted = std::vformat(fmt, std::make_format_args(args...));
-            logger_->warn(formatted);
-        } else {
-            logger_->warn(fmt);
-        }
+    void warn(spdlog::format_string_t<Args...> fmt, Args&&... args) {
+        log(spdlog::level::warn, fmt, std::forward<Args>(args)...);
     }
+    void warn(std::string_view msg) { log(spdlog::level::warn, msg); }
     
     template<typename... Args>
-    void error(const std::string& fmt, Args&&... args) {
-        if constexpr (sizeof...(args) > 0) {
-            std::string formatted = std::vformat(fmt, std::make_format_args(args...));
-            logger_->error(formatted);
-        } else {
-            logger_->error(fmt);
-        }
+    void error(spdlog::format_string_t<Args...> fmt, Args&&... args) {
+        log(spdlog::level::err, fmt, std::forward<Args>(args)...);
     }
+    void error(std::string_view msg) { log(spdlog::level::err, msg); }
     
     template<typename... Args>
-    void debug(const std::string& fmt, Args&&... args) {
-        if (!debug_enabled_) {
-            return; // Skip debug output when disabled
+    void debug(spdlog::format_string_t<Args...> fmt, Args&&... args) {
+        log(spdlog::level::debug, fmt, std::forward<Args>(args)...);
+    }
+    void debug(std::string_view msg) { log(spdlog::level::debug, msg); }
+    
+    template<typename... Args>
+    void log(spdlog::level::level_enum level, spdlog::format_string_t<Args...> fmt, Args&&... args) {
+        if (!should_log(level)) {
+            return;
         }
-        
-        if constexpr (sizeof...(args) > 0) {
-            std::string formatted = std::vformat(fmt, std::make_format_args(args...));
-            logger_->debug(formatted);
+        bool pushed = queue_.try_push([&](LogRecord& record) {
+            record.time = spdlog::log_clock::now();
+            record.level = level;
+            auto result = std::format_to_n(record.text, MAX_MESSAGE_LENGTH, fmt, std::forward<Args>(args)...);
+            record.length = static_cast<size_t>(result.out - record.text);
+            if (result.size > static_cast<std::ptrdiff_t>(MAX_MESSAGE_LENGTH)) {
+                mark_truncated(record);
+            }
+        });
+        if (pushed) {
+            notify_writer();
         } else {
-            logger_->debug(fmt);
+            dropped_.fetch_add(1, std::memory_order_relaxed);
         }
     }
+    void log(spdlog::level::level_enum level, std::string_view msg) {
+        if (!should_log(level)) {
+            return;
+        }
+        bool pushed = queue_.try_push([&](LogRecord& record) {
+            record.time = spdlog::log_clock::now();
+            record.level = level;
+            record.length = std::min(msg.size(), MAX_MESSAGE_LENGTH);
+            std::memcpy(record.text, msg.data(), record.length);
+            if (msg.size() > MAX_MESSAGE_LENGTH) {
+                mark_truncated(record);
+            }
+        });
+        if (pushed) {
+            notify_writer();
+        } else {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    
+    // Blocks until everything logged before the call has reached the sinks
+    void flush();
     
     void clear() {
         if (imgui_sink_) {
@@ -196,7 +341,19 @@ public:
 };
 
 
-#define LOG_INFO(...) Logger::get_instance().info(__VA_ARGS__)
-#define LOG_WARN(...) Logger::get_instance().warn(__VA_ARGS__)
-#define LOG_ERROR(...) Logger::get_instance().error(__VA_ARGS__)
-#define LOG_DEBUG(...) Logger::get_instance().debug(__VA_ARGS__)
\ No newline at end of file
+// The level check runs before the arguments are evaluated. Levels below LOG_ACTIVE_LEVEL stay
+// type-checked but generate no code.
+#define LOG_AT_LEVEL_(active, level, ...)                                             \
+    do {                                                                              \
+        if constexpr (active) {                                                       \
+            if (Logger::should_log(level)) {                                          \
+                Logger::get_instance().log(level, __VA_ARGS__);                       \
+            }                                                                         \
+        }                                                                             \
+    } while (0)
+
+#define LOG_TRACE(...) LOG_AT_LEVEL_(LOG_ACTIVE_LEVEL <= LOG_LEVEL_TRACE, spdlog::level::trace, __VA_ARGS__)
+#define LOG_DEBUG(...) LOG_AT_LEVEL_(LOG_ACTIVE_LEVEL <= LOG_LEVEL_DEBUG, spdlog::level::debug, __VA_ARGS__)
+#define LOG_INFO(...)  LOG_AT_LEVEL_(LOG_ACTIVE_LEVEL <= LOG_LEVEL_INFO, spdlog::level::info, __VA_ARGS__)
+#define LOG_WARN(...)  LOG_AT_LEVEL_(LOG_ACTIVE_LEVEL <= LOG_LEVEL_WARN, spdlog::level::warn, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT_LEVEL_(LOG_ACTIVE_LEVEL <= LOG_LEVEL_ERROR, spdlog::level::err, __VA_ARGS__)
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+enum class MemoryCategory : uint8_t {
+    k_mesh_cpu = 0,        // Vertex and index arrays kept in Mesh
+    k_mesh_gpu,            // Vertex and index buffers
+    k_texture_gpu,         // Textures loaded from files or data
+    k_render_targets,      // Framebuffer attachments, pooled transients, Hi-Z and shadow maps
+    k_gpu_buffers,         // Other buffer objects: culling SSBOs, fullscreen geometry
+    k_staging,             // Pixel pack buffers for readback
+    k_coroutine_frames,    // Async::Task coroutine frames
+    k_log_buffers,         // Log panel ring
+    k_count
+};
+
+// Byte counts per memory category.
+// Owners report their allocations with allocate()/release(); the counters are atomics, so any thread
+// may report. Peaks are kept per category and for the total. A category (or the total) can be
+// given a budget; check_budgets() warns once when one is exceeded and again only after usage
+// dropped back under it. It logs, so it runs on the main thread once per frame rather than inside
+// allocate(), which the log sink itself calls.
+class MemoryTracker {
+public:
+    static constexpr size_t CATEGORY_COUNT = static_cast<size_t>(MemoryCategory::k_count);
+
+    struct CategoryStats {
+        size_t current_bytes = 0;
+        size_t peak_bytes = 0;
+        size_t live_allocations = 0;
+        size_t budget_bytes = 0;  // 0 = no budget
+    };
+
+    struct Snapshot {
+        std::array<CategoryStats, CATEGORY_COUNT> categories;
+        CategoryStats total;
+    };
+
+    static MemoryTracker& get_instance();
+
+    MemoryTracker() = default;
+
+    MemoryTracker(const MemoryTracker&) = delete;
+    MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+    void allocate(MemoryCategory category, size_t bytes);
+    void release(MemoryCategory category, size_t bytes);
+    // An allocation that changed size in place; it stays one live allocation
+    void resize(MemoryCategory category, size_t old_bytes, size_t new_bytes);
+
+    Snapshot get_snapshot() const;
+    size_t get_current_bytes(MemoryCategory category) const;
+
+    void set_budget(MemoryCategory category, size_t bytes);
+    void set_total_budget(size_t bytes);
+    // Peaks restart from the current usage
+    void reset_peaks();
+
+    // Main thread, once per frame
+    void check_budgets();
+
+    static const char* get_category_name(MemoryCategory category);
+
+private:
+    struct Counter {
+        std::atomic<size_t> current{0};
+        std::atomic<size_t> peak{0};
+        std::atomic<size_t> live{0};
+        std::atomic<size_t> budget{0};
+        bool over_budget = false;  // Main thread only
+    };
+
+    static void raise_peak(Counter& counter, size_t value);
+    static CategoryStats read(const Counter& counter);
+    static void check_budget(Counter& counter, const char* name);
+
+    std::array<Counter, CATEGORY_COUNT> counters_;
+    Counter total_;
+};
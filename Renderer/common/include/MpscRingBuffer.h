@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Async {
+
+    // Bounded multi-producer / single-consumer queue (Vyukov's sequence-per-cell design).
+    // Producers claim a cell with one CAS and fill it in place, so pushing never takes a lock or
+    // allocates; when the ring is full try_push fails instead of waiting. The consumer reads
+    // cells in claim order and hands them back to producers by bumping their sequence.
+    template<typename T>
+    class MpscRingBuffer {
+    private:
+        struct Cell {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+
+        // Keep the producer and consumer cursors on separate cache lines
+        static constexpr size_t CACHE_LINE = 64;
+
+        std::unique_ptr<Cell[]> cells_;
+        size_t mask_;
+        alignas(CACHE_LINE) std::atomic<size_t> enqueue_pos_{0};
+        alignas(CACHE_LINE) size_t dequeue_pos_ = 0;
+
+        static size_t round_up_to_power_of_two(size_t value) {
+            size_t result = 2;
+            while (result < value) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+    public:
+        explicit MpscRingBuffer(size_t capacity)
+            : cells_(std::make_unique<Cell[]>(round_up_to_power_of_two(capacity)))
+            , mask_(round_up_to_power_of_two(capacity) - 1)
+        {
+            for (size_t i = 0; i <= mask_; ++i) {
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpscRingBuffer(const MpscRingBuffer&) = delete;
+        MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+        size_t capacity() const { return mask_ + 1; }
+
+        // Any thread. fill(T&) writes the claimed cell; returns false without calling it when full.
+        template<typename Fill>
+        bool try_push(Fill&& fill) {
+            size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+            Cell* cell = nullptr;
+            for (;;) {
+                cell = &cells_[pos & mask_];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+                if (diff == 0) {
+                    if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = enqueue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+
+            fill(cell->value);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer thread only. Calls consume(T&) for every published cell in order and stops at
+        // the first cell a producer has claimed but not finished. Returns the number consumed.
+        template<typename Consume>
+        size_t consume_all(Consume&& consume) {
+            size_t count = 0;
+            for (;;) {
+                Cell& cell = cells_[dequeue_pos_ & mask_];
+                size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                if (sequence != dequeue_pos_ + 1) {
+                    return count;
+                }
+
+                consume(cell.value);
+                cell.sequence.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+                ++dequeue_pos_;
+                ++count;
+            }
+        }
+    };
+
+} // namespace Async
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define PROFILER_HAS_TSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define PROFILER_HAS_TSC 1
+#else
+#define PROFILER_HAS_TSC 0
+#endif
+
+// Set by the RENDERER_ENABLE_PROFILER CMake option. When 0 the PROFILE_* macros expand to nothing;
+// the Profiler class itself still exists so the UI can say it was compiled out.
+#ifndef RENDERER_PROFILER_ENABLED
+#define RENDERER_PROFILER_ENABLED 1
+#endif
+
+// CPU frame profiler.
+// PROFILE_SCOPE("name") records a zone from construction to end of scope into a ring owned by the
+// calling thread: no locks, no allocation, two clock reads and one release store per zone. On x86
+// the clock is the invariant TSC, converted to nanoseconds against steady_clock when drained. Once
+// per frame the main thread drains every thread's ring into a short frame history that the UI
+// draws as a timeline and export_chrome_trace() writes as Chrome Trace Event JSON (chrome://tracing,
+// ui.perfetto.dev). Zone names must outlive the profiler: string literals, or intern() the name.
+//
+// Zones must not span a co_await; a coroutine can resume on another thread.
+class Profiler {
+public:
+    struct ZoneRecord {
+        const char* name;
+        int64_t start_ns;
+        int64_t end_ns;
+        uint32_t depth;         // Nesting level within its thread
+        uint32_t thread_index;  // Into get_thread_names()
+    };
+
+    struct FrameRecord {
+        int64_t start_ns;
+        int64_t end_ns;
+        std::vector<ZoneRecord> zones;  // Zones that ended during the frame, any thread
+    };
+
+    static constexpr size_t ZONES_PER_THREAD = 16384;  // Power of two
+    static constexpr size_t MAX_FRAMES = 120;
+
+private:
+    // Relaxed atomics so the drain may read a slot the owner is lapping; such slots are discarded
+    struct Zone {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<int64_t> start_ticks{0};
+        std::atomic<int64_t> end_ticks{0};
+        std::atomic<uint32_t> depth{0};
+    };
+
+    // Written only by its thread; write_count is published after the zone is stored
+    struct ThreadBuffer {
+        std::array<Zone, ZONES_PER_THREAD> zones;
+        std::atomic<uint64_t> write_count{0};
+        uint64_t read_count = 0;  // Main thread only
+        uint32_t depth = 0;
+        uint32_t thread_index = 0;
+    };
+
+public:
+    class ScopedZone {
+    public:
+        explicit ScopedZone(const char* name)
+            : buffer_(get_thread_buffer()), name_(name), start_ticks_(now_ticks()), depth_(buffer_->depth++) {}
+
+        ~ScopedZone() {
+            int64_t end_ticks = now_ticks();
+            --buffer_->depth;
+            uint64_t index = buffer_->write_count.load(std::memory_order_relaxed);
+            Zone& zone = buffer_->zones[index & (ZONES_PER_THREAD - 1)];
+            zone.name.store(name_, std::memory_order_relaxed);
+            zone.start_ticks.store(start_ticks_, std::memory_order_relaxed);
+            zone.end_ticks.store(end_ticks, std::memory_order_relaxed);
+            zone.depth.store(depth_, std::memory_order_relaxed);
+            buffer_->write_count.store(index + 1, std::memory_order_release);
+        }
+
+        ScopedZone(const ScopedZone&) = delete;
+        ScopedZone& operator=(const ScopedZone&) = delete;
+
+    private:
+        ThreadBuffer* buffer_;
+        const char* name_;
+        int64_t start_ticks_;
+        uint32_t depth_;
+    };
+
+    static Profiler& get_instance();
+
+    Profiler();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    static int64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Zone timestamps; TSC ticks on x86, steady_clock nanoseconds elsewhere
+    static int64_t now_ticks() {
+#if PROFILER_HAS_TSC
+        return static_cast<int64_t>(__rdtsc());
+#else
+        return now_ns();
+#endif
+    }
+
+    // Stable copy of a runtime name, for zones whose name is not a literal
+    const char* intern(std::string_view name);
+
+    // Label for the calling thread's timeline row
+    void set_thread_name(const std::string& name);
+
+    // Main thread, once per frame: collects the zones every thread finished since the last call
+    void end_frame();
+
+    // Main thread only
+    const std::deque<FrameRecord>& get_frames() const { return frames_; }
+    std::vector<std::string> get_thread_names() const;
+
+    // While paused the history is frozen; zones are still drained so the rings never overflow
+    void set_paused(bool paused) { paused_ = paused; }
+    bool is_paused() const { return paused_; }
+
+    // Zones lost because a thread lapped its ring between two end_frame() calls
+    uint64_t get_overwritten_zone_count() const { return overwritten_zones_; }
+
+    // Writes the frame history as Chrome Trace Event JSON
+    bool export_chrome_trace(const std::string& path) const;
+
+    static constexpr bool is_compiled_in() { return RENDERER_PROFILER_ENABLED != 0; }
+
+private:
+    static ThreadBuffer* get_thread_buffer();
+    ThreadBuffer* register_thread();
+    void update_tick_calibration();
+    int64_t ticks_to_ns(int64_t ticks) const;
+
+    mutable std::mutex threads_mutex_;
+    std::vector<std::unique_ptr<ThreadBuffer>> threads_;
+    std::vector<std::string> thread_names_;
+
+    std::mutex names_mutex_;
+    std::unordered_set<std::string> interned_names_;  // Node-based, so element addresses are stable
+
+    std::deque<FrameRecord> frames_;
+    int64_t frame_start_ns_;
+
+    // Reference pair taken at startup; the tick rate is re-measured against it every frame
+    int64_t calibration_ticks_;
+    int64_t calibration_ns_;
+    double ns_per_tick_;
+    bool paused_;
+    uint64_t overwritten_zones_;
+};
+
+#define PROFILE_CONCAT_INNER_(a, b) a##b
+#define PROFILE_CONCAT_(a, b) PROFILE_CONCAT_INNER_(a, b)
+
+#if RENDERER_PROFILER_ENABLED
+#define PROFILE_SCOPE(name) Profiler::ScopedZone PROFILE_CONCAT_(profile_zone_, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+#define PROFILE_FRAME_MARK() Profiler::get_instance().end_frame()
+#define PROFILE_THREAD_NAME(name) Profiler::get_instance().set_thread_name(name)
+#else
+#define PROFILE_SCOPE(name) do {} while (0)
+#define PROFILE_FUNCTION() do {} while (0)
+#define PROFILE_FRAME_MARK() do {} while (0)
+#define PROFILE_THREAD_NAME(name) do {} while (0)
+#endif
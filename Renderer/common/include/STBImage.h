@@ -9,6 +9,8 @@ extern "C" {
     
     // STB Image loading functions
     stbi_uc *stbi_load(char const *filename, int *x, int *y, int *channels_in_file, int desired_channels);
+    stbi_uc *stbi_load_from_memory(stbi_uc const *buffer, int len, int *x, int *y, int *channels_in_file, int desired_channels);
+    int stbi_info(char const *filename, int *x, int *y, int *comp);
     void stbi_image_free(void *retval_from_stbi_load);
     
     // STB Image writing functions  
@@ -29,7 +31,11 @@ class STBImage {
 public:
     // Standard LDR image loading
     static unsigned char* load_image(const char* filename, int* width, int* height, int* nr_channels, int desired_channels = 0);
+    // Decodes an encoded file already read into memory
+    static unsigned char* load_image_from_memory(const unsigned char* buffer, int length, int* width, int* height, int* nr_channels, int desired_channels = 0);
     static void free_image(unsigned char* data);
+    // Reads only the header; false if the file is missing or not a supported image
+    static bool get_image_info(const char* filename, int* width, int* height, int* nr_channels);
     static bool write_image(const char* filename, int width, int height, int components, const void* data);
     static void set_flip_vertical_on_load(bool flip);
     
@@ -46,10 +52,18 @@ inline unsigned char* STBImage::load_image(const char* filename, int* width, int
     return stbi_load(filename, width, height, nr_channels, desired_channels);
 }
 
+inline unsigned char* STBImage::load_image_from_memory(const unsigned char* buffer, int length, int* width, int* height, int* nr_channels, int desired_channels) {
+    return stbi_load_from_memory(buffer, length, width, height, nr_channels, desired_channels);
+}
+
 inline void STBImage::free_image(unsigned char* data) {
     stbi_image_free(data);
 }
 
+inline bool STBImage::get_image_info(const char* filename, int* width, int* height, int* nr_channels) {
+    return stbi_info(filename, width, height, nr_channels) != 0;
+}
+
 inline bool STBImage::write_image(const char* filename, int width, int height, int components, const void* data) {
     // Determine file format from extension
     const char* ext = strrchr(filename, '.');
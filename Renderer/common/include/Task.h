@@ -8,6 +8,7 @@
 #include <condition_variable>
 
 #include <Logger.h>
+#include "MemoryTracker.h"
 
 namespace Async {
 
@@ -28,6 +29,18 @@ namespace Async {
         TaskPromiseBase() = default;
         ~TaskPromiseBase() = default;
 
+        // Coroutine frames are allocated through the promise, so their size is known here
+        static void* operator new(std::size_t size) {
+            void* frame = ::operator new(size);
+            MemoryTracker::get_instance().allocate(MemoryCategory::k_coroutine_frames, size);
+            return frame;
+        }
+
+        static void operator delete(void* frame, std::size_t size) noexcept {
+            MemoryTracker::get_instance().release(MemoryCategory::k_coroutine_frames, size);
+            ::operator delete(frame, size);
+        }
+
         // Common coroutine interface
         std::suspend_always initial_suspend() noexcept { return {}; }
         auto final_suspend() noexcept { 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <chrono>
 #include <vector>
 #include <memory>
 #include <thread>
@@ -94,10 +96,32 @@ public:
 
     Statistics getStatistics() const;
 
+    // How long tasks sat in the queue, per priority, and how much of the wall time since
+    // construction (or the last reset) each worker spent running work
+    struct QueueWaitStats {
+        size_t count = 0;
+        double total_ms = 0.0;
+        double max_ms = 0.0;
+    };
+
+    struct WorkerTimings {
+        std::array<QueueWaitStats, 4> queue_wait;  // [background, normal, high, critical]
+        std::vector<double> busy_ms;               // Per worker
+        double elapsed_ms = 0.0;
+    };
+
+    WorkerTimings get_worker_timings() const;
+    void reset_worker_timings();
+
 protected:
     // Worker thread function
     virtual void workerThread();
     
+    // Index of the calling worker into the per-worker timings; assigned on first use
+    size_t acquire_worker_index();
+    void record_queue_wait(const PriorityTask& task, std::chrono::steady_clock::time_point start);
+    void record_busy_time(size_t worker_index, std::chrono::steady_clock::duration duration);
+
     // Helper to wrap move-only callables
     template<typename F>
     static std::function<void()> makeTask(F&& f) {
@@ -118,6 +142,14 @@ protected:
 
     // Thread pool configuration
     const size_t numThreads_;
+
+    // Timing counters, in nanoseconds; initialised before the workers start
+    std::atomic<size_t> nextWorkerIndex_;
+    std::array<std::atomic<uint64_t>, 4> queueWaitCount_;
+    std::array<std::atomic<uint64_t>, 4> queueWaitTotalNs_;
+    std::array<std::atomic<uint64_t>, 4> queueWaitMaxNs_;
+    std::unique_ptr<std::atomic<uint64_t>[]> workerBusyNs_;
+    std::atomic<int64_t> timingStartNs_;
 };
 
 // Template implementation
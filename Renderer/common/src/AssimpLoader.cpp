@@ -1,15 +1,111 @@
 #include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <vector>
 #include <string>
 
+#include <assimp/DefaultIOSystem.h>
 #include <assimp/Importer.hpp>
+#include <assimp/IOStream.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 #include <assimp/material.h>
 
 #include "AssimpLoader.h"
 
+namespace {
+
+constexpr unsigned int k_import_flags =
+    aiProcess_Triangulate |           // Convert polygons to triangles
+    aiProcess_FlipUVs |              // Flip UV coordinates (OpenGL convention)
+    aiProcess_GenSmoothNormals |     // Generate smooth normals if missing
+    aiProcess_CalcTangentSpace |     // Generate tangent and bitangent vectors
+    aiProcess_JoinIdenticalVertices | // Remove duplicate vertices
+    aiProcess_ImproveCacheLocality |  // Optimize vertex cache locality
+    aiProcess_RemoveRedundantMaterials | // Remove redundant materials
+    aiProcess_OptimizeMeshes |        // Optimize mesh count
+    aiProcess_OptimizeGraph;          // Optimize scene graph
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Time and bytes spent in file I/O while Assimp parses, so parsing can be told apart from reading
+struct IOTotals {
+    Clock::duration time{};
+    uint64_t bytes = 0;
+};
+
+class TimedIOStream : public Assimp::IOStream {
+public:
+    TimedIOStream(Assimp::IOStream* stream, IOTotals& totals) : stream_(stream), totals_(totals) {}
+    ~TimedIOStream() override { delete stream_; }
+
+    size_t Read(void* buffer, size_t size, size_t count) override {
+        auto start = Clock::now();
+        size_t read = stream_->Read(buffer, size, count);
+        totals_.time += Clock::now() - start;
+        totals_.bytes += static_cast<uint64_t>(read) * size;
+        return read;
+    }
+
+    size_t Write(const void* buffer, size_t size, size_t count) override { return stream_->Write(buffer, size, count); }
+    aiReturn Seek(size_t offset, aiOrigin origin) override { return stream_->Seek(offset, origin); }
+    size_t Tell() const override { return stream_->Tell(); }
+    size_t FileSize() const override { return stream_->FileSize(); }
+    void Flush() override { stream_->Flush(); }
+
+private:
+    Assimp::IOStream* stream_;
+    IOTotals& totals_;
+};
+
+class TimedIOSystem : public Assimp::DefaultIOSystem {
+public:
+    explicit TimedIOSystem(IOTotals& totals) : totals_(totals) {}
+
+    Assimp::IOStream* Open(const char* file, const char* mode) override {
+        auto start = Clock::now();
+        Assimp::IOStream* stream = DefaultIOSystem::Open(file, mode);
+        totals_.time += Clock::now() - start;
+        return stream ? new TimedIOStream(stream, totals_) : nullptr;
+    }
+
+private:
+    IOTotals& totals_;
+};
+
+// ReadFile without post-processing, then ApplyPostProcessing, so each stage can be timed
+const aiScene* read_scene(Assimp::Importer& importer, const std::string& file_path, ImportTimings* timings) {
+    if (!timings) {
+        return importer.ReadFile(file_path, k_import_flags);
+    }
+
+    IOTotals io;
+    TimedIOSystem io_system(io);
+    importer.SetIOHandler(&io_system);
+
+    auto parse_start = Clock::now();
+    const aiScene* scene = importer.ReadFile(file_path, 0);
+    auto parse_end = Clock::now();
+    if (scene) {
+        scene = importer.ApplyPostProcessing(k_import_flags);
+    }
+    auto post_process_end = Clock::now();
+
+    timings->read_ms = std::chrono::duration<double, std::milli>(io.time).count();
+    timings->parse_ms = std::max(0.0, elapsed_ms(parse_start, parse_end) - timings->read_ms);
+    timings->post_process_ms = elapsed_ms(parse_end, post_process_end);
+    timings->bytes_read = io.bytes;
+
+    importer.SetIOHandler(nullptr);  // Hands io_system back before it goes out of scope
+    return scene;
+}
+
+} // namespace
+
 const std::vector<std::string> AssimpLoader::supportedExtensions = {
     ".obj", ".fbx", ".gltf", ".glb", ".dae", ".3ds", ".blend", ".stl", ".ply"
 };
@@ -23,22 +119,12 @@ bool AssimpLoader::can_load(const std::string& filePath) const {
     return std::find(supportedExtensions.begin(), supportedExtensions.end(), extension) != supportedExtensions.end();
 }
 
-void AssimpLoader::load_model(const std::string& filePath, std::vector<Mesh::Vertex>& vertices, std::vector<Mesh::Indices>& indices) {
+void AssimpLoader::load_model(const std::string& filePath, std::vector<Mesh::Vertex>& vertices, std::vector<Mesh::Indices>& indices,
+                              ImportTimings* timings) {
     
     Assimp::Importer importer;
     
-    // Set post-processing flags
-    const aiScene* scene = importer.ReadFile(filePath, 
-        aiProcess_Triangulate |           // Convert polygons to triangles
-        aiProcess_FlipUVs |              // Flip UV coordinates (OpenGL convention)
-        aiProcess_GenSmoothNormals |     // Generate smooth normals if missing
-        aiProcess_CalcTangentSpace |     // Generate tangent and bitangent vectors
-        aiProcess_JoinIdenticalVertices | // Remove duplicate vertices
-        aiProcess_ImproveCacheLocality |  // Optimize vertex cache locality
-        aiProcess_RemoveRedundantMaterials | // Remove redundant materials
-        aiProcess_OptimizeMeshes |        // Optimize mesh count
-        aiProcess_OptimizeGraph          // Optimize scene graph
-    );
+    const aiScene* scene = read_scene(importer, filePath, timings);
     
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
         std::string error = importer.GetErrorString();
@@ -46,7 +132,11 @@ void AssimpLoader::load_model(const std::string& filePath, std::vector<Mesh::Ver
     }
     
     // Process the scene graph starting from root node
+    auto convert_start = Clock::now();
     process_node(scene->mRootNode, scene, vertices, indices);
+    if (timings) {
+        timings->post_process_ms += elapsed_ms(convert_start, Clock::now());
+    }
     
     if (vertices.empty()) {
         throw std::runtime_error("No valid geometry found in file: " + filePath);
@@ -59,29 +149,20 @@ void AssimpLoader::load_model(const std::string& filePath, std::vector<Mesh::Ver
     return;
 }
 
-LoadedModelData AssimpLoader::load_model_with_textures(const std::string& filePath) {
+LoadedModelData AssimpLoader::load_model_with_textures(const std::string& filePath, ImportTimings* timings) {
     LoadedModelData model_data;
     
     Assimp::Importer importer;
     
-    // Set post-processing flags
-    const aiScene* scene = importer.ReadFile(filePath, 
-        aiProcess_Triangulate |           // Convert polygons to triangles
-        aiProcess_FlipUVs |              // Flip UV coordinates (OpenGL convention)
-        aiProcess_GenSmoothNormals |     // Generate smooth normals if missing
-        aiProcess_CalcTangentSpace |     // Generate tangent and bitangent vectors
-        aiProcess_JoinIdenticalVertices | // Remove duplicate vertices
-        aiProcess_ImproveCacheLocality |  // Optimize vertex cache locality
-        aiProcess_RemoveRedundantMaterials | // Remove redundant materials
-        aiProcess_OptimizeMeshes |        // Optimize mesh count
-        aiProcess_OptimizeGraph          // Optimize scene graph
-    );
+    const aiScene* scene = read_scene(importer, filePath, timings);
     
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
         std::string error = importer.GetErrorString();
         throw std::runtime_error("Failed to load model with Assimp: " + error);
     }
     
+    auto convert_start = Clock::now();
+
     // Store model directory for texture path resolution (very important!)
     model_directory_ = get_directory_from_path(filePath);
     LOG_INFO("AssimpLoader: Model directory: {}", model_directory_);
@@ -118,6 +199,9 @@ LoadedModelData AssimpLoader::load_model_with_textures(const std::string& filePa
     
     // Process the scene graph starting from root node
     process_node_with_materials(scene->mRootNode, scene, model_data);
+    if (timings) {
+        timings->post_process_ms += elapsed_ms(convert_start, Clock::now());
+    }
     
     if (model_data.meshes.empty()) {
         throw std::runtime_error("No valid geometry found in file: " + filePath);
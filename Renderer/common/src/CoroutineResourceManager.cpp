@@ -1,17 +1,136 @@
 #include "CoroutineResourceManager.h"
 #include "AssimpLoader.h"
 #include "Logger.h"
+#include "Profiler.h"
 #include "Shader.h"
 #include "Scene.h"
 #include "Light.h"
+#include "GLStateCache.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <filesystem>
+#include <map>
 #include <shared_mutex>
 #include <fstream>
-#include <sstream>
+#include <tuple>
+#include <unordered_set>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Reads and decodes an LDR image, timing both stages into record. The caller frees the pixels
+// with STBImage::free_image.
+unsigned char* decode_texture_timed(const std::string& path, CoroutineResourceManager::ImportRecord& record,
+                                    int& width, int& height, int& channels) {
+    auto read_start = Clock::now();
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        LOG_WARN("CoroutineResourceManager: Cannot open texture: {}", path);
+        return nullptr;
+    }
+    std::vector<unsigned char> encoded(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+
+    auto decode_start = Clock::now();
+    record.read_ms = elapsed_ms(read_start, decode_start);
+    record.bytes = encoded.size();
+
+    glRenderer::STBImage::set_flip_vertical_on_load(true);
+    unsigned char* pixels = glRenderer::STBImage::load_image_from_memory(
+        encoded.data(), static_cast<int>(encoded.size()), &width, &height, &channels, 0);
+
+    record.parse_ms = elapsed_ms(decode_start, Clock::now());
+    if (!pixels) {
+        LOG_WARN("CoroutineResourceManager: Failed to decode texture: {}", path);
+    }
+    return pixels;
+}
+
+// Reads, decodes and uploads an LDR image, timing each stage into record
+bool load_texture_timed(Texture& texture, const std::string& path, CoroutineResourceManager::ImportRecord& record) {
+    int width = 0, height = 0, channels = 0;
+    unsigned char* pixels = decode_texture_timed(path, record, width, height, channels);
+    if (!pixels) {
+        return false;
+    }
+
+    auto upload_start = Clock::now();
+    texture.load_from_data(pixels, width, height, channels);
+    glRenderer::STBImage::free_image(pixels);
+    record.upload_ms = elapsed_ms(upload_start, Clock::now());
+    return true;
+}
+
+// Reads a GLSL file and expands its #include "file" lines, relative to the including file.
+// A file is expanded once per stage, however often it is included, so shared helpers are never
+// defined twice. #line directives keep compile errors pointing at the including file's lines.
+std::string read_shader_source(const std::filesystem::path& path, std::unordered_set<std::string>& included) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open shader file: " + path.string());
+    }
+    included.insert(std::filesystem::weakly_canonical(path).string());
+
+    std::string source;
+    std::string line;
+    int line_number = 0;
+    while (std::getline(file, line)) {
+        ++line_number;
+        size_t first = line.find_first_not_of(" \t");
+        if (first == std::string::npos || line.compare(first, 8, "#include") != 0) {
+            source += line;
+            source += '\n';
+            continue;
+        }
+
+        size_t open = line.find('"', first);
+        size_t close = open == std::string::npos ? open : line.find('"', open + 1);
+        if (close == std::string::npos) {
+            throw std::runtime_error("Malformed #include in " + path.string() + ":" + std::to_string(line_number));
+        }
+        std::filesystem::path include_path = path.parent_path() / line.substr(open + 1, close - open - 1);
+        if (included.count(std::filesystem::weakly_canonical(include_path).string()) == 0) {
+            source += "#line 1\n";
+            source += read_shader_source(include_path, included);
+            source += "#line " + std::to_string(line_number + 1) + "\n";
+        }
+    }
+    return source;
+}
+
+void write_json_string(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        switch (c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out << escaped;
+                } else {
+                    out << c;
+                }
+                break;
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
 CoroutineResourceManager::CoroutineResourceManager() 
     : scheduler_(&Async::CoroutineThreadPoolScheduler::get_instance()) {
 
@@ -51,6 +170,7 @@ CoroutineResourceManager::~CoroutineResourceManager() {
 Async::Task<std::shared_ptr<Mesh>> CoroutineResourceManager::load_mesh_async(const std::string& path,
                                                                             std::function<void(float, const std::string&)> progressCallback,
                                                                             Async::TaskPriority priority) {  
+    auto request_time = Clock::now();
     std::string normalized_path = normalize_resource_path(path);
     LOG_INFO("Normalized path: '{}'", normalized_path);
     
@@ -89,8 +209,17 @@ Async::Task<std::shared_ptr<Mesh>> CoroutineResourceManager::load_mesh_async(con
         
 
         
+        ImportRecord record;
+        record.path = normalized_path;
+        record.kind = "mesh";
+        record.priority = priority;
+        Clock::time_point worker_end;
+
         // Use AssimpLoader directly in thread pool
-        auto mesh = co_await scheduler_->submit_to_threadpool(priority, [this, path, progressCallback]() -> std::shared_ptr<Mesh> {
+        auto submit_time = Clock::now();
+        auto mesh = co_await scheduler_->submit_to_threadpool(priority, [this, path, progressCallback, submit_time, &record, &worker_end]() -> std::shared_ptr<Mesh> {
+            PROFILE_SCOPE("Load mesh");
+            record.queue_wait_ms = elapsed_ms(submit_time, Clock::now());
             if (progressCallback) {
                 progressCallback(0.1f, "Starting file load...");
             }
@@ -103,24 +232,38 @@ Async::Task<std::shared_ptr<Mesh>> CoroutineResourceManager::load_mesh_async(con
             }
 
             // Direct AssimpLoader call
-            assimp_loader_->load_model(path, vertices, indices);
+            ImportTimings timings;
+            {
+                PROFILE_SCOPE("AssimpLoader::load_model");
+                assimp_loader_->load_model(path, vertices, indices, &timings);
+            }
+            record.bytes = timings.bytes_read;
+            record.read_ms = timings.read_ms;
+            record.parse_ms = timings.parse_ms;
+            record.post_process_ms = timings.post_process_ms;
 
             if (progressCallback) {
                 progressCallback(0.8f, "Creating mesh...");
             }
 
-            auto mesh = std::make_shared<Mesh>(vertices, indices);
+            auto mesh = std::make_shared<Mesh>(std::move(vertices), std::move(indices));
 
             if (progressCallback) {
                 progressCallback(1.0f, "Completed!");
             }
            
-            LOG_INFO("CoroutineResourceManager: Loaded {} vertices, {} indices", vertices.size(), indices.size());
+            LOG_INFO("CoroutineResourceManager: Loaded {} vertices, {} indices", mesh->get_vertex_count(), mesh->get_index_count());
             
+            worker_end = Clock::now();
             return mesh;
         });
         
         if (mesh) {
+            auto resume_time = Clock::now();
+            record.continuation_ms = elapsed_ms(worker_end, resume_time);
+            record.total_ms = elapsed_ms(request_time, resume_time);
+            record_import(record);
+
             // cache the loaded mesh
             {
                 std::unique_lock<std::shared_mutex> cache_lock(cache_mutex_);
@@ -145,6 +288,7 @@ Async::Task<std::shared_ptr<Mesh>> CoroutineResourceManager::load_mesh_async(con
 // Texture loading
 Async::Task<std::shared_ptr<Texture>> CoroutineResourceManager::load_texture_async(const std::string& path, Async::TaskPriority priority) {
     LOG_INFO("CoroutineResourceManager: Starting coroutine texture load for: {}", path);
+    auto request_time = Clock::now();
     
     std::string normalized_path = normalize_resource_path(path);
 
@@ -175,30 +319,51 @@ Async::Task<std::shared_ptr<Texture>> CoroutineResourceManager::load_texture_asy
             co_return nullptr;
         }
         
+        ImportRecord record;
+        record.path = normalized_path;
+        record.kind = "texture";
+        record.priority = priority;
+        Clock::time_point worker_end;
+
         // Use coroutine scheduler to submit to thread pool
-        auto texture = co_await scheduler_->submit_to_threadpool(priority, [path]() -> std::shared_ptr<Texture> {
+        auto submit_time = Clock::now();
+        auto texture = co_await scheduler_->submit_to_threadpool(priority, [path, submit_time, &record, &worker_end]() -> std::shared_ptr<Texture> {
+            PROFILE_SCOPE("Load texture");
+            record.queue_wait_ms = elapsed_ms(submit_time, Clock::now());
             LOG_DEBUG("CoroutineResourceManager: Worker thread loading texture: {}", path);
             
             auto texture = std::make_shared<Texture>();
             
             // Determine file type and load accordingly
             if (glRenderer::STBImage::is_exr_file(path.c_str()) || glRenderer::STBImage::is_hdr_file(path.c_str())) {
-                // Load HDR/EXR files
+                // Load HDR/EXR files; read, decode and upload happen in one call
+                auto load_start = Clock::now();
                 texture->load_equirectangular_hdr(path);
+                record.parse_ms = elapsed_ms(load_start, Clock::now());
+                std::error_code error;
+                auto size = std::filesystem::file_size(path, error);
+                record.bytes = error ? 0 : size;
             } else {
                 // Load standard LDR files
-                texture->load_from_file(path);
+                load_texture_timed(*texture, path, record);
             }
             
             LOG_DEBUG("CoroutineResourceManager: Texture loaded successfully: {}", path);
+            worker_end = Clock::now();
             return texture;
         });
         
         if (texture) {
+            auto resume_time = Clock::now();
+            record.continuation_ms = elapsed_ms(worker_end, resume_time);
+            record.total_ms = elapsed_ms(request_time, resume_time);
+            record_import(record);
+
             // Cache result
             {
                 std::unique_lock<std::shared_mutex> cache_lock(cache_mutex_);
                 texture_cache_[normalized_path] = texture;
+                ++texture_generation_;
                 LOG_DEBUG("CoroutineResourceManager: Cached texture: {}", normalized_path);
             }
             
@@ -243,9 +408,140 @@ void CoroutineResourceManager::reset_stats() {
     stats_.priority_loads[2].store(0, std::memory_order_relaxed); // high
     stats_.priority_loads[3].store(0, std::memory_order_relaxed); // critical
 
+    {
+        std::lock_guard<std::mutex> lock(telemetry_mutex_);
+        import_records_.clear();
+        import_count_ = 0;
+        texture_import_count_ = 0;
+        import_bytes_ = 0;
+        import_busy_ms_ = 0.0;
+        texture_busy_ms_ = 0.0;
+    }
+
     LOG_INFO("CoroutineResourceManager: Statistics reset (including dual-cache metrics)");
 }
 
+void CoroutineResourceManager::record_import(const ImportRecord& record) {
+    std::lock_guard<std::mutex> lock(telemetry_mutex_);
+    import_records_.push_back(record);
+    if (import_records_.size() > MAX_IMPORT_RECORDS) {
+        import_records_.pop_front();
+    }
+
+    double busy_ms = record.read_ms + record.parse_ms + record.post_process_ms + record.upload_ms;
+    ++import_count_;
+    import_bytes_ += record.bytes;
+    import_busy_ms_ += busy_ms;
+    if (record.kind == "texture") {
+        ++texture_import_count_;
+        texture_busy_ms_ += busy_ms;
+    }
+}
+
+void CoroutineResourceManager::add_upload_time(const std::string& path, double upload_ms) {
+    std::lock_guard<std::mutex> lock(telemetry_mutex_);
+    for (auto it = import_records_.rbegin(); it != import_records_.rend(); ++it) {
+        if (it->path == path) {
+            it->upload_ms += upload_ms;
+            it->total_ms += upload_ms;
+            import_busy_ms_ += upload_ms;
+            return;
+        }
+    }
+}
+
+CoroutineResourceManager::LoadTelemetry CoroutineResourceManager::get_load_telemetry() const {
+    LoadTelemetry telemetry;
+    {
+        std::lock_guard<std::mutex> lock(telemetry_mutex_);
+        telemetry.imports.assign(import_records_.begin(), import_records_.end());
+        telemetry.import_count = import_count_;
+        telemetry.texture_count = texture_import_count_;
+        telemetry.total_bytes = import_bytes_;
+        if (import_busy_ms_ > 0.0) {
+            telemetry.mb_per_second = (import_bytes_ / (1024.0 * 1024.0)) / (import_busy_ms_ / 1000.0);
+        }
+        if (texture_busy_ms_ > 0.0) {
+            telemetry.textures_per_second = texture_import_count_ / (texture_busy_ms_ / 1000.0);
+        }
+    }
+    if (scheduler_) {
+        telemetry.scheduler = scheduler_->get_stats();
+    }
+    return telemetry;
+}
+
+bool CoroutineResourceManager::export_load_telemetry_json(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        LOG_ERROR("CoroutineResourceManager: Cannot open '{}' for writing", path);
+        return false;
+    }
+
+    LoadTelemetry telemetry = get_load_telemetry();
+    const auto& scheduler = telemetry.scheduler;
+    static const char* priority_names[] = { "background", "normal", "high", "critical" };
+
+    char number[64];
+    auto format_number = [&](double value) {
+        std::snprintf(number, sizeof(number), "%.3f", value);
+        return number;
+    };
+
+    out << "{\n  \"import_count\": " << telemetry.import_count
+        << ",\n  \"texture_count\": " << telemetry.texture_count
+        << ",\n  \"total_bytes\": " << telemetry.total_bytes
+        << ",\n  \"mb_per_second\": " << format_number(telemetry.mb_per_second)
+        << ",\n  \"textures_per_second\": " << format_number(telemetry.textures_per_second);
+
+    out << ",\n  \"queue_wait\": {";
+    for (size_t i = 0; i < scheduler.queue_wait.size(); ++i) {
+        const auto& wait = scheduler.queue_wait[i];
+        double avg_ms = wait.count > 0 ? wait.total_ms / wait.count : 0.0;
+        out << (i > 0 ? ", " : "") << "\"" << priority_names[i] << "\": {\"count\": " << wait.count
+            << ", \"avg_ms\": " << format_number(avg_ms);
+        out << ", \"max_ms\": " << format_number(wait.max_ms) << "}";
+    }
+    out << "}";
+
+    out << ",\n  \"worker_utilization\": [";
+    for (size_t i = 0; i < scheduler.worker_utilization.size(); ++i) {
+        out << (i > 0 ? ", " : "") << format_number(scheduler.worker_utilization[i]);
+    }
+    out << "]";
+
+    double delay_avg_ms = scheduler.main_thread_resumes > 0
+        ? scheduler.main_thread_delay_total_ms / scheduler.main_thread_resumes : 0.0;
+    out << ",\n  \"main_thread_delay\": {\"count\": " << scheduler.main_thread_resumes
+        << ", \"avg_ms\": " << format_number(delay_avg_ms);
+    out << ", \"max_ms\": " << format_number(scheduler.main_thread_delay_max_ms) << "}";
+
+    out << ",\n  \"imports\": [";
+    for (size_t i = 0; i < telemetry.imports.size(); ++i) {
+        const ImportRecord& record = telemetry.imports[i];
+        out << (i > 0 ? "," : "") << "\n    {\"path\": ";
+        write_json_string(out, record.path);
+        out << ", \"kind\": \"" << record.kind << "\""
+            << ", \"priority\": \"" << priority_names[static_cast<size_t>(record.priority)] << "\""
+            << ", \"bytes\": " << record.bytes;
+        out << ", \"queue_wait_ms\": " << format_number(record.queue_wait_ms);
+        out << ", \"read_ms\": " << format_number(record.read_ms);
+        out << ", \"parse_ms\": " << format_number(record.parse_ms);
+        out << ", \"post_process_ms\": " << format_number(record.post_process_ms);
+        out << ", \"upload_ms\": " << format_number(record.upload_ms);
+        out << ", \"continuation_ms\": " << format_number(record.continuation_ms);
+        out << ", \"total_ms\": " << format_number(record.total_ms) << "}";
+    }
+    out << "\n  ]\n}\n";
+
+    if (!out) {
+        LOG_ERROR("CoroutineResourceManager: Failed writing load telemetry to '{}'", path);
+        return false;
+    }
+    LOG_INFO("CoroutineResourceManager: Wrote telemetry for {} imports to '{}'", telemetry.imports.size(), path);
+    return true;
+}
+
 void CoroutineResourceManager::clear_all_caches() {
     // Clear both resource cache and task cache with single lock
     std::unique_lock<std::shared_mutex> lock(cache_mutex_);
@@ -253,6 +549,8 @@ void CoroutineResourceManager::clear_all_caches() {
     // Clear resource caches
     mesh_cache_.clear();
     texture_cache_.clear();
+    texture_arrays_.clear();
+    texture_layer_cache_.clear();
     material_cache_.clear();
     model_cache_.clear();
     irradiance_cache_.clear();
@@ -519,6 +817,7 @@ void CoroutineResourceManager::store_texture_in_cache(const std::string& texture
     
     std::unique_lock<std::shared_mutex> lock(cache_mutex_);
     texture_cache_[texture_id] = texture;
+    ++texture_generation_;
     LOG_DEBUG("CoroutineResourceManager: Texture '{}' stored in cache", texture_id);
 }
 
@@ -536,27 +835,166 @@ void CoroutineResourceManager::store_renderable_in_cache(const std::string& rend
 void CoroutineResourceManager::load_model_textures(const std::unordered_map<std::string, std::string>& texture_paths) {
     LOG_INFO("CoroutineResourceManager: Loading {} textures for model", texture_paths.size());
     
+    if (texture_array_packing_) {
+        load_model_textures_packed(texture_paths);
+        return;
+    }
+    
+    for (const auto& [texture_name, texture_path] : texture_paths) {
+        load_model_texture(texture_path);
+    }
+}
+
+void CoroutineResourceManager::load_model_texture(const std::string& texture_path) {
+    try {
+        // Check if texture is already cached
+        auto existing_texture = get<Texture>(texture_path);
+        if (!existing_texture) {
+            // Create and load texture
+            ImportRecord record;
+            record.path = texture_path;
+            record.kind = "texture";
+            auto texture = std::make_shared<Texture>();
+            load_texture_timed(*texture, texture_path, record);
+            record.total_ms = record.read_ms + record.parse_ms + record.upload_ms;
+            record_import(record);
+            
+            // Cache the loaded texture
+            store_texture_in_cache(texture_path, texture);
+            LOG_INFO("CoroutineResourceManager: Loaded and cached texture: {}", texture_path);
+        } else {
+            LOG_DEBUG("CoroutineResourceManager: Using cached texture: {}", texture_path);
+        }
+    } catch (const std::exception& e) {
+        LOG_WARN("CoroutineResourceManager: Failed to load texture {}: {}", texture_path, e.what());
+    }
+}
+
+void CoroutineResourceManager::load_model_textures_packed(const std::unordered_map<std::string, std::string>& texture_paths) {
+    // Group by resolution class (size and channel count) from the file headers, so only one decoded
+    // image is held at a time. std::map keeps the array order stable between runs.
+    std::map<std::tuple<int, int, int>, std::vector<std::string>> classes;
+    std::unordered_set<std::string> seen;
     for (const auto& [texture_name, texture_path] : texture_paths) {
-        try {
-            // Check if texture is already cached
-            auto existing_texture = get<Texture>(texture_path);
-            if (!existing_texture) {
-                // Create and load texture
-                auto texture = std::make_shared<Texture>();
-                texture->load_from_file(texture_path);
+        if (!seen.insert(texture_path).second || get<Texture>(texture_path) || get_texture_layer(texture_path)) {
+            continue;
+        }
+        int width = 0, height = 0, channels = 0;
+        if (!glRenderer::STBImage::get_image_info(texture_path.c_str(), &width, &height, &channels)) {
+            LOG_WARN("CoroutineResourceManager: Cannot read texture header: {}", texture_path);
+            continue;
+        }
+        classes[{ width, height, channels }].push_back(texture_path);
+    }
+    
+    GLint max_layers = 256;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &max_layers);
+    
+    for (const auto& [resolution, paths] : classes) {
+        auto [width, height, channels] = resolution;
+        GLenum format = channels == 1 ? GL_RED : (channels == 3 ? GL_RGB : (channels == 4 ? GL_RGBA : GL_NONE));
+        GLenum internal_format = channels == 1 ? GL_R8 : (channels == 3 ? GL_RGB8 : GL_RGBA8);
+        
+        // A class of one gains nothing from an array; two-channel images are not supported by either path
+        if (paths.size() < MIN_TEXTURE_ARRAY_LAYERS || format == GL_NONE) {
+            for (const auto& path : paths) {
+                load_model_texture(path);
+            }
+            continue;
+        }
+        
+        for (size_t first = 0; first < paths.size(); first += static_cast<size_t>(max_layers)) {
+            // A material can only sample the arrays the geometry pass binds; past those, separate
+            // textures keep the rest of the classes textured
+            size_t array_count = 0;
+            {
+                std::shared_lock<std::shared_mutex> lock(cache_mutex_);
+                array_count = texture_arrays_.size();
+            }
+            if (array_count >= Material::MAX_TEXTURE_ARRAYS) {
+                LOG_INFO("CoroutineResourceManager: All {} texture arrays in use, loading {} textures of {}x{} separately",
+                         Material::MAX_TEXTURE_ARRAYS, paths.size() - first, width, height);
+                for (size_t i = first; i < paths.size(); ++i) {
+                    load_model_texture(paths[i]);
+                }
+                break;
+            }
+            
+            size_t count = std::min(paths.size() - first, static_cast<size_t>(max_layers));
+            auto array = std::make_shared<Texture>(Texture::create_texture_array(
+                static_cast<GLuint>(width), static_cast<GLuint>(height), static_cast<GLuint>(count), internal_format));
+            
+            std::vector<ImportRecord> records;
+            std::vector<std::pair<std::string, uint32_t>> layers;
+            for (size_t i = 0; i < count; ++i) {
+                const std::string& path = paths[first + i];
+                ImportRecord record;
+                record.path = path;
+                record.kind = "texture";
+                int image_width = 0, image_height = 0, image_channels = 0;
+                unsigned char* pixels = decode_texture_timed(path, record, image_width, image_height, image_channels);
+                if (!pixels) {
+                    continue;
+                }
+                if (image_width != width || image_height != height || image_channels != channels) {
+                    LOG_WARN("CoroutineResourceManager: Texture {} decoded to {}x{} ({} channels), header said {}x{} ({} channels)",
+                             path, image_width, image_height, image_channels, width, height, channels);
+                    glRenderer::STBImage::free_image(pixels);
+                    continue;
+                }
                 
-                // Cache the loaded texture
-                store_texture_in_cache(texture_path, texture);
-                LOG_INFO("CoroutineResourceManager: Loaded and cached texture: {}", texture_path);
-            } else {
-                LOG_DEBUG("CoroutineResourceManager: Using cached texture: {}", texture_path);
+                auto upload_start = Clock::now();
+                array->upload_layer(static_cast<GLuint>(i), format, pixels);
+                glRenderer::STBImage::free_image(pixels);
+                record.upload_ms = elapsed_ms(upload_start, Clock::now());
+                records.push_back(record);
+                layers.emplace_back(path, static_cast<uint32_t>(i));
             }
-        } catch (const std::exception& e) {
-            LOG_WARN("CoroutineResourceManager: Failed to load texture {}: {}", texture_path, e.what());
+            
+            // The mip chain is built once for the whole array; its cost is shared by the layers
+            auto mip_start = Clock::now();
+            array->generate_array_mipmaps();
+            double mip_ms = elapsed_ms(mip_start, Clock::now());
+            for (auto& record : records) {
+                record.upload_ms += mip_ms / static_cast<double>(records.size());
+                record.total_ms = record.read_ms + record.parse_ms + record.upload_ms;
+                record_import(record);
+            }
+            
+            if (layers.empty()) {
+                continue;
+            }
+            
+            uint32_t array_index = 0;
+            {
+                std::unique_lock<std::shared_mutex> lock(cache_mutex_);
+                array_index = static_cast<uint32_t>(texture_arrays_.size());
+                texture_arrays_.push_back(array);
+                for (const auto& [path, layer] : layers) {
+                    texture_layer_cache_[path] = { array_index, layer };
+                }
+                ++texture_generation_;
+            }
+            LOG_INFO("CoroutineResourceManager: Packed {} textures of {}x{} ({} channels) into texture array {}",
+                     layers.size(), width, height, channels, array_index);
         }
     }
 }
 
+std::optional<CoroutineResourceManager::TextureLayer> CoroutineResourceManager::get_texture_layer(const std::string& path) const {
+    std::shared_lock<std::shared_mutex> lock(cache_mutex_);
+    auto it = texture_layer_cache_.find(normalize_resource_path(path));
+    if (it == texture_layer_cache_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::vector<std::shared_ptr<Texture>> CoroutineResourceManager::get_texture_arrays() const {
+    std::shared_lock<std::shared_mutex> lock(cache_mutex_);
+    return texture_arrays_;
+}
+
 std::shared_ptr<Model> CoroutineResourceManager::create_model_with_default_material(const std::string& mesh_path, const std::string& model_name) {
     LOG_INFO("CoroutineResourceManager: Creating model '{}' with default material from mesh '{}'", model_name, mesh_path);
     
@@ -631,7 +1069,8 @@ std::shared_ptr<Mesh> CoroutineResourceManager::createQuad(const std::string& qu
     };
     
     // Create mesh
-    auto quad_mesh = std::make_shared<Mesh>(vertices, indices);
+    // Drawn by the renderer, never picked
+    auto quad_mesh = std::make_shared<Mesh>(std::move(vertices), std::move(indices), Mesh::Retention::None);
     
     // Cache the quad mesh
     {
@@ -647,6 +1086,7 @@ Async::Task<LoadedModelData> CoroutineResourceManager::load_model_with_textures_
                                                                                      std::function<void(float, const std::string&)> progress_callback,
                                                                                      Async::TaskPriority priority) {
     LOG_INFO("CoroutineResourceManager: Loading model with textures: {}", model_path);
+    auto request_time = Clock::now();
     
     if (progress_callback) {
         progress_callback(0.0f, "Starting model load with textures...");
@@ -670,15 +1110,28 @@ Async::Task<LoadedModelData> CoroutineResourceManager::load_model_with_textures_
             co_return LoadedModelData{};
         }
         
+        ImportRecord record;
+        record.path = model_path;
+        record.kind = "model";
+        record.priority = priority;
+        Clock::time_point worker_end;
+
         // Use AssimpLoader to load model with textures in thread pool
-        auto model_data = co_await scheduler_->submit_to_threadpool(priority, [this, model_path, progress_callback]() -> LoadedModelData {
+        auto submit_time = Clock::now();
+        auto model_data = co_await scheduler_->submit_to_threadpool(priority, [this, model_path, progress_callback, submit_time, &record, &worker_end]() -> LoadedModelData {
+            record.queue_wait_ms = elapsed_ms(submit_time, Clock::now());
             if (progress_callback) {
                 progress_callback(0.1f, "Loading model data with textures...");
             }
             
             try {
                 // Use the enhanced AssimpLoader method
-                LoadedModelData data = assimp_loader_->load_model_with_textures(model_path);
+                ImportTimings timings;
+                LoadedModelData data = assimp_loader_->load_model_with_textures(model_path, &timings);
+                record.bytes = timings.bytes_read;
+                record.read_ms = timings.read_ms;
+                record.parse_ms = timings.parse_ms;
+                record.post_process_ms = timings.post_process_ms;
                 
                 if (progress_callback) {
                     progress_callback(0.8f, "Processing textures...");
@@ -705,6 +1158,7 @@ Async::Task<LoadedModelData> CoroutineResourceManager::load_model_with_textures_
                 LOG_INFO("CoroutineResourceManager: Loaded {} meshes with {} vertices, {} indices, {} materials, {} textures", 
                         data.meshes.size(), total_vertices, total_indices, data.materials.size(), data.texture_paths.size());
                 
+                worker_end = Clock::now();
                 return data;
                 
             } catch (const std::exception& e) {
@@ -716,6 +1170,13 @@ Async::Task<LoadedModelData> CoroutineResourceManager::load_model_with_textures_
             }
         });
         
+        if (!model_data.meshes.empty()) {
+            auto resume_time = Clock::now();
+            record.continuation_ms = elapsed_ms(worker_end, resume_time);
+            record.total_ms = elapsed_ms(request_time, resume_time);
+            record_import(record);
+        }
+
         stats_.async_loads_completed.fetch_add(1, std::memory_order_relaxed);
         co_return model_data;
         
@@ -748,16 +1209,8 @@ std::shared_ptr<Shader> CoroutineResourceManager::create_shader_sync(
         
         for (const auto& source : sources) {
             if (!source.path.empty()) {
-                std::ifstream file(source.path);
-                if (!file.is_open()) {
-                    throw std::runtime_error("Failed to open shader file: " + source.path);
-                }
-                
-                std::stringstream stream;
-                stream << file.rdbuf();
-                file.close();
-                
-                std::string source_code = stream.str();
+                std::unordered_set<std::string> included;
+                std::string source_code = read_shader_source(source.path, included);
                 if (source_code.empty()) {
                     throw std::runtime_error("Shader file is empty: " + source.path);
                 }
@@ -766,17 +1219,19 @@ std::shared_ptr<Shader> CoroutineResourceManager::create_shader_sync(
             }
         }
         
-        // Create and compile shader
         auto shader = std::make_shared<Shader>();
-        
-        // Attach all shaders
-        for (const auto& source_data : shader_sources) {
-            shader->attach_shader(source_data.first, source_data.second);
+        uint64_t binary_key = program_binary_cache_.make_key(shader_sources);
+        if (!program_binary_cache_.load(binary_key, *shader)) {
+            // Attach all shaders
+            for (const auto& source_data : shader_sources) {
+                shader->attach_shader(source_data.first, source_data.second);
+            }
+            
+            // Link the program
+            shader->link_program();
+            program_binary_cache_.store(binary_key, *shader);
         }
         
-        // Link the program
-        shader->link_program();
-        
         // Store in cache
         {
             std::unique_lock<std::shared_mutex> cache_lock(cache_mutex_);
@@ -840,6 +1295,136 @@ std::vector<std::string> CoroutineResourceManager::get_shader_names() const {
     return names;
 }
 
+bool CoroutineResourceManager::create_scene_shaders() {
+    auto start_time = std::chrono::steady_clock::now();
+    uint32_t cached_before = program_binary_cache_.get_stats().hits;
+
+    auto main_shader = create_shader_sync("simple_scene_main_shader", {
+        {"../assets/shaders/vertex.glsl", GL_VERTEX_SHADER},
+        {"../assets/shaders/phong_fragment.glsl", GL_FRAGMENT_SHADER}
+    });
+    
+    auto light_shader = create_shader_sync("simple_scene_light_shader", {
+        {"../assets/shaders/light_vertex.glsl", GL_VERTEX_SHADER},
+        {"../assets/shaders/light_fragment.glsl", GL_FRAGMENT_SHADER}
+    });
+    
+    // Create deferred rendering shaders
+    auto deferred_geometry_shader = create_shader_sync("deferred_geometry_shader", {
+        {"../assets/shaders/deferred_geometry_vertex.glsl", GL_VERTEX_SHADER},
+        {"../assets/shaders/deferred_geometry_fragment.glsl", GL_FRAGMENT_SHADER}
+    });
+    
+    auto deferred_lighting_shader = create_shader_sync("deferred_lighting_shader", {
+        {"../assets/shaders/deferred_lighting_vertex.glsl", GL_VERTEX_SHADER},
+        {"../assets/shaders/deferred_lighting_fragment.glsl", GL_FRAGMENT_SHADER}
+    });
+    
+    if (!deferred_lighting_shader) {
+        LOG_ERROR("Failed to create deferred_lighting_shader!");
+    } else {
+        LOG_INFO("Successfully created deferred_lighting_shader");
+    }
+    
+    // Create SSAO shaders
+    auto ssao_compute_shader = create_shader_sync("ssao_compute_shader", {
+        {"../assets/shaders/ssao_compute.glsl", GL_COMPUTE_SHADER}
+    });
+    
+    auto ssao_blur_shader = create_shader_sync("ssao_blur_shader", {
+        {"../assets/shaders/ssao_blur_vertex.glsl", GL_VERTEX_SHADER},
+        {"../assets/shaders/ssao_blur_fragment.glsl", GL_FRAGMENT_SHADER}
+    });
+    
+    auto ssao_apply_shader = create_shader_sync("ssao_apply_shader", {
+        {"../assets/shaders/ssao_apply_vertex.glsl", GL_VERTEX_SHADER},
+        {"../assets/shaders/ssao_apply_fragment.glsl", GL_FRAGMENT_SHADER}
+    });
+    
+    // Create SSGI shaders
+    
+    auto deferred_lighting_direct_shader = create_shader_sync("deferred_lighting_direct_shader", {
+        {"../assets/shaders/deferred_lighting_direct_vertex.glsl", GL_VERTEX_SHADER},
+        {"../assets/shaders/deferred_lighting_direct_fragment.glsl", GL_FRAGMENT_SHADER}
+    });
+    
+    auto deferred_lighting_tiled_shader = create_shader_sync("deferred_lighting_tiled_shader", {
+        {"../assets/shaders/deferred_lighting_tiled.glsl", GL_COMPUTE_SHADER}
+    });
+    
+    auto ssgi_compute_shader = create_shader_sync("ssgi_compute_shader", {
+        {"../assets/shaders/ssgi_compute.glsl", GL_COMPUTE_SHADER}
+    });
+    
+    auto ssgi_denoise_shader = create_shader_sync("ssgi_denoise_shader", {
+        {"../assets/shaders/ssgi_denoise_vertex.glsl", GL_VERTEX_SHADER},
+        {"../assets/shaders/ssgi_denoise_fragment.glsl", GL_FRAGMENT_SHADER}
+    });
+    
+    auto ssgi_composition_shader = create_shader_sync("ssgi_composition_shader", {
+        {"../assets/shaders/ssgi_composition_vertex.glsl", GL_VERTEX_SHADER},
+        {"../assets/shaders/ssgi_composition_fragment.glsl", GL_FRAGMENT_SHADER}
+    });
+
+    // Hi-Z Buffer generation compute shader
+    auto hiz_generate_shader = create_shader_sync("hiz_generate_shader", {
+        {"../assets/shaders/hiz_generate.glsl", GL_COMPUTE_SHADER}
+    });
+
+    // Hi-Z occlusion culling compute shader
+    auto occlusion_cull_shader = create_shader_sync("occlusion_cull_shader", {
+        {"../assets/shaders/occlusion_cull.glsl", GL_COMPUTE_SHADER}
+    });
+
+    // Shadow map min/max pyramid for adaptive PCSS
+    auto shadow_min_max_shader = create_shader_sync("shadow_min_max_shader", {
+        {"../assets/shaders/shadow_min_max.glsl", GL_COMPUTE_SHADER}
+    });
+
+    // Temporal anti-aliasing resolve
+    auto taa_resolve_shader = create_shader_sync("taa_resolve_shader", {
+        {"../assets/shaders/taa_resolve_vertex.glsl", GL_VERTEX_SHADER},
+        {"../assets/shaders/taa_resolve_fragment.glsl", GL_FRAGMENT_SHADER}
+    });
+    
+    if (!ssao_compute_shader || !ssao_blur_shader || !ssao_apply_shader || !deferred_lighting_direct_shader || 
+        !deferred_lighting_tiled_shader || !ssgi_compute_shader || !ssgi_denoise_shader || !ssgi_composition_shader || !hiz_generate_shader ||
+        !occlusion_cull_shader || !shadow_min_max_shader || !taa_resolve_shader) {
+        LOG_ERROR("Failed to create SSAO, SSGI, Hi-Z or TAA shaders!");
+    } else {
+        LOG_INFO("Successfully created all SSAO, SSGI, Hi-Z and TAA shaders");
+    }
+    
+    
+    // auto gbuffer_debug_shader = create_shader_sync("gbuffer_debug_shader", {
+    //     {"../assets/shaders/gbuffer_debug_vertex.glsl", GL_VERTEX_SHADER},
+    //     {"../assets/shaders/gbuffer_debug_fragment.glsl", GL_FRAGMENT_SHADER}
+    // });
+    
+    // Create skybox shader
+    auto skybox_shader = create_shader_sync("skybox_shader", {
+        {"../assets/shaders/skybox_vertex.glsl", GL_VERTEX_SHADER},
+        {"../assets/shaders/skybox_fragment.glsl", GL_FRAGMENT_SHADER}
+    });
+    
+    // Create plane reflection shader
+    auto plane_reflection_shader = create_shader_sync("plane_reflection_shader", {
+        {"../assets/shaders/vertex.glsl", GL_VERTEX_SHADER},
+        {"../assets/shaders/plane_reflection_fragment.glsl", GL_FRAGMENT_SHADER}
+    });
+
+    bool all_created = main_shader && light_shader && deferred_geometry_shader && deferred_lighting_shader &&
+        ssao_compute_shader && ssao_blur_shader && ssao_apply_shader && deferred_lighting_direct_shader &&
+        deferred_lighting_tiled_shader && ssgi_compute_shader && ssgi_denoise_shader && ssgi_composition_shader &&
+        hiz_generate_shader && occlusion_cull_shader && shadow_min_max_shader && taa_resolve_shader &&
+        skybox_shader && plane_reflection_shader;
+
+    double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+    LOG_INFO("CoroutineResourceManager: Scene shaders ready in {:.1f} ms, {} linked from the program binary cache",
+             elapsed_ms, program_binary_cache_.get_stats().hits - cached_before);
+    return all_created;
+}
+
 std::unique_ptr<Scene> CoroutineResourceManager::create_simple_scene() {
     LOG_INFO("CoroutineResourceManager: Creating simple scene");
     
@@ -895,7 +1480,7 @@ std::unique_ptr<Scene> CoroutineResourceManager::create_simple_scene() {
     };
 
     // Create cube mesh and store in cache
-    auto cube_mesh = std::make_shared<Mesh>(vertices, indices);
+    auto cube_mesh = std::make_shared<Mesh>(std::move(vertices), std::move(indices));
     {
         std::unique_lock<std::shared_mutex> lock(cache_mutex_);
         mesh_cache_["simple_scene_cube"] = cube_mesh;
@@ -922,7 +1507,7 @@ std::unique_ptr<Scene> CoroutineResourceManager::create_simple_scene() {
     };
 
     // Create plane mesh and store in cache
-    auto plane_mesh = std::make_shared<Mesh>(plane_vertices, plane_indices);
+    auto plane_mesh = std::make_shared<Mesh>(std::move(plane_vertices), std::move(plane_indices));
     {
         std::unique_lock<std::shared_mutex> lock(cache_mutex_);
         mesh_cache_["simple_scene_plane"] = plane_mesh;
@@ -1015,101 +1600,11 @@ std::unique_ptr<Scene> CoroutineResourceManager::create_simple_scene() {
         material_cache_["simple_scene_cube_material"] = cube_material;
         material_cache_["simple_scene_plane_material"] = plane_material;
         texture_cache_[texture_path] = clay_texture;
+        ++texture_generation_;
     }
 
     // Create shaders
-    auto main_shader = create_shader_sync("simple_scene_main_shader", {
-        {"../assets/shaders/vertex.glsl", GL_VERTEX_SHADER},
-        {"../assets/shaders/phong_fragment.glsl", GL_FRAGMENT_SHADER}
-    });
-    
-    auto light_shader = create_shader_sync("simple_scene_light_shader", {
-        {"../assets/shaders/light_vertex.glsl", GL_VERTEX_SHADER},
-        {"../assets/shaders/light_fragment.glsl", GL_FRAGMENT_SHADER}
-    });
-    
-    // Create deferred rendering shaders
-    auto deferred_geometry_shader = create_shader_sync("deferred_geometry_shader", {
-        {"../assets/shaders/deferred_geometry_vertex.glsl", GL_VERTEX_SHADER},
-        {"../assets/shaders/deferred_geometry_fragment.glsl", GL_FRAGMENT_SHADER}
-    });
-    
-    auto deferred_lighting_shader = create_shader_sync("deferred_lighting_shader", {
-        {"../assets/shaders/deferred_lighting_vertex.glsl", GL_VERTEX_SHADER},
-        {"../assets/shaders/deferred_lighting_fragment.glsl", GL_FRAGMENT_SHADER}
-    });
-    
-    if (!deferred_lighting_shader) {
-        LOG_ERROR("Failed to create deferred_lighting_shader!");
-    } else {
-        LOG_INFO("Successfully created deferred_lighting_shader");
-    }
-    
-    // Create SSAO shaders
-    auto ssao_compute_shader = create_shader_sync("ssao_compute_shader", {
-        {"../assets/shaders/ssao_compute.glsl", GL_COMPUTE_SHADER}
-    });
-    
-    auto ssao_blur_shader = create_shader_sync("ssao_blur_shader", {
-        {"../assets/shaders/ssao_blur_vertex.glsl", GL_VERTEX_SHADER},
-        {"../assets/shaders/ssao_blur_fragment.glsl", GL_FRAGMENT_SHADER}
-    });
-    
-    auto ssao_apply_shader = create_shader_sync("ssao_apply_shader", {
-        {"../assets/shaders/ssao_apply_vertex.glsl", GL_VERTEX_SHADER},
-        {"../assets/shaders/ssao_apply_fragment.glsl", GL_FRAGMENT_SHADER}
-    });
-    
-    // Create SSGI shaders
-    
-    auto deferred_lighting_direct_shader = create_shader_sync("deferred_lighting_direct_shader", {
-        {"../assets/shaders/deferred_lighting_direct_vertex.glsl", GL_VERTEX_SHADER},
-        {"../assets/shaders/deferred_lighting_direct_fragment.glsl", GL_FRAGMENT_SHADER}
-    });
-    
-    auto ssgi_compute_shader = create_shader_sync("ssgi_compute_shader", {
-        {"../assets/shaders/ssgi_compute.glsl", GL_COMPUTE_SHADER}
-    });
-    
-    auto ssgi_denoise_shader = create_shader_sync("ssgi_denoise_shader", {
-        {"../assets/shaders/ssgi_denoise_vertex.glsl", GL_VERTEX_SHADER},
-        {"../assets/shaders/ssgi_denoise_fragment.glsl", GL_FRAGMENT_SHADER}
-    });
-    
-    auto ssgi_composition_shader = create_shader_sync("ssgi_composition_shader", {
-        {"../assets/shaders/ssgi_composition_vertex.glsl", GL_VERTEX_SHADER},
-        {"../assets/shaders/ssgi_composition_fragment.glsl", GL_FRAGMENT_SHADER}
-    });
-
-    // Hi-Z Buffer generation compute shader
-    auto hiz_generate_shader = create_shader_sync("hiz_generate_shader", {
-        {"../assets/shaders/hiz_generate.glsl", GL_COMPUTE_SHADER}
-    });
-    
-    if (!ssao_compute_shader || !ssao_blur_shader || !ssao_apply_shader || !deferred_lighting_direct_shader || 
-        !ssgi_compute_shader || !ssgi_denoise_shader || !ssgi_composition_shader || !hiz_generate_shader) {
-        LOG_ERROR("Failed to create SSAO, SSGI or Hi-Z shaders!");
-    } else {
-        LOG_INFO("Successfully created all SSAO, SSGI and Hi-Z shaders");
-    }
-    
-    
-    // auto gbuffer_debug_shader = create_shader_sync("gbuffer_debug_shader", {
-    //     {"../assets/shaders/gbuffer_debug_vertex.glsl", GL_VERTEX_SHADER},
-    //     {"../assets/shaders/gbuffer_debug_fragment.glsl", GL_FRAGMENT_SHADER}
-    // });
-    
-    // Create skybox shader
-    auto skybox_shader = create_shader_sync("skybox_shader", {
-        {"../assets/shaders/skybox_vertex.glsl", GL_VERTEX_SHADER},
-        {"../assets/shaders/skybox_fragment.glsl", GL_FRAGMENT_SHADER}
-    });
-    
-    // Create plane reflection shader
-    auto plane_reflection_shader = create_shader_sync("plane_reflection_shader", {
-        {"../assets/shaders/vertex.glsl", GL_VERTEX_SHADER},
-        {"../assets/shaders/plane_reflection_fragment.glsl", GL_FRAGMENT_SHADER}
-    });
+    create_scene_shaders();
 
 
     // Create models by combining meshes and materials (observers only)
@@ -1148,6 +1643,7 @@ std::unique_ptr<Scene> CoroutineResourceManager::create_simple_scene() {
     if (skybox_texture) {
         std::unique_lock<std::shared_mutex> lock(cache_mutex_);
         texture_cache_["skybox_cubemap"] = skybox_texture;
+        ++texture_generation_;
         LOG_INFO("CoroutineResourceManager: HDR skybox loaded and cached successfully");
     } else {
         LOG_ERROR("CoroutineResourceManager: Failed to load HDR skybox, falling back to LDR skybox");
@@ -1166,6 +1662,7 @@ std::unique_ptr<Scene> CoroutineResourceManager::create_simple_scene() {
         
         std::unique_lock<std::shared_mutex> lock(cache_mutex_);
         texture_cache_["skybox_cubemap"] = fallback_skybox_texture;
+        ++texture_generation_;
         skybox_texture = fallback_skybox_texture;
     }
     
@@ -1264,14 +1761,14 @@ std::shared_ptr<Texture> CoroutineResourceManager::compute_irradiance_map(const
     glGenFramebuffers(1, &irradiance_fbo);
     glGenRenderbuffers(1, &irradiance_rbo);
     
-    glBindFramebuffer(GL_FRAMEBUFFER, irradiance_fbo);
+    GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, irradiance_fbo);
     glBindRenderbuffer(GL_RENDERBUFFER, irradiance_rbo);
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, irradiance_size, irradiance_size);
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, irradiance_rbo);
     
     // Use the texture ID from the Texture object (it's already generated in constructor)
     GLuint irradiance_texture_id = irradiance_map->get_id();
-    glBindTexture(GL_TEXTURE_CUBE_MAP, irradiance_texture_id);
+    GLStateCache::bind_texture(GL_TEXTURE_CUBE_MAP, irradiance_texture_id);
     for (unsigned int i = 0; i < 6; ++i) {
         glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, 
                      irradiance_size, irradiance_size, 0, GL_RGB, GL_FLOAT, nullptr);
@@ -1284,6 +1781,7 @@ std::shared_ptr<Texture> CoroutineResourceManager::compute_irradiance_map(const
     
     // Generate mipmaps for smooth filtering across distances
     glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+    irradiance_map->track_gpu_memory(GL_RGB16F, irradiance_size, irradiance_size, 6, Texture::get_mip_level_count(irradiance_size, irradiance_size));
     
     // Setup projection and view matrices for cubemap faces
     glm::mat4 captureProjection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 10.0f);
@@ -1344,12 +1842,12 @@ std::shared_ptr<Texture> CoroutineResourceManager::compute_irradiance_map(const
     GLuint cube_vao, cube_vbo;
     glGenVertexArrays(1, &cube_vao);
     glGenBuffers(1, &cube_vbo);
-    glBindVertexArray(cube_vao);
+    GLStateCache::bind_vertex_array(cube_vao);
     glBindBuffer(GL_ARRAY_BUFFER, cube_vbo);
     glBufferData(GL_ARRAY_BUFFER, sizeof(cube_vertices), cube_vertices, GL_STATIC_DRAW);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glBindVertexArray(0);
+    GLStateCache::bind_vertex_array(0);
     
     // Store current viewport
     GLint viewport[4];
@@ -1365,8 +1863,8 @@ std::shared_ptr<Texture> CoroutineResourceManager::compute_irradiance_map(const
         irradiance_shader->set_int("environmentMap", skybox_slot);
     }
     
-    glViewport(0, 0, irradiance_size, irradiance_size);
-    glBindFramebuffer(GL_FRAMEBUFFER, irradiance_fbo);
+    GLStateCache::viewport(0, 0, irradiance_size, irradiance_size);
+    GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, irradiance_fbo);
     
     // Render each face of the irradiance cubemap
     for (unsigned int i = 0; i < 6; ++i) {
@@ -1375,24 +1873,26 @@ std::shared_ptr<Texture> CoroutineResourceManager::compute_irradiance_map(const
                                GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, irradiance_texture_id, 0);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         
-        glBindVertexArray(cube_vao);
+        GLStateCache::bind_vertex_array(cube_vao);
         glDrawArrays(GL_TRIANGLES, 0, 36);
-        glBindVertexArray(0);
+        GLStateCache::bind_vertex_array(0);
     }
     
     // Generate mipmaps after rendering all faces
-    glBindTexture(GL_TEXTURE_CUBE_MAP, irradiance_texture_id);
+    GLStateCache::bind_texture(GL_TEXTURE_CUBE_MAP, irradiance_texture_id);
     glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
     
     // Cleanup
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, 0);
+    GLStateCache::forget_framebuffer(irradiance_fbo);
     glDeleteFramebuffers(1, &irradiance_fbo);
     glDeleteRenderbuffers(1, &irradiance_rbo);
+    GLStateCache::forget_vertex_array(cube_vao);
     glDeleteVertexArrays(1, &cube_vao);
     glDeleteBuffers(1, &cube_vbo);
     
     // Restore viewport
-    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    GLStateCache::viewport(viewport[0], viewport[1], viewport[2], viewport[3]);
     
     // Store in cache
     {
@@ -1470,14 +1970,14 @@ std::shared_ptr<Texture> CoroutineResourceManager::compute_prefiltered_map(const
     glGenFramebuffers(1, &prefilter_fbo);
     glGenRenderbuffers(1, &prefilter_rbo);
     
-    glBindFramebuffer(GL_FRAMEBUFFER, prefilter_fbo);
+    GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, prefilter_fbo);
     glBindRenderbuffer(GL_RENDERBUFFER, prefilter_rbo);
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, prefilter_size, prefilter_size);
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, prefilter_rbo);
     
     // Configure prefiltered cubemap texture
     GLuint prefilter_texture_id = prefiltered_map->get_id();
-    glBindTexture(GL_TEXTURE_CUBE_MAP, prefilter_texture_id);
+    GLStateCache::bind_texture(GL_TEXTURE_CUBE_MAP, prefilter_texture_id);
     for (unsigned int i = 0; i < 6; ++i) {
         glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, 
                      prefilter_size, prefilter_size, 0, GL_RGB, GL_FLOAT, nullptr);
@@ -1490,6 +1990,7 @@ std::shared_ptr<Texture> CoroutineResourceManager::compute_prefiltered_map(const
     
     // Generate mipmaps for different roughness levels
     glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+    prefiltered_map->track_gpu_memory(GL_RGB16F, prefilter_size, prefilter_size, 6, Texture::get_mip_level_count(prefilter_size, prefilter_size));
     
     // Setup projection and view matrices for cubemap faces
     glm::mat4 captureProjection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 10.0f);
@@ -1551,12 +2052,12 @@ std::shared_ptr<Texture> CoroutineResourceManager::compute_prefiltered_map(const
     GLuint cube_vao, cube_vbo;
     glGenVertexArrays(1, &cube_vao);
     glGenBuffers(1, &cube_vbo);
-    glBindVertexArray(cube_vao);
+    GLStateCache::bind_vertex_array(cube_vao);
     glBindBuffer(GL_ARRAY_BUFFER, cube_vbo);
     glBufferData(GL_ARRAY_BUFFER, sizeof(cube_vertices), cube_vertices, GL_STATIC_DRAW);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glBindVertexArray(0);
+    GLStateCache::bind_vertex_array(0);
     
     // Store current viewport
     GLint viewport[4];
@@ -1575,7 +2076,7 @@ std::shared_ptr<Texture> CoroutineResourceManager::compute_prefiltered_map(const
         return nullptr;
     }
     
-    glBindFramebuffer(GL_FRAMEBUFFER, prefilter_fbo);
+    GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, prefilter_fbo);
     
     // Render prefiltered map for different roughness levels (mip levels)
     unsigned int maxMipLevels = 5;
@@ -1585,7 +2086,7 @@ std::shared_ptr<Texture> CoroutineResourceManager::compute_prefiltered_map(const
         unsigned int mipHeight = static_cast<unsigned int>(prefilter_size * std::pow(0.5, mip));
         glBindRenderbuffer(GL_RENDERBUFFER, prefilter_rbo);
         glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, mipWidth, mipHeight);
-        glViewport(0, 0, mipWidth, mipHeight);
+        GLStateCache::viewport(0, 0, mipWidth, mipHeight);
 
         float roughness = (float)mip / (float)(maxMipLevels - 1);
         prefilter_shader->set_float("roughness", roughness);
@@ -1597,21 +2098,23 @@ std::shared_ptr<Texture> CoroutineResourceManager::compute_prefiltered_map(const
                                    GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, prefilter_texture_id, mip);
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
             
-            glBindVertexArray(cube_vao);
+            GLStateCache::bind_vertex_array(cube_vao);
             glDrawArrays(GL_TRIANGLES, 0, 36);
-            glBindVertexArray(0);
+            GLStateCache::bind_vertex_array(0);
         }
     }
     
     // Cleanup
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, 0);
+    GLStateCache::forget_framebuffer(prefilter_fbo);
     glDeleteFramebuffers(1, &prefilter_fbo);
     glDeleteRenderbuffers(1, &prefilter_rbo);
+    GLStateCache::forget_vertex_array(cube_vao);
     glDeleteVertexArrays(1, &cube_vao);
     glDeleteBuffers(1, &cube_vbo);
     
     // Restore viewport
-    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    GLStateCache::viewport(viewport[0], viewport[1], viewport[2], viewport[3]);
     
     // Set texture properties
     prefiltered_map->set_dimensions(prefilter_size, prefilter_size);
@@ -1692,7 +2195,7 @@ std::shared_ptr<Texture> CoroutineResourceManager::convert_equirectangular_to_cu
     // Create temporary texture for equirectangular map
     GLuint equirectTexture;
     glGenTextures(1, &equirectTexture);
-    glBindTexture(GL_TEXTURE_2D, equirectTexture);
+    GLStateCache::bind_texture(GL_TEXTURE_2D, equirectTexture);
     
     GLenum format = (imgChannels == 3) ? GL_RGB : GL_RGBA;
     GLenum internal_format = (imgChannels == 3) ? GL_RGB16F : GL_RGBA16F;
@@ -1713,14 +2216,14 @@ std::shared_ptr<Texture> CoroutineResourceManager::convert_equirectangular_to_cu
     glGenFramebuffers(1, &cubemap_fbo);
     glGenRenderbuffers(1, &cubemap_rbo);
     
-    glBindFramebuffer(GL_FRAMEBUFFER, cubemap_fbo);
+    GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, cubemap_fbo);
     glBindRenderbuffer(GL_RENDERBUFFER, cubemap_rbo);
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, cubemap_size, cubemap_size);
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, cubemap_rbo);
     
     // Configure cubemap texture
     GLuint cubemap_texture_id = cubemap_texture->get_id();
-    glBindTexture(GL_TEXTURE_CUBE_MAP, cubemap_texture_id);
+    GLStateCache::bind_texture(GL_TEXTURE_CUBE_MAP, cubemap_texture_id);
     for (unsigned int i = 0; i < 6; ++i) {
         glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, 
                      cubemap_size, cubemap_size, 0, GL_RGB, GL_FLOAT, nullptr);
@@ -1733,6 +2236,7 @@ std::shared_ptr<Texture> CoroutineResourceManager::convert_equirectangular_to_cu
     
     // Generate mipmaps for smooth filtering across distances
     glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+    cubemap_texture->track_gpu_memory(GL_RGB16F, cubemap_size, cubemap_size, 6, Texture::get_mip_level_count(cubemap_size, cubemap_size));
     
     // Set up projection matrix for cubemap faces
     glm::mat4 captureProjection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 10.0f);
@@ -1794,12 +2298,12 @@ std::shared_ptr<Texture> CoroutineResourceManager::convert_equirectangular_to_cu
     GLuint cube_vao, cube_vbo;
     glGenVertexArrays(1, &cube_vao);
     glGenBuffers(1, &cube_vbo);
-    glBindVertexArray(cube_vao);
+    GLStateCache::bind_vertex_array(cube_vao);
     glBindBuffer(GL_ARRAY_BUFFER, cube_vbo);
     glBufferData(GL_ARRAY_BUFFER, sizeof(cube_vertices), cube_vertices, GL_STATIC_DRAW);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glBindVertexArray(0);
+    GLStateCache::bind_vertex_array(0);
     
     // Store current viewport
     GLint viewport[4];
@@ -1811,11 +2315,11 @@ std::shared_ptr<Texture> CoroutineResourceManager::convert_equirectangular_to_cu
     equirect_shader->set_int("equirectangularMap", 0);
     
     // Bind equirectangular texture
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, equirectTexture);
+    GLStateCache::active_texture(0);
+    GLStateCache::bind_texture(GL_TEXTURE_2D, equirectTexture);
     
-    glViewport(0, 0, cubemap_size, cubemap_size);
-    glBindFramebuffer(GL_FRAMEBUFFER, cubemap_fbo);
+    GLStateCache::viewport(0, 0, cubemap_size, cubemap_size);
+    GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, cubemap_fbo);
     
     // Render each face of the cubemap
     for (unsigned int i = 0; i < 6; ++i) {
@@ -1824,21 +2328,24 @@ std::shared_ptr<Texture> CoroutineResourceManager::convert_equirectangular_to_cu
                                GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, cubemap_texture_id, 0);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         
-        glBindVertexArray(cube_vao);
+        GLStateCache::bind_vertex_array(cube_vao);
         glDrawArrays(GL_TRIANGLES, 0, 36);
-        glBindVertexArray(0);
+        GLStateCache::bind_vertex_array(0);
     }
     
     // Generate mipmaps after rendering all faces
-    glBindTexture(GL_TEXTURE_CUBE_MAP, cubemap_texture_id);
+    GLStateCache::bind_texture(GL_TEXTURE_CUBE_MAP, cubemap_texture_id);
     glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
     
     // Cleanup
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, 0);
+    GLStateCache::forget_framebuffer(cubemap_fbo);
     glDeleteFramebuffers(1, &cubemap_fbo);
     glDeleteRenderbuffers(1, &cubemap_rbo);
+    GLStateCache::forget_vertex_array(cube_vao);
     glDeleteVertexArrays(1, &cube_vao);
     glDeleteBuffers(1, &cube_vbo);
+    GLStateCache::forget_texture(equirectTexture);
     glDeleteTextures(1, &equirectTexture);
     
     // Free the loaded data
@@ -1849,7 +2356,7 @@ std::shared_ptr<Texture> CoroutineResourceManager::convert_equirectangular_to_cu
     }
     
     // Restore viewport
-    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    GLStateCache::viewport(viewport[0], viewport[1], viewport[2], viewport[3]);
     
     // Set texture properties
     cubemap_texture->set_dimensions(cubemap_size, cubemap_size);
@@ -1885,6 +2392,7 @@ std::shared_ptr<Texture> CoroutineResourceManager::load_hdr_skybox_cubemap(const
     {
         std::unique_lock<std::shared_mutex> lock(cache_mutex_);
         texture_cache_[cubemap_key] = cubemap_texture;
+        ++texture_generation_;
         LOG_DEBUG("CoroutineResourceManager: Cached HDR cubemap: {}", cubemap_key);
     }
     
@@ -1929,6 +2437,7 @@ Async::Task<std::shared_ptr<Texture>> CoroutineResourceManager::load_hdr_skybox_
             {
                 std::unique_lock<std::shared_mutex> cache_lock(cache_mutex_);
                 texture_cache_[cubemap_key] = cubemap_texture;
+                ++texture_generation_;
                 LOG_DEBUG("CoroutineResourceManager: Cached HDR cubemap: {}", cubemap_key);
             }
         }
@@ -1,5 +1,6 @@
 #include "CoroutineThreadPoolScheduler.h"
 #include "EnhancedThreadPool.h"
+#include "Profiler.h"
 #include <fstream>
 #include <random>
 #include <mutex>
@@ -12,28 +13,28 @@ thread_local size_t CoroutineThreadPoolScheduler::current_worker_index_ = 0;
 CoroutineThreadPoolScheduler::CoroutineThreadPoolScheduler(size_t thread_count)
     : main_thread_id_(std::this_thread::get_id()) {
     
-    Logger::get_instance().info("Creating CoroutineThreadPoolScheduler with {} threads", thread_count);
+    LOG_INFO("Creating CoroutineThreadPoolScheduler with {} threads", thread_count);
     
     try {
-        Logger::get_instance().debug("About to create EnhancedThreadPool...");
+        LOG_DEBUG("About to create EnhancedThreadPool...");
         thread_pool_ = std::make_unique<EnhancedThreadPool>(thread_count);
-        Logger::get_instance().debug("EnhancedThreadPool created successfully");
+        LOG_DEBUG("EnhancedThreadPool created successfully");
         
         if (!thread_pool_) {
             throw std::runtime_error("EnhancedThreadPool creation returned null");
         }
         
         // Initialize work stealing queues - one queue per thread
-        Logger::get_instance().debug("Initializing work stealing queues...");
+        LOG_DEBUG("Initializing work stealing queues...");
         worker_queues_.reserve(thread_count);
         for (size_t i = 0; i < thread_count; ++i) {
             worker_queues_.emplace_back(std::make_unique<WorkStealingQueue>());
         }
-        Logger::get_instance().debug("Work stealing queues initialized");
+        LOG_DEBUG("Work stealing queues initialized");
         
-        Logger::get_instance().info("CoroutineThreadPoolScheduler created successfully");
+        LOG_INFO("CoroutineThreadPoolScheduler created successfully");
     } catch (const std::exception& e) {
-        Logger::get_instance().error("Failed to create CoroutineThreadPoolScheduler: {}", e.what());
+        LOG_ERROR("Failed to create CoroutineThreadPoolScheduler: {}", e.what());
         // Ensure thread_pool_ is null on failure
         thread_pool_.reset();
         throw;
@@ -44,9 +45,9 @@ void CoroutineThreadPoolScheduler::initialize() {
     try {
         // Skip worker hook registration for now to avoid shared_from_this issues
         // The hook will be registered when needed
-        Logger::get_instance().info("CoroutineThreadPoolScheduler initialized (hook registration deferred)");
+        LOG_INFO("CoroutineThreadPoolScheduler initialized (hook registration deferred)");
     } catch (const std::exception& e) {
-        Logger::get_instance().error("Failed to initialize CoroutineThreadPoolScheduler: {}", e.what());
+        LOG_ERROR("Failed to initialize CoroutineThreadPoolScheduler: {}", e.what());
         throw;
     }
 }
@@ -150,7 +151,10 @@ bool CoroutineThreadPoolScheduler::try_process_coroutine_in_threadpool(size_t wo
     if (task_opt.has_value() && task_opt->handle) {
         try {
             LOG_DEBUG("ThreadPool worker {} executing coroutine task {}", worker_index, task_opt->task_id);
-            task_opt->handle.resume();
+            {
+                PROFILE_SCOPE("Resume coroutine");
+                task_opt->handle.resume();
+            }
             
             std::lock_guard<std::mutex> lock(stats_mutex_);
             stats_.coroutines_completed++;
@@ -188,7 +192,7 @@ std::optional<PriorityCoroutine> CoroutineThreadPoolScheduler::try_steal_corouti
         
         auto stolen_task = worker_queues_[target_worker]->steal();
         if (stolen_task.has_value()) {
-            Logger::get_instance().debug("Worker {} stole task from worker {}", current_worker, target_worker);
+            LOG_DEBUG("Worker {} stole task from worker {}", current_worker, target_worker);
             return stolen_task;
         }
     }
@@ -199,7 +203,7 @@ std::optional<PriorityCoroutine> CoroutineThreadPoolScheduler::try_steal_corouti
 void CoroutineThreadPoolScheduler::distribute_coroutine_to_worker(PriorityCoroutine task) {
     size_t target_worker = get_least_loaded_coroutine_worker();
     worker_queues_[target_worker]->push(std::move(task));
-    Logger::get_instance().debug("Distributed coroutine task to worker {}", target_worker);
+    LOG_DEBUG("Distributed coroutine task to worker {}", target_worker);
 }
 
 size_t CoroutineThreadPoolScheduler::get_least_loaded_coroutine_worker() const noexcept {
@@ -228,6 +232,19 @@ CoroutineThreadPoolScheduler::Stats CoroutineThreadPoolScheduler::get_stats() co
     result.priority_stats.normal_tasks = stats_.priority_stats.normal_tasks.load();
     result.priority_stats.high_tasks = stats_.priority_stats.high_tasks.load();
     result.priority_stats.critical_tasks = stats_.priority_stats.critical_tasks.load();
+
+    result.main_thread_resumes = stats_.main_thread_resumes.load();
+    result.main_thread_delay_total_ms = stats_.main_thread_delay_total_ns.load() * 1e-6;
+    result.main_thread_delay_max_ms = stats_.main_thread_delay_max_ns.load() * 1e-6;
+
+    if (thread_pool_) {
+        ThreadPool::WorkerTimings timings = thread_pool_->get_worker_timings();
+        result.queue_wait = timings.queue_wait;
+        result.worker_utilization.reserve(timings.busy_ms.size());
+        for (double busy_ms : timings.busy_ms) {
+            result.worker_utilization.push_back(timings.elapsed_ms > 0.0 ? busy_ms / timings.elapsed_ms : 0.0);
+        }
+    }
     return result;
 }
 
@@ -241,26 +258,33 @@ void CoroutineThreadPoolScheduler::reset_stats() noexcept {
     stats_.priority_stats.normal_tasks = 0;
     stats_.priority_stats.high_tasks = 0;
     stats_.priority_stats.critical_tasks = 0;
+    stats_.main_thread_resumes = 0;
+    stats_.main_thread_delay_total_ns = 0;
+    stats_.main_thread_delay_max_ns = 0;
+
+    if (thread_pool_) {
+        thread_pool_->reset_worker_timings();
+    }
 }
 
 // Context switching implementation
 Task<void> CoroutineThreadPoolScheduler::SwitchToMain() {
-    Logger::get_instance().debug("SwitchToMain requested");
+    LOG_DEBUG("SwitchToMain requested");
     
     ContextSwitchAwaiter awaiter(this, true);
     co_await awaiter;
     
-    Logger::get_instance().debug("SwitchToMain completed");
+    LOG_DEBUG("SwitchToMain completed");
     co_return;
 }
 
 Task<void> CoroutineThreadPoolScheduler::SwitchToThreadPool() {
-    Logger::get_instance().debug("SwitchToThreadPool requested");
+    LOG_DEBUG("SwitchToThreadPool requested");
     
     ContextSwitchAwaiter awaiter(this, false);
     co_await awaiter;
     
-    Logger::get_instance().debug("SwitchToThreadPool completed");
+    LOG_DEBUG("SwitchToThreadPool completed");
     co_return;
 }
 
@@ -269,9 +293,10 @@ size_t CoroutineThreadPoolScheduler::process_main_thread_coroutines() {
         LOG_WARN("process_main_thread_coroutines called from non-main thread");
         return 0;
     }
+    PROFILE_SCOPE("Main thread coroutines");
 
     size_t processed_count = 0;
-    std::queue<std::coroutine_handle<>> handles_to_process;
+    std::queue<MainThreadContinuation> handles_to_process;
     
     // Gather all pending handles
     {
@@ -281,10 +306,11 @@ size_t CoroutineThreadPoolScheduler::process_main_thread_coroutines() {
     
     // Process all handles
     while (!handles_to_process.empty()) {
-        auto handle = handles_to_process.front();
+        auto [handle, queued_time] = handles_to_process.front();
         handles_to_process.pop();
         
         if (handle) {
+            record_main_thread_delay(queued_time);
             processed_count++;
             try {
                 if (!handle) {
@@ -328,9 +354,9 @@ CoroutineThreadPoolScheduler& CoroutineThreadPoolScheduler::get_instance() {
     
     if (!instance) {
         try {
-            Logger::get_instance().debug("Creating CoroutineThreadPoolScheduler singleton instance...");
+            LOG_DEBUG("Creating CoroutineThreadPoolScheduler singleton instance...");
             instance = std::shared_ptr<CoroutineThreadPoolScheduler>(new CoroutineThreadPoolScheduler());
-            Logger::get_instance().debug("CoroutineThreadPoolScheduler instance created, initializing...");
+            LOG_DEBUG("CoroutineThreadPoolScheduler instance created, initializing...");
             
             // Verify the instance was created properly
             if (!instance->thread_pool_) {
@@ -339,9 +365,9 @@ CoroutineThreadPoolScheduler& CoroutineThreadPoolScheduler::get_instance() {
             
             // Delay initialization until after shared_ptr is fully constructed
             instance->initialize();
-            Logger::get_instance().info("CoroutineThreadPoolScheduler singleton initialized successfully");
+            LOG_INFO("CoroutineThreadPoolScheduler singleton initialized successfully");
         } catch (const std::exception& e) {
-            Logger::get_instance().error("Failed to create/initialize CoroutineThreadPoolScheduler in get_instance: {}", e.what());
+            LOG_ERROR("Failed to create/initialize CoroutineThreadPoolScheduler in get_instance: {}", e.what());
             instance.reset(); // Clear the instance on failure
             initialization_failed = true;
             throw;
@@ -357,7 +383,19 @@ CoroutineThreadPoolScheduler& CoroutineThreadPoolScheduler::get_instance() {
 
 void CoroutineThreadPoolScheduler::schedule_to_main_thread(std::coroutine_handle<> handle) {
     std::lock_guard<std::mutex> lock(main_thread_mutex_);
-    main_thread_queue_.push(handle);
+    main_thread_queue_.push({ handle, std::chrono::steady_clock::now() });
+}
+
+void CoroutineThreadPoolScheduler::record_main_thread_delay(std::chrono::steady_clock::time_point queued_time) {
+    int64_t delay_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - queued_time).count();
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.main_thread_resumes++;
+    stats_.main_thread_delay_total_ns += delay_ns;
+    if (delay_ns > stats_.main_thread_delay_max_ns) {
+        stats_.main_thread_delay_max_ns = delay_ns;
+    }
 }
 
 void CoroutineThreadPoolScheduler::schedule_to_thread_pool(std::coroutine_handle<> handle) {
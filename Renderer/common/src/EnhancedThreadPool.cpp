@@ -1,4 +1,5 @@
 #include "EnhancedThreadPool.h"
+#include "Profiler.h"
 
 namespace Async {
 
@@ -25,9 +26,9 @@ namespace Async {
 
     void EnhancedThreadPool::workerThread() {
         
-        static std::atomic<size_t> next_worker_index{0};
-        size_t worker_index = next_worker_index.fetch_add(1, std::memory_order_relaxed);
+        size_t worker_index = acquire_worker_index();
         setup_worker_thread(worker_index);
+        PROFILE_THREAD_NAME("Worker " + std::to_string(worker_index));
         
         LOG_DEBUG("EnhancedThreadPool: Worker thread {} started", worker_index);
         
@@ -39,7 +40,11 @@ namespace Async {
             bool processed_external = false;
             if (worker_hook_) {
                 try {
+                    auto hook_start = std::chrono::steady_clock::now();
                     processed_external = worker_hook_->execute_hook(worker_index);
+                    if (processed_external) {
+                        record_busy_time(worker_index, std::chrono::steady_clock::now() - hook_start);
+                    }
                         } catch (const std::exception& e) {
             LOG_ERROR("EnhancedThreadPool: Exception in worker hook for thread {}: {}",
                                       worker_index, e.what());
@@ -83,8 +88,13 @@ namespace Async {
                              worker_index, priority_task.task_id, static_cast<int>(priority_task.priority), activeThreads_.load());
                     
                     auto start_time = std::chrono::steady_clock::now();
-                    priority_task.task();
+                    record_queue_wait(priority_task, start_time);
+                    {
+                        PROFILE_SCOPE("ThreadPool task");
+                        priority_task.task();
+                    }
                     auto end_time = std::chrono::steady_clock::now();
+                    record_busy_time(worker_index, end_time - start_time);
                     
                     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
                     completedTasks_.fetch_add(1, std::memory_order_relaxed);
@@ -0,0 +1,159 @@
+#include "HeadlessContext.h"
+#include "Logger.h"
+
+#if RENDERER_HEADLESS_ENABLED
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <cstring>
+#endif
+
+HeadlessContext::HeadlessContext()
+    : display_(nullptr), context_(nullptr), major_version_(0), minor_version_(0)
+{
+}
+
+HeadlessContext::~HeadlessContext() {
+    destroy();
+}
+
+#if RENDERER_HEADLESS_ENABLED
+
+namespace {
+
+bool has_extension(const char* extensions, const char* name) {
+    if (!extensions) {
+        return false;
+    }
+    size_t length = std::strlen(name);
+    for (const char* found = std::strstr(extensions, name); found; found = std::strstr(found + length, name)) {
+        bool starts = found == extensions || found[-1] == ' ';
+        bool ends = found[length] == ' ' || found[length] == '\0';
+        if (starts && ends) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+bool HeadlessContext::initialize() {
+    EGLDisplay display = EGL_NO_DISPLAY;
+
+    // Mesa's surfaceless platform needs neither X11/Wayland nor a DRM device
+    const char* client_extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    auto get_platform_display = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (get_platform_display && has_extension(client_extensions, "EGL_MESA_platform_surfaceless")) {
+        display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    if (display == EGL_NO_DISPLAY) {
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+
+    EGLint egl_major = 0;
+    EGLint egl_minor = 0;
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, &egl_major, &egl_minor)) {
+        LOG_ERROR("HeadlessContext: Failed to initialize an EGL display (0x{:X})", eglGetError());
+        return false;
+    }
+    display_ = display;
+
+    const char* display_extensions = eglQueryString(display, EGL_EXTENSIONS);
+    if (!has_extension(display_extensions, "EGL_KHR_surfaceless_context")) {
+        LOG_ERROR("HeadlessContext: EGL display lacks EGL_KHR_surfaceless_context");
+        destroy();
+        return false;
+    }
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        LOG_ERROR("HeadlessContext: Desktop OpenGL is not available through EGL");
+        destroy();
+        return false;
+    }
+
+    // Nothing is drawn to an EGL surface, so any GL-capable config will do
+    const EGLint config_attributes[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+    EGLConfig config = nullptr;
+    EGLint config_count = 0;
+    if (!eglChooseConfig(display, config_attributes, &config, 1, &config_count) || config_count == 0) {
+        if (!has_extension(display_extensions, "EGL_KHR_no_config_context")) {
+            LOG_ERROR("HeadlessContext: No EGL config supports OpenGL");
+            destroy();
+            return false;
+        }
+        config = EGL_NO_CONFIG_KHR;
+    }
+
+    // Every shader is #version 460 core, so an older context could not build any of them
+    const EGLint context_attributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, REQUIRED_MAJOR_VERSION,
+        EGL_CONTEXT_MINOR_VERSION, REQUIRED_MINOR_VERSION,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, context_attributes);
+    if (context == EGL_NO_CONTEXT) {
+        LOG_ERROR("HeadlessContext: Failed to create an OpenGL {}.{} core context (0x{:X}). Mesa drivers that stop at 4.5, "
+                  "such as llvmpipe, need MESA_GL_VERSION_OVERRIDE=4.6 MESA_GLSL_VERSION_OVERRIDE=460",
+                  REQUIRED_MAJOR_VERSION, REQUIRED_MINOR_VERSION, eglGetError());
+        destroy();
+        return false;
+    }
+    context_ = context;
+    major_version_ = REQUIRED_MAJOR_VERSION;
+    minor_version_ = REQUIRED_MINOR_VERSION;
+
+    if (!make_current()) {
+        destroy();
+        return false;
+    }
+
+    LOG_INFO("HeadlessContext: OpenGL {}.{} core context on EGL {}.{} ({})", major_version_, minor_version_,
+        egl_major, egl_minor, eglQueryString(display, EGL_VENDOR));
+    return true;
+}
+
+bool HeadlessContext::make_current() {
+    if (!eglMakeCurrent(static_cast<EGLDisplay>(display_), EGL_NO_SURFACE, EGL_NO_SURFACE, static_cast<EGLContext>(context_))) {
+        LOG_ERROR("HeadlessContext: eglMakeCurrent failed (0x{:X})", eglGetError());
+        return false;
+    }
+    return true;
+}
+
+void HeadlessContext::destroy() {
+    if (!display_) {
+        return;
+    }
+    EGLDisplay display = static_cast<EGLDisplay>(display_);
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (context_) {
+        eglDestroyContext(display, static_cast<EGLContext>(context_));
+        context_ = nullptr;
+    }
+    eglTerminate(display);
+    display_ = nullptr;
+}
+
+void* HeadlessContext::get_proc_address(const char* name) {
+    return reinterpret_cast<void*>(eglGetProcAddress(name));
+}
+
+#else
+
+bool HeadlessContext::initialize() {
+    LOG_ERROR("HeadlessContext: Built without headless support, reconfigure with -DRENDERER_ENABLE_HEADLESS=ON");
+    return false;
+}
+
+bool HeadlessContext::make_current() {
+    return false;
+}
+
+void HeadlessContext::destroy() {
+}
+
+void* HeadlessContext::get_proc_address(const char*) {
+    return nullptr;
+}
+
+#endif
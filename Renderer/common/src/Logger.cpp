@@ -2,19 +2,27 @@
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <iostream>
-#include <iomanip>
-#include <sstream>
 
 std::unique_ptr<Logger> Logger::instance_ = nullptr;
 
 Logger& Logger::get_instance() {
-    if (!instance_) {
+    // Worker threads may log first; only one of them may construct the logger and its writer thread
+    static std::once_flag created;
+    std::call_once(created, [] {
         instance_ = std::make_unique<Logger>();
-    }
+    });
     return *instance_;
 }
 
-Logger::Logger() : debug_enabled_(false) {  // Debug disabled by default
+Logger::Logger()
+    : debug_enabled_(false)  // Debug disabled by default
+    , queue_(QUEUE_CAPACITY)
+    , published_(0)
+    , writer_waiting_(false)
+    , written_(0)
+    , running_(true)
+    , dropped_(0)
+{
     try {
 
         imgui_sink_ = std::make_shared<ImGuiSink_mt>(1000);
@@ -41,4 +49,65 @@ Logger::Logger() : debug_enabled_(false) {  // Debug disabled by default
     } catch (const spdlog::spdlog_ex& ex) {
         std::cerr << "Log initialization failed: " << ex.what() << std::endl;
     }
-}
\ No newline at end of file
+
+    writer_thread_ = std::thread(&Logger::writer_loop, this);
+}
+
+Logger::~Logger() {
+    running_.store(false, std::memory_order_seq_cst);
+    published_.fetch_add(1, std::memory_order_seq_cst);
+    published_.notify_one();
+    if (writer_thread_.joinable()) {
+        writer_thread_.join();
+    }
+    if (logger_) {
+        logger_->flush();
+    }
+}
+
+void Logger::writer_loop() {
+    for (;;) {
+        uint32_t seen = published_.load(std::memory_order_seq_cst);
+        if (drain() > 0) {
+            continue;
+        }
+        if (!running_.load(std::memory_order_seq_cst)) {
+            break;
+        }
+
+        // Returns at once if anything was pushed since `seen` was read
+        writer_waiting_.store(true, std::memory_order_seq_cst);
+        published_.wait(seen, std::memory_order_seq_cst);
+        writer_waiting_.store(false, std::memory_order_seq_cst);
+    }
+
+    // Producers racing the shutdown
+    drain();
+}
+
+size_t Logger::drain() {
+    size_t count = queue_.consume_all([this](LogRecord& record) {
+        if (logger_) {
+            logger_->log(record.time, spdlog::source_loc{}, record.level, std::string_view(record.text, record.length));
+        }
+    });
+    written_.fetch_add(static_cast<uint32_t>(count), std::memory_order_release);
+
+    uint64_t dropped = dropped_.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0 && logger_) {
+        logger_->warn("Log queue full, dropped {} messages", dropped);
+    }
+    return count;
+}
+
+void Logger::flush() {
+    // Every push bumps published_ once; wait for the writer to account for all of them
+    uint32_t target = published_.load(std::memory_order_seq_cst);
+    while (running_.load(std::memory_order_relaxed) &&
+           static_cast<int32_t>(written_.load(std::memory_order_acquire) - target) < 0) {
+        std::this_thread::yield();
+    }
+    if (logger_) {
+        logger_->flush();
+    }
+}
@@ -0,0 +1,124 @@
+#include "MemoryTracker.h"
+#include "Logger.h"
+
+MemoryTracker& MemoryTracker::get_instance() {
+    static MemoryTracker instance;
+    return instance;
+}
+
+void MemoryTracker::allocate(MemoryCategory category, size_t bytes) {
+    if (bytes == 0) {
+        return;
+    }
+    Counter& counter = counters_[static_cast<size_t>(category)];
+    counter.live.fetch_add(1, std::memory_order_relaxed);
+    raise_peak(counter, counter.current.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+
+    total_.live.fetch_add(1, std::memory_order_relaxed);
+    raise_peak(total_, total_.current.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+}
+
+void MemoryTracker::release(MemoryCategory category, size_t bytes) {
+    if (bytes == 0) {
+        return;
+    }
+    Counter& counter = counters_[static_cast<size_t>(category)];
+    counter.live.fetch_sub(1, std::memory_order_relaxed);
+    counter.current.fetch_sub(bytes, std::memory_order_relaxed);
+
+    total_.live.fetch_sub(1, std::memory_order_relaxed);
+    total_.current.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+void MemoryTracker::resize(MemoryCategory category, size_t old_bytes, size_t new_bytes) {
+    if (old_bytes == 0 || new_bytes == 0) {
+        release(category, old_bytes);
+        allocate(category, new_bytes);
+        return;
+    }
+    Counter& counter = counters_[static_cast<size_t>(category)];
+    if (new_bytes >= old_bytes) {
+        size_t grown = new_bytes - old_bytes;
+        raise_peak(counter, counter.current.fetch_add(grown, std::memory_order_relaxed) + grown);
+        raise_peak(total_, total_.current.fetch_add(grown, std::memory_order_relaxed) + grown);
+    } else {
+        size_t shrunk = old_bytes - new_bytes;
+        counter.current.fetch_sub(shrunk, std::memory_order_relaxed);
+        total_.current.fetch_sub(shrunk, std::memory_order_relaxed);
+    }
+}
+
+MemoryTracker::Snapshot MemoryTracker::get_snapshot() const {
+    Snapshot snapshot;
+    for (size_t i = 0; i < CATEGORY_COUNT; ++i) {
+        snapshot.categories[i] = read(counters_[i]);
+    }
+    snapshot.total = read(total_);
+    return snapshot;
+}
+
+size_t MemoryTracker::get_current_bytes(MemoryCategory category) const {
+    return counters_[static_cast<size_t>(category)].current.load(std::memory_order_relaxed);
+}
+
+void MemoryTracker::set_budget(MemoryCategory category, size_t bytes) {
+    counters_[static_cast<size_t>(category)].budget.store(bytes, std::memory_order_relaxed);
+}
+
+void MemoryTracker::set_total_budget(size_t bytes) {
+    total_.budget.store(bytes, std::memory_order_relaxed);
+}
+
+void MemoryTracker::reset_peaks() {
+    for (Counter& counter : counters_) {
+        counter.peak.store(counter.current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    total_.peak.store(total_.current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void MemoryTracker::check_budgets() {
+    for (size_t i = 0; i < CATEGORY_COUNT; ++i) {
+        check_budget(counters_[i], get_category_name(static_cast<MemoryCategory>(i)));
+    }
+    check_budget(total_, "Total");
+}
+
+const char* MemoryTracker::get_category_name(MemoryCategory category) {
+    switch (category) {
+        case MemoryCategory::k_mesh_cpu: return "Mesh CPU";
+        case MemoryCategory::k_mesh_gpu: return "Mesh GPU";
+        case MemoryCategory::k_texture_gpu: return "Texture GPU";
+        case MemoryCategory::k_render_targets: return "Render targets";
+        case MemoryCategory::k_gpu_buffers: return "GPU buffers";
+        case MemoryCategory::k_staging: return "Staging";
+        case MemoryCategory::k_coroutine_frames: return "Coroutine frames";
+        case MemoryCategory::k_log_buffers: return "Log buffers";
+        default: return "Unknown";
+    }
+}
+
+void MemoryTracker::raise_peak(Counter& counter, size_t value) {
+    size_t peak = counter.peak.load(std::memory_order_relaxed);
+    while (value > peak && !counter.peak.compare_exchange_weak(peak, value, std::memory_order_relaxed)) {
+    }
+}
+
+MemoryTracker::CategoryStats MemoryTracker::read(const Counter& counter) {
+    CategoryStats stats;
+    stats.current_bytes = counter.current.load(std::memory_order_relaxed);
+    stats.peak_bytes = counter.peak.load(std::memory_order_relaxed);
+    stats.live_allocations = counter.live.load(std::memory_order_relaxed);
+    stats.budget_bytes = counter.budget.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void MemoryTracker::check_budget(Counter& counter, const char* name) {
+    size_t budget = counter.budget.load(std::memory_order_relaxed);
+    size_t current = counter.current.load(std::memory_order_relaxed);
+    bool over = budget > 0 && current > budget;
+    if (over && !counter.over_budget) {
+        LOG_WARN("MemoryTracker: {} uses {:.1f} MB, over its {:.1f} MB budget",
+                 name, current / (1024.0 * 1024.0), budget / (1024.0 * 1024.0));
+    }
+    counter.over_budget = over;
+}
@@ -0,0 +1,187 @@
+#include "Profiler.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+Profiler& Profiler::get_instance() {
+    // Never destroyed: pool threads may still close zones while statics are torn down
+    static Profiler* instance = new Profiler();
+    return *instance;
+}
+
+Profiler::Profiler()
+    : frame_start_ns_(now_ns())
+    , calibration_ticks_(now_ticks())
+    , calibration_ns_(now_ns())
+    , ns_per_tick_(1.0)
+    , paused_(false)
+    , overwritten_zones_(0)
+{
+}
+
+void Profiler::update_tick_calibration() {
+#if PROFILER_HAS_TSC
+    int64_t elapsed_ticks = now_ticks() - calibration_ticks_;
+    int64_t elapsed_ns = now_ns() - calibration_ns_;
+    // Too short an interval gives a noisy rate; keep the previous one until a millisecond has passed
+    if (elapsed_ticks > 0 && elapsed_ns > 1000000) {
+        ns_per_tick_ = static_cast<double>(elapsed_ns) / static_cast<double>(elapsed_ticks);
+    }
+#endif
+}
+
+int64_t Profiler::ticks_to_ns(int64_t ticks) const {
+    return calibration_ns_ + static_cast<int64_t>(static_cast<double>(ticks - calibration_ticks_) * ns_per_tick_);
+}
+
+Profiler::ThreadBuffer* Profiler::get_thread_buffer() {
+    thread_local ThreadBuffer* buffer = get_instance().register_thread();
+    return buffer;
+}
+
+Profiler::ThreadBuffer* Profiler::register_thread() {
+    std::lock_guard<std::mutex> lock(threads_mutex_);
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->thread_index = static_cast<uint32_t>(threads_.size());
+    threads_.push_back(std::move(buffer));
+    thread_names_.push_back("Thread " + std::to_string(threads_.size() - 1));
+    return threads_.back().get();
+}
+
+const char* Profiler::intern(std::string_view name) {
+    std::lock_guard<std::mutex> lock(names_mutex_);
+    return interned_names_.emplace(name).first->c_str();
+}
+
+void Profiler::set_thread_name(const std::string& name) {
+    ThreadBuffer* buffer = get_thread_buffer();
+    std::lock_guard<std::mutex> lock(threads_mutex_);
+    thread_names_[buffer->thread_index] = name;
+}
+
+std::vector<std::string> Profiler::get_thread_names() const {
+    std::lock_guard<std::mutex> lock(threads_mutex_);
+    return thread_names_;
+}
+
+void Profiler::end_frame() {
+    FrameRecord frame;
+    frame.start_ns = frame_start_ns_;
+    frame.end_ns = now_ns();
+    frame_start_ns_ = frame.end_ns;
+    update_tick_calibration();
+
+    {
+        std::lock_guard<std::mutex> lock(threads_mutex_);
+        for (auto& thread : threads_) {
+            uint64_t write_count = thread->write_count.load(std::memory_order_acquire);
+            uint64_t first = std::max(thread->read_count, write_count > ZONES_PER_THREAD ? write_count - ZONES_PER_THREAD : 0);
+            overwritten_zones_ += first - thread->read_count;
+
+            size_t copied_from = frame.zones.size();
+            for (uint64_t index = first; index < write_count; ++index) {
+                const Zone& zone = thread->zones[index & (ZONES_PER_THREAD - 1)];
+                frame.zones.push_back({
+                    zone.name.load(std::memory_order_relaxed),
+                    ticks_to_ns(zone.start_ticks.load(std::memory_order_relaxed)),
+                    ticks_to_ns(zone.end_ticks.load(std::memory_order_relaxed)),
+                    zone.depth.load(std::memory_order_relaxed),
+                    thread->thread_index });
+            }
+
+            // The thread kept writing while we copied; drop slots it may have reused meanwhile,
+            // including the one it may be writing right now
+            uint64_t written_since = thread->write_count.load(std::memory_order_acquire);
+            if (written_since + 1 > first + ZONES_PER_THREAD) {
+                uint64_t reused = std::min(written_since + 1 - ZONES_PER_THREAD - first, write_count - first);
+                frame.zones.erase(frame.zones.begin() + copied_from, frame.zones.begin() + copied_from + reused);
+                overwritten_zones_ += reused;
+            }
+            thread->read_count = write_count;
+        }
+    }
+
+    if (paused_) {
+        return;
+    }
+    frames_.push_back(std::move(frame));
+    while (frames_.size() > MAX_FRAMES) {
+        frames_.pop_front();
+    }
+}
+
+namespace {
+
+void write_json_string(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        switch (*c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+                    out << escaped;
+                } else {
+                    out << *c;
+                }
+                break;
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
+bool Profiler::export_chrome_trace(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        LOG_ERROR("Profiler: Cannot open '{}' for writing", path);
+        return false;
+    }
+
+    const int64_t origin_ns = frames_.empty() ? 0 : frames_.front().start_ns;
+    auto to_us = [](int64_t ns) { return static_cast<double>(ns) / 1000.0; };
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first_event = true;
+    auto begin_event = [&]() {
+        if (!first_event) {
+            out << ",\n";
+        }
+        first_event = false;
+    };
+
+    std::vector<std::string> names = get_thread_names();
+    for (size_t thread = 0; thread < names.size(); ++thread) {
+        begin_event();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread << ",\"args\":{\"name\":";
+        write_json_string(out, names[thread].c_str());
+        out << "}}";
+    }
+
+    char number[64];
+    for (const auto& frame : frames_) {
+        for (const auto& zone : frame.zones) {
+            begin_event();
+            out << "{\"name\":";
+            write_json_string(out, zone.name);
+            std::snprintf(number, sizeof(number), "%.3f", to_us(zone.start_ns - origin_ns));
+            out << ",\"cat\":\"cpu\",\"ph\":\"X\",\"ts\":" << number;
+            std::snprintf(number, sizeof(number), "%.3f", to_us(zone.end_ns - zone.start_ns));
+            out << ",\"dur\":" << number << ",\"pid\":1,\"tid\":" << zone.thread_index << "}";
+        }
+    }
+    out << "\n]}\n";
+
+    if (!out) {
+        LOG_ERROR("Profiler: Failed writing trace to '{}'", path);
+        return false;
+    }
+    LOG_INFO("Profiler: Wrote {} frames to '{}'", frames_.size(), path);
+    return true;
+}
@@ -133,10 +133,11 @@ bool RaycastUtils::ray_mesh_intersect(const Ray& ray,
                                      const glm::mat4& model_matrix,
                                      const std::string& model_id,
                                      RaycastHit& hit) {
-    const auto& vertices = mesh.get_vertices();
+    // Meshes that released their CPU data cannot be picked
     const auto& indices = mesh.get_indices();
+    const size_t position_count = mesh.get_position_count();
     
-    if (indices.size() < 3 || indices.size() % 3 != 0) {
+    if (indices.size() < 3 || indices.size() % 3 != 0 || !mesh.has_positions()) {
         return false;
     }
 
@@ -157,13 +158,13 @@ bool RaycastUtils::ray_mesh_intersect(const Ray& ray,
         size_t idx1 = indices[i * 3 + 1];
         size_t idx2 = indices[i * 3 + 2];
         
-        if (idx0 >= vertices.size() || idx1 >= vertices.size() || idx2 >= vertices.size()) {
+        if (idx0 >= position_count || idx1 >= position_count || idx2 >= position_count) {
             continue;
         }
         
-        glm::vec3 v0 = vertices[idx0].position;
-        glm::vec3 v1 = vertices[idx1].position;
-        glm::vec3 v2 = vertices[idx2].position;
+        const glm::vec3& v0 = mesh.get_position(idx0);
+        const glm::vec3& v1 = mesh.get_position(idx1);
+        const glm::vec3& v2 = mesh.get_position(idx2);
         
         RaycastHit triangle_hit;
         if (ray_triangle_intersect(local_ray, v0, v1, v2, triangle_hit)) {
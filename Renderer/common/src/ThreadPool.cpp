@@ -6,12 +6,16 @@ namespace Async {
         : stop_(false)
         , activeThreads_(0)
         , completedTasks_(0)
-        , numThreads_(numThreads) {
+        , numThreads_(numThreads)
+        , nextWorkerIndex_(0)
+        , workerBusyNs_(std::make_unique<std::atomic<uint64_t>[]>(numThreads)) {
         
         if (numThreads == 0) {
             throw std::invalid_argument("ThreadPool: Number of threads must be greater than 0");
         }
 
+        reset_worker_timings();
+
         LOG_INFO("ThreadPool: Initializing thread pool with {} threads", numThreads);
 
         try {
@@ -46,6 +50,7 @@ namespace Async {
     }
 
     void ThreadPool::workerThread() {
+        size_t worker_index = acquire_worker_index();
         LOG_DEBUG("ThreadPool: Worker thread started");
         
         while (true) {
@@ -83,8 +88,10 @@ namespace Async {
                             priority_task.task_id, static_cast<int>(priority_task.priority), activeThreads_.load());
                     
                     auto start_time = std::chrono::steady_clock::now();
+                    record_queue_wait(priority_task, start_time);
                     priority_task.task();
                     auto end_time = std::chrono::steady_clock::now();
+                    record_busy_time(worker_index, end_time - start_time);
                     
                     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
                     completedTasks_.fetch_add(1);
@@ -190,4 +197,67 @@ namespace Async {
         
         return stats;
     }
+
+    ThreadPool::WorkerTimings ThreadPool::get_worker_timings() const {
+        constexpr double ns_to_ms = 1e-6;
+
+        WorkerTimings timings;
+        for (size_t i = 0; i < timings.queue_wait.size(); ++i) {
+            timings.queue_wait[i].count = queueWaitCount_[i].load(std::memory_order_relaxed);
+            timings.queue_wait[i].total_ms = queueWaitTotalNs_[i].load(std::memory_order_relaxed) * ns_to_ms;
+            timings.queue_wait[i].max_ms = queueWaitMaxNs_[i].load(std::memory_order_relaxed) * ns_to_ms;
+        }
+
+        timings.busy_ms.resize(numThreads_);
+        for (size_t i = 0; i < numThreads_; ++i) {
+            timings.busy_ms[i] = workerBusyNs_[i].load(std::memory_order_relaxed) * ns_to_ms;
+        }
+
+        int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        timings.elapsed_ms = (now_ns - timingStartNs_.load(std::memory_order_relaxed)) * ns_to_ms;
+        return timings;
+    }
+
+    void ThreadPool::reset_worker_timings() {
+        for (size_t i = 0; i < queueWaitCount_.size(); ++i) {
+            queueWaitCount_[i].store(0, std::memory_order_relaxed);
+            queueWaitTotalNs_[i].store(0, std::memory_order_relaxed);
+            queueWaitMaxNs_[i].store(0, std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < numThreads_; ++i) {
+            workerBusyNs_[i].store(0, std::memory_order_relaxed);
+        }
+        timingStartNs_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count(), std::memory_order_relaxed);
+    }
+
+    size_t ThreadPool::acquire_worker_index() {
+        return nextWorkerIndex_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void ThreadPool::record_queue_wait(const PriorityTask& task, std::chrono::steady_clock::time_point start) {
+        size_t priority = static_cast<size_t>(task.priority);
+        if (priority >= queueWaitCount_.size()) {
+            return;
+        }
+
+        uint64_t wait_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(start - task.submit_time).count());
+        queueWaitCount_[priority].fetch_add(1, std::memory_order_relaxed);
+        queueWaitTotalNs_[priority].fetch_add(wait_ns, std::memory_order_relaxed);
+
+        uint64_t max_ns = queueWaitMaxNs_[priority].load(std::memory_order_relaxed);
+        while (wait_ns > max_ns &&
+               !queueWaitMaxNs_[priority].compare_exchange_weak(max_ns, wait_ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    void ThreadPool::record_busy_time(size_t worker_index, std::chrono::steady_clock::duration duration) {
+        if (worker_index >= numThreads_) {
+            return;
+        }
+        workerBusyNs_[worker_index].fetch_add(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()), std::memory_order_relaxed);
+    }
 } // namespace Async
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Asynchronous framebuffer readback through a ring of pixel pack buffers.
+// request() issues glReadPixels into the next free PBO and fences it; the copy runs on the GPU
+// while the CPU records later frames. try_fetch() maps the oldest PBO once its fence has signalled,
+// so pixels arrive a frame or two late but the CPU never waits for the GPU to drain.
+class AsyncReadback {
+public:
+    struct Image {
+        uint64_t tag;                // Caller's label, e.g. the frame index
+        int width;
+        int height;
+        std::vector<uint8_t> pixels; // RGBA8, top row first
+    };
+
+    explicit AsyncReadback(int ring_size = 3);
+    ~AsyncReadback();
+
+    AsyncReadback(const AsyncReadback&) = delete;
+    AsyncReadback& operator=(const AsyncReadback&) = delete;
+
+    // Queues a copy of color attachment 0 of framebuffer. False if every PBO is still in flight.
+    bool request(GLuint framebuffer, int width, int height, uint64_t tag);
+
+    // Oldest finished readback, without blocking
+    bool try_fetch(Image& image);
+    // Oldest readback, waiting for the GPU if it has not finished; false if nothing is queued
+    bool fetch(Image& image);
+
+    int get_pending_count() const { return pending_count_; }
+
+    void cleanup();
+
+private:
+    struct Slot {
+        GLuint buffer = 0;
+        GLsync fence = nullptr;
+        size_t capacity = 0;
+        uint64_t tag = 0;
+        int width = 0;
+        int height = 0;
+    };
+
+    bool read_slot(Slot& slot, Image& image);
+
+    std::vector<Slot> slots_;
+    int next_;     // Slot the next request writes
+    int oldest_;   // Oldest slot in flight
+    int pending_count_;
+};
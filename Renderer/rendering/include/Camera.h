@@ -19,10 +19,15 @@ public:
            float yaw = -90.0f, float pitch = 0.0f);
 
     glm::mat4 get_view_matrix() const;
-    glm::mat4 get_projection_matrix(float aspectRatio) const;
+    glm::mat4 get_projection_matrix(float aspectRatio) const;  // Includes the projection jitter
+    glm::mat4 get_unjittered_projection_matrix(float aspectRatio) const;
     glm::vec3 get_position() const;
     glm::vec3 get_front() const;
 
+    // Sub-pixel offset in NDC applied to the projection (temporal anti-aliasing)
+    void set_projection_jitter(const glm::vec2& jitter) { projection_jitter = jitter; }
+    glm::vec2 get_projection_jitter() const { return projection_jitter; }
+
     void process_keyboard(Direction dir, float deltaTime);
     void process_mouse_movement(float xoffset, float yoffset, bool constrainPitch = true);
     void process_mouse_scroll(float yoffset);
@@ -39,6 +44,7 @@ private:
     float move_speed;
     float mouse_sensitivity;
     float zoom;
+    glm::vec2 projection_jitter;
 
     void update_camera_vectors();
 }; 
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Shadow copy of the GL binding and enable state the renderer changes most: program, vertex array,
+// texture per unit and target, framebuffers, viewport and a few capabilities. A call that would set
+// what is already set returns without reaching the driver and counts as
+// RenderCounters::state_calls_skipped. Changes go through the RenderStats wrappers, so the bind
+// counters only see real ones. GL thread only.
+//
+// The cache is only right while every change goes through it. Code that uses raw GL (ImGui,
+// load-time precomputation) runs outside the frame; the renderer calls invalidate() when a frame
+// starts. Deleting a bound object unbinds it and frees its name for reuse, so the owners report
+// deletions with the forget_* calls.
+class GLStateCache {
+public:
+    static constexpr GLuint MAX_TEXTURE_UNITS = 32;  // Units above are passed through untracked
+
+    // Everything becomes unknown; the next call of each kind reaches GL
+    static void invalidate();
+
+    static void use_program(GLuint program);
+    static void bind_vertex_array(GLuint vertex_array);
+
+    // Texture unit index, not GL_TEXTURE0 + unit
+    static void active_texture(GLuint unit);
+    // Binds for sampling: selects the unit, then binds the texture to it
+    static void bind_texture_unit(GLuint unit, GLenum target, GLuint texture);
+    // Binds on the active unit, as glBindTexture does; for uploads and parameter changes, so it is
+    // not counted as a texture bind
+    static void bind_texture(GLenum target, GLuint texture);
+    // glBindTextures: count consecutive units from first, a zero id unbinds every target of its unit
+    static void bind_textures(GLuint first, GLsizei count, const GLuint* textures);
+
+    // GL_FRAMEBUFFER sets both the draw and the read binding
+    static void bind_framebuffer(GLenum target, GLuint framebuffer);
+    static void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    // Capabilities outside the tracked set are passed through
+    static void enable(GLenum capability) { set_enabled(capability, true); }
+    static void disable(GLenum capability) { set_enabled(capability, false); }
+    static void set_enabled(GLenum capability, bool enabled);
+
+    static void forget_program(GLuint program);
+    static void forget_vertex_array(GLuint vertex_array);
+    static void forget_texture(GLuint texture);
+    static void forget_framebuffer(GLuint framebuffer);
+
+private:
+    static constexpr GLuint UNKNOWN = 0xFFFFFFFFu;
+
+    // Texture targets with a tracked binding per unit
+    static constexpr size_t TEXTURE_TARGET_COUNT = 3;
+    static int get_target_index(GLenum target);
+
+    // Capabilities with a tracked enable
+    static constexpr size_t CAPABILITY_COUNT = 6;
+    static int get_capability_index(GLenum capability);
+
+    struct TextureUnitState {
+        std::array<GLuint, TEXTURE_TARGET_COUNT> bound;
+        GLuint range_bound;  // Id last bound here by bind_textures(), whatever its target
+    };
+
+    static GLuint program_;
+    static GLuint vertex_array_;
+    static GLuint active_unit_;
+    static std::array<TextureUnitState, MAX_TEXTURE_UNITS> texture_units_;
+    static GLuint draw_framebuffer_;
+    static GLuint read_framebuffer_;
+    static std::array<GLint, 4> viewport_;
+    static bool viewport_known_;
+    static std::array<int8_t, CAPABILITY_COUNT> capabilities_;  // -1 unknown, 0 disabled, 1 enabled
+};
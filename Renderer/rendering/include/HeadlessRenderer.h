@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "AsyncReadback.h"
+
+class HeadlessContext;
+class Camera;
+class Scene;
+class CoroutineResourceManager;
+class TransformManager;
+class Transform;
+
+namespace glRenderer {
+    class Renderer;
+}
+
+// Runs the deferred renderer without a window: a HeadlessContext, the default scene and
+// Renderer::render_deferred into the offscreen framebuffer, with results read back through
+// AsyncReadback. Used for automated benchmarks, golden-image comparisons and batch renders.
+class HeadlessRenderer {
+public:
+    struct Options {
+        int width = 1280;
+        int height = 720;
+        int frames = 120;
+        int capture_interval = 0;                     // Also capture every Nth frame; 0 captures only the last
+        std::string output_directory = "headless_output";
+        bool export_pass_timings = true;              // pass_timings.csv in output_directory
+    };
+
+    HeadlessRenderer();
+    ~HeadlessRenderer();
+
+    HeadlessRenderer(const HeadlessRenderer&) = delete;
+    HeadlessRenderer& operator=(const HeadlessRenderer&) = delete;
+
+    bool initialize(int width, int height);
+    void render_frame();
+
+    // Queues a readback of the frame just rendered; collect it with fetch/try_fetch
+    bool request_capture(uint64_t tag);
+    bool try_fetch_capture(AsyncReadback::Image& image) { return readback_->try_fetch(image); }
+    bool fetch_capture(AsyncReadback::Image& image) { return readback_->fetch(image); }
+
+    // Renders options.frames frames, writes captures as PNG and the pass timings as CSV.
+    // Returns a process exit code.
+    int run(const Options& options);
+
+    static bool write_png(const std::string& path, const AsyncReadback::Image& image);
+
+    // Imports a model file into the scene as one Renderable, blocking until it is on the GPU
+    bool add_model(const std::string& path, const std::string& name, const Transform& transform);
+
+    glRenderer::Renderer& get_renderer() { return *renderer_; }
+    Camera& get_camera() { return *camera_; }
+    Scene& get_scene() { return *scene_; }
+    CoroutineResourceManager& get_resource_manager() { return *resource_manager_; }
+    TransformManager& get_transform_manager() { return *transform_manager_; }
+    uint64_t get_frame_index() const { return frame_index_; }
+
+    void shutdown();
+
+private:
+    bool save_capture(const AsyncReadback::Image& image, const std::string& directory);
+
+    std::unique_ptr<HeadlessContext> context_;
+    std::unique_ptr<glRenderer::Renderer> renderer_;
+    std::unique_ptr<CoroutineResourceManager> resource_manager_;
+    std::unique_ptr<Scene> scene_;
+    std::shared_ptr<Camera> camera_;
+    std::unique_ptr<TransformManager> transform_manager_;
+    std::unique_ptr<AsyncReadback> readback_;
+    int width_;
+    int height_;
+    uint64_t frame_index_;
+};
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -16,11 +19,11 @@ public:
     ~Material() = default;
 
     // Basic material properties (Legacy Phong/Blinn-Phong)
-    void set_ambient(const glm::vec3& ambient) { this->ambient = ambient; }
-    void set_diffuse(const glm::vec3& diffuse) { this->diffuse = diffuse; }
-    void set_specular(const glm::vec3& specular) { this->specular = specular; }
-    void set_shininess(float shininess) { this->shininess = shininess; }
-    void set_emissive(const glm::vec3& emissive) { this->emissive = emissive; }
+    void set_ambient(const glm::vec3& ambient) { this->ambient = ambient; invalidate_binding_block(); }
+    void set_diffuse(const glm::vec3& diffuse) { this->diffuse = diffuse; invalidate_binding_block(); }
+    void set_specular(const glm::vec3& specular) { this->specular = specular; invalidate_binding_block(); }
+    void set_shininess(float shininess) { this->shininess = shininess; invalidate_binding_block(); }
+    void set_emissive(const glm::vec3& emissive) { this->emissive = emissive; invalidate_binding_block(); }
 
     glm::vec3 get_ambient() const { return ambient; }
     glm::vec3 get_diffuse() const { return diffuse; }
@@ -29,11 +32,11 @@ public:
     glm::vec3 get_emissive() const { return emissive; }
 
     // PBR material properties
-    void set_albedo(const glm::vec3& albedo) { this->albedo = albedo; }
-    void set_metallic(float metallic) { this->metallic = glm::clamp(metallic, 0.0f, 1.0f); }
-    void set_roughness(float roughness) { this->roughness = glm::clamp(roughness, 0.0f, 1.0f); }
-    void set_ao(float ao) { this->ao = glm::clamp(ao, 0.0f, 1.0f); }
-    void set_height_scale(float scale) { this->heightScale = scale; }
+    void set_albedo(const glm::vec3& albedo) { this->albedo = albedo; invalidate_binding_block(); }
+    void set_metallic(float metallic) { this->metallic = glm::clamp(metallic, 0.0f, 1.0f); invalidate_binding_block(); }
+    void set_roughness(float roughness) { this->roughness = glm::clamp(roughness, 0.0f, 1.0f); invalidate_binding_block(); }
+    void set_ao(float ao) { this->ao = glm::clamp(ao, 0.0f, 1.0f); invalidate_binding_block(); }
+    void set_height_scale(float scale) { this->heightScale = scale; invalidate_binding_block(); }
 
     glm::vec3 get_albedo() const { return albedo; }
     float get_metallic() const { return metallic; }
@@ -42,7 +45,7 @@ public:
     float get_height_scale() const { return heightScale; }
 
     // PBR rendering mode
-    void set_pbr_enabled(bool enabled) { pbrEnabled = enabled; }
+    void set_pbr_enabled(bool enabled) { pbrEnabled = enabled; invalidate_binding_block(); }
     bool is_pbr_enabled() const { return pbrEnabled; }
 
     // Legacy texture methods (for backward compatibility) - using texture paths
@@ -108,6 +111,43 @@ public:
     // Simplified automatic texture binding using Texture's built-in slot management
     void bind_textures_auto(const class Shader& shader, const class CoroutineResourceManager& resource_manager) const;
 
+    // Binding block: the material's textures resolved once into a range of ids on fixed units, so a
+    // draw binds them with one glBindTextures call instead of looking textures up by name. The
+    // parameters live in MaterialTable, which rewrites a material's record when its revision
+    // changes. Shaders declare the matching layout(binding = ...) values
+    // (deferred_geometry_fragment.glsl).
+    enum TextureUnit : GLuint {
+        ALBEDO_UNIT = 0,
+        NORMAL_UNIT,
+        METALLIC_UNIT,
+        ROUGHNESS_UNIT,
+        AO_UNIT,
+        EMISSIVE_UNIT,
+        TEXTURE_UNIT_COUNT
+    };
+
+    // Recompiles the block if a property changed since, or if a texture was missing the last time
+    // and the resource manager cached textures since. GL thread only.
+    void update_binding_block(const class CoroutineResourceManager& resource_manager) const;
+    // Updates the block, then binds its textures
+    void bind_block(const class CoroutineResourceManager& resource_manager) const;
+
+    // Texture arrays (CoroutineResourceManager::get_texture_layer) are bound once per pass on the
+    // units from ARRAY_UNIT on. A unit whose texture was packed samples its layer there and needs
+    // no per-material bind.
+    static constexpr GLuint ARRAY_UNIT = TEXTURE_UNIT_COUNT;
+    static constexpr GLuint MAX_TEXTURE_ARRAYS = 8;
+
+    // Valid after update_binding_block(). The revision is unique across all materials and changes
+    // whenever a property or the set of resolved textures does.
+    uint64_t get_revision() const { return bindingBlock.revision; }
+    GLuint get_texture_mask() const { return bindingBlock.texture_mask; }
+    // Units sampled from a texture array, and array index << 16 | layer for each of them
+    GLuint get_array_mask() const { return bindingBlock.array_mask; }
+    const std::array<GLuint, TEXTURE_UNIT_COUNT>& get_texture_layers() const { return bindingBlock.texture_layers; }
+    // Whether bind_block() has anything to bind
+    bool has_separate_textures() const { return (bindingBlock.texture_mask & ~bindingBlock.array_mask) != 0; }
+
     // Material preset creation (Legacy)
     static Material create_default();
     static Material create_metal();
@@ -158,6 +198,27 @@ private:
     std::string heightTexturePath;
     std::string metallicRoughnessTexturePath;
 
+    // Resolved textures of the binding block. A copied Material starts without them and compiles its own.
+    struct BindingBlock {
+        std::array<GLuint, TEXTURE_UNIT_COUNT> texture_ids{};
+        std::array<std::shared_ptr<Texture>, TEXTURE_UNIT_COUNT> textures;  // Keep the ids alive
+        std::array<GLuint, TEXTURE_UNIT_COUNT> texture_layers{};
+        GLuint texture_mask = 0;  // Units with a texture
+        GLuint array_mask = 0;    // Units with a texture array layer
+        uint64_t revision = 0;
+        bool dirty = true;
+        bool unresolved = false;  // A texture path was not in the cache
+        uint64_t texture_generation = 0;  // CoroutineResourceManager::get_texture_generation() when compiled
+
+        BindingBlock() = default;
+        BindingBlock(const BindingBlock&) {}
+        BindingBlock& operator=(const BindingBlock&) { dirty = true; return *this; }
+    };
+    mutable BindingBlock bindingBlock;
+
+    void invalidate_binding_block() { bindingBlock.dirty = true; }
+    void compile_binding_block(const class CoroutineResourceManager& resource_manager) const;
+
     // Helper methods
     void syncLegacyTextures();
     void syncPBRTextures();
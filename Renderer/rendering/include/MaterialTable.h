@@ -0,0 +1,68 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class Material;
+class CoroutineResourceManager;
+
+// Parameters of every material drawn this frame, packed into one SSBO of records.
+// Draws carry only a record index (the base instance of their indirect command, read as
+// gl_BaseInstance), so draws with different materials need no uniform changes between them.
+// A record is rewritten only when the material in its slot or that material's revision changed,
+// and only the range of rewritten records is uploaded.
+class MaterialTable {
+public:
+    static constexpr GLuint BINDING = 3;  // SSBO bindings 0-2 belong to the culling shaders
+
+    // std430 layout of MaterialRecord in deferred_geometry_fragment.glsl
+    struct Record {
+        glm::vec4 ambient;
+        glm::vec4 diffuse;
+        glm::vec4 specular_shininess;  // Specular (rgb), shininess (a)
+        glm::vec4 emissive;
+        glm::vec4 params;              // Metallic, roughness, AO, height scale
+        glm::uvec4 flags;              // Bit per Material::TextureUnit with a texture, bit per unit in an array, PBR enabled, unused
+        glm::uvec4 texture_layers[2];  // Array index << 16 | layer per unit, units 0-3 then 4-5
+    };
+
+    MaterialTable();
+    ~MaterialTable();
+
+    MaterialTable(const MaterialTable&) = delete;
+    MaterialTable& operator=(const MaterialTable&) = delete;
+
+    // Material list, rebuilt every frame
+    void begin_frame();
+    // Index of the material's record; a material added twice in a frame gets the same one. GL thread only.
+    uint32_t add(const Material& material, const CoroutineResourceManager& resource_manager);
+    size_t get_material_count() const { return count_; }
+
+    void upload();
+    void bind() const;
+    void unbind() const;
+
+    void cleanup();
+
+private:
+    struct Slot {
+        const Material* material = nullptr;
+        uint64_t revision = 0;
+    };
+
+    void ensure_capacity(size_t count);
+    size_t get_gpu_bytes() const { return capacity_ * sizeof(Record); }
+
+    std::unordered_map<const Material*, uint32_t> indices_;
+    std::vector<Slot> slots_;       // Kept across frames to detect unchanged records
+    std::vector<Record> records_;
+    size_t count_;
+    size_t dirty_begin_;
+    size_t dirty_end_;
+
+    GLuint buffer_;
+    size_t capacity_;
+};
@@ -15,26 +15,68 @@ public:
 
     using Indices = unsigned int;
 
+    // What stays in CPU memory once setup_mesh() has uploaded the buffers
+    enum class Retention {
+        All,        // Full vertices and indices
+        Positions,  // Positions and indices, enough for picking
+        None,       // Nothing; the mesh can be drawn but not picked
+    };
+
     Mesh() = default;
-    Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+    // Takes the arrays by value so callers done with them can move them in
+    Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, Retention retention = Retention::Positions);
     ~Mesh();
 
+    // Owns GL objects and reports its memory to the MemoryTracker
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
+
     void draw() const;
+    // Draws with the DrawElementsIndirectCommand at command_offset in the bound GL_DRAW_INDIRECT_BUFFER
+    void draw_indirect(GLintptr command_offset) const;
     void setup_mesh();
     void ensure_setup() const; // Ensure OpenGL buffers are initialized
-    inline bool empty() const { return vertices.empty(); };
+    inline bool empty() const { return vertex_count_ == 0; };
     inline bool is_setup() const { return gl_initialized_; };
+
+    // Applies at upload; on an uploaded mesh it can only release more
+    void set_retention(Retention retention);
+    Retention get_retention() const { return retention_; }
     
-    // Accessors 
+    // Accessors. Vertices are empty after upload unless the mesh retains All, indices unless it
+    // retains at least Positions. Counts stay valid either way.
     const std::vector<Vertex>& get_vertices() const { return vertices; }
     const std::vector<unsigned int>& get_indices() const { return indices; }
-    size_t get_vertex_count() const { return vertices.size(); }
-    size_t get_triangle_count() const { return indices.size() / 3; }
+    size_t get_vertex_count() const { return vertex_count_; }
+    size_t get_triangle_count() const { return index_count_ / 3; }
+    GLuint get_index_count() const { return static_cast<GLuint>(index_count_); }
+
+    // Object-space positions for picking, from whichever copy is retained
+    bool has_positions() const { return !vertices.empty() || !positions_.empty(); }
+    size_t get_position_count() const { return vertices.empty() ? positions_.size() : vertices.size(); }
+    const glm::vec3& get_position(size_t index) const { return vertices.empty() ? positions_[index] : vertices[index].position; }
+    
+    // Object-space axis-aligned bounds, computed once from the vertex positions
+    const glm::vec3& get_bounds_min() const { return bounds_min_; }
+    const glm::vec3& get_bounds_max() const { return bounds_max_; }
 
 private:
+    void release_cpu_data();
+
     std::vector<Vertex> vertices;
     std::vector<unsigned int> indices;
+    std::vector<glm::vec3> positions_;  // Retention::Positions after upload
+    size_t vertex_count_ = 0;
+    size_t index_count_ = 0;
+    Retention retention_ = Retention::Positions;
+    
+    glm::vec3 bounds_min_ = glm::vec3(0.0f);
+    glm::vec3 bounds_max_ = glm::vec3(0.0f);
     
     mutable unsigned int vao_ = 0, vbo_ = 0, ebo_ = 0;
     mutable bool gl_initialized_ = false;
+
+    // Bytes reported to the MemoryTracker
+    size_t cpu_bytes_ = 0;
+    size_t gpu_bytes_ = 0;
 }; 
\ No newline at end of file
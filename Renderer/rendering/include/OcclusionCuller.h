@@ -0,0 +1,68 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class Shader;
+
+// GPU occlusion culling against the Hi-Z depth pyramid.
+// Every draw item owns one DrawElementsIndirectCommand; the cull pass only writes its
+// instanceCount (0 or 1), so rejected draws cost no vertex work and nothing is read back.
+class OcclusionCuller {
+public:
+    enum class Phase {
+        Early,  // Test against last frame's pyramid, reprojected with last frame's view-projection
+        Late    // Re-test items rejected by the early phase against this frame's pyramid
+    };
+
+    // Layout of DrawElementsIndirectCommand
+    struct DrawCommand {
+        GLuint count;
+        GLuint instance_count;
+        GLuint first_index;
+        GLint base_vertex;
+        GLuint base_instance;
+    };
+
+    OcclusionCuller();
+    ~OcclusionCuller();
+
+    // Draw item list, rebuilt every frame
+    void begin_frame();
+    // The base instance is passed through to the draw untouched; shaders read it as gl_BaseInstance
+    uint32_t add_draw_item(const glm::vec3& bounds_min, const glm::vec3& bounds_max, const glm::mat4& model_matrix,
+                           GLuint index_count, GLuint base_instance = 0);
+    size_t get_draw_item_count() const { return commands_.size(); }
+
+    // Upload bounds and commands. Without culling history every item starts visible.
+    void upload(bool visible_by_default);
+
+    void cull(Phase phase, const Shader& cull_shader, const glm::mat4& view_projection,
+              GLuint hiz_texture, int hiz_width, int hiz_height, int hiz_mip_levels);
+
+    void bind_commands() const;
+    void unbind_commands() const;
+    static GLintptr get_command_offset(uint32_t index) { return static_cast<GLintptr>(index * sizeof(DrawCommand)); }
+
+    void cleanup();
+
+private:
+    struct DrawBounds {
+        glm::vec4 bounds_min;
+        glm::vec4 bounds_max;
+    };
+
+    void ensure_capacity(size_t count);
+    // Bytes of the three buffers at the current capacity
+    size_t get_gpu_bytes() const { return capacity_ * (sizeof(DrawBounds) + sizeof(DrawCommand) + sizeof(GLuint)); }
+
+    std::vector<DrawBounds> bounds_;
+    std::vector<DrawCommand> commands_;
+
+    GLuint bounds_buffer_;
+    GLuint command_buffer_;
+    GLuint visibility_buffer_;
+    size_t capacity_;
+};
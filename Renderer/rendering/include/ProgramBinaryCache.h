@@ -0,0 +1,73 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+class Shader;
+
+// Disk cache of linked program binaries (glGetProgramBinary / glProgramBinary), so a launch that
+// already built a program skips compiling and linking its GLSL.
+// A program is keyed by a hash of its stage types and sources and of the driver's vendor, renderer
+// and version strings: binaries only load on the driver that produced them, and any edit to a
+// source file changes the key. Entries that fail to load (truncated, stale after a driver update
+// that kept its version string) are deleted, and the caller falls back to compiling from source.
+// GL thread only.
+class ProgramBinaryCache {
+public:
+    static constexpr const char* DEFAULT_DIRECTORY = "shader_cache";
+
+    struct Stats {
+        uint32_t hits = 0;      // Programs loaded from a binary
+        uint32_t misses = 0;    // Programs with no usable entry
+        uint32_t rejected = 0;  // Entries found but refused by the file check or the driver
+        uint32_t stores = 0;    // Binaries written
+    };
+
+    explicit ProgramBinaryCache(std::string directory = DEFAULT_DIRECTORY);
+
+    void set_enabled(bool enabled) { enabled_ = enabled; }
+    // False as well once the driver turned out to offer no binary formats
+    bool is_enabled() const { return enabled_ && (!driver_queried_ || binaries_supported_); }
+
+    void set_directory(std::string directory) { directory_ = std::move(directory); }
+    const std::string& get_directory() const { return directory_; }
+
+    // Source and stage type of every shader in the program, in attach order
+    uint64_t make_key(const std::vector<std::pair<std::string, GLenum>>& stages);
+
+    // Links the shader's program from the cached binary; false leaves it without a program
+    bool load(uint64_t key, Shader& shader);
+    void store(uint64_t key, const Shader& shader);
+
+    // Deletes every entry on disk
+    void clear();
+
+    const Stats& get_stats() const { return stats_; }
+    void reset_stats() { stats_ = Stats{}; }
+
+private:
+    // Header of a cache file, followed by the binary
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t key;
+        uint32_t binary_format;
+        uint32_t binary_size;
+    };
+    static constexpr uint32_t FILE_MAGIC = 0x43425052;  // "RPBC"
+    static constexpr uint32_t FILE_VERSION = 1;
+    static constexpr const char* FILE_EXTENSION = ".bin";
+
+    void query_driver();
+    std::string get_entry_path(uint64_t key) const;
+
+    std::string directory_;
+    bool enabled_;
+    bool driver_queried_;
+    bool binaries_supported_;
+    std::string driver_id_;  // Vendor, renderer and version strings
+    Stats stats_;
+};
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "RenderStats.h"
+#include "RenderTargetPool.h"
+
+class Texture;
+
+// Frame graph for the deferred pipeline.
+// Passes declare the textures they read and write; compile() culls passes whose outputs nothing
+// consumes, orders the rest by their dependencies, and works out the lifetime of every transient
+// texture. execute() acquires transients from the RenderTargetPool just before their first pass,
+// releases them after their last one, and issues only the glMemoryBarrier bits a pass needs to
+// see image stores of earlier passes. Each pass is timed on the CPU and on the GPU, the latter with
+// a ring of GL_TIMESTAMP query pairs read back a few frames late so the CPU never waits on them.
+//
+// The graph is rebuilt every frame: reset(), import/create resources, add passes, compile, execute.
+class RenderGraph {
+public:
+    using ResourceHandle = int;
+    static constexpr ResourceHandle INVALID_RESOURCE = -1;
+
+    // How a pass touches a texture; decides which barrier bits a later access needs
+    enum class Access {
+        Sampled,     // texture() / texelFetch()
+        Image,       // imageLoad() / imageStore()
+        Attachment,  // Framebuffer attachment, blit or copy source
+    };
+
+    class PassBuilder {
+    public:
+        ResourceHandle read(ResourceHandle resource, Access access = Access::Sampled);
+        ResourceHandle write(ResourceHandle resource, Access access = Access::Attachment);
+        // Keeps the pass even if nothing reads what it writes (e.g. it updates history for next frame)
+        void set_side_effect();
+
+    private:
+        friend class RenderGraph;
+        PassBuilder(RenderGraph& graph, int pass_index) : graph_(graph), pass_index_(pass_index) {}
+        RenderGraph& graph_;
+        int pass_index_;
+    };
+
+    using SetupFunction = std::function<void(PassBuilder&)>;
+    using ExecuteFunction = std::function<void(const RenderGraph&)>;
+
+    // Latest sample plus statistics over the last TIMING_WINDOW samples. GPU values are
+    // negative until the first query result is available. Counters are the pass's GL work last frame.
+    struct PassTiming {
+        std::string name;
+        float cpu_ms;
+        float gpu_ms;
+        float cpu_avg_ms;
+        float gpu_avg_ms;
+        float gpu_min_ms;
+        float gpu_p50_ms;
+        float gpu_p95_ms;
+        float gpu_p99_ms;
+        float gpu_max_ms;
+        size_t gpu_sample_count;
+        RenderCounters counters;
+    };
+
+    // Frames a GPU result may lag before that pass skips a sample instead of stalling
+    static constexpr int QUERY_RING_SIZE = 4;
+    static constexpr size_t TIMING_WINDOW = 120;
+
+    explicit RenderGraph(RenderTargetPool& pool);
+    ~RenderGraph();
+
+    RenderGraph(const RenderGraph&) = delete;
+    RenderGraph& operator=(const RenderGraph&) = delete;
+
+    // Drops last frame's passes and resources; timers are kept
+    void reset();
+
+    // Texture owned outside the graph. Outputs are the roots culling starts from.
+    ResourceHandle import_texture(const std::string& name, GLuint texture, bool is_output = false);
+    // Transient texture allocated from the pool for the passes that use it
+    ResourceHandle create_texture(const std::string& name, const RenderTargetPool::Desc& desc);
+
+    // The setup function runs immediately; the execute function runs in execute()
+    void add_pass(const std::string& name, const SetupFunction& setup, ExecuteFunction execute);
+
+    void compile();
+    void execute();
+
+    // Valid while a pass that uses the resource executes. Invalid handles give 0 / nullptr.
+    GLuint get_texture_id(ResourceHandle resource) const;
+    Texture* get_texture(ResourceHandle resource) const;
+
+    // Passes run last frame, in execution order
+    const std::vector<PassTiming>& get_pass_timings() const { return pass_timings_; }
+    size_t get_culled_pass_count() const { return culled_pass_count_; }
+    // One row per pass of get_pass_timings(), for tracking regressions across builds
+    bool export_timings_csv(const std::string& path) const;
+
+    void cleanup();
+
+private:
+    struct Resource {
+        std::string name;
+        bool imported;
+        bool is_output;
+        GLuint texture_id;
+        Texture* texture;                    // Transients only
+        RenderTargetPool::Desc desc;
+        int first_pass;                      // Execution positions, -1 if unused
+        int last_pass;
+        bool image_written;                  // Last write was an image store not yet made visible everywhere
+        GLbitfield visible_bits;             // Barrier bits issued since that write
+    };
+
+    struct ResourceAccess {
+        ResourceHandle resource;
+        Access access;
+    };
+
+    struct Pass {
+        std::string name;
+        ExecuteFunction execute;
+        std::vector<ResourceAccess> reads;
+        std::vector<ResourceAccess> writes;
+        bool side_effect;
+        bool culled;
+    };
+
+    // Rolling window of samples
+    struct SampleWindow {
+        std::array<float, TIMING_WINDOW> samples{};
+        size_t count = 0;
+        size_t next = 0;
+
+        void add(float value) {
+            samples[next] = value;
+            next = (next + 1) % TIMING_WINDOW;
+            count = count < TIMING_WINDOW ? count + 1 : TIMING_WINDOW;
+        }
+    };
+
+    // Ring of start/end GL_TIMESTAMP pairs. Timestamps rather than GL_TIME_ELAPSED because
+    // elapsed queries cannot nest, so a pass could not time part of its own work.
+    struct PassTimer {
+        GLuint queries[QUERY_RING_SIZE][2] = {};
+        bool pending[QUERY_RING_SIZE] = {};
+        int next = 0;         // Slot this frame writes
+        int oldest = 0;       // Oldest slot still waiting for its result
+        bool active = false;  // Timestamps were written this frame
+        float gpu_ms = -1.0f;
+        SampleWindow gpu_window;
+        SampleWindow cpu_window;
+        const char* profile_name = nullptr;  // Interned pass name for the CPU profiler
+    };
+
+    bool is_valid(ResourceHandle resource) const;
+    void cull_passes();
+    bool sort_passes();
+    void compute_lifetimes();
+    GLbitfield get_required_barriers(const Pass& pass) const;
+    void begin_pass_timer(PassTimer& timer);
+    void end_pass_timer(PassTimer& timer);
+    static PassTiming make_pass_timing(const std::string& name, const PassTimer& timer, float cpu_ms);
+    static GLbitfield get_barrier_bit(Access access);
+
+    RenderTargetPool& pool_;
+    std::vector<Resource> resources_;
+    std::vector<Pass> passes_;
+    std::vector<int> execution_order_;
+    bool compiled_;
+    size_t culled_pass_count_;
+
+    std::unordered_map<std::string, PassTimer> timers_;
+    std::vector<PassTiming> pass_timings_;
+};
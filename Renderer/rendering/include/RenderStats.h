@@ -0,0 +1,137 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+
+// Work the renderer submitted to GL, counted per frame and per render graph pass.
+struct RenderCounters {
+    uint64_t draw_calls = 0;
+    uint64_t triangles = 0;           // Submitted; an indirect draw counts its whole mesh even if culled on the GPU
+    uint64_t instances = 0;
+    uint64_t program_binds = 0;
+    uint64_t texture_binds = 0;       // Sampler and image units
+    uint64_t uniform_uploads = 0;
+    uint64_t framebuffer_binds = 0;
+    uint64_t buffer_upload_bytes = 0;
+    uint64_t compute_dispatches = 0;
+    uint64_t state_calls_skipped = 0; // Redundant state changes GLStateCache kept from the driver
+
+    RenderCounters& operator+=(const RenderCounters& other) {
+        draw_calls += other.draw_calls;
+        triangles += other.triangles;
+        instances += other.instances;
+        program_binds += other.program_binds;
+        texture_binds += other.texture_binds;
+        uniform_uploads += other.uniform_uploads;
+        framebuffer_binds += other.framebuffer_binds;
+        buffer_upload_bytes += other.buffer_upload_bytes;
+        compute_dispatches += other.compute_dispatches;
+        state_calls_skipped += other.state_calls_skipped;
+        return *this;
+    }
+
+    RenderCounters operator-(const RenderCounters& other) const {
+        RenderCounters result;
+        result.draw_calls = draw_calls - other.draw_calls;
+        result.triangles = triangles - other.triangles;
+        result.instances = instances - other.instances;
+        result.program_binds = program_binds - other.program_binds;
+        result.texture_binds = texture_binds - other.texture_binds;
+        result.uniform_uploads = uniform_uploads - other.uniform_uploads;
+        result.framebuffer_binds = framebuffer_binds - other.framebuffer_binds;
+        result.buffer_upload_bytes = buffer_upload_bytes - other.buffer_upload_bytes;
+        result.compute_dispatches = compute_dispatches - other.compute_dispatches;
+        result.state_calls_skipped = state_calls_skipped - other.state_calls_skipped;
+        return result;
+    }
+};
+
+// Thin wrappers around the GL calls that submit work or change state. Each forwards to GL and
+// bumps a plain counter, so they cost an add on top of the call. GL thread only.
+// end_frame() publishes the running totals as the last frame's and starts over; anything issued
+// between two frames (uploads from finished loads) counts towards the next one.
+class RenderStats {
+public:
+    static const RenderCounters& get_counters() { return counters_; }
+    static const RenderCounters& get_last_frame() { return last_frame_; }
+    static void end_frame();
+
+    static void draw_elements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+        glDrawElements(mode, count, type, indices);
+        count_draw(static_cast<uint64_t>(count) / 3, 1);
+    }
+
+    // index_count is the mesh's, as the command itself lives in GPU memory
+    static void draw_elements_indirect(GLenum mode, GLenum type, const void* indirect, GLsizei index_count) {
+        glDrawElementsIndirect(mode, type, indirect);
+        count_draw(static_cast<uint64_t>(index_count) / 3, 1);
+    }
+
+    static void draw_arrays(GLenum mode, GLint first, GLsizei count) {
+        glDrawArrays(mode, first, count);
+        uint64_t triangles = 0;
+        if (mode == GL_TRIANGLES) {
+            triangles = static_cast<uint64_t>(count) / 3;
+        } else if (mode == GL_TRIANGLE_STRIP && count > 2) {
+            triangles = static_cast<uint64_t>(count) - 2;
+        }
+        count_draw(triangles, 1);
+    }
+
+    static void dispatch_compute(GLuint groups_x, GLuint groups_y, GLuint groups_z) {
+        glDispatchCompute(groups_x, groups_y, groups_z);
+        ++counters_.compute_dispatches;
+    }
+
+    static void use_program(GLuint program) {
+        glUseProgram(program);
+        ++counters_.program_binds;
+    }
+
+    static void bind_texture(GLenum target, GLuint texture) {
+        glBindTexture(target, texture);
+        ++counters_.texture_binds;
+    }
+
+    // Binds count consecutive units from first; a zero id unbinds its unit
+    static void bind_textures(GLuint first, GLsizei count, const GLuint* textures) {
+        glBindTextures(first, count, textures);
+        counters_.texture_binds += static_cast<uint64_t>(count);
+    }
+
+    static void bind_image_texture(GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format) {
+        glBindImageTexture(unit, texture, level, layered, layer, access, format);
+        ++counters_.texture_binds;
+    }
+
+    static void bind_framebuffer(GLenum target, GLuint framebuffer) {
+        glBindFramebuffer(target, framebuffer);
+        ++counters_.framebuffer_binds;
+    }
+
+    static void buffer_data(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+        glBufferData(target, size, data, usage);
+        if (data) {
+            counters_.buffer_upload_bytes += static_cast<uint64_t>(size);
+        }
+    }
+
+    static void buffer_sub_data(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+        glBufferSubData(target, offset, size, data);
+        counters_.buffer_upload_bytes += static_cast<uint64_t>(size);
+    }
+
+    // For uploads made through a typed glUniform* call
+    static void count_uniform_upload() { ++counters_.uniform_uploads; }
+    static void count_skipped_state_call() { ++counters_.state_calls_skipped; }
+
+private:
+    static void count_draw(uint64_t triangles, uint64_t instances) {
+        ++counters_.draw_calls;
+        counters_.triangles += triangles * instances;
+        counters_.instances += instances;
+    }
+
+    static RenderCounters counters_;
+    static RenderCounters last_frame_;
+};
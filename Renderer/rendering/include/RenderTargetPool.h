@@ -0,0 +1,80 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Texture;
+
+// Pool of transient render targets keyed by (format, size).
+// A pass acquires a target, releases it as soon as its last reader has run, and a later pass
+// asking for the same key gets the same texture back. GL has no placement of textures in shared
+// memory, so aliasing happens at texture granularity: passes whose lifetimes do not overlap share
+// one allocation. Targets left unused for a few frames are freed.
+class RenderTargetPool {
+public:
+    struct Desc {
+        int width;
+        int height;
+        GLenum internal_format;
+        int levels = 1;
+
+        bool operator==(const Desc& other) const {
+            return width == other.width && height == other.height &&
+                   internal_format == other.internal_format && levels == other.levels;
+        }
+    };
+
+    // A target used from first_pass to last_pass (inclusive) of a frame, for memory planning
+    struct Usage {
+        std::string name;
+        Desc desc;
+        int first_pass;
+        int last_pass;
+    };
+
+    struct MemoryReport {
+        size_t unaliased_bytes;  // Every target in its own allocation
+        size_t aliased_bytes;    // Targets with disjoint lifetimes share an allocation
+        int unaliased_count;
+        int aliased_count;
+    };
+
+    RenderTargetPool();
+    ~RenderTargetPool();
+
+    RenderTargetPool(const RenderTargetPool&) = delete;
+    RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+    // Returns every target still held from the previous frame and frees idle ones
+    void begin_frame(uint32_t max_idle_frames = 3);
+
+    Texture* acquire(const Desc& desc);
+    void release(Texture*& texture);
+
+    // Frees every target; nothing may be held
+    void clear();
+
+    size_t get_allocated_bytes() const { return allocated_bytes_; }
+    size_t get_peak_allocated_bytes() const { return peak_allocated_bytes_; }
+    size_t get_texture_count() const { return entries_.size(); }
+
+    static size_t get_texture_bytes(const Desc& desc);
+    static MemoryReport plan(const std::vector<Usage>& usages);
+
+private:
+    struct Entry {
+        Desc desc;
+        std::unique_ptr<Texture> texture;
+        bool in_use;
+        uint64_t last_used_frame;
+    };
+
+    std::vector<Entry> entries_;
+    uint64_t frame_index_;
+    size_t allocated_bytes_;
+    size_t peak_allocated_bytes_;
+};
@@ -14,6 +14,11 @@
 #include "Material.h"
 #include "Texture.h"
 #include "ShadowMap.h"
+#include "OcclusionCuller.h"
+#include "MaterialTable.h"
+#include "RenderTargetPool.h"
+#include "RenderGraph.h"
+#include "RenderStats.h"
 #include <Scene.h>
 
 // Forward declarations
@@ -22,17 +27,24 @@ class TransformManager;
 namespace glRenderer {
     class Renderer {
     public:
+        // Size of the light uniform arrays of the lighting shaders; lights past it are not shaded
+        static constexpr size_t MAX_LIGHTS = 8;
+
         Renderer(
             int width,
             int height
         );
         ~Renderer();
 
-        void initialize();
+        // The loader defaults to GLFW's; headless sessions pass their context's instead
+        void initialize(GLADloadproc proc_loader = reinterpret_cast<GLADloadproc>(glfwGetProcAddress));
         //void render();
         void process_input();
         void update_camera(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& camera_pos);
         GLuint get_color_texture() const { return color_texture_ ? color_texture_->get_id() : 0; }
+        GLuint get_framebuffer() const { return framebuffer_; }
+        int get_viewport_width() const { return viewport_width_; }
+        int get_viewport_height() const { return viewport_height_; }
    
         void set_render_to_framebuffer(bool enable);
         void resize_framebuffer(int width, int height);
@@ -73,12 +85,14 @@ namespace glRenderer {
         
         // SSAO rendering
         void SSAO_render(const Scene& scene, const Camera& camera, const CoroutineResourceManager& resource_manager);
+        void SSAO_blur(const CoroutineResourceManager& resource_manager);
         void apply_ssao_to_framebuffer(const Scene& scene, const Camera& camera, const CoroutineResourceManager& resource_manager);
         void set_ssao_enabled(bool enable);
         bool is_ssao_enabled() const { return use_ssao_; }
         
         // SSGI rendering
         void SSGI_render(const Scene& scene, const Camera& camera, const CoroutineResourceManager& resource_manager);
+        void SSGI_denoise(const Camera& camera, const CoroutineResourceManager& resource_manager);
         void set_ssgi_enabled(bool enable);
         bool is_ssgi_enabled() const { return use_ssgi_; }
         void set_ssgi_exposure(float exposure);
@@ -89,8 +103,49 @@ namespace glRenderer {
         void set_ssgi_thickness(float thickness);
         void set_ssgi_num_samples(int num_samples);
         
+        // Screen-space effect resolution: divisor 1 (full), 2 (half) or 4 (quarter)
+        void set_ssao_resolution_divisor(int divisor);
+        void set_ssgi_resolution_divisor(int divisor);
+        int get_ssao_resolution_divisor() const { return ssao_resolution_divisor_; }
+        int get_ssgi_resolution_divisor() const { return ssgi_resolution_divisor_; }
+        
+        // Last measured GPU time (ms) of an effect at the given divisor, negative if not measured yet
+        float get_ssao_gpu_time_ms(int divisor) const;
+        float get_ssgi_gpu_time_ms(int divisor) const;
+        
+        // Temporal anti-aliasing (deferred path). A render scale below 1 renders the G-Buffer and
+        // lighting at a lower internal resolution and the resolve reconstructs the viewport size.
+        void set_taa_enabled(bool enable);
+        bool is_taa_enabled() const { return use_taa_; }
+        void set_taa_render_scale(float scale);
+        float get_taa_render_scale() const { return taa_render_scale_; }
+        // Jitter (NDC) for the next frame, to be applied with Camera::set_projection_jitter
+        glm::vec2 get_projection_jitter() const;
+        
+        // Memory of the deferred pass graph's render targets at a given viewport size, with and
+        // without sharing allocations between targets whose lifetimes do not overlap
+        RenderTargetPool::MemoryReport get_render_target_report(int width, int height) const;
+        void log_render_target_report() const;
+        
+        // CPU and GPU time of each render graph pass run last frame, with rolling averages and percentiles
+        const std::vector<RenderGraph::PassTiming>& get_pass_timings() const { return render_graph_->get_pass_timings(); }
+        bool export_pass_timings_csv(const std::string& path) const { return render_graph_->export_timings_csv(path); }
+
+        // GL work of the last finished frame (draws, binds, uploads); per pass in get_pass_timings()
+        const RenderCounters& get_frame_counters() const { return RenderStats::get_last_frame(); }
+        
+        // Hi-Z occlusion culling
+        void set_occlusion_culling_enabled(bool enable);
+        bool is_occlusion_culling_enabled() const { return use_occlusion_culling_; }
+        
+        // Compute-shader tiled direct lighting (16x16 tiles with per-tile light culling)
+        void set_tiled_lighting_enabled(bool enable);
+        bool is_tiled_lighting_enabled() const { return use_tiled_lighting_; }
+        
         // SSGI pipeline functions
         void render_direct_lighting_pass(const Scene& scene, const Camera& camera, const CoroutineResourceManager& resource_manager);
+        void render_deferred_lighting_pass(const Scene& scene, const Camera& camera, const CoroutineResourceManager& resource_manager);
+        void render_tiled_lighting_pass(const Scene& scene, const Camera& camera, const CoroutineResourceManager& resource_manager);
         void render_composition_pass(const Scene& scene, const Camera& camera, const CoroutineResourceManager& resource_manager);
 
     private:
@@ -104,6 +159,10 @@ namespace glRenderer {
         int viewport_width_;
         int viewport_height_;
         
+        // Internal resolution of the deferred pipeline; equals the viewport unless TAA upsamples
+        int render_width_;
+        int render_height_;
+        
         // Forward rendering framebuffer
         GLuint framebuffer_;
         std::unique_ptr<Texture> color_texture_;
@@ -112,12 +171,12 @@ namespace glRenderer {
         
         // G-Buffer for deferred rendering
         GLuint g_buffer_fbo_;
-        std::unique_ptr<Texture> g_position_texture_;     // RT0: World Position (xyz) + Material ID (w)
-        std::unique_ptr<Texture> g_albedo_metallic_texture_;  // RT1: Albedo (rgb) + Metallic (a)
-        std::unique_ptr<Texture> g_normal_roughness_texture_; // RT2: Normal (xyz) + Roughness (a)
-        std::unique_ptr<Texture> g_motion_ao_texture_;    // RT3: Motion Vector (xy) + AO (z) + unused (w)
-        std::unique_ptr<Texture> g_emissive_texture_;     // RT4: Emissive Color (rgb) + intensity (a)
-        std::unique_ptr<Texture> g_depth_texture_;        // Depth buffer for G-Buffer
+        // World position is not stored; passes reconstruct it from depth + inverse view-projection
+        std::unique_ptr<Texture> g_albedo_metallic_texture_;  // RT0: Albedo (rgb, sRGB) + Metallic (a)            - SRGB8_ALPHA8
+        std::unique_ptr<Texture> g_normal_roughness_texture_; // RT1: Octahedral Normal (rg) + Roughness (b)      - RGB10_A2
+        std::unique_ptr<Texture> g_motion_ao_texture_;    // RT2: Motion Vector (xy) + AO (z) + unused (w)        - RGBA16F (signed motion)
+        std::unique_ptr<Texture> g_emissive_texture_;     // RT3: Emissive Color (rgb) + intensity (a)            - RGBA8
+        std::unique_ptr<Texture> g_depth_texture_;        // Depth buffer for G-Buffer                            - DEPTH24
         bool use_deferred_rendering_;
         
         // Shadow light configuration - consistent across shadow pass and lighting pass
@@ -133,17 +192,23 @@ namespace glRenderer {
         
         // SSAO framebuffers and textures
         GLuint ssao_fbo_;
-        std::unique_ptr<Texture> ssao_raw_texture_;       // Raw noisy SSAO output
-        std::unique_ptr<Texture> ssao_final_texture_;     // Blurred SSAO output
+        Texture* ssao_raw_texture_;                       // Raw noisy SSAO output (pooled, until the blur)
+        Texture* ssao_final_texture_;                     // Blurred SSAO output (pooled, until the frame is composed)
         std::unique_ptr<Texture> ssao_noise_texture_;     // Noise texture for random sampling
         bool use_ssao_;
+        int ssao_resolution_divisor_;
         
         // SSGI framebuffers and textures
         GLuint ssgi_fbo_;
-        std::unique_ptr<Texture> ssgi_raw_texture_;       // Raw noisy SSGI output
-        std::unique_ptr<Texture> ssgi_final_texture_;     // Denoised SSGI output
+        Texture* ssgi_raw_texture_;                       // Raw noisy SSGI output (pooled, until the denoise)
+        // Final and history swap every frame (ping-pong, immutable storage, no copies).
+        // Allocated on the first SSGI frame and freed when SSGI is disabled.
+        std::unique_ptr<Texture> ssgi_final_texture_;     // Denoised SSGI output (rgb) + history length (a)
         std::unique_ptr<Texture> ssgi_prev_texture_;      // Previous frame SSGI for temporal accumulation
-        std::unique_ptr<Texture> lit_scene_texture_;      // Direct lighting only 
+        std::unique_ptr<Texture> ssgi_geometry_texture_;  // Normal (rg) + linear depth (b) the denoise saw this frame
+        std::unique_ptr<Texture> ssgi_prev_geometry_texture_; // Last frame's, for the disocclusion test
+        bool ssgi_history_valid_;                         // ssgi_prev_texture_ holds last frame's result
+        Texture* lit_scene_texture_;                      // Direct lighting only (pooled, until the frame is composed)
         bool use_ssgi_;
         float ssgi_exposure_;
         float ssgi_intensity_;
@@ -152,11 +217,49 @@ namespace glRenderer {
         float ssgi_step_size_;
         float ssgi_thickness_;
         int ssgi_num_samples_;
+        int ssgi_resolution_divisor_;
+        
+        // Deferred frame graph and the pool its transient targets come from
+        std::unique_ptr<RenderTargetPool> render_target_pool_;
+        std::unique_ptr<RenderGraph> render_graph_;
+        void clear_transient_targets();
+        
+        // GPU time of each screen-space effect per resolution (full, half, quarter), from the graph's pass timers
+        float ssao_time_ms_[3] = { -1.0f, -1.0f, -1.0f };
+        float ssgi_time_ms_[3] = { -1.0f, -1.0f, -1.0f };
         
         // Hi-Z Buffer for accelerated ray marching
-        GLuint hiz_textures_[2];        // Hi-Z pyramid ping-pong textures
-        GLuint final_hiz_texture_;      // Points to the texture containing final result
+        GLuint hiz_texture_;            // Hi-Z pyramid, all levels in one mip-chained texture
+        GLuint hiz_counter_buffer_;     // Atomic workgroup counter for single-pass generation
         int hiz_mip_levels_;            // Number of mip levels in Hi-Z pyramid
+        size_t hiz_gpu_bytes_;          // Pyramid size reported to the MemoryTracker
+        glm::mat4 hiz_view_projection_; // View-projection the current pyramid was built with
+        bool hiz_history_valid_;        // Pyramid holds a previous frame usable for culling
+        
+        // Occlusion culling: one indirect command per draw item
+        struct DrawItem {
+            const Model* model;
+            const std::string* model_id;  // Owned by the Renderable, valid for the frame
+            glm::mat4 model_matrix;
+        };
+        std::unique_ptr<OcclusionCuller> occlusion_culler_;
+        std::unique_ptr<MaterialTable> material_table_;  // Record index is each command's base instance
+        std::vector<DrawItem> draw_items_;
+        bool use_occlusion_culling_;
+        
+        // Tiled lighting
+        bool use_tiled_lighting_;
+        
+        // Temporal anti-aliasing
+        bool use_taa_;
+        float taa_render_scale_;
+        GLuint taa_scene_fbo_;                              // Lit scene at render resolution, depth shared with the G-Buffer
+        std::unique_ptr<Texture> taa_scene_color_texture_;
+        GLuint taa_resolve_fbo_;
+        std::unique_ptr<Texture> taa_history_textures_[2]; // Resolve output at viewport resolution, ping-pong
+        int taa_history_index_;                             // History read this frame
+        bool taa_history_valid_;
+        uint32_t taa_frame_index_;                          // Position in the jitter sequence
         
         // Temporal accumulation data
         glm::mat4 prev_view_matrix_;
@@ -200,11 +303,36 @@ namespace glRenderer {
         void cleanup_ssgi();
         void setup_ssgi_textures();
         void cleanup_ssgi_textures();
+        void create_ssgi_targets();
+        
+        // Effect resolution and timing helpers
+        glm::ivec2 get_effect_size(int divisor) const;
+        static int get_resolution_index(int divisor);
+        void update_effect_times();
         
         // Hi-Z Buffer methods
         void setup_hiz_buffer();
         void cleanup_hiz_buffer();
-        void generate_hiz_pyramid(const CoroutineResourceManager& resource_manager);
+        void generate_hiz_pyramid(const CoroutineResourceManager& resource_manager, GLuint depth_texture);
+        
+        // TAA methods
+        void setup_taa();
+        void cleanup_taa();
+        void setup_taa_targets();
+        void render_taa_resolve(const Camera& camera, const CoroutineResourceManager& resource_manager);
+        bool is_taa_active() const { return use_taa_ && use_deferred_rendering_; }
+        GLuint get_scene_target_fbo() const { return is_taa_active() ? taa_scene_fbo_ : framebuffer_; }
+        
+        // Internal resolution: recreates every render-resolution target when it changes
+        glm::ivec2 get_render_size() const;
+        void update_render_resolution();
+        void resize_render_targets();
+        
+        // Occlusion culling methods
+        void collect_draw_items(const Scene& scene, const CoroutineResourceManager& resource_manager,
+                                const TransformManager& transform_manager, bool use_model_transforms);
+        bool cull_draw_items_early(const CoroutineResourceManager& resource_manager);
+        void cull_draw_items_late(const CoroutineResourceManager& resource_manager, const glm::mat4& view_projection);
         
     };
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <glad/glad.h>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <glm/glm.hpp>
 
 
@@ -22,6 +23,11 @@ public:
     // Shader compilation and linking methods
     Shader& attach_shader(const std::string& shader_source, GLenum shader_type);
     void link_program();
+
+    // Program binaries, for ProgramBinaryCache. load_binary() replaces any program this shader has;
+    // when the driver refuses the binary it returns false and leaves the shader without a program.
+    bool load_binary(GLenum binary_format, const void* binary, GLsizei length);
+    bool get_binary(GLenum& binary_format, std::vector<char>& binary) const;
     
     void use() const;
     unsigned int get_id() const;
@@ -40,6 +46,7 @@ private:
     std::unordered_map<GLenum, GLuint> attached_shaders_;
     
     // Helper methods
+    void release_program();
     void check_compile_errors(GLuint shader, const std::string& type);
     GLuint compile_shader(const std::string& shader_source, GLenum shader_type, const std::string& type_name);
 }; 
\ No newline at end of file
@@ -30,10 +30,19 @@ public:
     
     glm::mat4 get_light_space_matrix(const glm::vec3& light_direction, const glm::vec3& shadow_center) const;
     
+    // Min/max depth pyramid (RG32F, level 0 at half the shadow map resolution).
+    // PCSS reads it to skip filtering where a region is entirely lit or entirely shadowed.
+    void build_min_max_pyramid(const Shader& min_max_shader);
+    GLuint get_min_max_texture() const { return min_max_texture_; }
+    int get_min_max_levels() const { return min_max_levels_; }
+    
 
 private:
     GLuint framebuffer_;
     GLuint depth_texture_;
+    GLuint min_max_texture_;
+    int min_max_levels_;
+    size_t gpu_bytes_;  // Both textures, as reported to the MemoryTracker
     int shadow_width_;
     int shadow_height_;
     bool initialized_;
@@ -7,6 +7,7 @@
 #include <unordered_set>
 #include <memory>
 #include "STBImage.h"
+#include "MemoryTracker.h"
 
 // Forward declarations for future graphics API abstraction
 enum class GraphicsAPI {
@@ -65,6 +66,13 @@ public:
     static Texture create_framebuffer_texture(GLuint width, GLuint height, GLenum internal_format, GLenum format, GLenum type, bool generate_mipmaps = false);
     static Texture create_noise_texture(GLuint width, GLuint height, const std::vector<float>& noise_data);
     static Texture create_g_buffer_texture(GLuint width, GLuint height, GLenum internal_format, GLenum format, GLenum type);
+    // Immutable storage (glTexStorage2D): size and format are fixed, contents are never reallocated
+    static Texture create_immutable_texture(GLuint width, GLuint height, GLenum internal_format, GLsizei levels = 1);
+    // GL_TEXTURE_2D_ARRAY of material textures sharing one size and format, immutable storage with a
+    // full mip chain. Fill the layers with upload_layer(), then build the mips with generate_array_mipmaps().
+    static Texture create_texture_array(GLuint width, GLuint height, GLuint layers, GLenum internal_format);
+    void upload_layer(GLuint layer, GLenum format, const unsigned char* data);
+    void generate_array_mipmaps();
     
     // Generic texture creation method using abstraction structure
     static Texture create_texture(const TextureCreateInfo& create_info);
@@ -111,10 +119,23 @@ public:
     // Static methods for binding raw OpenGL texture IDs (for renderer internal use)
     static unsigned int bind_raw_texture(GLuint texture_id, GLenum target = GL_TEXTURE_2D);
 
+    // Reports the storage just allocated for this texture to the MemoryTracker, replacing what was
+    // reported before. The size is estimated from the internal format, dimensions, faces and levels.
+    void track_gpu_memory(GLenum internal_format, GLuint width, GLuint height, GLuint faces = 1, GLuint levels = 1,
+                          MemoryCategory category = MemoryCategory::k_texture_gpu);
+    size_t get_gpu_bytes() const { return gpu_bytes_; }
+    // Levels of a full mip chain, as built by glGenerateMipmap
+    static GLuint get_mip_level_count(GLuint width, GLuint height);
+    // Same estimate, for textures created with raw GL calls
+    static size_t get_texture_bytes(GLenum internal_format, GLuint width, GLuint height, GLuint faces = 1, GLuint levels = 1);
+
 private:
     GLuint texture_id_ = 0;
     GLuint width_, height_, nr_channels_;
     bool is_hdr_ = false;
+
+    size_t gpu_bytes_ = 0;
+    MemoryCategory memory_category_ = MemoryCategory::k_texture_gpu;
     
     // Static slot counter for sequential allocation
     static unsigned int current_slot_counter_;
@@ -0,0 +1,130 @@
+#include "AsyncReadback.h"
+#include <Logger.h>
+#include "MemoryTracker.h"
+
+#include <algorithm>
+#include <cstring>
+
+AsyncReadback::AsyncReadback(int ring_size)
+    : slots_(std::max(ring_size, 1)), next_(0), oldest_(0), pending_count_(0)
+{
+}
+
+AsyncReadback::~AsyncReadback() {
+    cleanup();
+}
+
+bool AsyncReadback::request(GLuint framebuffer, int width, int height, uint64_t tag) {
+    if (width <= 0 || height <= 0 || pending_count_ == static_cast<int>(slots_.size())) {
+        return false;
+    }
+
+    Slot& slot = slots_[next_];
+    size_t size = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+    if (slot.buffer == 0) {
+        glGenBuffers(1, &slot.buffer);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    if (slot.capacity < size) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_READ);
+        MemoryTracker::get_instance().resize(MemoryCategory::k_staging, slot.capacity, size);
+        slot.capacity = size;
+    }
+
+    // With a pack buffer bound, glReadPixels only records the copy
+    GLint previous_read_framebuffer = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previous_read_framebuffer);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previous_read_framebuffer));
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.tag = tag;
+    slot.width = width;
+    slot.height = height;
+
+    next_ = (next_ + 1) % static_cast<int>(slots_.size());
+    ++pending_count_;
+    return true;
+}
+
+bool AsyncReadback::try_fetch(Image& image) {
+    if (pending_count_ == 0) {
+        return false;
+    }
+
+    // Flush once so the fence is sure to reach the GPU, but never wait
+    Slot& slot = slots_[oldest_];
+    GLenum status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+        return false;
+    }
+    return read_slot(slot, image);
+}
+
+bool AsyncReadback::fetch(Image& image) {
+    if (pending_count_ == 0) {
+        return false;
+    }
+
+    Slot& slot = slots_[oldest_];
+    GLenum status = GL_TIMEOUT_EXPIRED;
+    while (status == GL_TIMEOUT_EXPIRED) {
+        status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);  // 1 s
+    }
+    if (status == GL_WAIT_FAILED) {
+        LOG_ERROR("AsyncReadback: Waiting for readback {} failed", slot.tag);
+    }
+    return read_slot(slot, image);
+}
+
+bool AsyncReadback::read_slot(Slot& slot, Image& image) {
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+    oldest_ = (oldest_ + 1) % static_cast<int>(slots_.size());
+    --pending_count_;
+
+    const size_t row_bytes = static_cast<size_t>(slot.width) * 4;
+    const size_t size = row_bytes * static_cast<size_t>(slot.height);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    const auto* mapped = static_cast<const uint8_t*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(size), GL_MAP_READ_BIT));
+    if (!mapped) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        LOG_ERROR("AsyncReadback: Failed to map readback {}", slot.tag);
+        return false;
+    }
+
+    // GL rows start at the bottom; images are stored top row first
+    image.tag = slot.tag;
+    image.width = slot.width;
+    image.height = slot.height;
+    image.pixels.resize(size);
+    for (int row = 0; row < slot.height; ++row) {
+        std::memcpy(image.pixels.data() + static_cast<size_t>(row) * row_bytes,
+                    mapped + static_cast<size_t>(slot.height - 1 - row) * row_bytes, row_bytes);
+    }
+
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return true;
+}
+
+void AsyncReadback::cleanup() {
+    for (auto& slot : slots_) {
+        if (slot.fence) {
+            glDeleteSync(slot.fence);
+        }
+        if (slot.buffer != 0) {
+            glDeleteBuffers(1, &slot.buffer);
+        }
+        MemoryTracker::get_instance().release(MemoryCategory::k_staging, slot.capacity);
+        slot = Slot();
+    }
+    next_ = 0;
+    oldest_ = 0;
+    pending_count_ = 0;
+}
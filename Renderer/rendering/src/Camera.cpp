@@ -4,7 +4,7 @@
 
 Camera::Camera(glm::vec3 position, glm::vec3 up, float yaw, float pitch)
     : position(position), worldUp(up), yaw(yaw), pitch(pitch),
-      move_speed(2.5f), mouse_sensitivity(0.1f), zoom(45.0f) {
+      move_speed(2.5f), mouse_sensitivity(0.1f), zoom(45.0f), projection_jitter(0.0f) {
     update_camera_vectors();
 }
 
@@ -13,6 +13,14 @@ glm::mat4 Camera::get_view_matrix() const {
 }
 
 glm::mat4 Camera::get_projection_matrix(float aspectRatio) const {
+    glm::mat4 projection = get_unjittered_projection_matrix(aspectRatio);
+    // Clip w is -z_view, so subtracting from the third column moves NDC by +jitter
+    projection[2][0] -= projection_jitter.x;
+    projection[2][1] -= projection_jitter.y;
+    return projection;
+}
+
+glm::mat4 Camera::get_unjittered_projection_matrix(float aspectRatio) const {
     return glm::perspective(glm::radians(zoom), aspectRatio, 0.1f, 100.0f);
 }
 
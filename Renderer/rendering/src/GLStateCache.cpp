@@ -0,0 +1,218 @@
+#include "GLStateCache.h"
+#include "RenderStats.h"
+
+GLuint GLStateCache::program_ = GLStateCache::UNKNOWN;
+GLuint GLStateCache::vertex_array_ = GLStateCache::UNKNOWN;
+GLuint GLStateCache::active_unit_ = GLStateCache::UNKNOWN;
+std::array<GLStateCache::TextureUnitState, GLStateCache::MAX_TEXTURE_UNITS> GLStateCache::texture_units_;
+GLuint GLStateCache::draw_framebuffer_ = GLStateCache::UNKNOWN;
+GLuint GLStateCache::read_framebuffer_ = GLStateCache::UNKNOWN;
+std::array<GLint, 4> GLStateCache::viewport_{};
+bool GLStateCache::viewport_known_ = false;
+std::array<int8_t, GLStateCache::CAPABILITY_COUNT> GLStateCache::capabilities_;
+
+namespace {
+
+// Nothing is known about the context the cache starts in
+struct InitialState {
+    InitialState() { GLStateCache::invalidate(); }
+} initial_state;
+
+} // namespace
+
+void GLStateCache::invalidate() {
+    program_ = UNKNOWN;
+    vertex_array_ = UNKNOWN;
+    active_unit_ = UNKNOWN;
+    for (TextureUnitState& unit : texture_units_) {
+        unit.bound.fill(UNKNOWN);
+        unit.range_bound = UNKNOWN;
+    }
+    draw_framebuffer_ = UNKNOWN;
+    read_framebuffer_ = UNKNOWN;
+    viewport_known_ = false;
+    capabilities_.fill(-1);
+}
+
+void GLStateCache::use_program(GLuint program) {
+    if (program == program_) {
+        RenderStats::count_skipped_state_call();
+        return;
+    }
+    RenderStats::use_program(program);
+    program_ = program;
+}
+
+void GLStateCache::bind_vertex_array(GLuint vertex_array) {
+    if (vertex_array == vertex_array_) {
+        RenderStats::count_skipped_state_call();
+        return;
+    }
+    glBindVertexArray(vertex_array);
+    vertex_array_ = vertex_array;
+}
+
+void GLStateCache::active_texture(GLuint unit) {
+    if (unit == active_unit_) {
+        RenderStats::count_skipped_state_call();
+        return;
+    }
+    glActiveTexture(GL_TEXTURE0 + unit);
+    active_unit_ = unit;
+}
+
+void GLStateCache::bind_texture_unit(GLuint unit, GLenum target, GLuint texture) {
+    int target_index = get_target_index(target);
+    if (unit < MAX_TEXTURE_UNITS && target_index >= 0 && texture_units_[unit].bound[target_index] == texture) {
+        RenderStats::count_skipped_state_call();
+        return;
+    }
+    active_texture(unit);
+    RenderStats::bind_texture(target, texture);
+    if (unit < MAX_TEXTURE_UNITS && target_index >= 0) {
+        texture_units_[unit].bound[target_index] = texture;
+        texture_units_[unit].range_bound = UNKNOWN;
+    }
+}
+
+void GLStateCache::bind_texture(GLenum target, GLuint texture) {
+    int target_index = get_target_index(target);
+    bool tracked = active_unit_ < MAX_TEXTURE_UNITS && target_index >= 0;
+    if (tracked && texture_units_[active_unit_].bound[target_index] == texture) {
+        RenderStats::count_skipped_state_call();
+        return;
+    }
+    glBindTexture(target, texture);
+    if (tracked) {
+        texture_units_[active_unit_].bound[target_index] = texture;
+        texture_units_[active_unit_].range_bound = UNKNOWN;
+    } else if (active_unit_ == UNKNOWN) {
+        // Landed on a unit the cache does not know; none of them can be trusted for this target
+        for (TextureUnitState& unit : texture_units_) {
+            if (target_index >= 0) {
+                unit.bound[target_index] = UNKNOWN;
+            }
+            unit.range_bound = UNKNOWN;
+        }
+    }
+}
+
+void GLStateCache::bind_textures(GLuint first, GLsizei count, const GLuint* textures) {
+    bool unchanged = first + static_cast<GLuint>(count) <= MAX_TEXTURE_UNITS;
+    for (GLsizei i = 0; unchanged && i < count; ++i) {
+        unchanged = texture_units_[first + i].range_bound == textures[i];
+    }
+    if (unchanged) {
+        RenderStats::count_skipped_state_call();
+        return;
+    }
+
+    RenderStats::bind_textures(first, count, textures);
+    for (GLsizei i = 0; i < count && first + i < MAX_TEXTURE_UNITS; ++i) {
+        TextureUnitState& unit = texture_units_[first + i];
+        // A non-zero id lands on its own target, which the cache cannot tell from the id
+        unit.bound.fill(textures[i] == 0 ? 0 : UNKNOWN);
+        unit.range_bound = textures[i];
+    }
+}
+
+void GLStateCache::bind_framebuffer(GLenum target, GLuint framebuffer) {
+    bool draw = target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER;
+    bool read = target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER;
+    if ((!draw || draw_framebuffer_ == framebuffer) && (!read || read_framebuffer_ == framebuffer)) {
+        RenderStats::count_skipped_state_call();
+        return;
+    }
+    RenderStats::bind_framebuffer(target, framebuffer);
+    if (draw) {
+        draw_framebuffer_ = framebuffer;
+    }
+    if (read) {
+        read_framebuffer_ = framebuffer;
+    }
+}
+
+void GLStateCache::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    std::array<GLint, 4> viewport = { x, y, width, height };
+    if (viewport_known_ && viewport == viewport_) {
+        RenderStats::count_skipped_state_call();
+        return;
+    }
+    glViewport(x, y, width, height);
+    viewport_ = viewport;
+    viewport_known_ = true;
+}
+
+void GLStateCache::set_enabled(GLenum capability, bool enabled) {
+    int index = get_capability_index(capability);
+    int8_t state = enabled ? 1 : 0;
+    if (index >= 0 && capabilities_[index] == state) {
+        RenderStats::count_skipped_state_call();
+        return;
+    }
+    if (enabled) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+    if (index >= 0) {
+        capabilities_[index] = state;
+    }
+}
+
+void GLStateCache::forget_program(GLuint program) {
+    // A deleted program stays in use until another is, but its name can come back from glCreateProgram
+    if (program_ == program) {
+        program_ = UNKNOWN;
+    }
+}
+
+void GLStateCache::forget_vertex_array(GLuint vertex_array) {
+    if (vertex_array_ == vertex_array) {
+        vertex_array_ = 0;
+    }
+}
+
+void GLStateCache::forget_texture(GLuint texture) {
+    for (TextureUnitState& unit : texture_units_) {
+        for (GLuint& bound : unit.bound) {
+            if (bound == texture) {
+                bound = 0;
+            }
+        }
+        if (unit.range_bound == texture) {
+            unit.bound.fill(UNKNOWN);
+            unit.range_bound = UNKNOWN;
+        }
+    }
+}
+
+void GLStateCache::forget_framebuffer(GLuint framebuffer) {
+    if (draw_framebuffer_ == framebuffer) {
+        draw_framebuffer_ = 0;
+    }
+    if (read_framebuffer_ == framebuffer) {
+        read_framebuffer_ = 0;
+    }
+}
+
+int GLStateCache::get_target_index(GLenum target) {
+    switch (target) {
+        case GL_TEXTURE_2D: return 0;
+        case GL_TEXTURE_CUBE_MAP: return 1;
+        case GL_TEXTURE_2D_ARRAY: return 2;
+        default: return -1;
+    }
+}
+
+int GLStateCache::get_capability_index(GLenum capability) {
+    switch (capability) {
+        case GL_DEPTH_TEST: return 0;
+        case GL_CULL_FACE: return 1;
+        case GL_BLEND: return 2;
+        case GL_FRAMEBUFFER_SRGB: return 3;
+        case GL_SCISSOR_TEST: return 4;
+        case GL_STENCIL_TEST: return 5;
+        default: return -1;
+    }
+}
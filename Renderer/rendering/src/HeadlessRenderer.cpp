@@ -0,0 +1,214 @@
+#include "HeadlessRenderer.h"
+#include "HeadlessContext.h"
+#include "Renderer.h"
+#include "RenderStats.h"
+#include "Camera.h"
+#include "Scene.h"
+#include "Renderable.h"
+#include "Transform.h"
+#include <CoroutineResourceManager.h>
+#include <CoroutineThreadPoolScheduler.h>
+#include <TransformManager.h>
+#include <STBImage.h>
+#include <Logger.h>
+#include <MemoryTracker.h>
+#include <Profiler.h>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+
+HeadlessRenderer::HeadlessRenderer()
+    : width_(0), height_(0), frame_index_(0)
+{
+}
+
+HeadlessRenderer::~HeadlessRenderer() {
+    shutdown();
+}
+
+bool HeadlessRenderer::initialize(int width, int height) {
+    width_ = width;
+    height_ = height;
+
+    context_ = std::make_unique<HeadlessContext>();
+    if (!context_->initialize()) {
+        context_.reset();
+        return false;
+    }
+
+    try {
+        renderer_ = std::make_unique<glRenderer::Renderer>(width_, height_);
+        renderer_->initialize(&HeadlessContext::get_proc_address);
+        renderer_->set_render_to_framebuffer(true);
+
+        resource_manager_ = std::make_unique<CoroutineResourceManager>();
+        scene_ = resource_manager_->create_simple_scene();
+        camera_ = std::make_shared<Camera>();
+        transform_manager_ = std::make_unique<TransformManager>();
+
+        renderer_->set_deferred_rendering(true);
+        renderer_->set_ssgi_enabled(true);
+    } catch (const std::exception& e) {
+        LOG_ERROR("HeadlessRenderer: Initialization failed: {}", e.what());
+        shutdown();
+        return false;
+    }
+
+    readback_ = std::make_unique<AsyncReadback>();
+    LOG_INFO("HeadlessRenderer: Rendering {}x{} offscreen", width_, height_);
+    return true;
+}
+
+void HeadlessRenderer::render_frame() {
+    PROFILE_SCOPE("Headless frame");
+    Async::CoroutineThreadPoolScheduler::get_instance().process_main_thread_coroutines();
+
+    camera_->set_projection_jitter(renderer_->get_projection_jitter());
+    renderer_->render_deferred(*scene_, *camera_, *resource_manager_, *transform_manager_);
+    RenderStats::end_frame();
+    MemoryTracker::get_instance().check_budgets();
+    ++frame_index_;
+    PROFILE_FRAME_MARK();
+}
+
+bool HeadlessRenderer::request_capture(uint64_t tag) {
+    return readback_->request(renderer_->get_framebuffer(), renderer_->get_viewport_width(), renderer_->get_viewport_height(), tag);
+}
+
+int HeadlessRenderer::run(const Options& options) {
+    if (!initialize(options.width, options.height)) {
+        return 1;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(options.output_directory, error);
+    if (error) {
+        LOG_ERROR("HeadlessRenderer: Cannot create '{}': {}", options.output_directory, error.message());
+        return 1;
+    }
+
+    bool ok = true;
+    AsyncReadback::Image image;
+    for (int frame = 0; frame < options.frames; ++frame) {
+        render_frame();
+
+        bool last = frame + 1 == options.frames;
+        bool interval = options.capture_interval > 0 && (frame + 1) % options.capture_interval == 0;
+        if (last || interval) {
+            // A full ring means the GPU is behind; drain the oldest capture rather than drop this one
+            while (!request_capture(frame_index_)) {
+                if (!fetch_capture(image)) {
+                    break;
+                }
+                ok = save_capture(image, options.output_directory) && ok;
+            }
+        }
+        while (try_fetch_capture(image)) {
+            ok = save_capture(image, options.output_directory) && ok;
+        }
+    }
+    while (fetch_capture(image)) {
+        ok = save_capture(image, options.output_directory) && ok;
+    }
+
+    if (options.export_pass_timings) {
+        std::string path = (std::filesystem::path(options.output_directory) / "pass_timings.csv").string();
+        ok = renderer_->export_pass_timings_csv(path) && ok;
+    }
+
+    LOG_INFO("HeadlessRenderer: Rendered {} frames", frame_index_);
+    return ok ? 0 : 1;
+}
+
+bool HeadlessRenderer::save_capture(const AsyncReadback::Image& image, const std::string& directory) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "frame_%05llu.png", static_cast<unsigned long long>(image.tag));
+    return write_png((std::filesystem::path(directory) / name).string(), image);
+}
+
+bool HeadlessRenderer::write_png(const std::string& path, const AsyncReadback::Image& image) {
+    if (!glRenderer::STBImage::write_image(path.c_str(), image.width, image.height, 4, image.pixels.data())) {
+        LOG_ERROR("HeadlessRenderer: Failed to write '{}'", path);
+        return false;
+    }
+    LOG_INFO("HeadlessRenderer: Wrote '{}'", path);
+    return true;
+}
+
+bool HeadlessRenderer::add_model(const std::string& path, const std::string& name, const Transform& transform) {
+    auto task = resource_manager_->load_model_with_textures_async(path, nullptr, Async::TaskPriority::k_high);
+
+    // The loader finishes on the main thread, so keep draining its coroutines while waiting
+    auto& scheduler = Async::CoroutineThreadPoolScheduler::get_instance();
+    while (!task.is_ready()) {
+        if (scheduler.process_main_thread_coroutines() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    std::optional<LoadedModelData> model_data;
+    try {
+        model_data = task.try_get();
+    } catch (const std::exception& e) {
+        LOG_ERROR("HeadlessRenderer: Failed to load '{}': {}", path, e.what());
+        return false;
+    }
+    if (!model_data.has_value() || model_data->meshes.empty()) {
+        LOG_ERROR("HeadlessRenderer: '{}' contains no meshes", path);
+        return false;
+    }
+
+    // Non-const: the vertex and index arrays are moved into the meshes
+    LoadedModelData& data = model_data.value();
+    resource_manager_->load_model_textures(data.texture_paths);
+
+    auto renderable = std::make_shared<Renderable>(name);
+    std::chrono::steady_clock::duration mesh_upload_time{};
+    for (size_t i = 0; i < data.meshes.size(); ++i) {
+        auto& mesh_data = data.meshes[i];
+        auto mesh = std::make_shared<Mesh>(std::move(mesh_data.vertices), std::move(mesh_data.indices));
+        auto upload_start = std::chrono::steady_clock::now();
+        mesh->ensure_setup();
+        mesh_upload_time += std::chrono::steady_clock::now() - upload_start;
+        resource_manager_->store_mesh_in_cache(name + "_mesh_" + std::to_string(i), mesh);
+
+        std::shared_ptr<Material> material;
+        if (mesh_data.material_index < data.materials.size()) {
+            material = std::make_shared<Material>(data.materials[mesh_data.material_index]);
+            resource_manager_->store_material_in_cache(name + "_material_" + std::to_string(mesh_data.material_index), material);
+        } else {
+            material = std::make_shared<Material>(Material::create_pbr_default());
+            resource_manager_->store_material_in_cache(name + "_default_material_" + std::to_string(i), material);
+        }
+
+        std::string model_id = name + "_model_" + std::to_string(i);
+        resource_manager_->store_model_in_cache(model_id, std::make_shared<Model>(mesh.get(), material.get()));
+        renderable->add_model(model_id);
+    }
+
+    resource_manager_->add_upload_time(path, std::chrono::duration<double, std::milli>(mesh_upload_time).count());
+
+    resource_manager_->store_renderable_in_cache(name, renderable);
+    scene_->add_renderable_reference(name);
+    transform_manager_->set_transform(name, transform);
+
+    LOG_INFO("HeadlessRenderer: Added '{}' with {} meshes", name, data.meshes.size());
+    return true;
+}
+
+void HeadlessRenderer::shutdown() {
+    if (!context_) {
+        return;
+    }
+
+    // GL objects go before the context that owns them
+    readback_.reset();
+    transform_manager_.reset();
+    scene_.reset();
+    resource_manager_.reset();
+    renderer_.reset();
+    camera_.reset();
+    context_.reset();
+}
@@ -1,5 +1,7 @@
 #include "Light.h"
 #include "Shader.h"
+#include "RenderStats.h"
+#include "GLStateCache.h"
 #include <memory>
 #include <iostream>
 #include <string>
@@ -130,16 +132,16 @@ void Light::setup_light_mesh() {
     glGenVertexArrays(1, &light_vao);
     glGenBuffers(1, &light_vbo);
 
-    glBindVertexArray(light_vao);
+    GLStateCache::bind_vertex_array(light_vao);
 
     glBindBuffer(GL_ARRAY_BUFFER, light_vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    RenderStats::buffer_data(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
     // Position attribute
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
 
-    glBindVertexArray(0);
+    GLStateCache::bind_vertex_array(0);
     
     mesh_initialized = true;
     std::cout << "Light mesh initialized with VAO: " << light_vao << std::endl;
@@ -151,9 +153,8 @@ void Light::render() const {
         return;
     }
 
-    glBindVertexArray(light_vao);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
-    glBindVertexArray(0);
+    GLStateCache::bind_vertex_array(light_vao);
+    RenderStats::draw_arrays(GL_TRIANGLES, 0, 36);
 }
 
 void Light::set_shader(const Shader& shader) const {
@@ -2,9 +2,20 @@
 #include "Shader.h"
 #include "CoroutineResourceManager.h"
 #include "Texture.h"
+#include "GLStateCache.h"
+#include <Logger.h>
 #include <glad/glad.h>
+#include <atomic>
 #include <unordered_set>
 
+namespace {
+
+// Revisions are drawn from one counter so a material at the address of a destroyed one never
+// repeats its revision
+std::atomic<uint64_t> g_binding_block_revision{0};
+
+} // namespace
+
 Material::Material() 
     : ambient(0.1f, 0.1f, 0.1f)
     , diffuse(0.7f, 0.7f, 0.7f)
@@ -72,6 +83,7 @@ Material Material::create_stone() {
 
 // Legacy texture methods
 void Material::set_diffuse_texture(const std::string& texturePath) {
+    invalidate_binding_block();
     diffuseTexturePath = texturePath;
     if (!texturePath.empty()) {
         namedTexturePaths["diffuse"] = texturePath;
@@ -81,6 +93,7 @@ void Material::set_diffuse_texture(const std::string& texturePath) {
 }
 
 void Material::set_specular_texture(const std::string& texturePath) {
+    invalidate_binding_block();
     specularTexturePath = texturePath;
     if (!texturePath.empty()) {
         namedTexturePaths["specular"] = texturePath;
@@ -90,6 +103,7 @@ void Material::set_specular_texture(const std::string& texturePath) {
 }
 
 void Material::set_normal_texture(const std::string& texturePath) {
+    invalidate_binding_block();
     normalTexturePath = texturePath;
     if (!texturePath.empty()) {
         namedTexturePaths["normal"] = texturePath;
@@ -99,6 +113,7 @@ void Material::set_normal_texture(const std::string& texturePath) {
 }
 
 void Material::set_emissive_texture(const std::string& texturePath) {
+    invalidate_binding_block();
     emissiveTexturePath = texturePath;
     if (!texturePath.empty()) {
         namedTexturePaths["emissive"] = texturePath;
@@ -125,6 +140,7 @@ bool Material::has_emissive_texture() const {
 
 // Enhanced texture management with named slots
 void Material::add_texture(const std::string& name, const std::string& texturePath) {
+    invalidate_binding_block();
     if (!texturePath.empty()) {
         namedTexturePaths[name] = texturePath;
         
@@ -158,6 +174,7 @@ void Material::add_texture(const std::string& name, const std::string& texturePa
 }
 
 void Material::remove_texture(const std::string& name) {
+    invalidate_binding_block();
     auto it = namedTexturePaths.find(name);
     if (it != namedTexturePaths.end()) {
         namedTexturePaths.erase(it);
@@ -223,6 +240,7 @@ const std::string& Material::get_texture_path(const std::string& name) const {
 }
 
 void Material::clear_all_textures() {
+    invalidate_binding_block();
     namedTexturePaths.clear();
     
     // Clear legacy texture paths
@@ -258,6 +276,7 @@ void Material::syncLegacyTextures() {
 
 // PBR texture methods (using texture paths)
 void Material::set_albedo_texture(const std::string& texturePath) {
+    invalidate_binding_block();
     albedoTexturePath = texturePath;
     if (!texturePath.empty()) {
         namedTexturePaths["albedo"] = texturePath;
@@ -267,6 +286,7 @@ void Material::set_albedo_texture(const std::string& texturePath) {
 }
 
 void Material::set_metallic_texture(const std::string& texturePath) {
+    invalidate_binding_block();
     metallicTexturePath = texturePath;
     if (!texturePath.empty()) {
         namedTexturePaths["metallic"] = texturePath;
@@ -276,6 +296,7 @@ void Material::set_metallic_texture(const std::string& texturePath) {
 }
 
 void Material::set_roughness_texture(const std::string& texturePath) {
+    invalidate_binding_block();
     roughnessTexturePath = texturePath;
     if (!texturePath.empty()) {
         namedTexturePaths["roughness"] = texturePath;
@@ -285,6 +306,7 @@ void Material::set_roughness_texture(const std::string& texturePath) {
 }
 
 void Material::set_ao_texture(const std::string& texturePath) {
+    invalidate_binding_block();
     aoTexturePath = texturePath;
     if (!texturePath.empty()) {
         namedTexturePaths["ao"] = texturePath;
@@ -294,6 +316,7 @@ void Material::set_ao_texture(const std::string& texturePath) {
 }
 
 void Material::set_height_texture(const std::string& texturePath) {
+    invalidate_binding_block();
     heightTexturePath = texturePath;
     if (!texturePath.empty()) {
         namedTexturePaths["height"] = texturePath;
@@ -303,6 +326,7 @@ void Material::set_height_texture(const std::string& texturePath) {
 }
 
 void Material::set_metallic_roughness_texture(const std::string& texturePath) {
+    invalidate_binding_block();
     metallicRoughnessTexturePath = texturePath;
     if (!texturePath.empty()) {
         namedTexturePaths["metallic_roughness"] = texturePath;
@@ -522,4 +546,73 @@ void Material::bind_textures_auto(const Shader& shader, const CoroutineResourceM
     }
 }
 
- 
\ No newline at end of file
+ 
+
+void Material::compile_binding_block(const CoroutineResourceManager& resource_manager) const {
+    // Texture per unit, by the same names bind_textures_auto() uses; the albedo unit falls back to
+    // the PBR albedo path for materials that only set that one
+    const std::string* paths[TEXTURE_UNIT_COUNT] = {
+        !diffuseTexturePath.empty() ? &diffuseTexturePath : &albedoTexturePath,
+        &normalTexturePath,
+        &metallicTexturePath,
+        &roughnessTexturePath,
+        &aoTexturePath,
+        &emissiveTexturePath,
+    };
+
+    BindingBlock& block = bindingBlock;
+    block.unresolved = false;
+    // Read before the lookups, so a texture added while they run triggers another retry
+    block.texture_generation = resource_manager.get_texture_generation();
+    GLuint texture_mask = 0;
+    GLuint array_mask = 0;
+    for (GLuint unit = 0; unit < TEXTURE_UNIT_COUNT; ++unit) {
+        block.textures[unit].reset();
+        block.texture_ids[unit] = 0;
+        block.texture_layers[unit] = 0;
+        const std::string& path = *paths[unit];
+        if (path.empty()) {
+            continue;
+        }
+        if (auto texture = resource_manager.get<Texture>(path)) {
+            block.texture_ids[unit] = texture->get_id();
+            block.textures[unit] = std::move(texture);
+            texture_mask |= 1u << unit;
+            continue;
+        }
+        if (auto layer = resource_manager.get_texture_layer(path)) {
+            if (layer->array_index >= MAX_TEXTURE_ARRAYS) {
+                LOG_WARN("Material: Texture {} is in texture array {}, only {} can be bound", path, layer->array_index, MAX_TEXTURE_ARRAYS);
+                continue;
+            }
+            block.texture_layers[unit] = (layer->array_index << 16) | layer->layer;
+            texture_mask |= 1u << unit;
+            array_mask |= 1u << unit;
+            continue;
+        }
+        block.unresolved = true;
+    }
+
+    // A retry that resolved nothing new keeps the revision, so MaterialTable leaves the record alone
+    if (!block.dirty && texture_mask == block.texture_mask && array_mask == block.array_mask) {
+        return;
+    }
+    block.texture_mask = texture_mask;
+    block.array_mask = array_mask;
+    block.revision = ++g_binding_block_revision;
+    block.dirty = false;
+}
+
+void Material::update_binding_block(const CoroutineResourceManager& resource_manager) const {
+    // A path that did not resolve may be loading or may have failed; either way the lookups can
+    // only succeed once a texture was added to the cache
+    if (bindingBlock.dirty ||
+        (bindingBlock.unresolved && bindingBlock.texture_generation != resource_manager.get_texture_generation())) {
+        compile_binding_block(resource_manager);
+    }
+}
+
+void Material::bind_block(const CoroutineResourceManager& resource_manager) const {
+    update_binding_block(resource_manager);
+    GLStateCache::bind_textures(ALBEDO_UNIT, TEXTURE_UNIT_COUNT, bindingBlock.texture_ids.data());
+}
@@ -0,0 +1,130 @@
+#include "MaterialTable.h"
+#include "Material.h"
+#include "RenderStats.h"
+#include "MemoryTracker.h"
+#include <Logger.h>
+
+#include <algorithm>
+
+MaterialTable::MaterialTable()
+    : count_(0), dirty_begin_(0), dirty_end_(0), buffer_(0), capacity_(0)
+{
+}
+
+MaterialTable::~MaterialTable() {
+    cleanup();
+}
+
+void MaterialTable::begin_frame() {
+    indices_.clear();
+    count_ = 0;
+    dirty_begin_ = 0;
+    dirty_end_ = 0;
+}
+
+uint32_t MaterialTable::add(const Material& material, const CoroutineResourceManager& resource_manager) {
+    auto [it, inserted] = indices_.try_emplace(&material, static_cast<uint32_t>(count_));
+    if (!inserted) {
+        return it->second;
+    }
+
+    size_t index = count_++;
+    if (index == slots_.size()) {
+        slots_.emplace_back();
+        records_.emplace_back();
+    }
+
+    // Resolves textures still loading; a change shows up as a new revision
+    material.update_binding_block(resource_manager);
+
+    Slot& slot = slots_[index];
+    if (slot.material == &material && slot.revision == material.get_revision()) {
+        return it->second;
+    }
+    slot.material = &material;
+    slot.revision = material.get_revision();
+
+    Record& record = records_[index];
+    record.ambient = glm::vec4(material.get_ambient(), 0.0f);
+    record.diffuse = glm::vec4(material.get_diffuse(), 0.0f);
+    record.specular_shininess = glm::vec4(material.get_specular(), material.get_shininess());
+    record.emissive = glm::vec4(material.get_emissive(), 0.0f);
+    record.params = glm::vec4(material.get_metallic(), material.get_roughness(), material.get_ao(), material.get_height_scale());
+    record.flags = glm::uvec4(material.get_texture_mask(), material.get_array_mask(), material.is_pbr_enabled() ? 1u : 0u, 0u);
+    const auto& layers = material.get_texture_layers();
+    record.texture_layers[0] = glm::uvec4(layers[0], layers[1], layers[2], layers[3]);
+    record.texture_layers[1] = glm::uvec4(layers[4], layers[5], 0u, 0u);
+
+    if (dirty_begin_ == dirty_end_) {
+        dirty_begin_ = index;
+    }
+    dirty_begin_ = std::min(dirty_begin_, index);
+    dirty_end_ = std::max(dirty_end_, index + 1);
+    return it->second;
+}
+
+void MaterialTable::ensure_capacity(size_t count) {
+    if (count <= capacity_ && buffer_ != 0) {
+        return;
+    }
+
+    size_t new_capacity = std::max<size_t>(std::max<size_t>(count, capacity_ * 2), 64);
+
+    if (buffer_ == 0) {
+        glGenBuffers(1, &buffer_);
+    }
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer_);
+    RenderStats::buffer_data(GL_SHADER_STORAGE_BUFFER, new_capacity * sizeof(Record), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    size_t old_bytes = get_gpu_bytes();
+    capacity_ = new_capacity;
+    MemoryTracker::get_instance().resize(MemoryCategory::k_gpu_buffers, old_bytes, get_gpu_bytes());
+    LOG_DEBUG("MaterialTable: Record buffer resized to {} materials", capacity_);
+
+    // The new store holds nothing yet
+    dirty_begin_ = 0;
+    dirty_end_ = count_;
+}
+
+void MaterialTable::upload() {
+    if (count_ == 0) {
+        return;
+    }
+
+    ensure_capacity(count_);
+    if (dirty_begin_ == dirty_end_) {
+        return;
+    }
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer_);
+    RenderStats::buffer_sub_data(GL_SHADER_STORAGE_BUFFER,
+                                 static_cast<GLintptr>(dirty_begin_ * sizeof(Record)),
+                                 static_cast<GLsizeiptr>((dirty_end_ - dirty_begin_) * sizeof(Record)),
+                                 records_.data() + dirty_begin_);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    dirty_begin_ = 0;
+    dirty_end_ = 0;
+}
+
+void MaterialTable::bind() const {
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BINDING, buffer_);
+}
+
+void MaterialTable::unbind() const {
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BINDING, 0);
+}
+
+void MaterialTable::cleanup() {
+    if (buffer_ != 0) {
+        glDeleteBuffers(1, &buffer_);
+        buffer_ = 0;
+    }
+    MemoryTracker::get_instance().release(MemoryCategory::k_gpu_buffers, get_gpu_bytes());
+    capacity_ = 0;
+    slots_.clear();
+    records_.clear();
+    indices_.clear();
+    count_ = 0;
+}
@@ -1,17 +1,36 @@
 #include "Mesh.h"
+#include "RenderStats.h"
+#include "GLStateCache.h"
 #include "Logger.h"
+#include "MemoryTracker.h"
 
-Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
-    : vertices(vertices), indices(indices), vao_(0), vbo_(0), ebo_(0), gl_initialized_(false) {
-   
+#include <utility>
+
+Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, Retention retention)
+    : vertices(std::move(vertices)), indices(std::move(indices)), vertex_count_(this->vertices.size()),
+      index_count_(this->indices.size()), retention_(retention), vao_(0), vbo_(0), ebo_(0), gl_initialized_(false) {
+    if (!this->vertices.empty()) {
+        bounds_min_ = this->vertices[0].position;
+        bounds_max_ = this->vertices[0].position;
+        for (const auto& vertex : this->vertices) {
+            bounds_min_ = glm::min(bounds_min_, vertex.position);
+            bounds_max_ = glm::max(bounds_max_, vertex.position);
+        }
+    }
+
+    cpu_bytes_ = this->vertices.capacity() * sizeof(Vertex) + this->indices.capacity() * sizeof(unsigned int);
+    MemoryTracker::get_instance().allocate(MemoryCategory::k_mesh_cpu, cpu_bytes_);
 }
 
 Mesh::~Mesh() {
     if (gl_initialized_) {
+        GLStateCache::forget_vertex_array(vao_);
         glDeleteVertexArrays(1, &vao_);
         glDeleteBuffers(1, &vbo_);
         glDeleteBuffers(1, &ebo_);
     }
+    MemoryTracker::get_instance().release(MemoryCategory::k_mesh_gpu, gpu_bytes_);
+    MemoryTracker::get_instance().release(MemoryCategory::k_mesh_cpu, cpu_bytes_);
 }
 
 void Mesh::setup_mesh() {
@@ -24,13 +43,13 @@ void Mesh::setup_mesh() {
     glGenBuffers(1, &vbo_);
     glGenBuffers(1, &ebo_);
 
-    glBindVertexArray(vao_);
+    GLStateCache::bind_vertex_array(vao_);
 
     glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
+    RenderStats::buffer_data(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), &indices[0], GL_STATIC_DRAW);
+    RenderStats::buffer_data(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), &indices[0], GL_STATIC_DRAW);
 
     // Vertex positions
     glEnableVertexAttribArray(0);
@@ -48,10 +67,46 @@ void Mesh::setup_mesh() {
     glEnableVertexAttribArray(3);
     glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, tangent));
 
-    glBindVertexArray(0);
+    GLStateCache::bind_vertex_array(0);
     
     gl_initialized_ = true;
 
+    gpu_bytes_ = vertices.size() * sizeof(Vertex) + indices.size() * sizeof(GLuint);
+    MemoryTracker::get_instance().allocate(MemoryCategory::k_mesh_gpu, gpu_bytes_);
+
+    release_cpu_data();
+
+}
+
+void Mesh::set_retention(Retention retention) {
+    if (gl_initialized_ && retention < retention_) {
+        LOG_WARN("Mesh::set_retention() - CPU data already released, keeping the current retention");
+        return;
+    }
+    retention_ = retention;
+    if (gl_initialized_) {
+        release_cpu_data();
+    }
+}
+
+void Mesh::release_cpu_data() {
+    if (retention_ == Retention::All) {
+        return;
+    }
+    if (retention_ == Retention::Positions && !vertices.empty()) {
+        positions_.reserve(vertices.size());
+        for (const auto& vertex : vertices) {
+            positions_.push_back(vertex.position);
+        }
+    } else if (retention_ == Retention::None) {
+        std::vector<glm::vec3>().swap(positions_);
+        std::vector<unsigned int>().swap(indices);
+    }
+    std::vector<Vertex>().swap(vertices);
+
+    size_t cpu_bytes = positions_.capacity() * sizeof(glm::vec3) + indices.capacity() * sizeof(unsigned int);
+    MemoryTracker::get_instance().resize(MemoryCategory::k_mesh_cpu, cpu_bytes_, cpu_bytes);
+    cpu_bytes_ = cpu_bytes;
 }
 
 void Mesh::ensure_setup() const {
@@ -62,8 +117,14 @@ void Mesh::ensure_setup() const {
 
 void Mesh::draw() const {
     ensure_setup();
-    glBindVertexArray(vao_);
-    glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
+    // Left bound: every draw binds its own vertex array, so unbinding would only cost a call
+    GLStateCache::bind_vertex_array(vao_);
+    RenderStats::draw_elements(GL_TRIANGLES, static_cast<GLsizei>(index_count_), GL_UNSIGNED_INT, 0);
+}
+
+void Mesh::draw_indirect(GLintptr command_offset) const {
+    ensure_setup();
+    GLStateCache::bind_vertex_array(vao_);
+    RenderStats::draw_elements_indirect(GL_TRIANGLES, GL_UNSIGNED_INT, reinterpret_cast<const void*>(command_offset), static_cast<GLsizei>(index_count_));
 } 
 
@@ -0,0 +1,142 @@
+#include "OcclusionCuller.h"
+#include "Shader.h"
+#include "Texture.h"
+#include "RenderStats.h"
+#include "MemoryTracker.h"
+#include <Logger.h>
+
+#include <algorithm>
+#include <limits>
+
+OcclusionCuller::OcclusionCuller()
+    : bounds_buffer_(0), command_buffer_(0), visibility_buffer_(0), capacity_(0)
+{
+}
+
+OcclusionCuller::~OcclusionCuller() {
+    cleanup();
+}
+
+void OcclusionCuller::begin_frame() {
+    bounds_.clear();
+    commands_.clear();
+}
+
+uint32_t OcclusionCuller::add_draw_item(const glm::vec3& bounds_min, const glm::vec3& bounds_max, const glm::mat4& model_matrix,
+                                       GLuint index_count, GLuint base_instance) {
+    // Transform the object-space box and take the world-space box around it
+    glm::vec3 world_min(std::numeric_limits<float>::max());
+    glm::vec3 world_max(std::numeric_limits<float>::lowest());
+    for (int i = 0; i < 8; ++i) {
+        glm::vec3 corner((i & 1) ? bounds_max.x : bounds_min.x,
+                         (i & 2) ? bounds_max.y : bounds_min.y,
+                         (i & 4) ? bounds_max.z : bounds_min.z);
+        glm::vec3 world_corner = glm::vec3(model_matrix * glm::vec4(corner, 1.0f));
+        world_min = glm::min(world_min, world_corner);
+        world_max = glm::max(world_max, world_corner);
+    }
+
+    bounds_.push_back({ glm::vec4(world_min, 1.0f), glm::vec4(world_max, 1.0f) });
+    commands_.push_back({ index_count, 1, 0, 0, base_instance });
+    return static_cast<uint32_t>(commands_.size() - 1);
+}
+
+void OcclusionCuller::ensure_capacity(size_t count) {
+    if (count <= capacity_ && command_buffer_ != 0) {
+        return;
+    }
+
+    size_t new_capacity = std::max<size_t>(std::max<size_t>(count, capacity_ * 2), 64);
+
+    if (bounds_buffer_ == 0) {
+        glGenBuffers(1, &bounds_buffer_);
+        glGenBuffers(1, &command_buffer_);
+        glGenBuffers(1, &visibility_buffer_);
+    }
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, bounds_buffer_);
+    RenderStats::buffer_data(GL_SHADER_STORAGE_BUFFER, new_capacity * sizeof(DrawBounds), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, command_buffer_);
+    RenderStats::buffer_data(GL_SHADER_STORAGE_BUFFER, new_capacity * sizeof(DrawCommand), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, visibility_buffer_);
+    RenderStats::buffer_data(GL_SHADER_STORAGE_BUFFER, new_capacity * sizeof(GLuint), nullptr, GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    size_t old_bytes = get_gpu_bytes();
+    capacity_ = new_capacity;
+    MemoryTracker::get_instance().resize(MemoryCategory::k_gpu_buffers, old_bytes, get_gpu_bytes());
+    LOG_DEBUG("OcclusionCuller: Draw item buffers resized to {} items", capacity_);
+}
+
+void OcclusionCuller::upload(bool visible_by_default) {
+    if (commands_.empty()) {
+        return;
+    }
+
+    ensure_capacity(commands_.size());
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, bounds_buffer_);
+    RenderStats::buffer_sub_data(GL_SHADER_STORAGE_BUFFER, 0, bounds_.size() * sizeof(DrawBounds), bounds_.data());
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, command_buffer_);
+    RenderStats::buffer_sub_data(GL_SHADER_STORAGE_BUFFER, 0, commands_.size() * sizeof(DrawCommand), commands_.data());
+
+    GLuint visibility = visible_by_default ? 1u : 0u;
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, visibility_buffer_);
+    glClearBufferSubData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, 0, commands_.size() * sizeof(GLuint),
+                         GL_RED_INTEGER, GL_UNSIGNED_INT, &visibility);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void OcclusionCuller::cull(Phase phase, const Shader& cull_shader, const glm::mat4& view_projection,
+                           GLuint hiz_texture, int hiz_width, int hiz_height, int hiz_mip_levels) {
+    if (commands_.empty() || hiz_texture == 0) {
+        return;
+    }
+
+    cull_shader.use();
+
+    Texture::reset_slot_counter();
+    unsigned int hiz_slot = Texture::bind_raw_texture(hiz_texture, GL_TEXTURE_2D);
+    if (hiz_slot != Texture::INVALID_SLOT) cull_shader.set_int("hizTexture", hiz_slot);
+
+    cull_shader.set_vec2("hizSize", glm::vec2(hiz_width, hiz_height));
+    cull_shader.set_int("hizMipLevels", hiz_mip_levels);
+    cull_shader.set_mat4("viewProjection", view_projection);
+    cull_shader.set_int("phase", phase == Phase::Early ? 0 : 1);
+    cull_shader.set_int("drawCount", static_cast<int>(commands_.size()));
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, bounds_buffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, command_buffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, visibility_buffer_);
+
+    RenderStats::dispatch_compute(static_cast<GLuint>((commands_.size() + 63) / 64), 1, 1);
+
+    // Commands are consumed by indirect draws
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, 0);
+}
+
+void OcclusionCuller::bind_commands() const {
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, command_buffer_);
+}
+
+void OcclusionCuller::unbind_commands() const {
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void OcclusionCuller::cleanup() {
+    if (bounds_buffer_ != 0) {
+        glDeleteBuffers(1, &bounds_buffer_);
+        glDeleteBuffers(1, &command_buffer_);
+        glDeleteBuffers(1, &visibility_buffer_);
+        bounds_buffer_ = 0;
+        command_buffer_ = 0;
+        visibility_buffer_ = 0;
+    }
+    MemoryTracker::get_instance().release(MemoryCategory::k_gpu_buffers, get_gpu_bytes());
+    capacity_ = 0;
+}
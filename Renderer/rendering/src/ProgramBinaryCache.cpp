@@ -0,0 +1,171 @@
+#include "ProgramBinaryCache.h"
+#include "Shader.h"
+#include <Logger.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+// FNV-1a, 64 bit
+constexpr uint64_t kHashOffset = 14695981039346656037ull;
+constexpr uint64_t kHashPrime = 1099511628211ull;
+
+uint64_t hash_bytes(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= kHashPrime;
+    }
+    return hash;
+}
+
+uint64_t hash_string(uint64_t hash, const std::string& text) {
+    // Length first, so ("ab", "c") and ("a", "bc") differ
+    uint64_t size = text.size();
+    hash = hash_bytes(hash, &size, sizeof(size));
+    return hash_bytes(hash, text.data(), text.size());
+}
+
+std::string get_gl_string(GLenum name) {
+    const GLubyte* value = glGetString(name);
+    return value ? reinterpret_cast<const char*>(value) : "";
+}
+
+} // namespace
+
+ProgramBinaryCache::ProgramBinaryCache(std::string directory)
+    : directory_(std::move(directory)), enabled_(true), driver_queried_(false), binaries_supported_(false)
+{
+}
+
+void ProgramBinaryCache::query_driver() {
+    if (driver_queried_) {
+        return;
+    }
+    driver_queried_ = true;
+
+    GLint format_count = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+    binaries_supported_ = format_count > 0;
+    driver_id_ = get_gl_string(GL_VENDOR) + "\n" + get_gl_string(GL_RENDERER) + "\n" + get_gl_string(GL_VERSION);
+
+    if (!binaries_supported_) {
+        LOG_INFO("ProgramBinaryCache: Driver offers no program binary formats, compiling from source");
+    }
+}
+
+uint64_t ProgramBinaryCache::make_key(const std::vector<std::pair<std::string, GLenum>>& stages) {
+    query_driver();
+
+    uint64_t hash = hash_string(kHashOffset, driver_id_);
+    for (const auto& [source, type] : stages) {
+        uint32_t stage_type = type;
+        hash = hash_bytes(hash, &stage_type, sizeof(stage_type));
+        hash = hash_string(hash, source);
+    }
+    return hash;
+}
+
+std::string ProgramBinaryCache::get_entry_path(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(directory_) / (std::string(name) + FILE_EXTENSION)).string();
+}
+
+bool ProgramBinaryCache::load(uint64_t key, Shader& shader) {
+    if (!is_enabled()) {
+        return false;
+    }
+
+    std::string path = get_entry_path(key);
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        ++stats_.misses;
+        return false;
+    }
+
+    FileHeader header{};
+    std::vector<char> binary;
+    bool valid = static_cast<bool>(file.read(reinterpret_cast<char*>(&header), sizeof(header))) &&
+                 header.magic == FILE_MAGIC && header.version == FILE_VERSION && header.key == key &&
+                 header.binary_size > 0;
+    if (valid) {
+        binary.resize(header.binary_size);
+        valid = static_cast<bool>(file.read(binary.data(), static_cast<std::streamsize>(binary.size())));
+    }
+    file.close();
+
+    if (valid && shader.load_binary(header.binary_format, binary.data(), static_cast<GLsizei>(binary.size()))) {
+        ++stats_.hits;
+        return true;
+    }
+
+    // Rebuilt from source and stored again by the caller
+    LOG_WARN("ProgramBinaryCache: Discarding unusable entry '{}'", path);
+    std::error_code error;
+    std::filesystem::remove(path, error);
+    ++stats_.rejected;
+    ++stats_.misses;
+    return false;
+}
+
+void ProgramBinaryCache::store(uint64_t key, const Shader& shader) {
+    if (!is_enabled()) {
+        return;
+    }
+
+    GLenum binary_format = 0;
+    std::vector<char> binary;
+    if (!shader.get_binary(binary_format, binary)) {
+        LOG_WARN("ProgramBinaryCache: Driver returned no binary for program {}", shader.get_id());
+        return;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+    if (error) {
+        LOG_WARN("ProgramBinaryCache: Cannot create '{}': {}", directory_, error.message());
+        return;
+    }
+
+    // Written under a temporary name, so a crash mid-write never leaves a truncated entry behind
+    std::string path = get_entry_path(key);
+    std::string temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        FileHeader header{ FILE_MAGIC, FILE_VERSION, key, binary_format, static_cast<uint32_t>(binary.size()) };
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+        if (!file) {
+            LOG_WARN("ProgramBinaryCache: Failed writing '{}'", temp_path);
+            file.close();
+            std::filesystem::remove(temp_path, error);
+            return;
+        }
+    }
+    std::filesystem::rename(temp_path, path, error);
+    if (error) {
+        LOG_WARN("ProgramBinaryCache: Failed to move '{}' into place: {}", temp_path, error.message());
+        std::filesystem::remove(temp_path, error);
+        return;
+    }
+    ++stats_.stores;
+}
+
+void ProgramBinaryCache::clear() {
+    std::error_code error;
+    std::filesystem::directory_iterator it(directory_, error);
+    if (error) {
+        return;
+    }
+
+    size_t removed = 0;
+    for (const auto& entry : it) {
+        if (entry.is_regular_file(error) && entry.path().extension() == FILE_EXTENSION) {
+            removed += std::filesystem::remove(entry.path(), error) ? 1 : 0;
+        }
+    }
+    LOG_INFO("ProgramBinaryCache: Removed {} entries from '{}'", removed, directory_);
+}
@@ -0,0 +1,453 @@
+#include "RenderGraph.h"
+#include "Texture.h"
+#include <Logger.h>
+#include <Profiler.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+RenderGraph::ResourceHandle RenderGraph::PassBuilder::read(ResourceHandle resource, Access access) {
+    if (!graph_.is_valid(resource)) {
+        return INVALID_RESOURCE;
+    }
+    graph_.passes_[pass_index_].reads.push_back({ resource, access });
+    return resource;
+}
+
+RenderGraph::ResourceHandle RenderGraph::PassBuilder::write(ResourceHandle resource, Access access) {
+    if (!graph_.is_valid(resource)) {
+        return INVALID_RESOURCE;
+    }
+    graph_.passes_[pass_index_].writes.push_back({ resource, access });
+    return resource;
+}
+
+void RenderGraph::PassBuilder::set_side_effect() {
+    graph_.passes_[pass_index_].side_effect = true;
+}
+
+RenderGraph::RenderGraph(RenderTargetPool& pool)
+    : pool_(pool), compiled_(false), culled_pass_count_(0)
+{
+}
+
+RenderGraph::~RenderGraph() {
+    cleanup();
+}
+
+void RenderGraph::reset() {
+    // Transients still held if last frame's execute() returned early
+    for (auto& resource : resources_) {
+        if (!resource.imported && resource.texture) {
+            pool_.release(resource.texture);
+        }
+    }
+    resources_.clear();
+    passes_.clear();
+    execution_order_.clear();
+    compiled_ = false;
+}
+
+RenderGraph::ResourceHandle RenderGraph::import_texture(const std::string& name, GLuint texture, bool is_output) {
+    Resource resource{};
+    resource.name = name;
+    resource.imported = true;
+    resource.is_output = is_output;
+    resource.texture_id = texture;
+    resource.texture = nullptr;
+    resource.first_pass = -1;
+    resource.last_pass = -1;
+    resources_.push_back(resource);
+    return static_cast<ResourceHandle>(resources_.size() - 1);
+}
+
+RenderGraph::ResourceHandle RenderGraph::create_texture(const std::string& name, const RenderTargetPool::Desc& desc) {
+    Resource resource{};
+    resource.name = name;
+    resource.imported = false;
+    resource.is_output = false;
+    resource.texture_id = 0;
+    resource.texture = nullptr;
+    resource.desc = desc;
+    resource.first_pass = -1;
+    resource.last_pass = -1;
+    resources_.push_back(resource);
+    return static_cast<ResourceHandle>(resources_.size() - 1);
+}
+
+void RenderGraph::add_pass(const std::string& name, const SetupFunction& setup, ExecuteFunction execute) {
+    Pass pass;
+    pass.name = name;
+    pass.execute = std::move(execute);
+    pass.side_effect = false;
+    pass.culled = false;
+    passes_.push_back(std::move(pass));
+
+    PassBuilder builder(*this, static_cast<int>(passes_.size() - 1));
+    setup(builder);
+}
+
+void RenderGraph::compile() {
+    if (!sort_passes()) {
+        LOG_ERROR("RenderGraph: Dependency cycle between passes, running them in declaration order");
+        execution_order_.clear();
+        for (int i = 0; i < static_cast<int>(passes_.size()); ++i) {
+            execution_order_.push_back(i);
+        }
+    }
+    cull_passes();
+    compute_lifetimes();
+    compiled_ = true;
+}
+
+bool RenderGraph::sort_passes() {
+    const int pass_count = static_cast<int>(passes_.size());
+    std::vector<std::vector<int>> successors(pass_count);
+    std::vector<int> in_degree(pass_count, 0);
+
+    auto add_edge = [&](int from, int to) {
+        if (from == to || std::find(successors[from].begin(), successors[from].end(), to) != successors[from].end()) {
+            return;
+        }
+        successors[from].push_back(to);
+        ++in_degree[to];
+    };
+    auto uses = [](const std::vector<ResourceAccess>& accesses, ResourceHandle resource) {
+        return std::any_of(accesses.begin(), accesses.end(), [&](const ResourceAccess& access) {
+            return access.resource == resource;
+        });
+    };
+
+    // Readers follow the writer declared before them; writers follow earlier readers and writers.
+    // A transient read before any pass declared its writer waits for the first writer.
+    for (ResourceHandle resource = 0; resource < static_cast<ResourceHandle>(resources_.size()); ++resource) {
+        int last_writer = -1;
+        std::vector<int> readers_since_write;
+        std::vector<int> early_readers;
+
+        for (int pass = 0; pass < pass_count; ++pass) {
+            if (uses(passes_[pass].reads, resource)) {
+                if (last_writer >= 0) {
+                    add_edge(last_writer, pass);
+                    readers_since_write.push_back(pass);
+                } else if (!resources_[resource].imported) {
+                    early_readers.push_back(pass);
+                } else {
+                    readers_since_write.push_back(pass);
+                }
+            }
+            if (uses(passes_[pass].writes, resource)) {
+                if (last_writer >= 0) {
+                    add_edge(last_writer, pass);
+                } else {
+                    for (int reader : early_readers) {
+                        add_edge(pass, reader);
+                    }
+                }
+                for (int reader : readers_since_write) {
+                    add_edge(reader, pass);
+                }
+                readers_since_write.clear();
+                last_writer = pass;
+            }
+        }
+    }
+
+    // Kahn's algorithm; among ready passes the one declared first runs first
+    execution_order_.clear();
+    std::vector<bool> scheduled(pass_count, false);
+    for (int step = 0; step < pass_count; ++step) {
+        int next = -1;
+        for (int pass = 0; pass < pass_count; ++pass) {
+            if (!scheduled[pass] && in_degree[pass] == 0) {
+                next = pass;
+                break;
+            }
+        }
+        if (next < 0) {
+            return false;
+        }
+        scheduled[next] = true;
+        execution_order_.push_back(next);
+        for (int successor : successors[next]) {
+            --in_degree[successor];
+        }
+    }
+    return true;
+}
+
+void RenderGraph::cull_passes() {
+    // Walk backwards from the outputs; a pass survives if a surviving pass or an output needs what it writes
+    std::vector<bool> needed(resources_.size(), false);
+    for (size_t i = 0; i < resources_.size(); ++i) {
+        needed[i] = resources_[i].is_output;
+    }
+
+    culled_pass_count_ = 0;
+    for (auto it = execution_order_.rbegin(); it != execution_order_.rend(); ++it) {
+        Pass& pass = passes_[*it];
+        bool writes_needed = std::any_of(pass.writes.begin(), pass.writes.end(), [&](const ResourceAccess& access) {
+            return needed[access.resource];
+        });
+
+        pass.culled = !pass.side_effect && !writes_needed;
+        if (pass.culled) {
+            ++culled_pass_count_;
+            continue;
+        }
+        for (const auto& access : pass.reads) {
+            needed[access.resource] = true;
+        }
+    }
+
+    execution_order_.erase(std::remove_if(execution_order_.begin(), execution_order_.end(), [&](int pass) {
+        return passes_[pass].culled;
+    }), execution_order_.end());
+}
+
+void RenderGraph::compute_lifetimes() {
+    for (int position = 0; position < static_cast<int>(execution_order_.size()); ++position) {
+        const Pass& pass = passes_[execution_order_[position]];
+        auto touch = [&](const ResourceAccess& access) {
+            Resource& resource = resources_[access.resource];
+            if (resource.first_pass < 0) {
+                resource.first_pass = position;
+            }
+            resource.last_pass = position;
+        };
+        std::for_each(pass.reads.begin(), pass.reads.end(), touch);
+        std::for_each(pass.writes.begin(), pass.writes.end(), touch);
+    }
+}
+
+void RenderGraph::execute() {
+    if (!compiled_) {
+        compile();
+    }
+
+    pass_timings_.clear();
+
+    for (int position = 0; position < static_cast<int>(execution_order_.size()); ++position) {
+        Pass& pass = passes_[execution_order_[position]];
+
+        // Transients come from the pool right before their first pass
+        for (auto& resource : resources_) {
+            if (!resource.imported && resource.first_pass == position) {
+                resource.texture = pool_.acquire(resource.desc);
+                resource.texture_id = resource.texture->get_id();
+                resource.image_written = false;
+                resource.visible_bits = 0;
+            }
+        }
+
+        // Make earlier image stores visible to the way this pass accesses them
+        GLbitfield barriers = get_required_barriers(pass);
+        if (barriers != 0) {
+            glMemoryBarrier(barriers);
+            for (auto& resource : resources_) {
+                if (resource.image_written) {
+                    resource.visible_bits |= barriers;
+                }
+            }
+        }
+
+        PassTimer& timer = timers_[pass.name];
+        if (!timer.profile_name) {
+            timer.profile_name = Profiler::get_instance().intern(pass.name);
+        }
+        begin_pass_timer(timer);
+        RenderCounters counters_before = RenderStats::get_counters();
+        auto cpu_start = std::chrono::high_resolution_clock::now();
+
+        {
+            PROFILE_SCOPE(timer.profile_name);
+            Texture::reset_slot_counter();
+            pass.execute(*this);
+        }
+
+        auto cpu_end = std::chrono::high_resolution_clock::now();
+        end_pass_timer(timer);
+        float cpu_ms = std::chrono::duration<float, std::milli>(cpu_end - cpu_start).count();
+        timer.cpu_window.add(cpu_ms);
+        pass_timings_.push_back(make_pass_timing(pass.name, timer, cpu_ms));
+        pass_timings_.back().counters = RenderStats::get_counters() - counters_before;
+
+        for (const auto& access : pass.writes) {
+            Resource& resource = resources_[access.resource];
+            resource.image_written = (access.access == Access::Image);
+            resource.visible_bits = 0;
+        }
+
+        // Hand transients back once their last reader has run so later passes can reuse them
+        for (auto& resource : resources_) {
+            if (!resource.imported && resource.last_pass == position) {
+                pool_.release(resource.texture);
+                resource.texture_id = 0;
+            }
+        }
+    }
+}
+
+GLbitfield RenderGraph::get_required_barriers(const Pass& pass) const {
+    GLbitfield bits = 0;
+    auto check = [&](const ResourceAccess& access) {
+        const Resource& resource = resources_[access.resource];
+        GLbitfield bit = get_barrier_bit(access.access);
+        if (resource.image_written && (resource.visible_bits & bit) == 0) {
+            bits |= bit;
+        }
+    };
+    std::for_each(pass.reads.begin(), pass.reads.end(), check);
+    std::for_each(pass.writes.begin(), pass.writes.end(), check);
+    return bits;
+}
+
+GLbitfield RenderGraph::get_barrier_bit(Access access) {
+    switch (access) {
+        case Access::Sampled:    return GL_TEXTURE_FETCH_BARRIER_BIT;
+        case Access::Image:      return GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+        case Access::Attachment: return GL_FRAMEBUFFER_BARRIER_BIT;
+    }
+    return GL_ALL_BARRIER_BITS;
+}
+
+GLuint RenderGraph::get_texture_id(ResourceHandle resource) const {
+    return is_valid(resource) ? resources_[resource].texture_id : 0;
+}
+
+Texture* RenderGraph::get_texture(ResourceHandle resource) const {
+    return is_valid(resource) ? resources_[resource].texture : nullptr;
+}
+
+bool RenderGraph::is_valid(ResourceHandle resource) const {
+    return resource >= 0 && resource < static_cast<ResourceHandle>(resources_.size());
+}
+
+void RenderGraph::begin_pass_timer(PassTimer& timer) {
+    if (timer.queries[0][0] == 0) {
+        glGenQueries(QUERY_RING_SIZE * 2, &timer.queries[0][0]);
+    }
+
+    // Collect every finished result, oldest first, stopping at the first the GPU has not reached
+    while (timer.pending[timer.oldest]) {
+        GLint available = 0;
+        glGetQueryObjectiv(timer.queries[timer.oldest][1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            break;
+        }
+
+        GLuint64 start_ns = 0;
+        GLuint64 end_ns = 0;
+        glGetQueryObjectui64v(timer.queries[timer.oldest][0], GL_QUERY_RESULT, &start_ns);
+        glGetQueryObjectui64v(timer.queries[timer.oldest][1], GL_QUERY_RESULT, &end_ns);
+        timer.gpu_ms = static_cast<float>((end_ns - start_ns) / 1.0e6);
+        timer.gpu_window.add(timer.gpu_ms);
+        timer.pending[timer.oldest] = false;
+        timer.oldest = (timer.oldest + 1) % QUERY_RING_SIZE;
+    }
+
+    // GPU is QUERY_RING_SIZE frames behind; skip timing this frame rather than stall
+    if (timer.pending[timer.next]) {
+        timer.active = false;
+        return;
+    }
+
+    glQueryCounter(timer.queries[timer.next][0], GL_TIMESTAMP);
+    timer.active = true;
+}
+
+void RenderGraph::end_pass_timer(PassTimer& timer) {
+    if (!timer.active) {
+        return;
+    }
+
+    glQueryCounter(timer.queries[timer.next][1], GL_TIMESTAMP);
+    timer.pending[timer.next] = true;
+    timer.next = (timer.next + 1) % QUERY_RING_SIZE;
+    timer.active = false;
+}
+
+RenderGraph::PassTiming RenderGraph::make_pass_timing(const std::string& name, const PassTimer& timer, float cpu_ms) {
+    PassTiming timing{};
+    timing.name = name;
+    timing.cpu_ms = cpu_ms;
+    timing.gpu_ms = timer.gpu_ms;
+    timing.gpu_sample_count = timer.gpu_window.count;
+
+    float cpu_sum = 0.0f;
+    for (size_t i = 0; i < timer.cpu_window.count; ++i) {
+        cpu_sum += timer.cpu_window.samples[i];
+    }
+    timing.cpu_avg_ms = timer.cpu_window.count > 0 ? cpu_sum / static_cast<float>(timer.cpu_window.count) : cpu_ms;
+
+    if (timer.gpu_window.count == 0) {
+        timing.gpu_avg_ms = timing.gpu_min_ms = timing.gpu_p50_ms = timing.gpu_p95_ms = timing.gpu_p99_ms = timing.gpu_max_ms = -1.0f;
+        return timing;
+    }
+
+    // At most TIMING_WINDOW samples, so sorting a copy every frame is cheap
+    std::array<float, TIMING_WINDOW> sorted;
+    const size_t count = timer.gpu_window.count;
+    std::copy_n(timer.gpu_window.samples.begin(), count, sorted.begin());
+    std::sort(sorted.begin(), sorted.begin() + count);
+
+    float gpu_sum = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        gpu_sum += sorted[i];
+    }
+    auto percentile = [&](float p) {
+        size_t index = static_cast<size_t>(p * static_cast<float>(count - 1) + 0.5f);
+        return sorted[std::min(index, count - 1)];
+    };
+
+    timing.gpu_avg_ms = gpu_sum / static_cast<float>(count);
+    timing.gpu_min_ms = sorted[0];
+    timing.gpu_p50_ms = percentile(0.50f);
+    timing.gpu_p95_ms = percentile(0.95f);
+    timing.gpu_p99_ms = percentile(0.99f);
+    timing.gpu_max_ms = sorted[count - 1];
+    return timing;
+}
+
+bool RenderGraph::export_timings_csv(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        LOG_ERROR("RenderGraph: Cannot open '{}' for writing", path);
+        return false;
+    }
+
+    out << "pass,cpu_ms,cpu_avg_ms,gpu_ms,gpu_avg_ms,gpu_min_ms,gpu_p50_ms,gpu_p95_ms,gpu_p99_ms,gpu_max_ms,gpu_samples,"
+           "draw_calls,triangles,instances,program_binds,texture_binds,uniform_uploads,framebuffer_binds,buffer_upload_bytes,compute_dispatches,state_calls_skipped\n";
+    for (const auto& timing : pass_timings_) {
+        const RenderCounters& counters = timing.counters;
+        out << timing.name << ','
+            << timing.cpu_ms << ',' << timing.cpu_avg_ms << ','
+            << timing.gpu_ms << ',' << timing.gpu_avg_ms << ','
+            << timing.gpu_min_ms << ',' << timing.gpu_p50_ms << ','
+            << timing.gpu_p95_ms << ',' << timing.gpu_p99_ms << ','
+            << timing.gpu_max_ms << ',' << timing.gpu_sample_count << ','
+            << counters.draw_calls << ',' << counters.triangles << ',' << counters.instances << ','
+            << counters.program_binds << ',' << counters.texture_binds << ',' << counters.uniform_uploads << ','
+            << counters.framebuffer_binds << ',' << counters.buffer_upload_bytes << ',' << counters.compute_dispatches << ','
+            << counters.state_calls_skipped << '\n';
+    }
+
+    if (!out) {
+        LOG_ERROR("RenderGraph: Failed writing pass timings to '{}'", path);
+        return false;
+    }
+    LOG_INFO("RenderGraph: Wrote timings of {} passes to '{}'", pass_timings_.size(), path);
+    return true;
+}
+
+void RenderGraph::cleanup() {
+    reset();
+    for (auto& [name, timer] : timers_) {
+        if (timer.queries[0][0] != 0) {
+            glDeleteQueries(QUERY_RING_SIZE * 2, &timer.queries[0][0]);
+        }
+    }
+    timers_.clear();
+    pass_timings_.clear();
+}
@@ -0,0 +1,9 @@
+#include "RenderStats.h"
+
+RenderCounters RenderStats::counters_;
+RenderCounters RenderStats::last_frame_;
+
+void RenderStats::end_frame() {
+    last_frame_ = counters_;
+    counters_ = RenderCounters();
+}
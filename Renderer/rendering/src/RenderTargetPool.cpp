@@ -0,0 +1,118 @@
+#include "RenderTargetPool.h"
+#include "Texture.h"
+#include <Logger.h>
+
+#include <algorithm>
+
+RenderTargetPool::RenderTargetPool()
+    : frame_index_(0), allocated_bytes_(0), peak_allocated_bytes_(0)
+{
+}
+
+RenderTargetPool::~RenderTargetPool() = default;
+
+void RenderTargetPool::begin_frame(uint32_t max_idle_frames) {
+    ++frame_index_;
+
+    for (auto& entry : entries_) {
+        entry.in_use = false;
+    }
+
+    // Free targets no pass has asked for recently (effect disabled, old resolution)
+    auto idle = [&](const Entry& entry) {
+        return frame_index_ - entry.last_used_frame > max_idle_frames;
+    };
+    for (const auto& entry : entries_) {
+        if (idle(entry)) {
+            allocated_bytes_ -= get_texture_bytes(entry.desc);
+            LOG_DEBUG("RenderTargetPool: Freed idle {}x{} target (format 0x{:X})", entry.desc.width, entry.desc.height, entry.desc.internal_format);
+        }
+    }
+    entries_.erase(std::remove_if(entries_.begin(), entries_.end(), idle), entries_.end());
+}
+
+Texture* RenderTargetPool::acquire(const Desc& desc) {
+    for (auto& entry : entries_) {
+        if (!entry.in_use && entry.desc == desc) {
+            entry.in_use = true;
+            entry.last_used_frame = frame_index_;
+            return entry.texture.get();
+        }
+    }
+
+    Entry entry;
+    entry.desc = desc;
+    entry.texture = std::make_unique<Texture>(Texture::create_immutable_texture(desc.width, desc.height, desc.internal_format, desc.levels));
+    entry.in_use = true;
+    entry.last_used_frame = frame_index_;
+    entries_.push_back(std::move(entry));
+
+    allocated_bytes_ += get_texture_bytes(desc);
+    peak_allocated_bytes_ = std::max(peak_allocated_bytes_, allocated_bytes_);
+    LOG_DEBUG("RenderTargetPool: Allocated {}x{} target (format 0x{:X}), pool holds {} targets, {:.1f} MB",
+        desc.width, desc.height, desc.internal_format, entries_.size(), allocated_bytes_ / (1024.0 * 1024.0));
+
+    return entries_.back().texture.get();
+}
+
+void RenderTargetPool::release(Texture*& texture) {
+    if (!texture) {
+        return;
+    }
+    for (auto& entry : entries_) {
+        if (entry.texture.get() == texture) {
+            entry.in_use = false;
+            break;
+        }
+    }
+    texture = nullptr;
+}
+
+void RenderTargetPool::clear() {
+    entries_.clear();
+    allocated_bytes_ = 0;
+}
+
+size_t RenderTargetPool::get_texture_bytes(const Desc& desc) {
+    return Texture::get_texture_bytes(desc.internal_format, static_cast<GLuint>(desc.width), static_cast<GLuint>(desc.height),
+                                      1, static_cast<GLuint>(std::max(desc.levels, 1)));
+}
+
+RenderTargetPool::MemoryReport RenderTargetPool::plan(const std::vector<Usage>& usages) {
+    MemoryReport report{ 0, 0, 0, 0 };
+
+    // Assign targets in order of first use to the first allocation of the same key that is free again
+    std::vector<const Usage*> ordered;
+    for (const auto& usage : usages) {
+        ordered.push_back(&usage);
+    }
+    std::stable_sort(ordered.begin(), ordered.end(), [](const Usage* a, const Usage* b) {
+        return a->first_pass < b->first_pass;
+    });
+
+    struct Allocation {
+        Desc desc;
+        int last_pass;
+    };
+    std::vector<Allocation> allocations;
+
+    for (const Usage* usage : ordered) {
+        size_t bytes = get_texture_bytes(usage->desc);
+        report.unaliased_bytes += bytes;
+        ++report.unaliased_count;
+
+        auto reusable = std::find_if(allocations.begin(), allocations.end(), [&](const Allocation& allocation) {
+            return allocation.desc == usage->desc && allocation.last_pass < usage->first_pass;
+        });
+        if (reusable != allocations.end()) {
+            reusable->last_pass = usage->last_pass;
+            continue;
+        }
+
+        allocations.push_back({ usage->desc, usage->last_pass });
+        report.aliased_bytes += bytes;
+        ++report.aliased_count;
+    }
+
+    return report;
+}
@@ -1,5 +1,9 @@
 #include "Renderer.h"
 #include "Logger.h"
+#include "Profiler.h"
+#include "RenderStats.h"
+#include "GLStateCache.h"
+#include "MemoryTracker.h"
 #include "Camera.h"
 #include "CoroutineResourceManager.h"
 #include "TransformManager.h"
@@ -8,6 +12,9 @@
 #include <iostream>
 #include <vector>
 #include <random>
+#include <cmath>
+#include <algorithm>
+#include <utility>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -22,12 +29,13 @@ namespace glRenderer {
        height_(height),
        viewport_width_(width),
        viewport_height_(height),
+       render_width_(width),
+       render_height_(height),
        framebuffer_(0),
        color_texture_(nullptr),
        depth_texture_(nullptr),
        use_framebuffer_(false),
        g_buffer_fbo_(0),
-       g_position_texture_(nullptr),
        g_albedo_metallic_texture_(nullptr),
        g_normal_roughness_texture_(nullptr),
        g_motion_ao_texture_(nullptr),
@@ -45,10 +53,14 @@ namespace glRenderer {
        ssao_final_texture_(nullptr),
        ssao_noise_texture_(nullptr),
        use_ssao_(false),
+       ssao_resolution_divisor_(1),
        ssgi_fbo_(0),
        ssgi_raw_texture_(nullptr),
        ssgi_final_texture_(nullptr),
        ssgi_prev_texture_(nullptr),
+       ssgi_geometry_texture_(nullptr),
+       ssgi_prev_geometry_texture_(nullptr),
+       ssgi_history_valid_(false),
        lit_scene_texture_(nullptr),
        use_ssgi_(false),
        ssgi_exposure_(1.0f),    // Match GUI default - higher for brighter result
@@ -58,9 +70,23 @@ namespace glRenderer {
        ssgi_step_size_(0.15f),
        ssgi_thickness_(1.2f),   // Match GUI default for better hit detection
        ssgi_num_samples_(8),
-       hiz_textures_{0, 0},
-       final_hiz_texture_(0),
+       ssgi_resolution_divisor_(2),  // Ray marching is the most expensive pass, trace at half resolution
+       hiz_texture_(0),
+       hiz_counter_buffer_(0),
        hiz_mip_levels_(0),
+       hiz_gpu_bytes_(0),
+       hiz_view_projection_(1.0f),
+       hiz_history_valid_(false),
+       use_occlusion_culling_(true),
+       use_tiled_lighting_(true),
+       use_taa_(false),
+       taa_render_scale_(1.0f),
+       taa_scene_fbo_(0),
+       taa_scene_color_texture_(nullptr),
+       taa_resolve_fbo_(0),
+       taa_history_index_(0),
+       taa_history_valid_(false),
+       taa_frame_index_(0),
        prev_view_matrix_(1.0f),
        prev_projection_matrix_(1.0f),
        first_frame_(true)
@@ -75,17 +101,20 @@ namespace glRenderer {
         cleanup_ssao();
         cleanup_ssgi();
         cleanup_hiz_buffer();
+        cleanup_taa();
+        render_graph_.reset();
+        render_target_pool_.reset();
     }
 
-    void Renderer::initialize() {
-        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+    void Renderer::initialize(GLADloadproc proc_loader) {
+        if (!gladLoadGLLoader(proc_loader)) {
             throw std::runtime_error("Failed to initialize GLAD");
         }
 
-        glViewport(0, 0, viewport_width_, viewport_height_);
-        glEnable(GL_DEPTH_TEST);
+        GLStateCache::viewport(0, 0, viewport_width_, viewport_height_);
+        GLStateCache::enable(GL_DEPTH_TEST);
         
-        glDisable(GL_CULL_FACE);
+        GLStateCache::disable(GL_CULL_FACE);
 
         // All texture slot management is now handled automatically by the Texture class
 
@@ -103,16 +132,23 @@ namespace glRenderer {
         setup_g_buffer();
         // setup_screen_quad(); // Moved to lazy initialization in render methods
         setup_skybox();
+        render_target_pool_ = std::make_unique<RenderTargetPool>();
+        render_graph_ = std::make_unique<RenderGraph>(*render_target_pool_);
         setup_ssao();
         setup_ssgi();
         setup_hiz_buffer();
+        setup_taa();
+        
+        occlusion_culler_ = std::make_unique<OcclusionCuller>();
+        material_table_ = std::make_unique<MaterialTable>();
 
+        log_render_target_report();
     }
   
         void Renderer::setup_framebuffer() {
         
         glGenFramebuffers(1, &framebuffer_);
-        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, framebuffer_);
 
         // Create color texture using factory method
         color_texture_ = std::make_unique<Texture>(Texture::create_render_target(viewport_width_, viewport_height_, false));
@@ -123,7 +159,7 @@ namespace glRenderer {
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depth_texture_->get_id(), 0);
 
         //restore to default
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, 0);
         
         LOG_INFO("Framebuffer setup completed: {}x{}", viewport_width_, viewport_height_);
     }
@@ -150,37 +186,131 @@ namespace glRenderer {
             glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depth_texture_->get_id(), 0);
         }
 
+        // Everything rendered at the internal resolution follows the viewport
+        glm::ivec2 render_size = get_render_size();
+        render_width_ = render_size.x;
+        render_height_ = render_size.y;
+        resize_render_targets();
+        setup_taa_targets();
+
+        LOG_INFO("Framebuffer resized to: {}x{}, render resolution: {}x{}", viewport_width_, viewport_height_, render_width_, render_height_);
+
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    glm::ivec2 Renderer::get_render_size() const {
+        float scale = is_taa_active() ? taa_render_scale_ : 1.0f;
+        return glm::ivec2(std::max(1, static_cast<int>(std::lround(viewport_width_ * scale))),
+                          std::max(1, static_cast<int>(std::lround(viewport_height_ * scale))));
+    }
+
+    void Renderer::update_render_resolution() {
+        glm::ivec2 render_size = get_render_size();
+        if (render_size.x == render_width_ && render_size.y == render_height_) {
+            return;
+        }
+
+        render_width_ = render_size.x;
+        render_height_ = render_size.y;
+        resize_render_targets();
+        setup_taa_targets();
+        LOG_INFO("Renderer: Render resolution set to {}x{} (viewport {}x{})", render_width_, render_height_, viewport_width_, viewport_height_);
+    }
+
+    void Renderer::resize_render_targets() {
         // Resize G-Buffer textures using new resize method
-        if (g_position_texture_) {
-            g_position_texture_->resize_texture(viewport_width_, viewport_height_, GL_RGBA32F, GL_RGBA, GL_FLOAT);
-            g_albedo_metallic_texture_->resize_texture(viewport_width_, viewport_height_, GL_RGBA16F, GL_RGBA, GL_FLOAT);
-            g_normal_roughness_texture_->resize_texture(viewport_width_, viewport_height_, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE);
-            g_motion_ao_texture_->resize_texture(viewport_width_, viewport_height_, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE);
-            g_emissive_texture_->resize_texture(viewport_width_, viewport_height_, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE);
-            g_depth_texture_->resize_texture(viewport_width_, viewport_height_, GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_FLOAT);
+        if (g_albedo_metallic_texture_) {
+            g_albedo_metallic_texture_->resize_texture(render_width_, render_height_, GL_SRGB8_ALPHA8, GL_RGBA, GL_UNSIGNED_BYTE);
+            g_normal_roughness_texture_->resize_texture(render_width_, render_height_, GL_RGB10_A2, GL_RGBA, GL_UNSIGNED_INT_2_10_10_10_REV);
+            g_motion_ao_texture_->resize_texture(render_width_, render_height_, GL_RGBA16F, GL_RGBA, GL_FLOAT);
+            g_emissive_texture_->resize_texture(render_width_, render_height_, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE);
+            g_depth_texture_->resize_texture(render_width_, render_height_, GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_FLOAT);
         }
 
-        // Resize SSAO textures if they exist
-        if (ssao_raw_texture_ || ssao_final_texture_) {
-            cleanup_ssao_textures();
-            setup_ssao_textures();
+        // Pooled targets are sized per frame; drop the ones at the old resolution
+        clear_transient_targets();
+        if (render_graph_) {
+            render_graph_->reset();
+        }
+        if (render_target_pool_) {
+            render_target_pool_->clear();
         }
         
-        // Resize SSGI textures if they exist
-        if (ssgi_raw_texture_ || ssgi_final_texture_ || lit_scene_texture_) {
-            cleanup_ssgi_textures();
-            setup_ssgi_textures();
+        // Resize the SSGI history if SSGI has run
+        if (ssgi_final_texture_) {
+            create_ssgi_targets();
         }
         
         // Resize Hi-Z buffer if it exists
-        if (hiz_textures_[0] != 0) {
+        if (hiz_texture_ != 0) {
             cleanup_hiz_buffer();
             setup_hiz_buffer();
         }
+    }
+    
+    void Renderer::clear_transient_targets() {
+        // The render graph owns the transients; these are only views for the pass that runs
+        ssao_raw_texture_ = nullptr;
+        ssao_final_texture_ = nullptr;
+        ssgi_raw_texture_ = nullptr;
+        lit_scene_texture_ = nullptr;
+    }
+
+    RenderTargetPool::MemoryReport Renderer::get_render_target_report(int width, int height) const {
+        // Passes of the deferred frame, in execution order
+        enum Pass { kGeometry, kHiZ, kSSAO, kSSAOBlur, kDirectLighting, kSSGI, kSSGIDenoise, kComposition, kTAA };
+
+        float scale = use_taa_ ? taa_render_scale_ : 1.0f;
+        int render_width = std::max(1, static_cast<int>(std::lround(width * scale)));
+        int render_height = std::max(1, static_cast<int>(std::lround(height * scale)));
+        auto effect_desc = [&](int divisor, GLenum format) {
+            return RenderTargetPool::Desc{ std::max(1, (render_width + divisor - 1) / divisor),
+                                           std::max(1, (render_height + divisor - 1) / divisor), format };
+        };
+        int hiz_levels = static_cast<int>(std::floor(std::log2(std::max(render_width, render_height)))) + 1;
+
+        // Persistent targets live for the whole frame
+        std::vector<RenderTargetPool::Usage> usages = {
+            { "g_albedo_metallic", { render_width, render_height, GL_SRGB8_ALPHA8 }, kGeometry, kTAA },
+            { "g_normal_roughness", { render_width, render_height, GL_RGB10_A2 }, kGeometry, kTAA },
+            { "g_motion_ao", { render_width, render_height, GL_RGBA16F }, kGeometry, kTAA },
+            { "g_emissive", { render_width, render_height, GL_RGBA8 }, kGeometry, kTAA },
+            { "g_depth", { render_width, render_height, GL_DEPTH_COMPONENT24 }, kGeometry, kTAA },
+            { "hiz", { render_width, render_height, GL_R32F, hiz_levels }, kGeometry, kTAA },
+            { "framebuffer_color", { width, height, GL_RGB8 }, kGeometry, kTAA },
+            { "framebuffer_depth", { width, height, GL_DEPTH_COMPONENT24 }, kGeometry, kTAA },
+            // Transient targets, alive from the pass that writes them to their last reader
+            { "lit_scene", { render_width, render_height, GL_RGBA16F }, kDirectLighting, kComposition },
+        };
+        if (use_ssao_) {
+            usages.push_back({ "ssao_raw", effect_desc(ssao_resolution_divisor_, GL_R16F), kSSAO, kSSAOBlur });
+            usages.push_back({ "ssao_final", effect_desc(ssao_resolution_divisor_, GL_R16F), kSSAOBlur, kComposition });
+        }
+        if (use_ssgi_) {
+            usages.push_back({ "ssgi_raw", effect_desc(ssgi_resolution_divisor_, GL_RGBA16F), kSSGI, kSSGIDenoise });
+            usages.push_back({ "ssgi_final", effect_desc(ssgi_resolution_divisor_, GL_RGBA16F), kGeometry, kTAA });
+            usages.push_back({ "ssgi_prev", effect_desc(ssgi_resolution_divisor_, GL_RGBA16F), kGeometry, kTAA });
+            usages.push_back({ "ssgi_geometry", effect_desc(ssgi_resolution_divisor_, GL_RGBA16F), kGeometry, kTAA });
+            usages.push_back({ "ssgi_prev_geometry", effect_desc(ssgi_resolution_divisor_, GL_RGBA16F), kGeometry, kTAA });
+        }
+        if (use_taa_) {
+            usages.push_back({ "taa_scene_color", { render_width, render_height, GL_RGBA8 }, kGeometry, kTAA });
+            usages.push_back({ "taa_history_0", { width, height, GL_RGBA8 }, kGeometry, kTAA });
+            usages.push_back({ "taa_history_1", { width, height, GL_RGBA8 }, kGeometry, kTAA });
+        }
 
-        LOG_INFO("Framebuffer, G-Buffer, SSGI textures, and Hi-Z buffer resized to: {}x{}", viewport_width_, viewport_height_);
+        return RenderTargetPool::plan(usages);
+    }
 
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    void Renderer::log_render_target_report() const {
+        const int sizes[][2] = { { 1920, 1080 }, { 3840, 2160 } };
+        for (const auto& size : sizes) {
+            RenderTargetPool::MemoryReport report = get_render_target_report(size[0], size[1]);
+            LOG_INFO("Renderer: Render targets at {}x{}: {:.1f} MB in {} textures, {:.1f} MB in {} textures with aliasing",
+                size[0], size[1],
+                report.unaliased_bytes / (1024.0 * 1024.0), report.unaliased_count,
+                report.aliased_bytes / (1024.0 * 1024.0), report.aliased_count);
+        }
     }
     
     void Renderer::cleanup_framebuffer() {
@@ -189,6 +319,7 @@ namespace glRenderer {
         depth_texture_.reset();
         
         if (framebuffer_ != 0) {
+            GLStateCache::forget_framebuffer(framebuffer_);
             glDeleteFramebuffers(1, &framebuffer_);
             framebuffer_ = 0;
         }
@@ -197,36 +328,35 @@ namespace glRenderer {
     void Renderer::setup_g_buffer() {
         // Generate G-Buffer framebuffer
         glGenFramebuffers(1, &g_buffer_fbo_);
-        glBindFramebuffer(GL_FRAMEBUFFER, g_buffer_fbo_);
-        
-        // RT0: Position + Material ID using factory method
-        g_position_texture_ = std::make_unique<Texture>(Texture::create_g_buffer_texture(viewport_width_, viewport_height_, GL_RGBA32F, GL_RGBA, GL_FLOAT));
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, g_position_texture_->get_id(), 0);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, g_buffer_fbo_);
         
-        // RT1: Albedo (RGB16F) + Metallic (R16F) using factory method
-        g_albedo_metallic_texture_ = std::make_unique<Texture>(Texture::create_g_buffer_texture(viewport_width_, viewport_height_, GL_RGBA16F, GL_RGBA, GL_FLOAT));
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, g_albedo_metallic_texture_->get_id(), 0);
+        // No position target: world position is reconstructed from depth, keeping the
+        // layout at 20 B/px (4 color targets + depth) instead of 40 B/px
+
+        // RT0: Albedo (sRGB8) + Metallic (A8) using factory method
+        g_albedo_metallic_texture_ = std::make_unique<Texture>(Texture::create_g_buffer_texture(render_width_, render_height_, GL_SRGB8_ALPHA8, GL_RGBA, GL_UNSIGNED_BYTE));
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, g_albedo_metallic_texture_->get_id(), 0);
         
-        // RT2: Normal (RGB8) + Roughness (R8) using factory method
-        g_normal_roughness_texture_ = std::make_unique<Texture>(Texture::create_g_buffer_texture(viewport_width_, viewport_height_, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE));
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, GL_TEXTURE_2D, g_normal_roughness_texture_->get_id(), 0);
+        // RT1: Octahedral Normal (RG10) + Roughness (B10) using factory method
+        g_normal_roughness_texture_ = std::make_unique<Texture>(Texture::create_g_buffer_texture(render_width_, render_height_, GL_RGB10_A2, GL_RGBA, GL_UNSIGNED_INT_2_10_10_10_REV));
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, g_normal_roughness_texture_->get_id(), 0);
         
-        // RT3: Motion Vector (RG8) + AO (R8) + unused (R8) using factory method
-        g_motion_ao_texture_ = std::make_unique<Texture>(Texture::create_g_buffer_texture(viewport_width_, viewport_height_, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE));
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT3, GL_TEXTURE_2D, g_motion_ao_texture_->get_id(), 0);
+        // RT2: Motion Vector (RG) + AO + unused (RGBA16F) using factory method
+        g_motion_ao_texture_ = std::make_unique<Texture>(Texture::create_g_buffer_texture(render_width_, render_height_, GL_RGBA16F, GL_RGBA, GL_FLOAT));
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, GL_TEXTURE_2D, g_motion_ao_texture_->get_id(), 0);
         
-        // RT4: Emissive Color (RGB8) + Intensity (R8) using factory method
-        g_emissive_texture_ = std::make_unique<Texture>(Texture::create_g_buffer_texture(viewport_width_, viewport_height_, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE));
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT4, GL_TEXTURE_2D, g_emissive_texture_->get_id(), 0);
+        // RT3: Emissive Color (RGB8) + Intensity (R8) using factory method
+        g_emissive_texture_ = std::make_unique<Texture>(Texture::create_g_buffer_texture(render_width_, render_height_, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE));
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT3, GL_TEXTURE_2D, g_emissive_texture_->get_id(), 0);
         
         // Depth buffer using factory method
-        g_depth_texture_ = std::make_unique<Texture>(Texture::create_depth_buffer(viewport_width_, viewport_height_));
+        g_depth_texture_ = std::make_unique<Texture>(Texture::create_depth_buffer(render_width_, render_height_));
         g_depth_texture_->set_filter_mode(GL_LINEAR, GL_LINEAR); // Override default nearest filtering for depth
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, g_depth_texture_->get_id(), 0);
         
         // Specify which color attachments we'll use for rendering
-        GLenum draw_buffers[5] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3, GL_COLOR_ATTACHMENT4 };
-        glDrawBuffers(5, draw_buffers);
+        GLenum draw_buffers[4] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3 };
+        glDrawBuffers(4, draw_buffers);
         
         // Check OpenGL errors after MRT setup
         GLenum gl_error = glGetError();
@@ -239,16 +369,15 @@ namespace glRenderer {
         if (framebuffer_status != GL_FRAMEBUFFER_COMPLETE) {
             LOG_ERROR("G-Buffer framebuffer not complete! Status: {}", framebuffer_status);
         } else {
-            LOG_INFO("G-Buffer setup completed: {}x{} with 4 render targets", viewport_width_, viewport_height_);
+            LOG_INFO("G-Buffer setup completed: {}x{} with 4 render targets", render_width_, render_height_);
         }
         
         // Unbind framebuffer
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, 0);
     }
     
     void Renderer::cleanup_g_buffer() {
         // Texture objects will be automatically cleaned up by their destructors
-        g_position_texture_.reset();
         g_albedo_metallic_texture_.reset();
         g_normal_roughness_texture_.reset();
         g_motion_ao_texture_.reset();
@@ -256,6 +385,7 @@ namespace glRenderer {
         g_depth_texture_.reset();
         
         if (g_buffer_fbo_ != 0) {
+            GLStateCache::forget_framebuffer(g_buffer_fbo_);
             glDeleteFramebuffers(1, &g_buffer_fbo_);
             g_buffer_fbo_ = 0;
         }
@@ -263,6 +393,8 @@ namespace glRenderer {
     
     void Renderer::set_deferred_rendering(bool enable) {
         use_deferred_rendering_ = enable;
+        taa_history_valid_ = false;
+        update_render_resolution();
         LOG_INFO("Deferred rendering {}", enable ? "enabled" : "disabled");
     }
     
@@ -296,11 +428,11 @@ namespace glRenderer {
     void Renderer::set_render_to_framebuffer(bool enable) {
         use_framebuffer_ = enable;
         if (enable) {
-            glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
-            glViewport(0, 0, viewport_width_, viewport_height_);
+            GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, framebuffer_);
+            GLStateCache::viewport(0, 0, viewport_width_, viewport_height_);
         } else {
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
-            glViewport(0, 0, viewport_width_, viewport_height_);
+            GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, 0);
+            GLStateCache::viewport(0, 0, viewport_width_, viewport_height_);
         }
     }
     
@@ -308,12 +440,15 @@ namespace glRenderer {
       // Reset texture slot counter for geometry pass
       Texture::reset_slot_counter();
       
-      glBindFramebuffer(GL_FRAMEBUFFER, g_buffer_fbo_);
-      glViewport(0, 0, viewport_width_, viewport_height_);
+      GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, g_buffer_fbo_);
+      GLStateCache::viewport(0, 0, render_width_, render_height_);
 
       // Re-specify draw buffers
-      GLenum draw_buffers[5] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3, GL_COLOR_ATTACHMENT4};
-      glDrawBuffers(5, draw_buffers);
+      GLenum draw_buffers[4] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3};
+      glDrawBuffers(4, draw_buffers);
+
+      // Albedo target is sRGB: let the hardware encode on write
+      GLStateCache::enable(GL_FRAMEBUFFER_SRGB);
 
       // Clear G-Buffer
       glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
@@ -321,32 +456,35 @@ namespace glRenderer {
       glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
       // Enable depth testing and depth writing, disable face culling
-      glEnable(GL_DEPTH_TEST);
+      GLStateCache::enable(GL_DEPTH_TEST);
       glDepthFunc(GL_LESS);
       glDepthMask(GL_TRUE);  // Ensure depth writing is enabled
-      glDisable(GL_CULL_FACE);
+      GLStateCache::disable(GL_CULL_FACE);
       
       // Disable blending for opaque geometry rendering
-      glDisable(GL_BLEND);
+      GLStateCache::disable(GL_BLEND);
     }
 
     void Renderer::bind_g_buffer_for_lighting_pass() {
-      // Bind default framebuffer for final output
-      glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
-      glViewport(0, 0, viewport_width_, viewport_height_);
+      // Bind the scene target for final output
+      GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, get_scene_target_fbo());
+      GLStateCache::viewport(0, 0, render_width_, render_height_);
 
       // Disable depth testing for screen-space quad and ensure face culling is off
-      glDisable(GL_DEPTH_TEST);
-      glDisable(GL_CULL_FACE);
+      GLStateCache::disable(GL_DEPTH_TEST);
+      GLStateCache::disable(GL_CULL_FACE);
       
       // Enable blending 
-      glEnable(GL_BLEND);
+      GLStateCache::enable(GL_BLEND);
       glBlendFunc(GL_ONE, GL_ONE);
 
     }
 
     void Renderer::render_deferred(const Scene& scene, const Camera& camera, 
         const CoroutineResourceManager& resource_manager, const TransformManager& transform_manager) {
+        PROFILE_SCOPE("Renderer::render_deferred");
+        // ImGui and load-time work touch GL behind the cache's back between frames
+        GLStateCache::invalidate();
         // Initialize screen quad if not already done
         //shadow_map = nullptr;
         if (!screen_quad_mesh_) {
@@ -359,27 +497,6 @@ namespace glRenderer {
             return;
         }
         
-        // Unbind all textures and reset slot counter for this render pass
-        
-        Texture::reset_slot_counter();
-        
-        // Bind G-Buffer textures for reading using automatic slot management
-        unsigned int g_pos_slot = Texture::bind_raw_texture(g_position_texture_->get_id(), GL_TEXTURE_2D);
-        unsigned int g_albedo_slot = Texture::bind_raw_texture(g_albedo_metallic_texture_->get_id(), GL_TEXTURE_2D);
-        unsigned int g_normal_slot = Texture::bind_raw_texture(g_normal_roughness_texture_->get_id(), GL_TEXTURE_2D);
-        unsigned int g_motion_slot = Texture::bind_raw_texture(g_motion_ao_texture_->get_id(), GL_TEXTURE_2D);
-        unsigned int g_emissive_slot = Texture::bind_raw_texture(g_emissive_texture_->get_id(), GL_TEXTURE_2D);
-        unsigned int g_depth_slot = Texture::bind_raw_texture(g_depth_texture_->get_id(), GL_TEXTURE_2D);
-        
-        // Shadow Pass 
-        if (shadow_map) {
-            //LOG_INFO("Renderer: Rendering shadow pass for deferred rendering");
-            render_shadow_pass_deferred(scene, camera, resource_manager, transform_manager);
-        }
-        
-        // Geometry Pass
-        bind_g_buffer_for_geometry_pass();
-        
         // Get geometry shader from ResourceManager
         auto geometry_shader = resource_manager.get_shader("deferred_geometry_shader");
         if (!geometry_shader) {
@@ -387,240 +504,339 @@ namespace glRenderer {
             return;
         }
         
-        //LOG_INFO("Renderer: Using deferred geometry shader for geometry pass");
-        geometry_shader->use();
-        
         // Set camera matrices
         glm::mat4 view = camera.get_view_matrix();
         glm::mat4 projection = camera.get_projection_matrix(static_cast<float>(viewport_width_) / static_cast<float>(viewport_height_));
-        glm::vec3 camera_pos = camera.get_position();
-        
-        //LOG_INFO("Renderer: Camera position: ({}, {}, {})", camera_pos.x, camera_pos.y, camera_pos.z);
-        
-        geometry_shader->set_mat4("view", view);
-        geometry_shader->set_mat4("projection", projection);
 
-        // Set previous frame MVP for motion vectors and temporal accumulation
-        glm::mat4 prevMVP;
+        // Motion vectors use unjittered matrices so they only carry camera motion
+        glm::mat4 unjittered_projection = camera.get_unjittered_projection_matrix(static_cast<float>(viewport_width_) / static_cast<float>(viewport_height_));
+
+        // Set previous frame view-projection for motion vectors and temporal accumulation
+        glm::mat4 prevViewProjection;
         if (first_frame_) {
             // On first frame, use current matrices to avoid artifacts
-            prevMVP = projection * view;
+            prevViewProjection = unjittered_projection * view;
             first_frame_ = false;
         } else {
             // Use previous frame matrices
-            prevMVP = prev_projection_matrix_ * prev_view_matrix_;
+            prevViewProjection = prev_projection_matrix_ * prev_view_matrix_;
         }
-        geometry_shader->set_mat4("prevModelViewProjection", prevMVP);
+        glm::mat4 currViewProjection = unjittered_projection * view;
         
         // Store current matrices for next frame
         prev_view_matrix_ = view;
-        prev_projection_matrix_ = projection;
-        
-        // Render all renderables to G-Buffer
-        const auto& renderable_refs = scene.get_renderable_references();
+        prev_projection_matrix_ = unjittered_projection;
+        
+        // Transient targets are acquired by the graph for the passes that use them
+        render_target_pool_->begin_frame();
+        RenderGraph& graph = *render_graph_;
+        graph.reset();
+        using Access = RenderGraph::Access;
+        
+        // Targets owned by the renderer
+        bool taa_active = is_taa_active();
+        auto g_albedo = graph.import_texture("g_albedo_metallic", g_albedo_metallic_texture_->get_id());
+        auto g_normal = graph.import_texture("g_normal_roughness", g_normal_roughness_texture_->get_id());
+        auto g_motion = graph.import_texture("g_motion_ao", g_motion_ao_texture_->get_id());
+        auto g_emissive = graph.import_texture("g_emissive", g_emissive_texture_->get_id());
+        auto g_depth = graph.import_texture("g_depth", g_depth_texture_->get_id());
+        auto hiz = graph.import_texture("hiz", hiz_texture_);
+        auto scene_color = graph.import_texture("scene_color",
+            taa_active ? taa_scene_color_texture_->get_id() : color_texture_->get_id(), !taa_active);
+        auto output_color = taa_active ? graph.import_texture("output_color", color_texture_->get_id(), true) : scene_color;
+        auto shadow_depth = RenderGraph::INVALID_RESOURCE;
+        auto shadow_min_max = RenderGraph::INVALID_RESOURCE;
+        if (shadow_map) {
+            shadow_depth = graph.import_texture("shadow_depth", shadow_map->get_depth_texture());
+            shadow_min_max = graph.import_texture("shadow_min_max", shadow_map->get_min_max_texture());
+        }
+        auto read_g_buffer = [=](RenderGraph::PassBuilder& builder) {
+            builder.read(g_albedo);
+            builder.read(g_normal);
+            builder.read(g_motion);
+            builder.read(g_emissive);
+            builder.read(g_depth);
+        };
         
-        for (const auto& renderable_id : renderable_refs) {
-            auto renderable = resource_manager.get<Renderable>(renderable_id);
-            if (!renderable || !renderable->is_visible() || !renderable->has_models()) {
-                continue;
-            }
+        // Shadow Pass
+        if (shadow_map) {
+            graph.add_pass("shadow", [&](RenderGraph::PassBuilder& builder) {
+                builder.write(shadow_depth, Access::Attachment);
+                builder.write(shadow_min_max, Access::Image);
+            }, [&](const RenderGraph&) {
+                render_shadow_pass_deferred(scene, camera, resource_manager, transform_manager);
+            });
+        }
+        
+        // Geometry Pass; the early cull reads last frame's pyramid, the late phase rebuilds it
+        graph.add_pass("geometry", [&](RenderGraph::PassBuilder& builder) {
+            builder.read(hiz);
+            builder.write(g_albedo);
+            builder.write(g_normal);
+            builder.write(g_motion);
+            builder.write(g_emissive);
+            builder.write(g_depth);
+            builder.write(hiz, Access::Image);
+        }, [&](const RenderGraph&) {
+            bind_g_buffer_for_geometry_pass();
             
-            // Get transform from external transform system
-            glm::mat4 renderable_matrix = transform_manager.get_model_matrix(renderable_id);
+            // Render all renderables to G-Buffer; visibility comes from the indirect command of each item
+            collect_draw_items(scene, resource_manager, transform_manager, false);
+            bool run_late_phase = cull_draw_items_early(resource_manager);
             
-            // Render each model in the renderable
-            for (const auto& model_id : renderable->get_model_ids()) {
-                Texture::reset_slot_counter();
-                auto model = resource_manager.get<Model>(model_id);
-                if (!model || !model->has_mesh() || !model->has_material()) {
-                    continue;
+            geometry_shader->use();
+            geometry_shader->set_mat4("view", view);
+            geometry_shader->set_mat4("projection", projection);
+            geometry_shader->set_mat4("currViewProjection", currViewProjection);
+            geometry_shader->set_mat4("prevViewProjection", prevViewProjection);
+            
+            // Packed material textures; bound once per phase, the Hi-Z passes in between reuse low units
+            std::array<GLuint, Material::MAX_TEXTURE_ARRAYS> texture_array_ids{};
+            GLsizei texture_array_count = 0;
+            for (const auto& texture_array : resource_manager.get_texture_arrays()) {
+                if (texture_array_count == static_cast<GLsizei>(texture_array_ids.size())) {
+                    break;
                 }
-                
-                geometry_shader->set_mat4("model", renderable_matrix);
+                texture_array_ids[texture_array_count++] = texture_array->get_id();
+            }
             
-                // Set material properties
-                const Material& material = *model->get_material();
-                
-                // Set basic material uniforms
-                material.set_shader(*geometry_shader, "material");
-                
-                // Set PBR material parameters
-                material.set_shader_pbr(*geometry_shader);
-                geometry_shader->set_int("materialID", 0);
+            auto draw_geometry_items = [&]() {
+                occlusion_culler_->bind_commands();
+                material_table_->bind();
+                if (texture_array_count > 0) {
+                    GLStateCache::bind_textures(Material::ARRAY_UNIT, texture_array_count, texture_array_ids.data());
+                }
+                const Material* bound_material = nullptr;
+                for (uint32_t i = 0; i < draw_items_.size(); ++i) {
+                    const DrawItem& item = draw_items_[i];
                 
-                // Bind material textures using automatic slot management
-                material.bind_textures_auto(*geometry_shader, resource_manager);
+                    geometry_shader->set_mat4("model", item.model_matrix);
+            
+                    // Material parameters come from the material table through the command's base
+                    // instance and packed textures from the arrays; only separate textures need a bind,
+                    // kept while consecutive items share the material
+                    const Material& material = *item.model->get_material();
+                    if (&material != bound_material && material.has_separate_textures()) {
+                        material.bind_block(resource_manager);
+                        bound_material = &material;
+                    }
                 
-                // Render the mesh
-                try {
-                    const Mesh& mesh = *model->get_mesh();
-                    mesh.draw();
-                } catch (const std::exception& e) {
-                    LOG_ERROR("Renderer: Failed to render model '{}' in geometry pass: {}", model_id, e.what());
-                    continue;
+                    // Render the mesh
+                    try {
+                        const Mesh& mesh = *item.model->get_mesh();
+                        mesh.draw_indirect(OcclusionCuller::get_command_offset(i));
+                    } catch (const std::exception& e) {
+                        LOG_ERROR("Renderer: Failed to render model '{}' in geometry pass: {}", *item.model_id, e.what());
+                        continue;
+                    }
                 }
+                material_table_->unbind();
+                occlusion_culler_->unbind_commands();
+            };
+            
+            draw_geometry_items();
+            
+            if (run_late_phase) {
+                // Build a pyramid from what the early phase drew and draw items that became visible
+                generate_hiz_pyramid(resource_manager, g_depth_texture_->get_id());
+                glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+                cull_draw_items_late(resource_manager, projection * view);
+                
+                geometry_shader->use();
+                draw_geometry_items();
             }
-        }
-        
-        // Ensure G-Buffer writes are complete before generating Hi-Z pyramid
-        glMemoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT);
-        
-        // Generate Hi-Z pyramid after geometry pass for accelerated ray marching
-        generate_hiz_pyramid(resource_manager);
-        
-        // Render skybox using G-Buffer depth information
-        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
-        glViewport(0, 0, viewport_width_, viewport_height_);
-        
-        // Clear only color buffer, keep depth from G-Buffer
-        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
-        
-        // Copy depth from G-Buffer to final framebuffer
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, g_buffer_fbo_);
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer_);
-        glBlitFramebuffer(0, 0, viewport_width_, viewport_height_, 0, 0, viewport_width_, viewport_height_, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
-        
-        // Render skybox with proper depth testing
-        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
-        render_skybox(camera, resource_manager);
-
-        // SSAO pass (if enabled) - runs after G-Buffer generation
-        if (use_ssao_) {
-            SSAO_render(scene, camera, resource_manager);
-        }
-
-        if (use_ssgi_) {
-            // SSGI-enabled pipeline: Direct lighting -> SSGI -> Skybox -> Composition
-            // LOG_INFO("Renderer: Starting SSGI pipeline - Direct lighting pass");
-            render_direct_lighting_pass(scene, camera, resource_manager);
             
-            // LOG_INFO("Renderer: SSGI compute pass");
-            SSGI_render(scene, camera, resource_manager);
+            // sRGB encoding only applies to the albedo target; later passes write linear HDR
+            GLStateCache::disable(GL_FRAMEBUFFER_SRGB);
+        });
+        
+        // Hi-Z pyramid for accelerated ray marching and next frame's culling
+        graph.add_pass("hiz", [&](RenderGraph::PassBuilder& builder) {
+            builder.read(g_depth);
+            builder.write(hiz, Access::Image);
+            builder.set_side_effect();
+        }, [&](const RenderGraph&) {
+            generate_hiz_pyramid(resource_manager, g_depth_texture_->get_id());
+            // Next frame's early cull fetches the pyramid, and the graph forgets image writes between
+            // frames, so no pass barrier covers that read
+            glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+            hiz_view_projection_ = projection * view;
+            hiz_history_valid_ = true;
+        });
+        
+        // Skybox into the scene target, depth tested against the G-Buffer depth
+        graph.add_pass("skybox", [&](RenderGraph::PassBuilder& builder) {
+            builder.read(g_depth, Access::Attachment);
+            builder.write(scene_color);
+        }, [&](const RenderGraph&) {
+            GLuint scene_fbo = get_scene_target_fbo();
+            GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, scene_fbo);
+            GLStateCache::viewport(0, 0, render_width_, render_height_);
             
-            // Render skybox to main framebuffer before composition
-            glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
-            //render_skybox(camera, resource_manager);
-           
-            // LOG_INFO("Renderer: SSGI composition pass");
-            render_composition_pass(scene, camera, resource_manager);
-
-        } else {
-            // Traditional deferred lighting
-            bind_g_buffer_for_lighting_pass();
+            // Clear only color buffer, keep depth from G-Buffer
+            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
             
-            // Get lighting shader from ResourceManager
-            auto lighting_shader = resource_manager.get_shader("deferred_lighting_shader");
-            if (!lighting_shader) {
-                LOG_ERROR("Renderer: Deferred lighting shader not found in ResourceManager");
-                return;
+            // Copy depth from G-Buffer to final framebuffer (the TAA scene target shares the G-Buffer depth)
+            if (!is_taa_active()) {
+                GLStateCache::bind_framebuffer(GL_READ_FRAMEBUFFER, g_buffer_fbo_);
+                GLStateCache::bind_framebuffer(GL_DRAW_FRAMEBUFFER, framebuffer_);
+                glBlitFramebuffer(0, 0, viewport_width_, viewport_height_, 0, 0, viewport_width_, viewport_height_, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
             }
-        
-            lighting_shader->use();
-        
-            // Bind G-Buffer textures
-            // Set G-Buffer texture uniforms using dynamically assigned slots
-            if (g_pos_slot != Texture::INVALID_SLOT) lighting_shader->set_int("gPosition", g_pos_slot);
-            if (g_albedo_slot != Texture::INVALID_SLOT) lighting_shader->set_int("gAlbedoMetallic", g_albedo_slot);
-            if (g_normal_slot != Texture::INVALID_SLOT) lighting_shader->set_int("gNormalRoughness", g_normal_slot);
-            if (g_motion_slot != Texture::INVALID_SLOT) lighting_shader->set_int("gMotionAO", g_motion_slot);
-            if (g_emissive_slot != Texture::INVALID_SLOT) lighting_shader->set_int("gEmissive", g_emissive_slot);
-            if (g_depth_slot != Texture::INVALID_SLOT) lighting_shader->set_int("gDepth", g_depth_slot);
             
-
-        
-            // Set camera uniforms
-            lighting_shader->set_vec3("viewPos", camera_pos);
-            lighting_shader->set_mat4("view", view);
-            lighting_shader->set_mat4("projection", projection);
-        
-            // Set ambient lighting from scene
-            lighting_shader->set_vec3("ambientLight", scene.get_ambient_light());
-        
-            // Set up lighting using scene lights
-            auto scene_lights = resource_manager.get_scene_lights(scene);
-            size_t light_size = std::min(scene_lights.size(), size_t(8)); // Limit to 8 lights
-            lighting_shader->set_int("numLights", static_cast<int>(light_size));
+            // Render skybox with proper depth testing
+            GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, scene_fbo);
+            render_skybox(camera, resource_manager);
+        });
         
-
-        
-            for (size_t i = 0; i < light_size; ++i) {
-                auto light = scene_lights[i];
+        // SSAO: compute at the SSAO resolution, then blur
+        auto ssao_final = RenderGraph::INVALID_RESOURCE;
+        if (use_ssao_) {
+            glm::ivec2 ssao_size = get_effect_size(ssao_resolution_divisor_);
+            auto ssao_raw = graph.create_texture("ssao_raw", { ssao_size.x, ssao_size.y, GL_R16F });
+            ssao_final = graph.create_texture("ssao_final", { ssao_size.x, ssao_size.y, GL_R16F });
             
-                if (light) {
-                    // Use the new Light::set_shader_array method to set all light parameters
-                    light->set_shader_array(*lighting_shader, static_cast<int>(i));
-                } else {
-                    LOG_WARN("Renderer: Light {} is null", i);
-                }
-            }
-        
-            // IBL irradiance and prefiltered mapping
-            auto irradiance_map = resource_manager.get_irradiance_map("skybox_cubemap");
-            auto prefiltered_map = resource_manager.get_prefiltered_map("skybox_cubemap");
-        
-            if (irradiance_map && prefiltered_map) {
-                lighting_shader->set_bool("useIBL", true);
+            graph.add_pass("ssao", [&](RenderGraph::PassBuilder& builder) {
+                builder.read(g_normal);
+                builder.read(g_depth);
+                builder.write(ssao_raw, Access::Image);
+            }, [&, ssao_raw](const RenderGraph& resources) {
+                ssao_raw_texture_ = resources.get_texture(ssao_raw);
+                SSAO_render(scene, camera, resource_manager);
+            });
+            
+            graph.add_pass("ssao_blur", [&](RenderGraph::PassBuilder& builder) {
+                builder.read(ssao_raw);
+                builder.write(ssao_final);
+            }, [&, ssao_raw](const RenderGraph& resources) {
+                ssao_raw_texture_ = resources.get_texture(ssao_raw);
+                ssao_final_texture_ = resources.get_texture(ssao_final);
+                SSAO_blur(resource_manager);
+            });
+        }
+
+        if (use_ssgi_ || use_tiled_lighting_) {
+            // SSGI-enabled pipeline: Direct lighting -> SSGI -> Composition
+            // Tiled lighting also takes this path; the composition skips SSGI when it is off
+            auto lit_scene = graph.create_texture("lit_scene", { render_width_, render_height_, GL_RGBA16F });
             
-                // Bind irradiance map using automatic slot management
-                unsigned int irradiance_slot = irradiance_map->bind_cubemap_auto();
-                if (irradiance_slot != Texture::INVALID_SLOT) {
-                    lighting_shader->set_int("irradianceMap", irradiance_slot);
+            graph.add_pass("direct_lighting", [&](RenderGraph::PassBuilder& builder) {
+                read_g_buffer(builder);
+                builder.read(shadow_depth);
+                builder.read(shadow_min_max);
+                builder.write(lit_scene, use_tiled_lighting_ ? Access::Image : Access::Attachment);
+            }, [&, lit_scene](const RenderGraph& resources) {
+                lit_scene_texture_ = resources.get_texture(lit_scene);
+                render_direct_lighting_pass(scene, camera, resource_manager);
+            });
+            
+            auto ssgi_final = RenderGraph::INVALID_RESOURCE;
+            if (use_ssgi_) {
+                // Last frame's result becomes the history and its texture is reused as this frame's target
+                if (!ssgi_final_texture_) {
+                    create_ssgi_targets();
                 }
+                std::swap(ssgi_final_texture_, ssgi_prev_texture_);
+                std::swap(ssgi_geometry_texture_, ssgi_prev_geometry_texture_);
                 
-                // Bind prefiltered environment map using automatic slot management
-                unsigned int prefiltered_slot = prefiltered_map->bind_cubemap_auto();
-                if (prefiltered_slot != Texture::INVALID_SLOT) {
-                    lighting_shader->set_int("prefilteredMap", prefiltered_slot);
-                }
+                glm::ivec2 ssgi_size = get_effect_size(ssgi_resolution_divisor_);
+                auto ssgi_raw = graph.create_texture("ssgi_raw", { ssgi_size.x, ssgi_size.y, GL_RGBA16F });
+                auto ssgi_history = graph.import_texture("ssgi_history", ssgi_prev_texture_->get_id());
+                ssgi_final = graph.import_texture("ssgi_final", ssgi_final_texture_->get_id());
+                auto ssgi_geometry_history = graph.import_texture("ssgi_geometry_history", ssgi_prev_geometry_texture_->get_id());
+                auto ssgi_geometry = graph.import_texture("ssgi_geometry", ssgi_geometry_texture_->get_id());
                 
-                LOG_INFO("Renderer: IBL maps bound - irradiance: slot {}, prefiltered: slot {}", irradiance_slot, prefiltered_slot);
+                graph.add_pass("ssgi", [&](RenderGraph::PassBuilder& builder) {
+                    read_g_buffer(builder);
+                    builder.read(lit_scene);
+                    builder.read(hiz);
+                    builder.write(ssgi_raw, Access::Image);
+                }, [&, lit_scene, ssgi_raw](const RenderGraph& resources) {
+                    lit_scene_texture_ = resources.get_texture(lit_scene);
+                    ssgi_raw_texture_ = resources.get_texture(ssgi_raw);
+                    SSGI_render(scene, camera, resource_manager);
+                });
+                
+                graph.add_pass("ssgi_denoise", [&](RenderGraph::PassBuilder& builder) {
+                    builder.read(ssgi_raw);
+                    builder.read(ssgi_history);
+                    builder.read(ssgi_geometry_history);
+                    builder.read(g_normal);
+                    builder.read(g_motion);
+                    builder.read(g_depth);
+                    builder.write(ssgi_final);
+                    builder.write(ssgi_geometry);
+                }, [&, ssgi_raw](const RenderGraph& resources) {
+                    ssgi_raw_texture_ = resources.get_texture(ssgi_raw);
+                    SSGI_denoise(camera, resource_manager);
+                });
             } else {
-                lighting_shader->set_bool("useIBL", false);
-                LOG_WARN("Renderer: IBL maps not available (irradiance: {}, prefiltered: {}), using fallback ambient lighting", 
-                        irradiance_map ? "OK" : "missing", prefiltered_map ? "OK" : "missing");
+                ssgi_history_valid_ = false;
             }
-        
-            // Shadow mapping (if enabled)
-            if (shadow_map) {
-                lighting_shader->set_bool("enableShadows", true);
-            
-                // Bind shadow map texture using automatic slot management
-                GLuint shadow_texture_id = shadow_map->get_depth_texture();
-                unsigned int shadow_slot = Texture::bind_raw_texture(shadow_texture_id, GL_TEXTURE_2D);
-                if (shadow_slot != Texture::INVALID_SLOT) {
-                    lighting_shader->set_int("shadowMap", shadow_slot);
-                }
             
+            graph.add_pass("composition", [&](RenderGraph::PassBuilder& builder) {
+                read_g_buffer(builder);
+                builder.read(lit_scene);
+                builder.read(ssgi_final);
+                builder.read(ssao_final);
+                builder.write(scene_color);
+            }, [&, lit_scene](const RenderGraph& resources) {
+                lit_scene_texture_ = resources.get_texture(lit_scene);
+                ssao_final_texture_ = resources.get_texture(ssao_final);
+                render_composition_pass(scene, camera, resource_manager);
+            });
 
+        } else {
+            ssgi_history_valid_ = false;
             
-                // Use first light as shadow caster if available, otherwise use fixed position
-                glm::vec3 shadow_light_direction = glm::normalize(shadow_light_pos_);
-                if (light_size > 0 && scene_lights[0] && scene_lights[0]->get_type() == Light::Type::kDirectional) {
-                    shadow_light_direction = scene_lights[0]->get_direction();
-                }
-            
-                // For directional light shadows, center the shadow map around the scene center
-                glm::vec3 shadow_center = glm::vec3(0.0f, 0.0f, 0.0f); // Use scene center as shadow map center
-            
-                // Set light space matrix for shadow mapping (use the same matrix from shadow pass)
-                lighting_shader->set_mat4("lightSpaceMatrix", last_light_space_matrix_);
-            } else {
-                lighting_shader->set_bool("enableShadows", false);
-            }
-        
-            // Render screen-space quad
-            render_screen_quad();
+            // Traditional deferred lighting, blended onto the skybox
+            graph.add_pass("deferred_lighting", [&](RenderGraph::PassBuilder& builder) {
+                read_g_buffer(builder);
+                builder.read(shadow_depth);
+                builder.read(shadow_min_max);
+                builder.read(scene_color, Access::Attachment);
+                builder.write(scene_color);
+            }, [&](const RenderGraph&) {
+                render_deferred_lighting_pass(scene, camera, resource_manager);
+            });
             
             // Apply SSAO in a post-processing pass if enabled
             if (use_ssao_) {
-                apply_ssao_to_framebuffer(scene, camera, resource_manager);
+                graph.add_pass("ssao_apply", [&](RenderGraph::PassBuilder& builder) {
+                    builder.read(scene_color, Access::Attachment);
+                    builder.read(ssao_final);
+                    builder.read(g_normal);
+                    builder.read(g_motion);
+                    builder.read(g_depth);
+                    builder.write(scene_color);
+                }, [&](const RenderGraph& resources) {
+                    ssao_final_texture_ = resources.get_texture(ssao_final);
+                    apply_ssao_to_framebuffer(scene, camera, resource_manager);
+                    GLStateCache::enable(GL_DEPTH_TEST);
+                });
             }
-            
-            // Re-enable depth testing and disable blending for subsequent rendering
-            glEnable(GL_DEPTH_TEST);
-            glDisable(GL_BLEND);
         }
+        
+        // Resolve the jittered scene into the viewport-sized framebuffer
+        if (taa_active) {
+            graph.add_pass("taa_resolve", [&](RenderGraph::PassBuilder& builder) {
+                builder.read(scene_color);
+                builder.read(g_motion);
+                builder.read(g_depth);
+                builder.write(output_color);
+            }, [&](const RenderGraph&) {
+                render_taa_resolve(camera, resource_manager);
+            });
+        }
+        
+        {
+            PROFILE_SCOPE("RenderGraph::compile");
+            graph.compile();
+        }
+        graph.execute();
+        update_effect_times();
+        
+        clear_transient_targets();
 
             // Temporal function
             //render_plane_reflection(scene, camera, resource_manager, transform_manager);
@@ -636,15 +852,15 @@ namespace glRenderer {
         }
         
         // Bind final framebuffer for output
-        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
-        glViewport(0, 0, viewport_width_, viewport_height_);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, framebuffer_);
+        GLStateCache::viewport(0, 0, viewport_width_, viewport_height_);
         
         // Clear framebuffer
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         
         // Disable depth testing
-        glDisable(GL_DEPTH_TEST);
+        GLStateCache::disable(GL_DEPTH_TEST);
         
         // Get debug shader
         auto debug_shader = resource_manager.get_shader("gbuffer_debug_shader");
@@ -656,14 +872,12 @@ namespace glRenderer {
         debug_shader->use();
         
         // Bind G-Buffer textures using automatic slot management
-        unsigned int pos_slot = Texture::bind_raw_texture(g_position_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int albedo_slot = Texture::bind_raw_texture(g_albedo_metallic_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int normal_slot = Texture::bind_raw_texture(g_normal_roughness_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int motion_slot = Texture::bind_raw_texture(g_motion_ao_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int emissive_slot = Texture::bind_raw_texture(g_emissive_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int depth_slot = Texture::bind_raw_texture(g_depth_texture_->get_id(), GL_TEXTURE_2D);
         
-        if (pos_slot != Texture::INVALID_SLOT) debug_shader->set_int("gPosition", pos_slot);
         if (albedo_slot != Texture::INVALID_SLOT) debug_shader->set_int("gAlbedoMetallic", albedo_slot);
         if (normal_slot != Texture::INVALID_SLOT) debug_shader->set_int("gNormalRoughness", normal_slot);
         if (motion_slot != Texture::INVALID_SLOT) debug_shader->set_int("gMotionAO", motion_slot);
@@ -677,11 +891,13 @@ namespace glRenderer {
         render_screen_quad();
         
         // Re-enable depth testing
-        glEnable(GL_DEPTH_TEST);
+        GLStateCache::enable(GL_DEPTH_TEST);
     }
     
     
     void Renderer::render(const Scene& scene, const Camera& camera, const CoroutineResourceManager& resource_manager, const TransformManager& transform_manager) {
+        PROFILE_SCOPE("Renderer::render");
+        GLStateCache::invalidate();
         // Check if scene is empty
         if (scene.is_empty()) {
             LOG_ERROR("Renderer: Scene is empty, skipping rendering");
@@ -692,8 +908,8 @@ namespace glRenderer {
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         
         // Enable depth test and disable face culling
-        glEnable(GL_DEPTH_TEST);
-        glDisable(GL_CULL_FACE);
+        GLStateCache::enable(GL_DEPTH_TEST);
+        GLStateCache::disable(GL_CULL_FACE);
 
         // Update camera matrices
         glm::mat4 view = camera.get_view_matrix();
@@ -722,44 +938,28 @@ namespace glRenderer {
         auto scene_lights = resource_manager.get_scene_lights(scene);
         main_shader->set_int("numLights", static_cast<int>(scene_lights.size()));
         
-        for (size_t i = 0; i < scene_lights.size() && i < 8; ++i) {  // Limit to 8 lights
+        for (size_t i = 0; i < scene_lights.size() && i < MAX_LIGHTS; ++i) {
             auto light = scene_lights[i];
             if (light) {
                 light->set_shader(*main_shader); 
             }
         }
         
-        // Render all renderables in the scene
-        const auto& renderable_refs = scene.get_renderable_references();
+        // Render all renderables in the scene; visibility comes from the indirect command of each item.
+        // The Hi-Z pyramid can only be built when rendering into the offscreen framebuffer's depth texture.
+        bool build_hiz = use_occlusion_culling_ && use_framebuffer_;
+        if (!build_hiz) {
+            hiz_history_valid_ = false;
+        }
+        collect_draw_items(scene, resource_manager, transform_manager, true);
+        bool run_late_phase = cull_draw_items_early(resource_manager);
+        main_shader->use();
         
-        for (const auto& renderable_id : renderable_refs) {
-            auto renderable = resource_manager.get<Renderable>(renderable_id);
-            if (!renderable || !renderable->is_visible() || !renderable->has_models()) {
-                continue;
-            }
-            
-            // Get transform from external transform system
-            glm::mat4 renderable_matrix = transform_manager.get_model_matrix(renderable_id);
-            
-            // Render each model in the renderable
-            for (const auto& model_id : renderable->get_model_ids()) {
-            // Get model from ResourceManager
-            auto model = resource_manager.get<Model>(model_id);
-            if (!model) {
-                LOG_WARN("Renderer: Model '{}' not found in ResourceManager", model_id);
-                continue;
-            }
-            
-            // Validate model has required components
-            if (!model->has_mesh()) {
-                LOG_WARN("Renderer: Model '{}' has no mesh, skipping", model_id);
-                continue;
-            }
-            
-            if (!model->has_material()) {
-                LOG_WARN("Renderer: Model '{}' has no material, skipping", model_id);
-                continue;
-            }
+        auto draw_forward_items = [&]() {
+            occlusion_culler_->bind_commands();
+            for (uint32_t item_index = 0; item_index < draw_items_.size(); ++item_index) {
+            const DrawItem& item = draw_items_[item_index];
+            const std::string& model_id = *item.model_id;
             
             // Check if this is the plane model and use reflection shader
             if (model_id == "simple_scene_plane_model") {
@@ -779,7 +979,7 @@ namespace glRenderer {
                     auto scene_lights = resource_manager.get_scene_lights(scene);
                     plane_shader->set_int("numLights", static_cast<int>(scene_lights.size()));
                     
-                    for (size_t i = 0; i < scene_lights.size() && i < 8; ++i) {
+                    for (size_t i = 0; i < scene_lights.size() && i < MAX_LIGHTS; ++i) {
                         auto light = scene_lights[i];
                         if (light) {
                             light->set_shader(*plane_shader); 
@@ -799,11 +999,10 @@ namespace glRenderer {
                     plane_shader->set_float("reflectionStrength", 0.4f);
                     
                     // Get transform and render
-                    glm::mat4 model_matrix = transform_manager.get_model_matrix(model_id);
-                    plane_shader->set_mat4("model", model_matrix);
+                    plane_shader->set_mat4("model", item.model_matrix);
                     
                     // Set material properties
-                    const Material& material = *model->get_material();
+                    const Material& material = *item.model->get_material();
                     material.set_shader(*plane_shader, "material");
                     
                     // Bind material textures using automatic slot management
@@ -811,8 +1010,8 @@ namespace glRenderer {
                     
                     // Render the plane mesh
                     try {
-                        const Mesh& mesh = *model->get_mesh();
-                        mesh.draw();
+                        const Mesh& mesh = *item.model->get_mesh();
+                        mesh.draw_indirect(OcclusionCuller::get_command_offset(item_index));
                     } catch (const std::exception& e) {
                         LOG_ERROR("Renderer: Failed to render plane model '{}': {}", model_id, e.what());
                         continue;
@@ -825,12 +1024,10 @@ namespace glRenderer {
                 }
             } else {
                 // Use default shader for non-plane objects
-                // Get transform from external transform system
-                glm::mat4 model_matrix = transform_manager.get_model_matrix(model_id);
-                main_shader->set_mat4("model", model_matrix);
+                main_shader->set_mat4("model", item.model_matrix);
                 
                 // Set material properties
-                const Material& material = *model->get_material();
+                const Material& material = *item.model->get_material();
                 material.set_shader(*main_shader, "material");
                 
                 // Bind material textures using automatic slot management
@@ -838,15 +1035,36 @@ namespace glRenderer {
                 
                 // Render the model's mesh
                 try {
-                    const Mesh& mesh = *model->get_mesh();
-                    mesh.draw();
+                    const Mesh& mesh = *item.model->get_mesh();
+                    mesh.draw_indirect(OcclusionCuller::get_command_offset(item_index));
                 } catch (const std::exception& e) {
                     LOG_ERROR("Renderer: Failed to render model '{}': {}", model_id, e.what());
                     continue;
                 }
             }
+            }
+            occlusion_culler_->unbind_commands();
+        };
+        
+        draw_forward_items();
+        
+        if (build_hiz) {
+            if (run_late_phase) {
+                // Build a pyramid from what the early phase drew and draw items that became visible
+                generate_hiz_pyramid(resource_manager, depth_texture_->get_id());
+                glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+                cull_draw_items_late(resource_manager, projection * view);
+                
+                main_shader->use();
+                draw_forward_items();
+            }
+            
+            // Pyramid for next frame's early phase
+            generate_hiz_pyramid(resource_manager, depth_texture_->get_id());
+            glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+            hiz_view_projection_ = projection * view;
+            hiz_history_valid_ = true;
         }
-         }
          
          // Render skybox as background
          render_skybox(camera, resource_manager);
@@ -939,7 +1157,7 @@ namespace glRenderer {
         }
         
         // Enable depth testing for light spheres
-        glEnable(GL_DEPTH_TEST);
+        GLStateCache::enable(GL_DEPTH_TEST);
         
         light_shader->use();
         
@@ -1026,15 +1244,15 @@ namespace glRenderer {
         glGenVertexArrays(1, &skybox_vao_);
         glGenBuffers(1, &skybox_vbo_);
         
-        glBindVertexArray(skybox_vao_);
+        GLStateCache::bind_vertex_array(skybox_vao_);
         glBindBuffer(GL_ARRAY_BUFFER, skybox_vbo_);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(skybox_vertices), skybox_vertices, GL_STATIC_DRAW);
+        RenderStats::buffer_data(GL_ARRAY_BUFFER, sizeof(skybox_vertices), skybox_vertices, GL_STATIC_DRAW);
         
         // Position attribute
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
         
-        glBindVertexArray(0);
+        GLStateCache::bind_vertex_array(0);
         
         LOG_INFO("Skybox setup completed");
     }
@@ -1047,6 +1265,7 @@ namespace glRenderer {
             skybox_vbo_ = 0;
         }
         if (skybox_vao_ != 0) {
+            GLStateCache::forget_vertex_array(skybox_vao_);
             glDeleteVertexArrays(1, &skybox_vao_);
             skybox_vao_ = 0;
         }
@@ -1091,9 +1310,8 @@ namespace glRenderer {
         }
         
         // Render skybox cube
-        glBindVertexArray(skybox_vao_);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
-        glBindVertexArray(0);
+        GLStateCache::bind_vertex_array(skybox_vao_);
+        RenderStats::draw_arrays(GL_TRIANGLES, 0, 36);
         
         // Restore depth settings
         glDepthFunc(GL_LESS);
@@ -1109,7 +1327,7 @@ namespace glRenderer {
         shadow_map->begin_shadow_pass();
         shadow_map->get_shadow_shader()->use();
 
-        glEnable(GL_CULL_FACE);
+        GLStateCache::enable(GL_CULL_FACE);
         glCullFace(GL_FRONT);
 
         glm::vec3 shadow_light_direction = glm::normalize(shadow_light_pos_);
@@ -1204,9 +1422,15 @@ namespace glRenderer {
         }
 
         glCullFace(GL_BACK);
-        glDisable(GL_CULL_FACE);
+        GLStateCache::disable(GL_CULL_FACE);
 
         shadow_map->end_shadow_pass();
+        
+        // Min/max pyramid for the PCSS early-outs in the lighting passes
+        auto shadow_min_max_shader = resource_manager.get_shader("shadow_min_max_shader");
+        if (shadow_min_max_shader) {
+            shadow_map->build_min_max_pyramid(*shadow_min_max_shader);
+        }
     }
 
     void Renderer::render_plane_reflection(const Scene& scene, const Camera& camera, 
@@ -1243,9 +1467,9 @@ namespace glRenderer {
             }
             
             // Enable depth testing and disable blending for opaque plane rendering
-            glEnable(GL_DEPTH_TEST);
+            GLStateCache::enable(GL_DEPTH_TEST);
             glDepthFunc(GL_LESS);
-            glDisable(GL_BLEND);
+            GLStateCache::disable(GL_BLEND);
             
             plane_shader->use();
             
@@ -1343,6 +1567,7 @@ namespace glRenderer {
     void Renderer::cleanup_ssgi() {
         cleanup_ssgi_textures();
         if (ssgi_fbo_ != 0) {
+            GLStateCache::forget_framebuffer(ssgi_fbo_);
             glDeleteFramebuffers(1, &ssgi_fbo_);
             ssgi_fbo_ = 0;
         }
@@ -1351,43 +1576,46 @@ namespace glRenderer {
 
     void Renderer::setup_ssgi_textures() {
         // Generate framebuffer
+        // Generate framebuffer; its attachment is set by each pass that draws through it.
+        // The raw output and the lit scene come from the render target pool, the history
+        // textures are created on the first SSGI frame.
         glGenFramebuffers(1, &ssgi_fbo_);
-        glBindFramebuffer(GL_FRAMEBUFFER, ssgi_fbo_);
-
-        // Create SSGI raw texture using factory method
-        ssgi_raw_texture_ = std::make_unique<Texture>(Texture::create_framebuffer_texture(viewport_width_, viewport_height_, GL_RGBA16F, GL_RGBA, GL_FLOAT));
-
-        // Create SSGI final texture (denoised output) using factory method
-        ssgi_final_texture_ = std::make_unique<Texture>(Texture::create_framebuffer_texture(viewport_width_, viewport_height_, GL_RGBA16F, GL_RGBA, GL_FLOAT));
-
-        // Create lit scene texture (direct lighting only) using factory method
-        lit_scene_texture_ = std::make_unique<Texture>(Texture::create_framebuffer_texture(viewport_width_, viewport_height_, GL_RGBA16F, GL_RGBA, GL_FLOAT));
-
-        // Create previous frame SSGI texture for temporal accumulation using factory method
-        ssgi_prev_texture_ = std::make_unique<Texture>(Texture::create_framebuffer_texture(viewport_width_, viewport_height_, GL_RGBA16F, GL_RGBA, GL_FLOAT));
+        LOG_INFO("SSGI framebuffer setup completed");
+    }
 
-        // Attach textures to framebuffer 
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, ssgi_raw_texture_->get_id(), 0);
+    void Renderer::create_ssgi_targets() {
+        glm::ivec2 size = get_effect_size(ssgi_resolution_divisor_);
 
-        // Check framebuffer completeness
-        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-            LOG_ERROR("SSGI framebuffer is not complete!");
-        }
+        // Create SSGI final and history textures; they swap roles every frame
+        ssgi_final_texture_ = std::make_unique<Texture>(Texture::create_immutable_texture(size.x, size.y, GL_RGBA16F));
+        ssgi_prev_texture_ = std::make_unique<Texture>(Texture::create_immutable_texture(size.x, size.y, GL_RGBA16F));
+        ssgi_geometry_texture_ = std::make_unique<Texture>(Texture::create_immutable_texture(size.x, size.y, GL_RGBA16F));
+        ssgi_prev_geometry_texture_ = std::make_unique<Texture>(Texture::create_immutable_texture(size.x, size.y, GL_RGBA16F));
 
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        LOG_INFO("SSGI textures setup completed: {}x{}", viewport_width_, viewport_height_);
+        // New storage holds no history
+        ssgi_history_valid_ = false;
     }
 
     void Renderer::cleanup_ssgi_textures() {
-        // Texture objects will be automatically cleaned up by their destructors
-        ssgi_raw_texture_.reset();
+        // Pooled targets belong to the render graph, owned ones are cleaned up by their destructors
+        ssgi_raw_texture_ = nullptr;
+        lit_scene_texture_ = nullptr;
         ssgi_final_texture_.reset();
         ssgi_prev_texture_.reset();
-        lit_scene_texture_.reset();
+        ssgi_geometry_texture_.reset();
+        ssgi_prev_geometry_texture_.reset();
     }
 
     void Renderer::set_ssgi_enabled(bool enable) {
         use_ssgi_ = enable;
+        if (!enable) {
+            // Free the history; it is recreated on the next SSGI frame
+            ssgi_final_texture_.reset();
+            ssgi_prev_texture_.reset();
+            ssgi_geometry_texture_.reset();
+            ssgi_prev_geometry_texture_.reset();
+            ssgi_history_valid_ = false;
+        }
         LOG_INFO("SSGI {}", enable ? "enabled" : "disabled");
     }
 
@@ -1426,6 +1654,80 @@ namespace glRenderer {
         LOG_DEBUG("Renderer: SSGI num samples set to {}", num_samples);
     }
 
+    void Renderer::set_ssgi_resolution_divisor(int divisor) {
+        if (divisor != 1 && divisor != 2 && divisor != 4) {
+            LOG_WARN("Renderer: Unsupported SSGI resolution divisor {}, expected 1, 2 or 4", divisor);
+            return;
+        }
+        if (divisor == ssgi_resolution_divisor_) {
+            return;
+        }
+        ssgi_resolution_divisor_ = divisor;
+        if (ssgi_final_texture_) {
+            create_ssgi_targets();
+        }
+        glm::ivec2 size = get_effect_size(divisor);
+        LOG_INFO("Renderer: SSGI resolution set to 1/{} ({}x{})", divisor, size.x, size.y);
+    }
+
+    void Renderer::set_ssao_resolution_divisor(int divisor) {
+        if (divisor != 1 && divisor != 2 && divisor != 4) {
+            LOG_WARN("Renderer: Unsupported SSAO resolution divisor {}, expected 1, 2 or 4", divisor);
+            return;
+        }
+        if (divisor == ssao_resolution_divisor_) {
+            return;
+        }
+        ssao_resolution_divisor_ = divisor;
+        glm::ivec2 size = get_effect_size(divisor);
+        LOG_INFO("Renderer: SSAO resolution set to 1/{} ({}x{})", divisor, size.x, size.y);
+    }
+
+    float Renderer::get_ssao_gpu_time_ms(int divisor) const {
+        return ssao_time_ms_[get_resolution_index(divisor)];
+    }
+
+    float Renderer::get_ssgi_gpu_time_ms(int divisor) const {
+        return ssgi_time_ms_[get_resolution_index(divisor)];
+    }
+
+    glm::ivec2 Renderer::get_effect_size(int divisor) const {
+        // Round up so the low resolution grid covers every full resolution pixel
+        return glm::ivec2(std::max(1, (render_width_ + divisor - 1) / divisor),
+                          std::max(1, (render_height_ + divisor - 1) / divisor));
+    }
+
+    int Renderer::get_resolution_index(int divisor) {
+        return divisor >= 4 ? 2 : (divisor == 2 ? 1 : 0);
+    }
+
+    void Renderer::update_effect_times() {
+        // An effect's time is the sum of its graph passes, once all of them have a GPU result.
+        // Results lag a few frames, so the first ones after a resolution change are the old one's.
+        auto effect_time = [&](std::initializer_list<const char*> passes) {
+            float total = 0.0f;
+            size_t found = 0;
+            for (const auto& timing : render_graph_->get_pass_timings()) {
+                for (const char* pass : passes) {
+                    if (timing.name == pass && timing.gpu_ms >= 0.0f) {
+                        total += timing.gpu_ms;
+                        ++found;
+                    }
+                }
+            }
+            return found == passes.size() ? total : -1.0f;
+        };
+
+        float ssao_ms = effect_time({ "ssao", "ssao_blur" });
+        if (ssao_ms >= 0.0f) {
+            ssao_time_ms_[get_resolution_index(ssao_resolution_divisor_)] = ssao_ms;
+        }
+        float ssgi_ms = effect_time({ "ssgi", "ssgi_denoise" });
+        if (ssgi_ms >= 0.0f) {
+            ssgi_time_ms_[get_resolution_index(ssgi_resolution_divisor_)] = ssgi_ms;
+        }
+    }
+
     // SSAO Implementation
     void Renderer::setup_ssao() {
         setup_ssao_textures();
@@ -1437,6 +1739,7 @@ namespace glRenderer {
     void Renderer::cleanup_ssao() {
         cleanup_ssao_textures();
         if (ssao_fbo_ != 0) {
+            GLStateCache::forget_framebuffer(ssao_fbo_);
             glDeleteFramebuffers(1, &ssao_fbo_);
             ssao_fbo_ = 0;
         }
@@ -1444,32 +1747,15 @@ namespace glRenderer {
     }
 
     void Renderer::setup_ssao_textures() {
-        // Generate framebuffer
+        // Generate framebuffer; the raw and blurred targets come from the render target pool
         glGenFramebuffers(1, &ssao_fbo_);
-        glBindFramebuffer(GL_FRAMEBUFFER, ssao_fbo_);
-
-        // Create SSAO raw texture (single channel for AO values) using factory method
-        ssao_raw_texture_ = std::make_unique<Texture>(Texture::create_framebuffer_texture(viewport_width_, viewport_height_, GL_R16F, GL_RED, GL_FLOAT));
-
-        // Create SSAO final texture (blurred output) using factory method
-        ssao_final_texture_ = std::make_unique<Texture>(Texture::create_framebuffer_texture(viewport_width_, viewport_height_, GL_R16F, GL_RED, GL_FLOAT));
-
-        // Attach texture to framebuffer 
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, ssao_final_texture_->get_id(), 0);
-
-        // Check framebuffer completeness
-        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-            LOG_ERROR("SSAO framebuffer is not complete!");
-        }
-
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        LOG_INFO("SSAO textures setup completed: {}x{}", viewport_width_, viewport_height_);
+        LOG_INFO("SSAO framebuffer setup completed");
     }
 
     void Renderer::cleanup_ssao_textures() {
-        // Texture objects will be automatically cleaned up by their destructors
-        ssao_raw_texture_.reset();
-        ssao_final_texture_.reset();
+        // Pooled targets belong to the render graph, the noise texture is cleaned up by its destructor
+        ssao_raw_texture_ = nullptr;
+        ssao_final_texture_ = nullptr;
         ssao_noise_texture_.reset();
     }
 
@@ -1503,50 +1789,53 @@ namespace glRenderer {
             LOG_ERROR("SSAO apply shader not found in ResourceManager");
             return;
         }
+        if (!ssao_final_texture_) {
+            return;
+        }
 
-        // Create a temporary texture to store current framebuffer content
-        GLuint temp_texture;
-        glGenTextures(1, &temp_texture);
-        glBindTexture(GL_TEXTURE_2D, temp_texture);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, viewport_width_, viewport_height_, 0, GL_RGBA, GL_FLOAT, nullptr);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        // Temporary copy of the current framebuffer content; shares its allocation with the lit scene target
+        Texture* temp_texture = render_target_pool_->acquire({ render_width_, render_height_, GL_RGBA16F });
 
         // Copy current framebuffer content to temporary texture
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer_);
-        glBindTexture(GL_TEXTURE_2D, temp_texture);
-        glCopyTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 0, 0, viewport_width_, viewport_height_, 0);
+        GLStateCache::bind_framebuffer(GL_READ_FRAMEBUFFER, get_scene_target_fbo());
+        GLStateCache::bind_texture(GL_TEXTURE_2D, temp_texture->get_id());
+        glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, render_width_, render_height_);
 
         // Now render back to framebuffer with SSAO applied
-        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
-        glViewport(0, 0, viewport_width_, viewport_height_);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, get_scene_target_fbo());
+        GLStateCache::viewport(0, 0, render_width_, render_height_);
         
         // Disable depth testing for screen-space quad
-        glDisable(GL_DEPTH_TEST);
-        glDisable(GL_CULL_FACE);
-        glDisable(GL_BLEND);
+        GLStateCache::disable(GL_DEPTH_TEST);
+        GLStateCache::disable(GL_CULL_FACE);
+        GLStateCache::disable(GL_BLEND);
 
         ssao_apply_shader->use();
         
         // Bind textures
         Texture::reset_slot_counter();
-        unsigned int scene_slot = Texture::bind_raw_texture(temp_texture, GL_TEXTURE_2D);
+        unsigned int scene_slot = Texture::bind_raw_texture(temp_texture->get_id(), GL_TEXTURE_2D);
         unsigned int ssao_slot = Texture::bind_raw_texture(ssao_final_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int motion_ao_slot = Texture::bind_raw_texture(g_motion_ao_texture_->get_id(), GL_TEXTURE_2D);
-        unsigned int pos_slot = Texture::bind_raw_texture(g_position_texture_->get_id(), GL_TEXTURE_2D);
+        unsigned int depth_slot = Texture::bind_raw_texture(g_depth_texture_->get_id(), GL_TEXTURE_2D);
         
         if (scene_slot != Texture::INVALID_SLOT) ssao_apply_shader->set_int("sceneTexture", scene_slot);
         if (ssao_slot != Texture::INVALID_SLOT) ssao_apply_shader->set_int("ssaoTexture", ssao_slot);
         if (motion_ao_slot != Texture::INVALID_SLOT) ssao_apply_shader->set_int("gMotionAO", motion_ao_slot);
-        if (pos_slot != Texture::INVALID_SLOT) ssao_apply_shader->set_int("gPosition", pos_slot);
+        if (depth_slot != Texture::INVALID_SLOT) ssao_apply_shader->set_int("gDepth", depth_slot);
+        unsigned int normal_slot = Texture::bind_raw_texture(g_normal_roughness_texture_->get_id(), GL_TEXTURE_2D);
+        if (normal_slot != Texture::INVALID_SLOT) ssao_apply_shader->set_int("gNormalRoughness", normal_slot);
+
+        // Low resolution SSAO is upsampled with depth and normal weights
+        glm::mat4 projection = camera.get_projection_matrix(static_cast<float>(viewport_width_) / static_cast<float>(viewport_height_));
+        ssao_apply_shader->set_mat4("invProjection", glm::inverse(projection));
+        ssao_apply_shader->set_int("ssaoResolutionScale", ssao_resolution_divisor_);
 
         // Render screen-space quad
         render_screen_quad();
 
-        // Clean up temporary texture
-        glDeleteTextures(1, &temp_texture);
+        // Hand the temporary texture back to the pool
+        render_target_pool_->release(temp_texture);
         
         LOG_DEBUG("SSAO applied to framebuffer");
     }
@@ -1570,6 +1859,8 @@ namespace glRenderer {
             return;
         }
 
+        glm::ivec2 ssao_size = get_effect_size(ssao_resolution_divisor_);
+
         // Camera matrices
         glm::mat4 view = camera.get_view_matrix();
         glm::mat4 projection = camera.get_projection_matrix(static_cast<float>(viewport_width_) / static_cast<float>(viewport_height_));
@@ -1603,12 +1894,10 @@ namespace glRenderer {
         
         // Bind G-Buffer textures using automatic slot management
         Texture::unbind_all_textures();
-        unsigned int ssao_pos_slot = Texture::bind_raw_texture(g_position_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int ssao_normal_slot = Texture::bind_raw_texture(g_normal_roughness_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int ssao_depth_slot = Texture::bind_raw_texture(g_depth_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int ssao_noise_slot = Texture::bind_raw_texture(ssao_noise_texture_->get_id(), GL_TEXTURE_2D);
         
-        if (ssao_pos_slot != Texture::INVALID_SLOT) ssao_compute_shader->set_int("gPosition", ssao_pos_slot);
         if (ssao_normal_slot != Texture::INVALID_SLOT) ssao_compute_shader->set_int("gNormalRoughness", ssao_normal_slot);
         if (ssao_depth_slot != Texture::INVALID_SLOT) ssao_compute_shader->set_int("gDepth", ssao_depth_slot);
         if (ssao_noise_slot != Texture::INVALID_SLOT) ssao_compute_shader->set_int("noiseTexture", ssao_noise_slot);
@@ -1625,7 +1914,8 @@ namespace glRenderer {
         ssao_compute_shader->set_float("radius", 0.5f);
         ssao_compute_shader->set_float("bias", 0.025f);
         ssao_compute_shader->set_float("intensity", 1.0f);
-        ssao_compute_shader->set_vec2("noiseScale", glm::vec2(viewport_width_ / 4.0f, viewport_height_ / 4.0f));
+        ssao_compute_shader->set_vec2("noiseScale", glm::vec2(ssao_size.x / 4.0f, ssao_size.y / 4.0f));
+        ssao_compute_shader->set_int("resolutionScale", ssao_resolution_divisor_);
 
         // Upload sample kernel
         for (unsigned int i = 0; i < 64; ++i) {
@@ -1633,16 +1923,25 @@ namespace glRenderer {
         }
 
         // Bind output texture
-        glBindImageTexture(0, ssao_raw_texture_->get_id(), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R16F);
+        RenderStats::bind_image_texture(0, ssao_raw_texture_->get_id(), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R16F);
+
+        // Dispatch one thread per SSAO texel
+        RenderStats::dispatch_compute((ssao_size.x + 7) / 8, (ssao_size.y + 7) / 8, 1);
+    }
 
-        // Dispatch compute shader
-        glDispatchCompute((viewport_width_ + 7) / 8, (viewport_height_ + 7) / 8, 1);
-        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+    void Renderer::SSAO_blur(const CoroutineResourceManager& resource_manager) {
+        auto ssao_blur_shader = resource_manager.get_shader("ssao_blur_shader");
+        if (!ssao_blur_shader) {
+            LOG_ERROR("SSAO blur shader not found in ResourceManager");
+            return;
+        }
 
-        // Step 2: Blur Pass
-        glBindFramebuffer(GL_FRAMEBUFFER, ssao_fbo_);
+        glm::ivec2 ssao_size = get_effect_size(ssao_resolution_divisor_);
+
+        // Blur Pass at SSAO resolution, upsampled later by the composition pass
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, ssao_fbo_);
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, ssao_final_texture_->get_id(), 0);
-        glViewport(0, 0, viewport_width_, viewport_height_);
+        GLStateCache::viewport(0, 0, ssao_size.x, ssao_size.y);
         glClear(GL_COLOR_BUFFER_BIT);
 
         ssao_blur_shader->use();
@@ -1654,13 +1953,14 @@ namespace glRenderer {
         if (blur_input_slot != Texture::INVALID_SLOT) ssao_blur_shader->set_int("ssaoInput", blur_input_slot);
 
         // Set blur parameters
-        ssao_blur_shader->set_vec2("screenSize", glm::vec2(viewport_width_, viewport_height_));
+        ssao_blur_shader->set_vec2("screenSize", glm::vec2(ssao_size));
         ssao_blur_shader->set_int("blurRadius", 2);
 
         // Render full-screen quad
         render_screen_quad();
 
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, 0);
+        GLStateCache::viewport(0, 0, render_width_, render_height_);
         LOG_DEBUG("SSAO render pass completed");
     }
 
@@ -1669,101 +1969,176 @@ namespace glRenderer {
     // Hi-Z Buffer Implementation
     void Renderer::setup_hiz_buffer() {
         // Calculate number of mip levels needed
-        int max_dimension = std::max(viewport_width_, viewport_height_);
+        int max_dimension = std::max(render_width_, render_height_);
         hiz_mip_levels_ = static_cast<int>(std::floor(std::log2(max_dimension))) + 1;
         
-        glGenTextures(2, hiz_textures_);
+        glGenTextures(1, &hiz_texture_);
+        GLStateCache::bind_texture(GL_TEXTURE_2D, hiz_texture_);
+        glTexStorage2D(GL_TEXTURE_2D, hiz_mip_levels_, GL_R32F, render_width_, render_height_);
+        hiz_gpu_bytes_ = Texture::get_texture_bytes(GL_R32F, render_width_, render_height_, 1, hiz_mip_levels_);
+        MemoryTracker::get_instance().allocate(MemoryCategory::k_render_targets, hiz_gpu_bytes_);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         
-        for (int i = 0; i < 2; ++i) {
-            glBindTexture(GL_TEXTURE_2D, hiz_textures_[i]);
-            glTexStorage2D(GL_TEXTURE_2D, hiz_mip_levels_, GL_R32F, viewport_width_, viewport_height_);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        }
+        // New storage holds no usable depth for occlusion culling
+        hiz_history_valid_ = false;
         
-        LOG_INFO("Hi-Z Ping-Pong Buffers setup completed: {}x{} with {} mip levels", 
-            viewport_width_, viewport_height_, hiz_mip_levels_);
+        // Workgroup counter used by the last workgroup to detect it should reduce the tail levels.
+        // The shader resets it to zero after use, so it is only cleared here.
+        GLuint zero = 0;
+        glGenBuffers(1, &hiz_counter_buffer_);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, hiz_counter_buffer_);
+        RenderStats::buffer_data(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint), &zero, GL_DYNAMIC_COPY);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        
+        LOG_INFO("Hi-Z Buffer setup completed: {}x{} with {} mip levels", 
+            render_width_, render_height_, hiz_mip_levels_);
     }
 
     void Renderer::cleanup_hiz_buffer() {
-        if (hiz_textures_[0] != 0) {
-            glDeleteTextures(2, hiz_textures_);
-            hiz_textures_[0] = 0;
-            hiz_textures_[1] = 0;
+        if (hiz_texture_ != 0) {
+            GLStateCache::forget_texture(hiz_texture_);
+            glDeleteTextures(1, &hiz_texture_);
+            hiz_texture_ = 0;
+            MemoryTracker::get_instance().release(MemoryCategory::k_render_targets, hiz_gpu_bytes_);
+            hiz_gpu_bytes_ = 0;
+        }
+        if (hiz_counter_buffer_ != 0) {
+            glDeleteBuffers(1, &hiz_counter_buffer_);
+            hiz_counter_buffer_ = 0;
         }
-        final_hiz_texture_ = 0;
         hiz_mip_levels_ = 0;
-        LOG_INFO("Hi-Z Buffer ping-pong cleanup completed");
+        LOG_INFO("Hi-Z Buffer cleanup completed");
     }
 
-    void Renderer::generate_hiz_pyramid(const CoroutineResourceManager& resource_manager) {
+    void Renderer::generate_hiz_pyramid(const CoroutineResourceManager& resource_manager, GLuint depth_texture) {
         auto hiz_compute_shader = resource_manager.get_shader("hiz_generate_shader");
         if (!hiz_compute_shader) { 
             LOG_ERROR("Renderer: Hi-Z compute shader not found in ResourceManager");
             return; 
         }
         hiz_compute_shader->use();
-
-        // Step 1: Generate Mip 0 from G-Buffer depth texture to hiz_textures_[0]
-        LOG_DEBUG("Hi-Z: Generating Mip 0 from G-Buffer depth texture (ID: {}) to Hi-Z texture (ID: {})", 
-                  g_depth_texture_->get_id(), hiz_textures_[0]);
         
-        unsigned int depth_slot = Texture::bind_raw_texture(g_depth_texture_->get_id(), GL_TEXTURE_2D);
-        if (depth_slot != Texture::INVALID_SLOT) {
-            hiz_compute_shader->set_int("inputDepthTexture", depth_slot);
-        }
-        hiz_compute_shader->set_int("currentMipLevel", 0);
+        // Each dispatch writes up to 8 consecutive levels (one image unit per level, the GL minimum).
+        // A 1080p or 4K pyramid needs two dispatches; the second starts from the last level of the first.
+        constexpr int levels_per_dispatch = 8;
         
-        glBindImageTexture(0, hiz_textures_[0], 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        Texture::reset_slot_counter();
+        unsigned int depth_slot = Texture::bind_raw_texture(depth_texture, GL_TEXTURE_2D);
+        unsigned int hiz_slot = Texture::bind_raw_texture(hiz_texture_, GL_TEXTURE_2D);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, hiz_counter_buffer_);
         
-        int mip_width = viewport_width_;
-        int mip_height = viewport_height_;
-        LOG_DEBUG("Hi-Z: Dispatching compute for Mip 0: {}x{}, groups: {}x{}", 
-                  mip_width, mip_height, (mip_width + 7) / 8, (mip_height + 7) / 8);
-        glDispatchCompute((mip_width + 7) / 8, (mip_height + 7) / 8, 1);
+        for (int base_mip = 0; base_mip < hiz_mip_levels_; base_mip += levels_per_dispatch) {
+            int mip_count = std::min(levels_per_dispatch, hiz_mip_levels_ - base_mip);
+            
+            // Level 0 is copied from the scene depth, later dispatches read the previous Hi-Z level
+            unsigned int input_slot = (base_mip == 0) ? depth_slot : hiz_slot;
+            if (input_slot != Texture::INVALID_SLOT) {
+                hiz_compute_shader->set_int("inputDepthTexture", input_slot);
+            }
+            hiz_compute_shader->set_int("inputMipLevel", base_mip - 1);
+            hiz_compute_shader->set_int("mipCount", mip_count);
+            
+            // Unused image units point at the last level; the shader never writes past mipCount
+            for (int i = 0; i < levels_per_dispatch; ++i) {
+                int mip = std::min(base_mip + i, hiz_mip_levels_ - 1);
+                RenderStats::bind_image_texture(i, hiz_texture_, mip, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
+            }
+            
+            // One workgroup per 64x64 tile of the first level written
+            int base_width = std::max(1, render_width_ >> base_mip);
+            int base_height = std::max(1, render_height_ >> base_mip);
+            RenderStats::dispatch_compute((base_width + 63) / 64, (base_height + 63) / 64, 1);
+            
+            // The next dispatch, or the next generation, counts finished workgroups with the counter the
+            // last workgroup reset. The next dispatch also reads the last level written; the pyramid's
+            // barrier after the last dispatch is the caller's, which knows who reads it next: the late
+            // cull or next frame's early cull.
+            GLbitfield barriers = GL_SHADER_STORAGE_BARRIER_BIT;
+            if (base_mip + levels_per_dispatch < hiz_mip_levels_) {
+                barriers |= GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT;
+            }
+            glMemoryBarrier(barriers);
+        }
         
-        // Memory barrier to ensure Mip 0 is complete
-        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
-
-        GLuint read_texture = hiz_textures_[0];
-        GLuint write_texture = hiz_textures_[1];
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 0);
         
-        // Bind both Hi-Z textures once at the beginning
-        unsigned int hiz_slot_0 = Texture::bind_raw_texture(hiz_textures_[0], GL_TEXTURE_2D);
-        unsigned int hiz_slot_1 = Texture::bind_raw_texture(hiz_textures_[1], GL_TEXTURE_2D);
+        LOG_DEBUG("Hi-Z pyramid generation completed");
+    }
 
-        // Step 2: Generate Mip 1 to N, alternating read/write
-        for (int mip = 1; mip < hiz_mip_levels_; ++mip) {
-            // Ensure previous write is complete, safe to read
-            glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+    void Renderer::set_occlusion_culling_enabled(bool enable) {
+        use_occlusion_culling_ = enable;
+        hiz_history_valid_ = false;
+        LOG_INFO("Occlusion culling {}", enable ? "enabled" : "disabled");
+    }
 
-            // Bind output texture mip
-            glBindImageTexture(0, write_texture, mip, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+    void Renderer::set_tiled_lighting_enabled(bool enable) {
+        use_tiled_lighting_ = enable;
+        LOG_INFO("Tiled lighting {}", enable ? "enabled" : "disabled");
+    }
 
-            // Use the appropriate slot based on which texture we're reading from
-            unsigned int current_read_slot = (read_texture == hiz_textures_[0]) ? hiz_slot_0 : hiz_slot_1;
-            hiz_compute_shader->set_int("inputDepthTexture", current_read_slot);
-            hiz_compute_shader->set_int("inputMipLevel", mip - 1);
-            hiz_compute_shader->set_int("currentMipLevel", mip);
+    void Renderer::collect_draw_items(const Scene& scene, const CoroutineResourceManager& resource_manager,
+                                      const TransformManager& transform_manager, bool use_model_transforms) {
+        draw_items_.clear();
+        occlusion_culler_->begin_frame();
+        material_table_->begin_frame();
+        
+        for (const auto& renderable_id : scene.get_renderable_references()) {
+            auto renderable = resource_manager.get<Renderable>(renderable_id);
+            if (!renderable || !renderable->is_visible() || !renderable->has_models()) {
+                continue;
+            }
             
-            // Dispatch
-            mip_width = std::max(1, viewport_width_ >> mip);
-            mip_height = std::max(1, viewport_height_ >> mip);
-            glDispatchCompute((mip_width + 7) / 8, (mip_height + 7) / 8, 1);
+            // Get transform from external transform system
+            glm::mat4 renderable_matrix = transform_manager.get_model_matrix(renderable_id);
             
-            // Swap roles for next iteration
-            std::swap(read_texture, write_texture);
+            for (const auto& model_id : renderable->get_model_ids()) {
+                auto model = resource_manager.get<Model>(model_id);
+                if (!model || !model->has_mesh() || !model->has_material()) {
+                    continue;
+                }
+                
+                glm::mat4 model_matrix = use_model_transforms ? transform_manager.get_model_matrix(model_id) : renderable_matrix;
+                const Mesh& mesh = *model->get_mesh();
+                
+                // Draw item index and indirect command index are the same; the command carries the
+                // material record index as its base instance
+                uint32_t material_index = material_table_->add(*model->get_material(), resource_manager);
+                occlusion_culler_->add_draw_item(mesh.get_bounds_min(), mesh.get_bounds_max(), model_matrix,
+                                                 mesh.get_index_count(), material_index);
+                draw_items_.push_back({ model.get(), &model_id, model_matrix });
+            }
         }
         
-        // Step 3: Record final result texture, no copy needed!
-        final_hiz_texture_ = read_texture; 
+        material_table_->upload();
+    }
 
-        // Final barrier to ensure all generation operations are complete for subsequent passes
-        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+    bool Renderer::cull_draw_items_early(const CoroutineResourceManager& resource_manager) {
+        auto cull_shader = use_occlusion_culling_ ? resource_manager.get_shader("occlusion_cull_shader") : nullptr;
+        bool can_cull = cull_shader && hiz_history_valid_;
         
-        LOG_DEBUG("Hi-Z pyramid generation completed");
+        // Without a previous pyramid every item is drawn and no late phase is needed
+        occlusion_culler_->upload(!can_cull);
+        if (!can_cull) {
+            return false;
+        }
+        
+        // Last frame's pyramid is tested with last frame's view-projection (reprojection)
+        occlusion_culler_->cull(OcclusionCuller::Phase::Early, *cull_shader, hiz_view_projection_,
+                                hiz_texture_, render_width_, render_height_, hiz_mip_levels_);
+        return true;
+    }
+
+    void Renderer::cull_draw_items_late(const CoroutineResourceManager& resource_manager, const glm::mat4& view_projection) {
+        auto cull_shader = resource_manager.get_shader("occlusion_cull_shader");
+        if (!cull_shader) {
+            return;
+        }
+        
+        occlusion_culler_->cull(OcclusionCuller::Phase::Late, *cull_shader, view_projection,
+                                hiz_texture_, render_width_, render_height_, hiz_mip_levels_);
     }
 
     void Renderer::SSGI_render(const Scene& scene, const Camera& camera, const CoroutineResourceManager& resource_manager) {
@@ -1773,6 +2148,7 @@ namespace glRenderer {
         }
         
         if (!use_ssgi_) {
+            ssgi_history_valid_ = false;
             return;
         }
 
@@ -1786,6 +2162,8 @@ namespace glRenderer {
             return;
         }
 
+        glm::ivec2 ssgi_size = get_effect_size(ssgi_resolution_divisor_);
+
         // Camera matrices
         glm::mat4 view = camera.get_view_matrix();
         glm::mat4 projection = camera.get_projection_matrix(static_cast<float>(viewport_width_) / static_cast<float>(viewport_height_));
@@ -1798,15 +2176,13 @@ namespace glRenderer {
         
         // Bind G-Buffer textures using automatic slot management
         Texture::reset_slot_counter();
-        unsigned int ssgi_pos_slot = Texture::bind_raw_texture(g_position_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int ssgi_albedo_slot = Texture::bind_raw_texture(g_albedo_metallic_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int ssgi_normal_slot = Texture::bind_raw_texture(g_normal_roughness_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int ssgi_motion_slot = Texture::bind_raw_texture(g_motion_ao_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int ssgi_depth_slot = Texture::bind_raw_texture(g_depth_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int ssgi_lit_slot = Texture::bind_raw_texture(lit_scene_texture_->get_id(), GL_TEXTURE_2D);
-        unsigned int ssgi_hiz_slot = Texture::bind_raw_texture(final_hiz_texture_, GL_TEXTURE_2D);
+        unsigned int ssgi_hiz_slot = Texture::bind_raw_texture(hiz_texture_, GL_TEXTURE_2D);
         
-        if (ssgi_pos_slot != Texture::INVALID_SLOT) ssgi_compute_shader->set_int("gPosition", ssgi_pos_slot);
         if (ssgi_albedo_slot != Texture::INVALID_SLOT) ssgi_compute_shader->set_int("gAlbedoMetallic", ssgi_albedo_slot);
         if (ssgi_normal_slot != Texture::INVALID_SLOT) ssgi_compute_shader->set_int("gNormalRoughness", ssgi_normal_slot);
         if (ssgi_motion_slot != Texture::INVALID_SLOT) ssgi_compute_shader->set_int("gMotionAO", ssgi_motion_slot);
@@ -1828,18 +2204,33 @@ namespace glRenderer {
         ssgi_compute_shader->set_float("thickness", ssgi_thickness_);
         ssgi_compute_shader->set_float("intensity", ssgi_intensity_);
         ssgi_compute_shader->set_int("numSamples", ssgi_num_samples_);
+        ssgi_compute_shader->set_int("resolutionScale", ssgi_resolution_divisor_);
 
         // Bind output texture
-        glBindImageTexture(0, ssgi_raw_texture_->get_id(), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+        RenderStats::bind_image_texture(0, ssgi_raw_texture_->get_id(), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA16F);
 
-        // Dispatch compute shader using actual viewport dimensions
-        glDispatchCompute((viewport_width_ + 7) / 8, (viewport_height_ + 7) / 8, 1);
-        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+        // Dispatch one thread per SSGI texel
+        RenderStats::dispatch_compute((ssgi_size.x + 7) / 8, (ssgi_size.y + 7) / 8, 1);
+    }
+
+    void Renderer::SSGI_denoise(const Camera& camera, const CoroutineResourceManager& resource_manager) {
+        auto ssgi_denoise_shader = resource_manager.get_shader("ssgi_denoise_shader");
+        if (!ssgi_denoise_shader) {
+            LOG_ERROR("SSGI denoise shader not found in ResourceManager");
+            return;
+        }
+
+        glm::ivec2 ssgi_size = get_effect_size(ssgi_resolution_divisor_);
 
-        // Step 2: Denoising Pass
-        glBindFramebuffer(GL_FRAMEBUFFER, ssgi_fbo_);
+        // Denoising Pass at SSGI resolution into this frame's half of the ping-pong pairs,
+        // upsampled later by the composition pass. The second target keeps the normal and
+        // depth it was filtered against for the next frame's disocclusion test.
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, ssgi_fbo_);
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, ssgi_final_texture_->get_id(), 0);
-        glViewport(0, 0, viewport_width_, viewport_height_);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, ssgi_geometry_texture_->get_id(), 0);
+        GLenum denoise_draw_buffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+        glDrawBuffers(2, denoise_draw_buffers);
+        GLStateCache::viewport(0, 0, ssgi_size.x, ssgi_size.y);
         glClear(GL_COLOR_BUFFER_BIT);
 
         ssgi_denoise_shader->use();
@@ -1848,14 +2239,14 @@ namespace glRenderer {
         Texture::reset_slot_counter();
         unsigned int denoise_raw_slot = Texture::bind_raw_texture(ssgi_raw_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int denoise_prev_slot = Texture::bind_raw_texture(ssgi_prev_texture_->get_id(), GL_TEXTURE_2D);
-        unsigned int denoise_pos_slot = Texture::bind_raw_texture(g_position_texture_->get_id(), GL_TEXTURE_2D);
+        unsigned int denoise_prev_geometry_slot = Texture::bind_raw_texture(ssgi_prev_geometry_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int denoise_normal_slot = Texture::bind_raw_texture(g_normal_roughness_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int denoise_motion_slot = Texture::bind_raw_texture(g_motion_ao_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int denoise_depth_slot = Texture::bind_raw_texture(g_depth_texture_->get_id(), GL_TEXTURE_2D);
         
         if (denoise_raw_slot != Texture::INVALID_SLOT) ssgi_denoise_shader->set_int("ssgi_raw_texture", denoise_raw_slot);
         if (denoise_prev_slot != Texture::INVALID_SLOT) ssgi_denoise_shader->set_int("ssgi_prev_texture", denoise_prev_slot);
-        if (denoise_pos_slot != Texture::INVALID_SLOT) ssgi_denoise_shader->set_int("gPosition", denoise_pos_slot);
+        if (denoise_prev_geometry_slot != Texture::INVALID_SLOT) ssgi_denoise_shader->set_int("ssgi_prev_geometry", denoise_prev_geometry_slot);
         if (denoise_normal_slot != Texture::INVALID_SLOT) ssgi_denoise_shader->set_int("gNormalRoughness", denoise_normal_slot);
         if (denoise_motion_slot != Texture::INVALID_SLOT) ssgi_denoise_shader->set_int("gMotionAO", denoise_motion_slot);
         if (denoise_depth_slot != Texture::INVALID_SLOT) ssgi_denoise_shader->set_int("gDepth", denoise_depth_slot);
@@ -1864,30 +2255,37 @@ namespace glRenderer {
         ssgi_denoise_shader->set_float("spatialSigma", 2.0f);
         ssgi_denoise_shader->set_float("normalSigma", 0.1f);
         ssgi_denoise_shader->set_float("depthSigma", 0.01f);
-        ssgi_denoise_shader->set_int("filterRadius", 2);
-        ssgi_denoise_shader->set_bool("enableTemporalFilter", false);
-        ssgi_denoise_shader->set_vec2("screenSize", glm::vec2(viewport_width_, viewport_height_));
+        ssgi_denoise_shader->set_bool("enableTemporalFilter", true);
+        ssgi_denoise_shader->set_vec2("screenSize", glm::vec2(ssgi_size));
         
         // Set temporal accumulation parameters
-        ssgi_denoise_shader->set_float("temporalAlpha", 0.9f);      // High temporal weight for stability
-        ssgi_denoise_shader->set_float("maxTemporalWeight", 0.95f); // Maximum temporal contribution
-        ssgi_denoise_shader->set_bool("isFirstFrame", first_frame_);
+        ssgi_denoise_shader->set_bool("historyValid", ssgi_history_valid_);
+        ssgi_denoise_shader->set_float("maxHistoryLength", 32.0f);      // Caps the blend at 1/32 of the new frame
+        ssgi_denoise_shader->set_float("convergedHistoryLength", 8.0f); // From here on the spatial filter shrinks to 3x3
+        ssgi_denoise_shader->set_float("varianceClipGamma", 1.25f);     // Width of the neighbourhood clip box in std devs
+        ssgi_denoise_shader->set_float("historyDepthTolerance", 0.05f); // 5% of the view depth, covers camera motion along the view axis
+        glm::mat4 projection = camera.get_projection_matrix(static_cast<float>(viewport_width_) / static_cast<float>(viewport_height_));
+        ssgi_denoise_shader->set_mat4("invProjection", glm::inverse(projection));
 
         // Render full-screen quad
         render_screen_quad();
 
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        
-        // Copy current frame SSGI result to previous frame texture for next frame temporal accumulation
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, ssgi_fbo_);
-        glReadBuffer(GL_COLOR_ATTACHMENT0);
-        glBindTexture(GL_TEXTURE_2D, ssgi_prev_texture_->get_id());
-        glCopyTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, 0, 0, viewport_width_, viewport_height_, 0);
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        // The direct lighting pass draws through the same framebuffer with one target
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, 0, 0);
+        glDrawBuffer(GL_COLOR_ATTACHMENT0);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, 0);
+        ssgi_history_valid_ = true;
+
+        GLStateCache::viewport(0, 0, render_width_, render_height_);
         LOG_DEBUG("SSGI render pass completed");
     }
 
     void Renderer::render_direct_lighting_pass(const Scene& scene, const Camera& camera, const CoroutineResourceManager& resource_manager) {
+        if (use_tiled_lighting_) {
+            render_tiled_lighting_pass(scene, camera, resource_manager);
+            return;
+        }
+        
         // Initialize screen quad if not already done
         if (!screen_quad_mesh_) {
             setup_screen_quad(resource_manager);
@@ -1895,15 +2293,15 @@ namespace glRenderer {
         
         // Render direct lighting to lit_scene_texture_
         // LOG_DEBUG("Renderer: Direct lighting pass - binding framebuffer and textures");
-        glBindFramebuffer(GL_FRAMEBUFFER, ssgi_fbo_);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, ssgi_fbo_);
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, lit_scene_texture_->get_id(), 0);
-        glViewport(0, 0, viewport_width_, viewport_height_);
+        GLStateCache::viewport(0, 0, render_width_, render_height_);
         glClear(GL_COLOR_BUFFER_BIT);
         
         // Disable depth testing for screen-space quad
-        glDisable(GL_DEPTH_TEST);
-        glDisable(GL_CULL_FACE);
-        glDisable(GL_BLEND);
+        GLStateCache::disable(GL_DEPTH_TEST);
+        GLStateCache::disable(GL_CULL_FACE);
+        GLStateCache::disable(GL_BLEND);
         
         // Get direct lighting shader
         auto direct_lighting_shader = resource_manager.get_shader("deferred_lighting_direct_shader");
@@ -1916,14 +2314,12 @@ namespace glRenderer {
         
         // Bind G-Buffer textures using automatic slot management
         Texture::reset_slot_counter();
-        unsigned int direct_pos_slot = Texture::bind_raw_texture(g_position_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int direct_albedo_slot = Texture::bind_raw_texture(g_albedo_metallic_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int direct_normal_slot = Texture::bind_raw_texture(g_normal_roughness_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int direct_motion_slot = Texture::bind_raw_texture(g_motion_ao_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int direct_emissive_slot = Texture::bind_raw_texture(g_emissive_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int direct_depth_slot = Texture::bind_raw_texture(g_depth_texture_->get_id(), GL_TEXTURE_2D);
         
-        if (direct_pos_slot != Texture::INVALID_SLOT) direct_lighting_shader->set_int("gPosition", direct_pos_slot);
         if (direct_albedo_slot != Texture::INVALID_SLOT) direct_lighting_shader->set_int("gAlbedoMetallic", direct_albedo_slot);
         if (direct_normal_slot != Texture::INVALID_SLOT) direct_lighting_shader->set_int("gNormalRoughness", direct_normal_slot);
         if (direct_motion_slot != Texture::INVALID_SLOT) direct_lighting_shader->set_int("gMotionAO", direct_motion_slot);
@@ -1940,13 +2336,14 @@ namespace glRenderer {
         direct_lighting_shader->set_vec3("viewPos", camera_pos);
         direct_lighting_shader->set_mat4("view", view);
         direct_lighting_shader->set_mat4("projection", projection);
+        direct_lighting_shader->set_mat4("invViewProjection", glm::inverse(projection * view));
         
         // Set ambient lighting from scene
         direct_lighting_shader->set_vec3("ambientLight", scene.get_ambient_light());
         
         // Set up lighting using scene lights
         auto scene_lights = resource_manager.get_scene_lights(scene);
-        size_t light_size = std::min(scene_lights.size(), size_t(8));
+        size_t light_size = std::min(scene_lights.size(), MAX_LIGHTS);
         direct_lighting_shader->set_int("numLights", static_cast<int>(light_size));
         
         for (size_t i = 0; i < light_size; ++i) {
@@ -1963,6 +2360,11 @@ namespace glRenderer {
             if (direct_shadow_slot != Texture::INVALID_SLOT) {
                 direct_lighting_shader->set_int("shadowMap", direct_shadow_slot);
             }
+            unsigned int shadow_min_max_slot = Texture::bind_raw_texture(shadow_map->get_min_max_texture(), GL_TEXTURE_2D);
+            if (shadow_min_max_slot != Texture::INVALID_SLOT) {
+                direct_lighting_shader->set_int("shadowMinMax", shadow_min_max_slot);
+            }
+            direct_lighting_shader->set_int("shadowMinMaxLevels", shadow_map->get_min_max_levels());
             direct_lighting_shader->set_bool("enableShadows", true);
             direct_lighting_shader->set_mat4("lightSpaceMatrix", last_light_space_matrix_);
             /*glm::vec3 shadow_light_direction = glm::normalize(shadow_light_target_ - shadow_light_pos_);
@@ -1976,10 +2378,206 @@ namespace glRenderer {
         // Render screen-space quad
         render_screen_quad();
         
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, 0);
         //LOG_DEBUG("Direct lighting pass completed");
     }
 
+    void Renderer::render_tiled_lighting_pass(const Scene& scene, const Camera& camera, const CoroutineResourceManager& resource_manager) {
+        auto tiled_lighting_shader = resource_manager.get_shader("deferred_lighting_tiled_shader");
+        if (!tiled_lighting_shader) {
+            LOG_ERROR("Renderer: Tiled lighting shader not found in ResourceManager");
+            return;
+        }
+        
+        tiled_lighting_shader->use();
+        
+        // Bind G-Buffer textures using automatic slot management
+        Texture::reset_slot_counter();
+        unsigned int albedo_slot = Texture::bind_raw_texture(g_albedo_metallic_texture_->get_id(), GL_TEXTURE_2D);
+        unsigned int normal_slot = Texture::bind_raw_texture(g_normal_roughness_texture_->get_id(), GL_TEXTURE_2D);
+        unsigned int emissive_slot = Texture::bind_raw_texture(g_emissive_texture_->get_id(), GL_TEXTURE_2D);
+        unsigned int depth_slot = Texture::bind_raw_texture(g_depth_texture_->get_id(), GL_TEXTURE_2D);
+        
+        if (albedo_slot != Texture::INVALID_SLOT) tiled_lighting_shader->set_int("gAlbedoMetallic", albedo_slot);
+        if (normal_slot != Texture::INVALID_SLOT) tiled_lighting_shader->set_int("gNormalRoughness", normal_slot);
+        if (emissive_slot != Texture::INVALID_SLOT) tiled_lighting_shader->set_int("gEmissive", emissive_slot);
+        if (depth_slot != Texture::INVALID_SLOT) tiled_lighting_shader->set_int("gDepth", depth_slot);
+        
+        // Write straight into the lit scene texture, no framebuffer or quad
+        RenderStats::bind_image_texture(0, lit_scene_texture_->get_id(), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+        
+        // Set camera uniforms
+        glm::mat4 view = camera.get_view_matrix();
+        glm::mat4 projection = camera.get_projection_matrix(static_cast<float>(viewport_width_) / static_cast<float>(viewport_height_));
+        
+        tiled_lighting_shader->set_vec3("viewPos", camera.get_position());
+        tiled_lighting_shader->set_mat4("view", view);
+        tiled_lighting_shader->set_mat4("invProjection", glm::inverse(projection));
+        tiled_lighting_shader->set_mat4("invViewProjection", glm::inverse(projection * view));
+        
+        // Lights are culled per tile in the shader
+        auto scene_lights = resource_manager.get_scene_lights(scene);
+        size_t light_size = std::min(scene_lights.size(), MAX_LIGHTS);
+        tiled_lighting_shader->set_int("numLights", static_cast<int>(light_size));
+        
+        for (size_t i = 0; i < light_size; ++i) {
+            auto light = scene_lights[i];
+            if (light) {
+                light->set_shader_array(*tiled_lighting_shader, static_cast<int>(i));
+            }
+        }
+        
+        // Shadow mapping setup
+        if (shadow_map) {
+            unsigned int shadow_slot = Texture::bind_raw_texture(shadow_map->get_depth_texture(), GL_TEXTURE_2D);
+            if (shadow_slot != Texture::INVALID_SLOT) {
+                tiled_lighting_shader->set_int("shadowMap", shadow_slot);
+            }
+            unsigned int shadow_min_max_slot = Texture::bind_raw_texture(shadow_map->get_min_max_texture(), GL_TEXTURE_2D);
+            if (shadow_min_max_slot != Texture::INVALID_SLOT) {
+                tiled_lighting_shader->set_int("shadowMinMax", shadow_min_max_slot);
+            }
+            tiled_lighting_shader->set_int("shadowMinMaxLevels", shadow_map->get_min_max_levels());
+            tiled_lighting_shader->set_bool("enableShadows", true);
+            tiled_lighting_shader->set_mat4("lightSpaceMatrix", last_light_space_matrix_);
+        } else {
+            tiled_lighting_shader->set_bool("enableShadows", false);
+        }
+        
+        // One workgroup per 16x16 tile; the render graph makes the result visible to its readers
+        RenderStats::dispatch_compute((render_width_ + 15) / 16, (render_height_ + 15) / 16, 1);
+        RenderStats::bind_image_texture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+    }
+
+    void Renderer::render_deferred_lighting_pass(const Scene& scene, const Camera& camera, const CoroutineResourceManager& resource_manager) {
+        // Initialize screen quad if not already done
+        if (!screen_quad_mesh_) {
+            setup_screen_quad(resource_manager);
+        }
+        
+        // Traditional deferred lighting, added onto the skybox in the scene target
+        bind_g_buffer_for_lighting_pass();
+        
+        // Get lighting shader from ResourceManager
+        auto lighting_shader = resource_manager.get_shader("deferred_lighting_shader");
+        if (!lighting_shader) {
+            LOG_ERROR("Renderer: Deferred lighting shader not found in ResourceManager");
+            return;
+        }
+    
+        lighting_shader->use();
+    
+        // Bind G-Buffer textures using automatic slot management
+        unsigned int g_albedo_slot = Texture::bind_raw_texture(g_albedo_metallic_texture_->get_id(), GL_TEXTURE_2D);
+        unsigned int g_normal_slot = Texture::bind_raw_texture(g_normal_roughness_texture_->get_id(), GL_TEXTURE_2D);
+        unsigned int g_motion_slot = Texture::bind_raw_texture(g_motion_ao_texture_->get_id(), GL_TEXTURE_2D);
+        unsigned int g_emissive_slot = Texture::bind_raw_texture(g_emissive_texture_->get_id(), GL_TEXTURE_2D);
+        unsigned int g_depth_slot = Texture::bind_raw_texture(g_depth_texture_->get_id(), GL_TEXTURE_2D);
+        
+        if (g_albedo_slot != Texture::INVALID_SLOT) lighting_shader->set_int("gAlbedoMetallic", g_albedo_slot);
+        if (g_normal_slot != Texture::INVALID_SLOT) lighting_shader->set_int("gNormalRoughness", g_normal_slot);
+        if (g_motion_slot != Texture::INVALID_SLOT) lighting_shader->set_int("gMotionAO", g_motion_slot);
+        if (g_emissive_slot != Texture::INVALID_SLOT) lighting_shader->set_int("gEmissive", g_emissive_slot);
+        if (g_depth_slot != Texture::INVALID_SLOT) lighting_shader->set_int("gDepth", g_depth_slot);
+        
+
+    
+        // Set camera uniforms
+        glm::mat4 view = camera.get_view_matrix();
+        glm::mat4 projection = camera.get_projection_matrix(static_cast<float>(viewport_width_) / static_cast<float>(viewport_height_));
+        lighting_shader->set_vec3("viewPos", camera.get_position());
+        lighting_shader->set_mat4("view", view);
+        lighting_shader->set_mat4("projection", projection);
+        lighting_shader->set_mat4("invViewProjection", glm::inverse(projection * view));
+    
+        // Set ambient lighting from scene
+        lighting_shader->set_vec3("ambientLight", scene.get_ambient_light());
+    
+        // Set up lighting using scene lights
+        auto scene_lights = resource_manager.get_scene_lights(scene);
+        size_t light_size = std::min(scene_lights.size(), MAX_LIGHTS);
+        lighting_shader->set_int("numLights", static_cast<int>(light_size));
+    
+
+    
+        for (size_t i = 0; i < light_size; ++i) {
+            auto light = scene_lights[i];
+        
+            if (light) {
+                // Use the new Light::set_shader_array method to set all light parameters
+                light->set_shader_array(*lighting_shader, static_cast<int>(i));
+            } else {
+                LOG_WARN("Renderer: Light {} is null", i);
+            }
+        }
+    
+        // IBL irradiance and prefiltered mapping
+        auto irradiance_map = resource_manager.get_irradiance_map("skybox_cubemap");
+        auto prefiltered_map = resource_manager.get_prefiltered_map("skybox_cubemap");
+    
+        if (irradiance_map && prefiltered_map) {
+            lighting_shader->set_bool("useIBL", true);
+        
+            // Bind irradiance map using automatic slot management
+            unsigned int irradiance_slot = irradiance_map->bind_cubemap_auto();
+            if (irradiance_slot != Texture::INVALID_SLOT) {
+                lighting_shader->set_int("irradianceMap", irradiance_slot);
+            }
+            
+            // Bind prefiltered environment map using automatic slot management
+            unsigned int prefiltered_slot = prefiltered_map->bind_cubemap_auto();
+            if (prefiltered_slot != Texture::INVALID_SLOT) {
+                lighting_shader->set_int("prefilteredMap", prefiltered_slot);
+            }
+            
+            LOG_INFO("Renderer: IBL maps bound - irradiance: slot {}, prefiltered: slot {}", irradiance_slot, prefiltered_slot);
+        } else {
+            lighting_shader->set_bool("useIBL", false);
+            LOG_WARN("Renderer: IBL maps not available (irradiance: {}, prefiltered: {}), using fallback ambient lighting", 
+                    irradiance_map ? "OK" : "missing", prefiltered_map ? "OK" : "missing");
+        }
+    
+        // Shadow mapping (if enabled)
+        if (shadow_map) {
+            lighting_shader->set_bool("enableShadows", true);
+        
+            // Bind shadow map texture using automatic slot management
+            GLuint shadow_texture_id = shadow_map->get_depth_texture();
+            unsigned int shadow_slot = Texture::bind_raw_texture(shadow_texture_id, GL_TEXTURE_2D);
+            if (shadow_slot != Texture::INVALID_SLOT) {
+                lighting_shader->set_int("shadowMap", shadow_slot);
+            }
+            unsigned int shadow_min_max_slot = Texture::bind_raw_texture(shadow_map->get_min_max_texture(), GL_TEXTURE_2D);
+            if (shadow_min_max_slot != Texture::INVALID_SLOT) {
+                lighting_shader->set_int("shadowMinMax", shadow_min_max_slot);
+            }
+            lighting_shader->set_int("shadowMinMaxLevels", shadow_map->get_min_max_levels());
+        
+
+        
+            // Use first light as shadow caster if available, otherwise use fixed position
+            glm::vec3 shadow_light_direction = glm::normalize(shadow_light_pos_);
+            if (light_size > 0 && scene_lights[0] && scene_lights[0]->get_type() == Light::Type::kDirectional) {
+                shadow_light_direction = scene_lights[0]->get_direction();
+            }
+        
+            // For directional light shadows, center the shadow map around the scene center
+            glm::vec3 shadow_center = glm::vec3(0.0f, 0.0f, 0.0f); // Use scene center as shadow map center
+        
+            // Set light space matrix for shadow mapping (use the same matrix from shadow pass)
+            lighting_shader->set_mat4("lightSpaceMatrix", last_light_space_matrix_);
+        } else {
+            lighting_shader->set_bool("enableShadows", false);
+        }
+    
+        // Render screen-space quad
+        render_screen_quad();
+        
+        // Re-enable depth testing and disable blending for subsequent rendering
+        GLStateCache::enable(GL_DEPTH_TEST);
+        GLStateCache::disable(GL_BLEND);
+    }
+
     void Renderer::render_composition_pass(const Scene& scene, const Camera& camera, const CoroutineResourceManager& resource_manager) {
         // Initialize screen quad if not already done
         if (!screen_quad_mesh_) {
@@ -1988,13 +2586,13 @@ namespace glRenderer {
         
         // Final composition pass - render to main framebuffer
         // LOG_DEBUG("Renderer: Composition pass - combining direct lighting and SSGI");
-        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
-        glViewport(0, 0, viewport_width_, viewport_height_);
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, get_scene_target_fbo());
+        GLStateCache::viewport(0, 0, render_width_, render_height_);
         
         // Disable depth testing for screen-space quad
-        glDisable(GL_DEPTH_TEST);
-        glDisable(GL_CULL_FACE);
-        glDisable(GL_BLEND);
+        GLStateCache::disable(GL_DEPTH_TEST);
+        GLStateCache::disable(GL_CULL_FACE);
+        GLStateCache::disable(GL_BLEND);
         
         // Get composition shader
         auto composition_shader = resource_manager.get_shader("ssgi_composition_shader");
@@ -2008,8 +2606,9 @@ namespace glRenderer {
         // Bind input textures using automatic slot management
         Texture::reset_slot_counter();
         unsigned int comp_lit_slot = Texture::bind_raw_texture(lit_scene_texture_->get_id(), GL_TEXTURE_2D);
-        unsigned int comp_ssgi_slot = Texture::bind_raw_texture(ssgi_final_texture_->get_id(), GL_TEXTURE_2D);
-        unsigned int comp_pos_slot = Texture::bind_raw_texture(g_position_texture_->get_id(), GL_TEXTURE_2D);
+        bool ssgi_available = use_ssgi_ && ssgi_final_texture_;
+        unsigned int comp_ssgi_slot = ssgi_available ? Texture::bind_raw_texture(ssgi_final_texture_->get_id(), GL_TEXTURE_2D) : Texture::INVALID_SLOT;
+        unsigned int comp_depth_slot = Texture::bind_raw_texture(g_depth_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int comp_albedo_slot = Texture::bind_raw_texture(g_albedo_metallic_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int comp_normal_slot = Texture::bind_raw_texture(g_normal_roughness_texture_->get_id(), GL_TEXTURE_2D);
         unsigned int comp_emissive_slot = Texture::bind_raw_texture(g_emissive_texture_->get_id(), GL_TEXTURE_2D);
@@ -2017,14 +2616,14 @@ namespace glRenderer {
         
         if (comp_lit_slot != Texture::INVALID_SLOT) composition_shader->set_int("litSceneTexture", comp_lit_slot);
         if (comp_ssgi_slot != Texture::INVALID_SLOT) composition_shader->set_int("ssgi_final_texture", comp_ssgi_slot);
-        if (comp_pos_slot != Texture::INVALID_SLOT) composition_shader->set_int("gPosition", comp_pos_slot);
+        if (comp_depth_slot != Texture::INVALID_SLOT) composition_shader->set_int("gDepth", comp_depth_slot);
         if (comp_albedo_slot != Texture::INVALID_SLOT) composition_shader->set_int("gAlbedoMetallic", comp_albedo_slot);
         if (comp_normal_slot != Texture::INVALID_SLOT) composition_shader->set_int("gNormalRoughness", comp_normal_slot);
         if (comp_emissive_slot != Texture::INVALID_SLOT) composition_shader->set_int("gEmissive", comp_emissive_slot);
         if (comp_motion_slot != Texture::INVALID_SLOT) composition_shader->set_int("gMotionAO", comp_motion_slot);
         
         // Bind SSAO texture if enabled
-        if (use_ssao_) {
+        if (use_ssao_ && ssao_final_texture_) {
             unsigned int ssao_slot = Texture::bind_raw_texture(ssao_final_texture_->get_id(), GL_TEXTURE_2D);
             if (ssao_slot != Texture::INVALID_SLOT) composition_shader->set_int("ssaoTexture", ssao_slot);
             composition_shader->set_bool("enableSSAO", true);
@@ -2067,7 +2666,9 @@ namespace glRenderer {
         }
         
         // SSGI controls
-        composition_shader->set_bool("enableSSGI", use_ssgi_);
+        composition_shader->set_bool("enableSSGI", ssgi_available);
+        composition_shader->set_int("ssgiResolutionScale", ssgi_resolution_divisor_);
+        composition_shader->set_int("ssaoResolutionScale", ssao_resolution_divisor_);
         composition_shader->set_float("ssgiIntensity", ssgi_intensity_);
         composition_shader->set_float("exposure", ssgi_exposure_);
         
@@ -2075,10 +2676,156 @@ namespace glRenderer {
         render_screen_quad();
         
         // Re-enable depth testing for subsequent rendering
-        glEnable(GL_DEPTH_TEST);
+        GLStateCache::enable(GL_DEPTH_TEST);
         
         //LOG_DEBUG("Composition pass completed");
     }
 
+    void Renderer::setup_taa() {
+        glGenFramebuffers(1, &taa_scene_fbo_);
+        glGenFramebuffers(1, &taa_resolve_fbo_);
+        setup_taa_targets();
+        LOG_INFO("TAA setup completed");
+    }
+
+    void Renderer::cleanup_taa() {
+        taa_scene_color_texture_.reset();
+        taa_history_textures_[0].reset();
+        taa_history_textures_[1].reset();
+        if (taa_scene_fbo_ != 0) {
+            GLStateCache::forget_framebuffer(taa_scene_fbo_);
+            glDeleteFramebuffers(1, &taa_scene_fbo_);
+            taa_scene_fbo_ = 0;
+        }
+        if (taa_resolve_fbo_ != 0) {
+            GLStateCache::forget_framebuffer(taa_resolve_fbo_);
+            glDeleteFramebuffers(1, &taa_resolve_fbo_);
+            taa_resolve_fbo_ = 0;
+        }
+        LOG_INFO("TAA cleanup completed");
+    }
+
+    void Renderer::setup_taa_targets() {
+        if (taa_scene_fbo_ == 0 || !g_depth_texture_) {
+            return;
+        }
+
+        // Scene colour at render resolution; depth is the G-Buffer depth so the skybox needs no blit
+        taa_scene_color_texture_ = std::make_unique<Texture>(Texture::create_immutable_texture(render_width_, render_height_, GL_RGBA8));
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, taa_scene_fbo_);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, taa_scene_color_texture_->get_id(), 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, g_depth_texture_->get_id(), 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            LOG_ERROR("TAA scene framebuffer is not complete!");
+        }
+
+        // Resolve output at viewport resolution, read back as history next frame
+        taa_history_textures_[0] = std::make_unique<Texture>(Texture::create_immutable_texture(viewport_width_, viewport_height_, GL_RGBA8));
+        taa_history_textures_[1] = std::make_unique<Texture>(Texture::create_immutable_texture(viewport_width_, viewport_height_, GL_RGBA8));
+        taa_history_index_ = 0;
+        taa_history_valid_ = false;
+
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, 0);
+        LOG_INFO("TAA targets setup completed: {}x{} -> {}x{}", render_width_, render_height_, viewport_width_, viewport_height_);
+    }
+
+    void Renderer::set_taa_enabled(bool enable) {
+        use_taa_ = enable;
+        taa_history_valid_ = false;
+        update_render_resolution();
+        LOG_INFO("TAA {}", enable ? "enabled" : "disabled");
+    }
+
+    void Renderer::set_taa_render_scale(float scale) {
+        taa_render_scale_ = std::clamp(scale, 0.5f, 1.0f);
+        taa_history_valid_ = false;
+        update_render_resolution();
+    }
+
+    glm::vec2 Renderer::get_projection_jitter() const {
+        if (!is_taa_active()) {
+            return glm::vec2(0.0f);
+        }
+
+        // Halton(2, 3) sequence, 8 samples per cycle, skipping index 0
+        auto halton = [](uint32_t index, uint32_t base) {
+            float result = 0.0f;
+            float fraction = 1.0f / static_cast<float>(base);
+            while (index > 0) {
+                result += fraction * static_cast<float>(index % base);
+                index /= base;
+                fraction /= static_cast<float>(base);
+            }
+            return result;
+        };
+
+        uint32_t index = (taa_frame_index_ % 8) + 1;
+        glm::vec2 offset(halton(index, 2) - 0.5f, halton(index, 3) - 0.5f);
+
+        // Sub-pixel offset of the render resolution, in NDC
+        return offset * 2.0f / glm::vec2(render_width_, render_height_);
+    }
+
+    void Renderer::render_taa_resolve(const Camera& camera, const CoroutineResourceManager& resource_manager) {
+        auto taa_shader = resource_manager.get_shader("taa_resolve_shader");
+        if (!taa_shader || !taa_scene_color_texture_ || !taa_history_textures_[0]) {
+            LOG_ERROR("Renderer: TAA resolve shader or targets not available");
+            return;
+        }
+
+        if (!screen_quad_mesh_) {
+            setup_screen_quad(resource_manager);
+        }
+
+        const Texture& history = *taa_history_textures_[taa_history_index_];
+        const Texture& output = *taa_history_textures_[1 - taa_history_index_];
+
+        // One draw writes the viewport colour and this frame's half of the history pair
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, taa_resolve_fbo_);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color_texture_->get_id(), 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, output.get_id(), 0);
+        GLenum resolve_draw_buffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+        glDrawBuffers(2, resolve_draw_buffers);
+        GLStateCache::viewport(0, 0, viewport_width_, viewport_height_);
+
+        GLStateCache::disable(GL_DEPTH_TEST);
+        GLStateCache::disable(GL_CULL_FACE);
+        GLStateCache::disable(GL_BLEND);
+
+        taa_shader->use();
+
+        Texture::reset_slot_counter();
+        unsigned int current_slot = Texture::bind_raw_texture(taa_scene_color_texture_->get_id(), GL_TEXTURE_2D);
+        unsigned int history_slot = Texture::bind_raw_texture(history.get_id(), GL_TEXTURE_2D);
+        unsigned int motion_slot = Texture::bind_raw_texture(g_motion_ao_texture_->get_id(), GL_TEXTURE_2D);
+        unsigned int depth_slot = Texture::bind_raw_texture(g_depth_texture_->get_id(), GL_TEXTURE_2D);
+
+        if (current_slot != Texture::INVALID_SLOT) taa_shader->set_int("currentColor", current_slot);
+        if (history_slot != Texture::INVALID_SLOT) taa_shader->set_int("historyColor", history_slot);
+        if (motion_slot != Texture::INVALID_SLOT) taa_shader->set_int("gMotionAO", motion_slot);
+        if (depth_slot != Texture::INVALID_SLOT) taa_shader->set_int("gDepth", depth_slot);
+
+        taa_shader->set_vec2("jitter", camera.get_projection_jitter());
+        taa_shader->set_vec2("renderSize", glm::vec2(render_width_, render_height_));
+        taa_shader->set_bool("historyValid", taa_history_valid_);
+        taa_shader->set_float("blendFactor", 0.1f);
+        taa_shader->set_float("minBlendFactor", 0.02f);
+        taa_shader->set_float("varianceClipGamma", 1.0f);
+
+        render_screen_quad();
+
+        // Depth is upscaled for later forward passes
+        GLStateCache::bind_framebuffer(GL_READ_FRAMEBUFFER, g_buffer_fbo_);
+        GLStateCache::bind_framebuffer(GL_DRAW_FRAMEBUFFER, framebuffer_);
+        glBlitFramebuffer(0, 0, render_width_, render_height_, 0, 0, viewport_width_, viewport_height_, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+
+        GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, framebuffer_);
+        GLStateCache::enable(GL_DEPTH_TEST);
+
+        taa_history_index_ = 1 - taa_history_index_;
+        taa_history_valid_ = true;
+        ++taa_frame_index_;
+    }
+
 
 }
@@ -1,4 +1,6 @@
 #include "Shader.h"
+#include "RenderStats.h"
+#include "GLStateCache.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -8,13 +10,7 @@
 Shader::Shader() : program_id_(0) {}
 
 Shader::~Shader() {
-    if (program_id_ != 0) {
-        // Clean up attached shaders
-        for (auto& pair : attached_shaders_) {
-            glDeleteShader(pair.second);
-        }
-        glDeleteProgram(program_id_);
-    }
+    release_program();
 }
 
 Shader::Shader(Shader&& other) noexcept 
@@ -24,12 +20,7 @@ Shader::Shader(Shader&& other) noexcept
 
 Shader& Shader::operator=(Shader&& other) noexcept {
     if (this != &other) {
-        if (program_id_ != 0) {
-            for (auto& pair : attached_shaders_) {
-                glDeleteShader(pair.second);
-            }
-            glDeleteProgram(program_id_);
-        }
+        release_program();
         program_id_ = other.program_id_;
         attached_shaders_ = std::move(other.attached_shaders_);
         other.program_id_ = 0;
@@ -67,13 +58,48 @@ void Shader::link_program() {
         throw std::runtime_error("Cannot link program: no shader program created");
     }
     
+    // Lets ProgramBinaryCache fetch the linked binary
+    glProgramParameteri(program_id_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     glLinkProgram(program_id_);
     check_compile_errors(program_id_, "PROGRAM");
 }
 
+bool Shader::load_binary(GLenum binary_format, const void* binary, GLsizei length) {
+    release_program();
+
+    program_id_ = glCreateProgram();
+    glProgramBinary(program_id_, binary_format, binary, length);
+
+    GLint success = 0;
+    glGetProgramiv(program_id_, GL_LINK_STATUS, &success);
+    if (!success) {
+        release_program();
+        return false;
+    }
+    return true;
+}
+
+bool Shader::get_binary(GLenum& binary_format, std::vector<char>& binary) const {
+    if (program_id_ == 0) {
+        return false;
+    }
+
+    GLint length = 0;
+    glGetProgramiv(program_id_, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return false;
+    }
+
+    binary.resize(static_cast<size_t>(length));
+    GLsizei written = 0;
+    glGetProgramBinary(program_id_, length, &written, &binary_format, binary.data());
+    binary.resize(static_cast<size_t>(written));
+    return written > 0;
+}
+
 void Shader::use() const {
     if (program_id_ != 0) {
-        glUseProgram(program_id_);
+        GLStateCache::use_program(program_id_);
     }
 }
 
@@ -87,30 +113,49 @@ bool Shader::is_valid() const {
 
 void Shader::set_bool(const std::string& name, bool value) const {
     glUniform1i(glGetUniformLocation(program_id_, name.c_str()), (int)value);
+    RenderStats::count_uniform_upload();
 }
 
 void Shader::set_int(const std::string& name, int value) const {
     glUniform1i(glGetUniformLocation(program_id_, name.c_str()), value);
+    RenderStats::count_uniform_upload();
 }
 
 void Shader::set_float(const std::string& name, float value) const {
     glUniform1f(glGetUniformLocation(program_id_, name.c_str()), value);
+    RenderStats::count_uniform_upload();
 }
 
 void Shader::set_vec2(const std::string& name, const glm::vec2& value) const {
     glUniform2fv(glGetUniformLocation(program_id_, name.c_str()), 1, glm::value_ptr(value));
+    RenderStats::count_uniform_upload();
 }
 
 void Shader::set_vec3(const std::string& name, const glm::vec3& value) const {
     glUniform3fv(glGetUniformLocation(program_id_, name.c_str()), 1, glm::value_ptr(value));
+    RenderStats::count_uniform_upload();
 }
 
 void Shader::set_mat4(const std::string& name, const glm::mat4& value) const {
     glUniformMatrix4fv(glGetUniformLocation(program_id_, name.c_str()), 1, GL_FALSE, glm::value_ptr(value));
+    RenderStats::count_uniform_upload();
 }
 
 
 
+void Shader::release_program() {
+    if (program_id_ != 0) {
+        // Clean up attached shaders
+        for (auto& pair : attached_shaders_) {
+            glDeleteShader(pair.second);
+        }
+        GLStateCache::forget_program(program_id_);
+        glDeleteProgram(program_id_);
+        program_id_ = 0;
+    }
+    attached_shaders_.clear();
+}
+
 void Shader::check_compile_errors(unsigned int shader, const std::string& type) {
     int success;
     char infoLog[1024];
@@ -1,14 +1,21 @@
 #include "ShadowMap.h"
 #include "Shader.h"
+#include "Texture.h"
+#include "RenderStats.h"
+#include "GLStateCache.h"
+#include "MemoryTracker.h"
 #include <Logger.h>
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <algorithm>
+#include <cmath>
 
 #include <glm/gtc/matrix_transform.hpp>
 
 ShadowMap::ShadowMap() 
-    : framebuffer_(0), depth_texture_(0), shadow_width_(0), shadow_height_(0), initialized_(false)
+    : framebuffer_(0), depth_texture_(0), min_max_texture_(0), min_max_levels_(0),
+      gpu_bytes_(0), shadow_width_(0), shadow_height_(0), initialized_(false)
 {
 }
 
@@ -28,7 +35,7 @@ bool ShadowMap::initialize(int width, int height) {
     LOG_INFO("ShadowMap::initialize({},{}))", width, height);
 
     glGenTextures(1, &depth_texture_);
-    glBindTexture(GL_TEXTURE_2D, depth_texture_);
+    GLStateCache::bind_texture(GL_TEXTURE_2D, depth_texture_);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -38,7 +45,7 @@ bool ShadowMap::initialize(int width, int height) {
     glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
     
     glGenFramebuffers(1, &framebuffer_);
-    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+    GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, framebuffer_);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depth_texture_, 0);
     glDrawBuffer(GL_NONE);
     glReadBuffer(GL_NONE);
@@ -49,7 +56,22 @@ bool ShadowMap::initialize(int width, int height) {
         return false;
     }
     
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, 0);
+    
+    // Min/max pyramid down to 1x1, starting at half resolution
+    int base_width = std::max(1, width / 2);
+    int base_height = std::max(1, height / 2);
+    min_max_levels_ = static_cast<int>(std::floor(std::log2(std::max(base_width, base_height)))) + 1;
+    glGenTextures(1, &min_max_texture_);
+    GLStateCache::bind_texture(GL_TEXTURE_2D, min_max_texture_);
+    glTexStorage2D(GL_TEXTURE_2D, min_max_levels_, GL_RG32F, base_width, base_height);
+    gpu_bytes_ = Texture::get_texture_bytes(GL_DEPTH_COMPONENT, width, height) +
+                 Texture::get_texture_bytes(GL_RG32F, base_width, base_height, 1, min_max_levels_);
+    MemoryTracker::get_instance().allocate(MemoryCategory::k_render_targets, gpu_bytes_);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     
     try {
         shadow_shader_ = std::make_unique<Shader>();
@@ -89,11 +111,23 @@ void ShadowMap::cleanup() {
     LOG_INFO("ShadowMap::cleanup()");
     
     if (depth_texture_ != 0) {
+        GLStateCache::forget_texture(depth_texture_);
         glDeleteTextures(1, &depth_texture_);
         depth_texture_ = 0;
     }
     
+    if (min_max_texture_ != 0) {
+        GLStateCache::forget_texture(min_max_texture_);
+        glDeleteTextures(1, &min_max_texture_);
+        min_max_texture_ = 0;
+        min_max_levels_ = 0;
+    }
+    
+    MemoryTracker::get_instance().release(MemoryCategory::k_render_targets, gpu_bytes_);
+    gpu_bytes_ = 0;
+    
     if (framebuffer_ != 0) {
+        GLStateCache::forget_framebuffer(framebuffer_);
         glDeleteFramebuffers(1, &framebuffer_);
         framebuffer_ = 0;
     }
@@ -111,10 +145,10 @@ void ShadowMap::begin_shadow_pass() {
     glGetIntegerv(GL_VIEWPORT, saved_viewport_);
     glGetIntegerv(GL_FRAMEBUFFER_BINDING, &saved_framebuffer_);
     
-    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
-    glViewport(0, 0, shadow_width_, shadow_height_);
+    GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, framebuffer_);
+    GLStateCache::viewport(0, 0, shadow_width_, shadow_height_);
     
-    glEnable(GL_DEPTH_TEST);
+    GLStateCache::enable(GL_DEPTH_TEST);
     glDepthFunc(GL_LESS);
     
     glClearDepth(1.0f);
@@ -129,8 +163,36 @@ void ShadowMap::end_shadow_pass() {
     }
     
     // restore viewport and framebuffer
-    glBindFramebuffer(GL_FRAMEBUFFER, saved_framebuffer_);
-    glViewport(saved_viewport_[0], saved_viewport_[1], saved_viewport_[2], saved_viewport_[3]);
+    GLStateCache::bind_framebuffer(GL_FRAMEBUFFER, saved_framebuffer_);
+    GLStateCache::viewport(saved_viewport_[0], saved_viewport_[1], saved_viewport_[2], saved_viewport_[3]);
+}
+
+void ShadowMap::build_min_max_pyramid(const Shader& min_max_shader) {
+    if (!initialized_ || min_max_texture_ == 0) {
+        return;
+    }
+    
+    min_max_shader.use();
+    
+    Texture::reset_slot_counter();
+    unsigned int depth_slot = Texture::bind_raw_texture(depth_texture_, GL_TEXTURE_2D);
+    unsigned int min_max_slot = Texture::bind_raw_texture(min_max_texture_, GL_TEXTURE_2D);
+    
+    // Level 0 reduces the shadow depth, every later level reduces the one before it
+    for (int level = 0; level < min_max_levels_; ++level) {
+        unsigned int input_slot = (level == 0) ? depth_slot : min_max_slot;
+        if (input_slot != Texture::INVALID_SLOT) {
+            min_max_shader.set_int("inputTexture", input_slot);
+        }
+        min_max_shader.set_int("inputLevel", level - 1);
+        RenderStats::bind_image_texture(0, min_max_texture_, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_RG32F);
+        
+        int level_width = std::max(1, (shadow_width_ / 2) >> level);
+        int level_height = std::max(1, (shadow_height_ / 2) >> level);
+        RenderStats::dispatch_compute((level_width + 7) / 8, (level_height + 7) / 8, 1);
+        
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+    }
 }
 
 glm::mat4 ShadowMap::get_light_space_matrix(const glm::vec3& lightDirection, const glm::vec3& shadowCenter) const {
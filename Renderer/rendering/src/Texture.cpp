@@ -1,10 +1,55 @@
 #include "Texture.h"
+#include "RenderStats.h"
+#include "GLStateCache.h"
 #include <iostream>
 #include <vector>
 #include <algorithm>
 #include <random>
 #include <glm/glm.hpp>
 
+namespace {
+
+// Bytes per texel of the storage the driver allocates. Unsized formats are assumed 8 bits per
+// channel, three-channel formats padded to four as most drivers do.
+size_t get_bytes_per_texel(GLenum internal_format) {
+    switch (internal_format) {
+        case GL_RED:
+        case GL_R8:
+            return 1;
+        case GL_RG:
+        case GL_RG8:
+        case GL_R16F:
+        case GL_DEPTH_COMPONENT16:
+            return 2;
+        case GL_RGB:
+        case GL_RGB8:
+        case GL_RGBA:
+        case GL_RGBA8:
+        case GL_SRGB8_ALPHA8:
+        case GL_RG16F:
+        case GL_R32F:
+        case GL_R11F_G11F_B10F:
+        case GL_RGB10_A2:
+        case GL_DEPTH_COMPONENT:
+        case GL_DEPTH_COMPONENT24:
+        case GL_DEPTH_COMPONENT32F:
+        case GL_DEPTH24_STENCIL8:
+            return 4;
+        case GL_RGB16F:
+        case GL_RGBA16F:
+        case GL_RG32F:
+        case GL_DEPTH32F_STENCIL8:
+            return 8;
+        case GL_RGB32F:
+        case GL_RGBA32F:
+            return 16;
+        default:
+            return 4;
+    }
+}
+
+} // namespace
+
 // Static member definitions
 unsigned int Texture::current_slot_counter_ = 0;
 
@@ -12,8 +57,9 @@ Texture::Texture() : texture_id_(0), width_(0), height_(0), nr_channels_(0), is_
     glGenTextures(1, &texture_id_);
 }
 
-Texture::Texture(Texture&& another) noexcept: texture_id_(another.texture_id_), width_(another.width_), height_(another.height_), nr_channels_(another.nr_channels_), is_hdr_(another.is_hdr_) {
+Texture::Texture(Texture&& another) noexcept: texture_id_(another.texture_id_), width_(another.width_), height_(another.height_), nr_channels_(another.nr_channels_), is_hdr_(another.is_hdr_), gpu_bytes_(another.gpu_bytes_), memory_category_(another.memory_category_) {
     another.texture_id_ = 0;
+    another.gpu_bytes_ = 0;
     another.width_ = 0;
     another.height_ = 0;
     another.nr_channels_ = 0;
@@ -23,16 +69,21 @@ Texture::Texture(Texture&& another) noexcept: texture_id_(another.texture_id_),
 Texture& Texture::operator=(Texture&& another) noexcept {
     if (&another != this) {
         if (texture_id_ != 0) {
+            GLStateCache::forget_texture(texture_id_);
             glDeleteTextures(1, &texture_id_);
         }
+        MemoryTracker::get_instance().release(memory_category_, gpu_bytes_);
         
         texture_id_ = another.texture_id_;
         width_ = another.width_;
         height_ = another.height_;
         nr_channels_ = another.nr_channels_;
         is_hdr_ = another.is_hdr_;
+        gpu_bytes_ = another.gpu_bytes_;
+        memory_category_ = another.memory_category_;
         
         another.texture_id_ = 0;
+        another.gpu_bytes_ = 0;
         another.width_ = 0;
         another.height_ = 0;
         another.nr_channels_ = 0;
@@ -43,8 +94,10 @@ Texture& Texture::operator=(Texture&& another) noexcept {
 
 Texture::~Texture() {
     if (texture_id_ != 0) {
+        GLStateCache::forget_texture(texture_id_);
         glDeleteTextures(1, &texture_id_);
     }
+    MemoryTracker::get_instance().release(memory_category_, gpu_bytes_);
 }
 
 bool Texture::operator==(const Texture& other) const noexcept {
@@ -71,7 +124,7 @@ void Texture::load_from_file(const std::string& path) {
     this->height_ = static_cast<GLuint>(imgHeight);
     this->nr_channels_ = static_cast<GLuint>(imgChannels);
     
-    glBindTexture(GL_TEXTURE_2D, texture_id_);
+    GLStateCache::bind_texture(GL_TEXTURE_2D, texture_id_);
     
     GLenum format;
     if (nr_channels_ == 1)
@@ -88,6 +141,7 @@ void Texture::load_from_file(const std::string& path) {
     
     glTexImage2D(GL_TEXTURE_2D, 0, format, width_, height_, 0, format, GL_UNSIGNED_BYTE, data);
     glGenerateMipmap(GL_TEXTURE_2D);
+    track_gpu_memory(format, width_, height_, 1, get_mip_level_count(width_, height_));
     
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
@@ -104,7 +158,7 @@ void Texture::load_from_data(unsigned char* data, int width, int height, int cha
     height_ = height;
     nr_channels_ = channels;
 
-    glBindTexture(GL_TEXTURE_2D, texture_id_);
+    GLStateCache::bind_texture(GL_TEXTURE_2D, texture_id_);
 
     GLenum format;
     if (channels == 1) {
@@ -120,6 +174,7 @@ void Texture::load_from_data(unsigned char* data, int width, int height, int cha
 
     glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
     glGenerateMipmap(GL_TEXTURE_2D);
+    track_gpu_memory(format, width, height, 1, get_mip_level_count(width, height));
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
@@ -133,11 +188,12 @@ void Texture::load_cubemap_from_files(const std::vector<std::string>& faces) {
         return;
     }
     
-    glBindTexture(GL_TEXTURE_CUBE_MAP, texture_id_);
+    GLStateCache::bind_texture(GL_TEXTURE_CUBE_MAP, texture_id_);
     
     // Don't flip images for cubemap
     glRenderer::STBImage::set_flip_vertical_on_load(false);
     
+    GLenum cubemap_format = GL_RGB;
     for (unsigned int i = 0; i < faces.size(); i++) {
         int imgWidth, imgHeight, imgChannels;
         unsigned char* data = glRenderer::STBImage::load_image(faces[i].c_str(), &imgWidth, &imgHeight, &imgChannels, 0);
@@ -164,6 +220,7 @@ void Texture::load_cubemap_from_files(const std::vector<std::string>& faces) {
                 this->width_ = static_cast<GLuint>(imgWidth);
                 this->height_ = static_cast<GLuint>(imgHeight);
                 this->nr_channels_ = static_cast<GLuint>(imgChannels);
+                cubemap_format = format;
             }
             
             std::cout << "Loaded cubemap face " << i << ": " << faces[i] << " (" << imgWidth << "x" << imgHeight << ")" << std::endl;
@@ -181,6 +238,7 @@ void Texture::load_cubemap_from_files(const std::vector<std::string>& faces) {
     
     // Generate mipmaps for smooth filtering
     glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+    track_gpu_memory(cubemap_format, width_, height_, 6, get_mip_level_count(width_, height_));
     
     std::cout << "Successfully loaded cubemap with " << faces.size() << " faces" << std::endl;
 }
@@ -190,8 +248,9 @@ void Texture::gen_depth_texture(GLuint width, const GLuint height) {
     height_ = height;
     nr_channels_ = 1;
 
-    glBindTexture(GL_TEXTURE_2D, texture_id_);
+    GLStateCache::bind_texture(GL_TEXTURE_2D, texture_id_);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+    track_gpu_memory(GL_DEPTH_COMPONENT, width, height, 1, 1, MemoryCategory::k_render_targets);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
@@ -205,10 +264,11 @@ void Texture::gen_depth_cube_map(GLuint size) {
     height_ = size;
     nr_channels_ = 1;
 
-    glBindTexture(GL_TEXTURE_CUBE_MAP, texture_id_);
+    GLStateCache::bind_texture(GL_TEXTURE_CUBE_MAP, texture_id_);
     for (unsigned int i = 0; i < 6; ++i) {
         glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_DEPTH_COMPONENT, size, size, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
     }
+    track_gpu_memory(GL_DEPTH_COMPONENT, size, size, 6, 1, MemoryCategory::k_render_targets);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -228,8 +288,7 @@ unsigned int Texture::bind_auto() {
         return INVALID_SLOT;
     }
     
-    glActiveTexture(GL_TEXTURE0 + slot);
-    glBindTexture(GL_TEXTURE_2D, texture_id_);
+    GLStateCache::bind_texture_unit(slot, GL_TEXTURE_2D, texture_id_);
     return slot;
 }
 
@@ -244,20 +303,17 @@ unsigned int Texture::bind_cubemap_auto() {
         return INVALID_SLOT;
     }
     
-    glActiveTexture(GL_TEXTURE0 + slot);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, texture_id_);
+    GLStateCache::bind_texture_unit(slot, GL_TEXTURE_CUBE_MAP, texture_id_);
     return slot;
 }
 
 // Legacy binding methods (manual slot specification, no tracking)
 void Texture::bind(unsigned int slot) const {
-    glActiveTexture(GL_TEXTURE0 + slot);
-    glBindTexture(GL_TEXTURE_2D, texture_id_);
+    GLStateCache::bind_texture_unit(slot, GL_TEXTURE_2D, texture_id_);
 }
 
 void Texture::bind_cube_map(unsigned int slot) const {
-    glActiveTexture(GL_TEXTURE0 + slot);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, texture_id_);
+    GLStateCache::bind_texture_unit(slot, GL_TEXTURE_CUBE_MAP, texture_id_);
 }
 
 unsigned int Texture::get_id() const {
@@ -280,12 +336,11 @@ void Texture::reset_slot_counter() {
 void Texture::unbind_all_textures() {
     // Unbind all texture slots by setting them to 0
     for (unsigned int slot = 0; slot < MAX_TEXTURE_UNITS; ++slot) {
-        glActiveTexture(GL_TEXTURE0 + slot);
-        glBindTexture(GL_TEXTURE_2D, 0);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+        GLStateCache::bind_texture_unit(slot, GL_TEXTURE_2D, 0);
+        GLStateCache::bind_texture_unit(slot, GL_TEXTURE_CUBE_MAP, 0);
     }
     // Reset active texture to slot 0
-    glActiveTexture(GL_TEXTURE0);
+    GLStateCache::active_texture(0);
     // Reset the slot counter
     current_slot_counter_ = 0;
 }
@@ -302,8 +357,7 @@ unsigned int Texture::bind_raw_texture(GLuint texture_id, GLenum target) {
         return INVALID_SLOT;
     }
     
-    glActiveTexture(GL_TEXTURE0 + slot);
-    glBindTexture(target, texture_id);
+    GLStateCache::bind_texture_unit(slot, target, texture_id);
     return slot;
 }
 
@@ -322,7 +376,7 @@ void Texture::load_hdr_from_file(const std::string& path) {
     this->nr_channels_ = static_cast<GLuint>(imgChannels);
     this->is_hdr_ = true;
     
-    glBindTexture(GL_TEXTURE_2D, texture_id_);
+    GLStateCache::bind_texture(GL_TEXTURE_2D, texture_id_);
     
     // Use floating-point internal format for HDR
     GLenum internal_format, format;
@@ -343,6 +397,7 @@ void Texture::load_hdr_from_file(const std::string& path) {
     
     glTexImage2D(GL_TEXTURE_2D, 0, internal_format, width_, height_, 0, format, GL_FLOAT, data);
     glGenerateMipmap(GL_TEXTURE_2D);
+    track_gpu_memory(internal_format, width_, height_, 1, get_mip_level_count(width_, height_));
     
     // Set texture parameters suitable for HDR
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -369,7 +424,7 @@ void Texture::load_exr_from_file(const std::string& path) {
     this->nr_channels_ = static_cast<GLuint>(imgChannels);
     this->is_hdr_ = true;
     
-    glBindTexture(GL_TEXTURE_2D, texture_id_);
+    GLStateCache::bind_texture(GL_TEXTURE_2D, texture_id_);
     
     // EXR can have different channel counts, handle accordingly
     GLenum format, internal_format;
@@ -390,6 +445,7 @@ void Texture::load_exr_from_file(const std::string& path) {
     
     glTexImage2D(GL_TEXTURE_2D, 0, internal_format, width_, height_, 0, format, GL_FLOAT, data);
     glGenerateMipmap(GL_TEXTURE_2D);
+    track_gpu_memory(internal_format, width_, height_, 1, get_mip_level_count(width_, height_));
     
     // Set texture parameters suitable for HDR
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -417,7 +473,7 @@ void Texture::convert_equirectangular_to_cubemap(float* hdr_data, int width, int
     // Create temporary texture for equirectangular map
     GLuint equirectTexture;
     glGenTextures(1, &equirectTexture);
-    glBindTexture(GL_TEXTURE_2D, equirectTexture);
+    GLStateCache::bind_texture(GL_TEXTURE_2D, equirectTexture);
     
     GLenum format = (channels == 3) ? GL_RGB : GL_RGBA;
     GLenum internal_format = (channels == 3) ? GL_RGB16F : GL_RGBA16F;
@@ -432,7 +488,7 @@ void Texture::convert_equirectangular_to_cubemap(float* hdr_data, int width, int
     const int cubemap_size = 512;
     
     // Configure this texture as a cubemap
-    glBindTexture(GL_TEXTURE_CUBE_MAP, texture_id_);
+    GLStateCache::bind_texture(GL_TEXTURE_CUBE_MAP, texture_id_);
     for (unsigned int i = 0; i < 6; ++i) {
         glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, 
                      cubemap_size, cubemap_size, 0, GL_RGB, GL_FLOAT, nullptr);
@@ -445,6 +501,7 @@ void Texture::convert_equirectangular_to_cubemap(float* hdr_data, int width, int
     
     // Generate mipmaps for smooth filtering
     glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+    track_gpu_memory(GL_RGB16F, cubemap_size, cubemap_size, 6, get_mip_level_count(cubemap_size, cubemap_size));
     
     // Store cubemap dimensions
     width_ = cubemap_size;
@@ -453,6 +510,7 @@ void Texture::convert_equirectangular_to_cubemap(float* hdr_data, int width, int
     is_hdr_ = true;   // Cubemap converted from HDR
     
     // Clean up temporary texture
+    GLStateCache::forget_texture(equirectTexture);
     glDeleteTextures(1, &equirectTexture);
     
     std::cout << "Converted equirectangular HDR to cubemap: " << cubemap_size << "x" << cubemap_size << std::endl;
@@ -497,8 +555,9 @@ Texture Texture::create_color_texture(GLuint width, GLuint height, GLenum intern
     texture.height_ = height;
     texture.nr_channels_ = (format == GL_RGB) ? 3 : (format == GL_RGBA) ? 4 : 1;
     
-    glBindTexture(GL_TEXTURE_2D, texture.texture_id_);
+    GLStateCache::bind_texture(GL_TEXTURE_2D, texture.texture_id_);
     glTexImage2D(GL_TEXTURE_2D, 0, internal_format, width, height, 0, format, type, nullptr);
+    texture.track_gpu_memory(internal_format, width, height, 1, 1, MemoryCategory::k_render_targets);
     
     // Set default parameters
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -515,8 +574,9 @@ Texture Texture::create_depth_texture(GLuint width, GLuint height, GLenum intern
     texture.height_ = height;
     texture.nr_channels_ = 1;
     
-    glBindTexture(GL_TEXTURE_2D, texture.texture_id_);
+    GLStateCache::bind_texture(GL_TEXTURE_2D, texture.texture_id_);
     glTexImage2D(GL_TEXTURE_2D, 0, internal_format, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+    texture.track_gpu_memory(internal_format, width, height, 1, 1, MemoryCategory::k_render_targets);
     
     // Set depth texture parameters
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -536,9 +596,12 @@ Texture Texture::create_framebuffer_texture(GLuint width, GLuint height, GLenum
     texture.height_ = height;
     texture.nr_channels_ = (format == GL_RGB) ? 3 : (format == GL_RGBA) ? 4 : 1;
     
-    glBindTexture(GL_TEXTURE_2D, texture.texture_id_);
+    GLStateCache::bind_texture(GL_TEXTURE_2D, texture.texture_id_);
     glTexImage2D(GL_TEXTURE_2D, 0, internal_format, width, height, 0, format, type, nullptr);
     
+    texture.track_gpu_memory(internal_format, width, height, 1, generate_mipmaps ? get_mip_level_count(width, height) : 1,
+                             MemoryCategory::k_render_targets);
+    
     if (generate_mipmaps) {
         glGenerateMipmap(GL_TEXTURE_2D);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
@@ -559,8 +622,9 @@ Texture Texture::create_noise_texture(GLuint width, GLuint height, const std::ve
     texture.height_ = height;
     texture.nr_channels_ = 3; // Assuming RGB noise data
     
-    glBindTexture(GL_TEXTURE_2D, texture.texture_id_);
+    GLStateCache::bind_texture(GL_TEXTURE_2D, texture.texture_id_);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGB, GL_FLOAT, noise_data.data());
+    texture.track_gpu_memory(GL_RGBA16F, width, height);
     
     // Set noise texture parameters (no filtering, repeat wrapping)
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -577,8 +641,9 @@ Texture Texture::create_g_buffer_texture(GLuint width, GLuint height, GLenum int
     texture.height_ = height;
     texture.nr_channels_ = (format == GL_RGB) ? 3 : (format == GL_RGBA) ? 4 : 1;
     
-    glBindTexture(GL_TEXTURE_2D, texture.texture_id_);
+    GLStateCache::bind_texture(GL_TEXTURE_2D, texture.texture_id_);
     glTexImage2D(GL_TEXTURE_2D, 0, internal_format, width, height, 0, format, type, nullptr);
+    texture.track_gpu_memory(internal_format, width, height, 1, 1, MemoryCategory::k_render_targets);
     
     // G-Buffer textures typically use nearest filtering for precision
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -589,15 +654,66 @@ Texture Texture::create_g_buffer_texture(GLuint width, GLuint height, GLenum int
     return texture;
 }
 
+Texture Texture::create_immutable_texture(GLuint width, GLuint height, GLenum internal_format, GLsizei levels) {
+    Texture texture;
+    texture.width_ = width;
+    texture.height_ = height;
+    texture.nr_channels_ = (internal_format == GL_R16F || internal_format == GL_R32F || internal_format == GL_R8) ? 1 : 4;
+    
+    GLStateCache::bind_texture(GL_TEXTURE_2D, texture.texture_id_);
+    glTexStorage2D(GL_TEXTURE_2D, levels, internal_format, width, height);
+    texture.track_gpu_memory(internal_format, width, height, 1, static_cast<GLuint>(levels), MemoryCategory::k_render_targets);
+    
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    
+    return texture;
+}
+
+Texture Texture::create_texture_array(GLuint width, GLuint height, GLuint layers, GLenum internal_format) {
+    Texture texture;
+    texture.width_ = width;
+    texture.height_ = height;
+    texture.nr_channels_ = internal_format == GL_R8 ? 1 : (internal_format == GL_RGB8 ? 3 : 4);
+    
+    GLuint levels = get_mip_level_count(width, height);
+    GLStateCache::bind_texture(GL_TEXTURE_2D_ARRAY, texture.texture_id_);
+    glTexStorage3D(GL_TEXTURE_2D_ARRAY, static_cast<GLsizei>(levels), internal_format, width, height, layers);
+    texture.track_gpu_memory(internal_format, width, height, layers, levels);
+    
+    // Same sampling as load_from_data, so a packed texture looks like its standalone version
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    GLStateCache::bind_texture(GL_TEXTURE_2D_ARRAY, 0);
+    
+    return texture;
+}
+
+void Texture::upload_layer(GLuint layer, GLenum format, const unsigned char* data) {
+    GLStateCache::bind_texture(GL_TEXTURE_2D_ARRAY, texture_id_);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, static_cast<GLint>(layer), width_, height_, 1, format, GL_UNSIGNED_BYTE, data);
+    GLStateCache::bind_texture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void Texture::generate_array_mipmaps() {
+    GLStateCache::bind_texture(GL_TEXTURE_2D_ARRAY, texture_id_);
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+    GLStateCache::bind_texture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
 // Texture configuration methods
 void Texture::set_filter_mode(GLenum min_filter, GLenum mag_filter) {
-    glBindTexture(GL_TEXTURE_2D, texture_id_);
+    GLStateCache::bind_texture(GL_TEXTURE_2D, texture_id_);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min_filter);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mag_filter);
 }
 
 void Texture::set_wrap_mode(GLenum wrap_s, GLenum wrap_t, GLenum wrap_r) {
-    glBindTexture(GL_TEXTURE_2D, texture_id_);
+    GLStateCache::bind_texture(GL_TEXTURE_2D, texture_id_);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap_s);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap_t);
     // Note: GL_TEXTURE_WRAP_R is only applicable to 3D textures and cubemaps
@@ -605,7 +721,7 @@ void Texture::set_wrap_mode(GLenum wrap_s, GLenum wrap_t, GLenum wrap_r) {
 }
 
 void Texture::set_border_color(const float* border_color) {
-    glBindTexture(GL_TEXTURE_2D, texture_id_);
+    GLStateCache::bind_texture(GL_TEXTURE_2D, texture_id_);
     glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, border_color);
 }
 
@@ -613,8 +729,9 @@ void Texture::resize_texture(GLuint new_width, GLuint new_height, GLenum interna
     width_ = new_width;
     height_ = new_height;
     
-    glBindTexture(GL_TEXTURE_2D, texture_id_);
+    GLStateCache::bind_texture(GL_TEXTURE_2D, texture_id_);
     glTexImage2D(GL_TEXTURE_2D, 0, internal_format, new_width, new_height, 0, format, type, nullptr);
+    track_gpu_memory(internal_format, new_width, new_height, 1, 1, memory_category_);
 }
 
 // Generic texture creation method using abstraction structure
@@ -635,13 +752,17 @@ Texture Texture::create_texture(const TextureCreateInfo& create_info) {
         texture.nr_channels_ = 1; // Default fallback
     }
     
-    glBindTexture(GL_TEXTURE_2D, texture.texture_id_);
+    GLStateCache::bind_texture(GL_TEXTURE_2D, texture.texture_id_);
     glTexImage2D(GL_TEXTURE_2D, 0, create_info.internal_format, create_info.width, create_info.height, 
                  0, create_info.format, create_info.type, create_info.data);
     
     if (create_info.generate_mipmaps) {
         glGenerateMipmap(GL_TEXTURE_2D);
     }
+    // Textures created without data are rendered to
+    texture.track_gpu_memory(create_info.internal_format, create_info.width, create_info.height, 1,
+                             create_info.generate_mipmaps ? get_mip_level_count(create_info.width, create_info.height) : 1,
+                             create_info.data ? MemoryCategory::k_texture_gpu : MemoryCategory::k_render_targets);
     
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, create_info.min_filter);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, create_info.mag_filter);
@@ -739,4 +860,32 @@ Texture Texture::create_ssao_noise_texture() {
     create_info.data = ssao_noise_data.data();
     
     return create_texture(create_info);
-}
\ No newline at end of file
+}
+
+void Texture::track_gpu_memory(GLenum internal_format, GLuint width, GLuint height, GLuint faces, GLuint levels,
+                               MemoryCategory category) {
+    MemoryTracker& tracker = MemoryTracker::get_instance();
+    tracker.release(memory_category_, gpu_bytes_);
+    gpu_bytes_ = get_texture_bytes(internal_format, width, height, faces, levels);
+    memory_category_ = category;
+    tracker.allocate(memory_category_, gpu_bytes_);
+}
+
+GLuint Texture::get_mip_level_count(GLuint width, GLuint height) {
+    GLuint levels = 1;
+    for (GLuint size = std::max(width, height); size > 1; size >>= 1) {
+        ++levels;
+    }
+    return levels;
+}
+
+size_t Texture::get_texture_bytes(GLenum internal_format, GLuint width, GLuint height, GLuint faces, GLuint levels) {
+    size_t texel_bytes = get_bytes_per_texel(internal_format);
+    size_t bytes = 0;
+    for (GLuint level = 0; level < levels; ++level) {
+        size_t level_width = std::max<GLuint>(width >> level, 1);
+        size_t level_height = std::max<GLuint>(height >> level, 1);
+        bytes += level_width * level_height * texel_bytes;
+    }
+    return bytes * faces;
+}
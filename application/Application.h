@@ -77,6 +77,21 @@ public:
     void set_ssgi_step_size(float step_size);
     void set_ssgi_thickness(float thickness);
     void set_ssgi_num_samples(int num_samples);
+    
+    // Occlusion culling toggle
+    void set_occlusion_culling(bool enable);
+    
+    // Tiled compute lighting toggle
+    void set_tiled_lighting(bool enable);
+    
+    // Screen-space effect resolution (divisor 1, 2 or 4) and GPU timings
+    void set_ssao_resolution(int divisor);
+    void set_ssgi_resolution(int divisor);
+    float get_effect_gpu_time_ms(const std::string& effect, int divisor) const;
+    
+    // Temporal anti-aliasing and its internal render scale
+    void set_taa_enabled(bool enable);
+    void set_taa_render_scale(float scale);
 
 private:
     std::unique_ptr<Window> window_;
@@ -1,10 +1,15 @@
 #include "GUI.h"
 #include "Logger.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
 #include <iostream>
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <string_view>
 #include <Window.h>
 
 GUI::GUI() 
@@ -243,10 +248,48 @@ void GUI::render_controls() {
         static bool enableSSGI = true;
         static float ssgiExposure = 1.0f;    // Higher default exposure for brighter result
         static float ssgiIntensity = 3.0f;   // Higher default intensity
+        static bool enableOcclusionCulling = true;
+        static bool enableTiledLighting = true;
+        static bool enableTextureArrayPacking = false;
+        static bool enableTAA = false;
+        const char* effectResolutions[] = {"Full", "Half", "Quarter"};
 
         ImGui::Checkbox("Enable Shadows", &enableShadows);
         ImGui::Checkbox("Enable SSAO", &enableSSAO);
         ImGui::Checkbox("Enable SSGI", &enableSSGI);
+        if (ImGui::Checkbox("Hi-Z Occlusion Culling", &enableOcclusionCulling)) {
+          if (occlusionCullingCallback_) {
+            occlusionCullingCallback_(enableOcclusionCulling);
+          }
+        }
+        if (ImGui::Checkbox("Tiled Compute Lighting", &enableTiledLighting)) {
+          if (tiledLightingCallback_) {
+            tiledLightingCallback_(enableTiledLighting);
+          }
+        }
+        // Applies to models imported afterwards
+        if (ImGui::Checkbox("Pack Imported Textures Into Arrays", &enableTextureArrayPacking)) {
+          if (textureArrayPackingCallback_) {
+            textureArrayPackingCallback_(enableTextureArrayPacking);
+          }
+        }
+        if (ImGui::Checkbox("Enable TAA", &enableTAA)) {
+          if (taaCallback_) {
+            taaCallback_(enableTAA);
+          }
+        }
+
+        if (enableTAA) {
+          ImGui::Text("TAA Render Scale");
+          const char* renderScales[] = {"Native (1.0)", "Quality (0.67)", "Balanced (0.58)", "Performance (0.5)"};
+          const float renderScaleValues[] = {1.0f, 0.67f, 0.58f, 0.5f};
+          static int taaRenderScale = 0;
+          if (ImGui::Combo("##taaRenderScale", &taaRenderScale, renderScales, IM_ARRAYSIZE(renderScales))) {
+            if (taaRenderScaleCallback_) {
+              taaRenderScaleCallback_(renderScaleValues[taaRenderScale]);
+            }
+          }
+        }
 
         if (enableShadows) {
           ImGui::Text("Shadow Map Size");
@@ -258,6 +301,16 @@ void GUI::render_controls() {
           ImGui::SliderFloat("##shadowBias", &shadowBias, 0.001f, 0.01f, "%.4f");
         }
         
+        if (enableSSAO) {
+          ImGui::Text("SSAO Resolution");
+          static int ssaoResolution = 0;
+          if (ImGui::Combo("##ssaoResolution", &ssaoResolution, effectResolutions, IM_ARRAYSIZE(effectResolutions))) {
+            if (ssaoResolutionCallback_) {
+              ssaoResolutionCallback_(1 << ssaoResolution);
+            }
+          }
+        }
+        
         if (enableSSGI) {
           ImGui::Text("SSGI Exposure");
           if (ImGui::SliderFloat("##ssgiExposure", &ssgiExposure, 0.1f, 5.0f, "%.2f")) {
@@ -276,6 +329,14 @@ void GUI::render_controls() {
           ImGui::Separator();
           ImGui::Text("SSGI Compute Parameters");
           
+          ImGui::Text("Resolution");
+          static int ssgiResolution = 1;
+          if (ImGui::Combo("##ssgiResolution", &ssgiResolution, effectResolutions, IM_ARRAYSIZE(effectResolutions))) {
+            if (ssgiResolutionCallback_) {
+              ssgiResolutionCallback_(1 << ssgiResolution);
+            }
+          }
+          
           static int ssgiMaxSteps = 32;
           static float ssgiMaxDistance = 6.0f;
           static float ssgiStepSize = 0.15f;
@@ -338,6 +399,139 @@ void GUI::render_controls() {
 
           ImGui::PlotLines("##fps", values, IM_ARRAYSIZE(values), valuesOffset,
                            "FPS", 0.0f, 120.0f, ImVec2(0, 80));
+
+          // GPU time of each screen-space effect at every resolution it has run at
+          if (effectTimingCallback_ && ImGui::BeginTable("##effectTimings", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("Effect");
+            ImGui::TableSetupColumn("Full");
+            ImGui::TableSetupColumn("Half");
+            ImGui::TableSetupColumn("Quarter");
+            ImGui::TableHeadersRow();
+
+            for (const char* effect : {"SSAO", "SSGI"}) {
+              ImGui::TableNextRow();
+              ImGui::TableNextColumn();
+              ImGui::TextUnformatted(effect);
+              for (int divisor : {1, 2, 4}) {
+                ImGui::TableNextColumn();
+                float time_ms = effectTimingCallback_(effect, divisor);
+                if (time_ms >= 0.0f) {
+                  ImGui::Text("%.3f ms", time_ms);
+                } else {
+                  ImGui::TextDisabled("-");
+                }
+              }
+            }
+            ImGui::EndTable();
+          }
+
+          // Render graph passes of the last deferred frame; GPU statistics cover the last 120 results
+          if (passTimingsCallback_) {
+            std::vector<RenderGraph::PassTiming> timings = passTimingsCallback_();
+            if (!timings.empty()) {
+              ImGui::Spacing();
+              ImGui::Text("Render Passes");
+              if (passTimingsExportCallback_) {
+                ImGui::SameLine();
+                if (ImGui::SmallButton("Export CSV")) {
+                  passTimingsExportCallback_();
+                }
+              }
+
+              if (ImGui::BeginTable("##passTimings", 8, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+                ImGui::TableSetupColumn("Pass");
+                ImGui::TableSetupColumn("CPU");
+                ImGui::TableSetupColumn("GPU");
+                ImGui::TableSetupColumn("Avg");
+                ImGui::TableSetupColumn("p95");
+                ImGui::TableSetupColumn("p99");
+                ImGui::TableSetupColumn("Draws");
+                ImGui::TableSetupColumn("Binds");
+                ImGui::TableHeadersRow();
+
+                float cpu_total = 0.0f;
+                float gpu_total = 0.0f;
+                auto time_cell = [](float time_ms) {
+                  ImGui::TableNextColumn();
+                  if (time_ms >= 0.0f) {
+                    ImGui::Text("%.3f", time_ms);
+                  } else {
+                    ImGui::TextDisabled("-");
+                  }
+                };
+                for (const auto& timing : timings) {
+                  ImGui::TableNextRow();
+                  ImGui::TableNextColumn();
+                  ImGui::TextUnformatted(timing.name.c_str());
+                  time_cell(timing.cpu_avg_ms);
+                  time_cell(timing.gpu_ms);
+                  time_cell(timing.gpu_avg_ms);
+                  time_cell(timing.gpu_p95_ms);
+                  time_cell(timing.gpu_p99_ms);
+                  ImGui::TableNextColumn();
+                  ImGui::Text("%llu", static_cast<unsigned long long>(timing.counters.draw_calls + timing.counters.compute_dispatches));
+                  ImGui::TableNextColumn();
+                  ImGui::Text("%llu", static_cast<unsigned long long>(timing.counters.program_binds + timing.counters.texture_binds + timing.counters.framebuffer_binds));
+                  cpu_total += timing.cpu_avg_ms;
+                  gpu_total += std::max(timing.gpu_avg_ms, 0.0f);
+                }
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted("Total");
+                time_cell(cpu_total);
+                ImGui::TableNextColumn();
+                time_cell(gpu_total);
+                ImGui::EndTable();
+              }
+            }
+          }
+
+          // GL work submitted last frame, including passes outside the render graph
+          if (renderCountersCallback_) {
+            RenderCounters counters = renderCountersCallback_();
+            ImGui::Spacing();
+            ImGui::Text("GL Work");
+            if (ImGui::BeginTable("##renderCounters", 2, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+              auto counter_row = [](const char* label, uint64_t value) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(label);
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", static_cast<unsigned long long>(value));
+              };
+              counter_row("Draw calls", counters.draw_calls);
+              counter_row("Triangles", counters.triangles);
+              counter_row("Instances", counters.instances);
+              counter_row("Compute dispatches", counters.compute_dispatches);
+              counter_row("Program binds", counters.program_binds);
+              counter_row("Texture binds", counters.texture_binds);
+              counter_row("Uniform uploads", counters.uniform_uploads);
+              counter_row("Framebuffer binds", counters.framebuffer_binds);
+              counter_row("Buffer upload bytes", counters.buffer_upload_bytes);
+              counter_row("State calls skipped", counters.state_calls_skipped);
+              ImGui::EndTable();
+            }
+          }
+          ImGui::Spacing();
+        });
+      }
+    });
+
+    with_font(current_subtitle_font_, [&](){
+      if (ImGui::CollapsingHeader("CPU Profiler")) {
+        ImGui::Spacing();
+        with_font(current_content_font_, [&](){
+          render_profiler_timeline();
+          ImGui::Spacing();
+        });
+      }
+    });
+
+    with_font(current_subtitle_font_, [&](){
+      if (ImGui::CollapsingHeader("Memory")) {
+        ImGui::Spacing();
+        with_font(current_content_font_, [&](){
+          render_memory_panel();
           ImGui::Spacing();
         });
       }
@@ -346,6 +540,162 @@ void GUI::render_controls() {
     ImGui::End();
 }
 
+void GUI::render_memory_panel() {
+    MemoryTracker& tracker = MemoryTracker::get_instance();
+    MemoryTracker::Snapshot snapshot = tracker.get_snapshot();
+    constexpr double MB = 1024.0 * 1024.0;
+
+    ImGui::Text("Total: %.1f MB, peak %.1f MB", snapshot.total.current_bytes / MB, snapshot.total.peak_bytes / MB);
+    ImGui::SameLine();
+    if (ImGui::SmallButton("Reset peaks")) {
+        tracker.reset_peaks();
+    }
+    ImGui::TextDisabled("GPU sizes are estimated from format and dimensions");
+
+    // Budgets are edited in MB; 0 disables the warning
+    if (ImGui::BeginTable("##memory", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Category");
+        ImGui::TableSetupColumn("Current MB");
+        ImGui::TableSetupColumn("Peak MB");
+        ImGui::TableSetupColumn("Count");
+        ImGui::TableSetupColumn("Budget MB");
+        ImGui::TableHeadersRow();
+        for (size_t i = 0; i <= MemoryTracker::CATEGORY_COUNT; ++i) {
+            bool is_total = i == MemoryTracker::CATEGORY_COUNT;
+            const MemoryTracker::CategoryStats& stats = is_total ? snapshot.total : snapshot.categories[i];
+            bool over_budget = stats.budget_bytes > 0 && stats.current_bytes > stats.budget_bytes;
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("%s", is_total ? "Total" : MemoryTracker::get_category_name(static_cast<MemoryCategory>(i)));
+            ImGui::TableNextColumn();
+            if (over_budget) {
+                ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%.2f", stats.current_bytes / MB);
+            } else {
+                ImGui::Text("%.2f", stats.current_bytes / MB);
+            }
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", stats.peak_bytes / MB);
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", stats.live_allocations);
+            ImGui::TableNextColumn();
+            float budget_mb = static_cast<float>(stats.budget_bytes / MB);
+            ImGui::PushID(static_cast<int>(i));
+            ImGui::SetNextItemWidth(-1.0f);
+            if (ImGui::InputFloat("##budget", &budget_mb, 0.0f, 0.0f, "%.0f", ImGuiInputTextFlags_EnterReturnsTrue)) {
+                size_t budget_bytes = static_cast<size_t>(std::max(budget_mb, 0.0f) * MB);
+                if (is_total) {
+                    tracker.set_total_budget(budget_bytes);
+                } else {
+                    tracker.set_budget(static_cast<MemoryCategory>(i), budget_bytes);
+                }
+            }
+            ImGui::PopID();
+        }
+        ImGui::EndTable();
+    }
+}
+
+void GUI::render_profiler_timeline() {
+    if (!Profiler::is_compiled_in()) {
+        ImGui::TextDisabled("Profiler compiled out (RENDERER_ENABLE_PROFILER=OFF)");
+        return;
+    }
+
+    Profiler& profiler = Profiler::get_instance();
+    bool paused = profiler.is_paused();
+    if (ImGui::Checkbox("Pause", &paused)) {
+        profiler.set_paused(paused);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Export Chrome Trace")) {
+        profiler.export_chrome_trace("profile_trace.json");
+    }
+    if (profiler.get_overwritten_zone_count() > 0) {
+        ImGui::TextDisabled("%llu zones lost to ring overflow", static_cast<unsigned long long>(profiler.get_overwritten_zone_count()));
+    }
+
+    const auto& frames = profiler.get_frames();
+    if (frames.empty()) {
+        ImGui::TextDisabled("No frames captured yet");
+        return;
+    }
+
+    // Frame times of the history, newest on the right; the slider picks the frame drawn below
+    static float frame_times[Profiler::MAX_FRAMES] = {};
+    int frame_count = static_cast<int>(frames.size());
+    for (int i = 0; i < frame_count; ++i) {
+        frame_times[i] = static_cast<float>((frames[i].end_ns - frames[i].start_ns) / 1.0e6);
+    }
+    ImGui::PlotHistogram("##frameTimes", frame_times, frame_count, 0, "Frame ms", 0.0f, 33.3f, ImVec2(0, 50));
+
+    static int frames_back = 0;
+    frames_back = std::clamp(frames_back, 0, frame_count - 1);
+    ImGui::SliderInt("Frames back", &frames_back, 0, frame_count - 1);
+
+    const Profiler::FrameRecord& frame = frames[frame_count - 1 - frames_back];
+    const double frame_ns = static_cast<double>(std::max<int64_t>(frame.end_ns - frame.start_ns, 1));
+    ImGui::Text("Frame: %.3f ms, %zu zones", frame_ns / 1.0e6, frame.zones.size());
+
+    // One lane per thread that recorded anything, one row per nesting level
+    std::vector<std::string> thread_names = profiler.get_thread_names();
+    std::vector<int> lane_depth(thread_names.size(), -1);
+    for (const auto& zone : frame.zones) {
+        if (zone.thread_index < lane_depth.size()) {
+            lane_depth[zone.thread_index] = std::max(lane_depth[zone.thread_index], static_cast<int>(zone.depth));
+        }
+    }
+
+    const float row_height = ImGui::GetTextLineHeight() + 2.0f;
+    const float label_width = 80.0f;
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const float timeline_width = std::max(ImGui::GetContentRegionAvail().x - label_width, 50.0f);
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    const ImVec2 mouse = ImGui::GetIO().MousePos;
+
+    std::vector<float> lane_y(thread_names.size(), 0.0f);
+    float y = origin.y;
+    for (size_t thread = 0; thread < thread_names.size(); ++thread) {
+        if (lane_depth[thread] < 0) {
+            continue;
+        }
+        lane_y[thread] = y;
+        draw_list->AddText(ImVec2(origin.x, y), ImGui::GetColorU32(ImGuiCol_Text), thread_names[thread].c_str());
+        y += row_height * static_cast<float>(lane_depth[thread] + 1) + 4.0f;
+    }
+
+    const Profiler::ZoneRecord* hovered = nullptr;
+    for (const auto& zone : frame.zones) {
+        if (zone.thread_index >= lane_depth.size()) {
+            continue;
+        }
+        // Zones that began in an earlier frame are clipped to this one
+        double start = std::max<double>(static_cast<double>(zone.start_ns - frame.start_ns), 0.0) / frame_ns;
+        double end = std::min<double>(static_cast<double>(zone.end_ns - frame.start_ns), frame_ns) / frame_ns;
+        ImVec2 min(origin.x + label_width + static_cast<float>(start) * timeline_width,
+                   lane_y[zone.thread_index] + row_height * static_cast<float>(zone.depth));
+        ImVec2 max(std::max(origin.x + label_width + static_cast<float>(end) * timeline_width, min.x + 1.0f),
+                   min.y + row_height - 1.0f);
+
+        // Same name, same colour
+        size_t hash = std::hash<std::string_view>{}(zone.name);
+        ImU32 color = ImColor::HSV(static_cast<float>(hash % 360) / 360.0f, 0.45f, 0.75f);
+        draw_list->AddRectFilled(min, max, color);
+        if (max.x - min.x > ImGui::CalcTextSize(zone.name).x + 4.0f) {
+            draw_list->AddText(ImVec2(min.x + 2.0f, min.y), IM_COL32(0, 0, 0, 255), zone.name);
+        }
+        if (mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y) {
+            hovered = &zone;
+        }
+    }
+
+    ImGui::Dummy(ImVec2(label_width + timeline_width, std::max(y - origin.y, row_height)));
+    if (hovered && ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("%s\n%.3f ms (%s)", hovered->name, (hovered->end_ns - hovered->start_ns) / 1.0e6,
+                          thread_names[hovered->thread_index].c_str());
+    }
+}
+
 void GUI::render_viewport() {
     const std::string windowName = "3D Viewport";
     if (next_window_positions_.find(windowName) != next_window_positions_.end()) {
@@ -436,20 +786,26 @@ void GUI::render_log_panel() {
     ImGui::BeginChild("LogScrollRegion", ImVec2(0, 0), false, ImGuiWindowFlags_HorizontalScrollbar);
     
     if (imguiSink) {
-        const auto& entries = imguiSink->get_entries();
+        // Copied out under the sink lock only when new messages arrived; only visible rows are drawn
+        imguiSink->snapshot(log_snapshot_, log_snapshot_version_);
         
-        for (const auto& entry : entries) {
-            
-            float color[4];
-            ImGuiSink_mt::get_level_color(entry.level, color);
-            ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(color[0], color[1], color[2], color[3]));
-            
-            ImGui::Text("[%s] %s %s", 
-                       entry.timestamp.c_str(),
-                       ImGuiSink_mt::getLevelString(entry.level),
-                       entry.message.c_str());
-            
-            ImGui::PopStyleColor();
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(log_snapshot_.size()));
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                const auto& entry = log_snapshot_[i];
+                
+                float color[4];
+                ImGuiSink_mt::get_level_color(entry.level, color);
+                ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(color[0], color[1], color[2], color[3]));
+                
+                ImGui::Text("[%s] %s %s", 
+                           entry.timestamp,
+                           ImGuiSink_mt::getLevelString(entry.level),
+                           entry.message.c_str());
+                
+                ImGui::PopStyleColor();
+            }
         }
         
         if (imguiSink->get_auto_scroll() && ImGui::GetScrollY() >= ImGui::GetScrollMaxY()) {
@@ -623,6 +979,96 @@ void GUI::render_resource_cache_panel() {
             });
         }
     });
+
+    // Import telemetry section
+    with_font(current_subtitle_font_, [&]() {
+        if (ImGui::CollapsingHeader("Import Telemetry")) {
+            ImGui::Spacing();
+            with_font(current_content_font_, [&]() {
+                if (!loadTelemetryCallback_) {
+                    ImGui::TextDisabled("Telemetry callback not set");
+                    return;
+                }
+
+                CoroutineResourceManager::LoadTelemetry telemetry = loadTelemetryCallback_();
+                const auto& scheduler = telemetry.scheduler;
+                ImGui::Text("Imports: %zu (%zu textures), %.1f MB",
+                            telemetry.import_count, telemetry.texture_count, telemetry.total_bytes / (1024.0 * 1024.0));
+                ImGui::Text("Throughput: %.1f MB/s, %.1f textures/s", telemetry.mb_per_second, telemetry.textures_per_second);
+                if (scheduler.main_thread_resumes > 0) {
+                    ImGui::Text("Main thread delay: avg %.2f ms, max %.2f ms",
+                                scheduler.main_thread_delay_total_ms / scheduler.main_thread_resumes,
+                                scheduler.main_thread_delay_max_ms);
+                }
+                if (loadTelemetryExportCallback_) {
+                    if (ImGui::SmallButton("Export JSON")) {
+                        loadTelemetryExportCallback_();
+                    }
+                }
+
+                static const char* priority_names[] = { "Background", "Normal", "High", "Critical" };
+                if (ImGui::BeginTable("##queueWait", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+                    ImGui::TableSetupColumn("Queue");
+                    ImGui::TableSetupColumn("Tasks");
+                    ImGui::TableSetupColumn("Avg ms");
+                    ImGui::TableSetupColumn("Max ms");
+                    ImGui::TableHeadersRow();
+                    for (size_t i = 0; i < scheduler.queue_wait.size(); ++i) {
+                        const auto& wait = scheduler.queue_wait[i];
+                        ImGui::TableNextRow();
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%s", priority_names[i]);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%zu", wait.count);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.2f", wait.count > 0 ? wait.total_ms / wait.count : 0.0);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.2f", wait.max_ms);
+                    }
+                    ImGui::EndTable();
+                }
+
+                for (size_t i = 0; i < scheduler.worker_utilization.size(); ++i) {
+                    char label[32];
+                    std::snprintf(label, sizeof(label), "Worker %zu", i);
+                    ImGui::ProgressBar(static_cast<float>(scheduler.worker_utilization[i]), ImVec2(-1.0f, 0.0f), label);
+                }
+
+                if (telemetry.imports.empty()) {
+                    ImGui::TextDisabled("No imports yet");
+                } else if (ImGui::BeginTable("##imports", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY,
+                                             ImVec2(0.0f, 200.0f))) {
+                    ImGui::TableSetupColumn("Asset");
+                    ImGui::TableSetupColumn("Queue");
+                    ImGui::TableSetupColumn("Read");
+                    ImGui::TableSetupColumn("Parse");
+                    ImGui::TableSetupColumn("Post");
+                    ImGui::TableSetupColumn("Upload");
+                    ImGui::TableSetupColumn("Resume");
+                    ImGui::TableHeadersRow();
+                    // Newest first
+                    for (auto it = telemetry.imports.rbegin(); it != telemetry.imports.rend(); ++it) {
+                        ImGui::TableNextRow();
+                        ImGui::TableNextColumn();
+                        std::string name = std::filesystem::path(it->path).filename().string();
+                        ImGui::Text("%s", name.c_str());
+                        if (ImGui::IsItemHovered()) {
+                            ImGui::SetTooltip("%s (%s)\n%.2f ms total, %.1f KB", it->path.c_str(), it->kind.c_str(),
+                                              it->total_ms, it->bytes / 1024.0);
+                        }
+                        const double stages[] = { it->queue_wait_ms, it->read_ms, it->parse_ms, it->post_process_ms,
+                                                  it->upload_ms, it->continuation_ms };
+                        for (double stage_ms : stages) {
+                            ImGui::TableNextColumn();
+                            ImGui::Text("%.2f", stage_ms);
+                        }
+                    }
+                    ImGui::EndTable();
+                }
+                ImGui::Spacing();
+            });
+        }
+    });
     
     ImGui::End();
 }
@@ -883,3 +1329,55 @@ void GUI::set_ssgi_thickness_callback(std::function<void(float)> callback) {
 void GUI::set_ssgi_num_samples_callback(std::function<void(int)> callback) {
     ssgiNumSamplesCallback_ = callback;
 }
+
+void GUI::set_occlusion_culling_callback(std::function<void(bool)> callback) {
+    occlusionCullingCallback_ = callback;
+}
+
+void GUI::set_tiled_lighting_callback(std::function<void(bool)> callback) {
+    tiledLightingCallback_ = callback;
+}
+
+void GUI::set_texture_array_packing_callback(std::function<void(bool)> callback) {
+    textureArrayPackingCallback_ = callback;
+}
+
+void GUI::set_ssao_resolution_callback(std::function<void(int)> callback) {
+    ssaoResolutionCallback_ = callback;
+}
+
+void GUI::set_ssgi_resolution_callback(std::function<void(int)> callback) {
+    ssgiResolutionCallback_ = callback;
+}
+
+void GUI::set_effect_timing_callback(std::function<float(const std::string&, int)> callback) {
+    effectTimingCallback_ = callback;
+}
+
+void GUI::set_pass_timings_callback(std::function<std::vector<RenderGraph::PassTiming>()> callback) {
+    passTimingsCallback_ = callback;
+}
+
+void GUI::set_pass_timings_export_callback(std::function<void()> callback) {
+    passTimingsExportCallback_ = callback;
+}
+
+void GUI::set_render_counters_callback(std::function<RenderCounters()> callback) {
+    renderCountersCallback_ = callback;
+}
+
+void GUI::set_load_telemetry_callback(std::function<CoroutineResourceManager::LoadTelemetry()> callback) {
+    loadTelemetryCallback_ = callback;
+}
+
+void GUI::set_load_telemetry_export_callback(std::function<void()> callback) {
+    loadTelemetryExportCallback_ = callback;
+}
+
+void GUI::set_taa_callback(std::function<void(bool)> callback) {
+    taaCallback_ = callback;
+}
+
+void GUI::set_taa_render_scale_callback(std::function<void(float)> callback) {
+    taaRenderScaleCallback_ = callback;
+}
@@ -4,11 +4,15 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <vector>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <imgui.h>
+#include "CoroutineResourceManager.h"
 #include "FileDialogManager.h"
+#include "Logger.h"
+#include "RenderGraph.h"
 
 class Window;
 
@@ -33,6 +37,17 @@ public:
     void set_ssgi_step_size_callback(std::function<void(float)> callback);
     void set_ssgi_thickness_callback(std::function<void(float)> callback);
     void set_ssgi_num_samples_callback(std::function<void(int)> callback);
+    void set_occlusion_culling_callback(std::function<void(bool)> callback);
+    void set_tiled_lighting_callback(std::function<void(bool)> callback);
+    void set_texture_array_packing_callback(std::function<void(bool)> callback);
+    void set_ssao_resolution_callback(std::function<void(int)> callback);
+    void set_ssgi_resolution_callback(std::function<void(int)> callback);
+    void set_effect_timing_callback(std::function<float(const std::string&, int)> callback);
+    void set_pass_timings_callback(std::function<std::vector<RenderGraph::PassTiming>()> callback);
+    void set_pass_timings_export_callback(std::function<void()> callback);
+    void set_render_counters_callback(std::function<RenderCounters()> callback);
+    void set_taa_callback(std::function<void(bool)> callback);
+    void set_taa_render_scale_callback(std::function<void(float)> callback);
     void update_fonts_for_window_size(int window_width, int window_height);
     bool needs_render() const { return needs_render_; }
     void reset_render_flag() { needs_render_ = false; }
@@ -41,6 +56,8 @@ public:
     void set_resource_cache_callback(std::function<std::vector<std::string>()> get_texture_names,
                                     std::function<std::vector<std::string>()> get_model_names,
                                     std::function<std::vector<std::string>()> get_material_names);
+    void set_load_telemetry_callback(std::function<CoroutineResourceManager::LoadTelemetry()> callback);
+    void set_load_telemetry_export_callback(std::function<void()> callback);
     
     bool is_mouse_in_viewport(double mouse_x, double mouse_y) const;
     
@@ -72,11 +89,24 @@ private:
     std::function<void(float)> ssgiStepSizeCallback_;
     std::function<void(float)> ssgiThicknessCallback_;
     std::function<void(int)> ssgiNumSamplesCallback_;
+    std::function<void(bool)> occlusionCullingCallback_;
+    std::function<void(bool)> tiledLightingCallback_;
+    std::function<void(bool)> textureArrayPackingCallback_;
+    std::function<void(int)> ssaoResolutionCallback_;
+    std::function<void(int)> ssgiResolutionCallback_;
+    std::function<float(const std::string&, int)> effectTimingCallback_;  // (effect, resolution divisor) -> GPU ms
+    std::function<std::vector<RenderGraph::PassTiming>()> passTimingsCallback_;
+    std::function<void()> passTimingsExportCallback_;
+    std::function<RenderCounters()> renderCountersCallback_;
+    std::function<void(bool)> taaCallback_;
+    std::function<void(float)> taaRenderScaleCallback_;
     
     // Resource cache callbacks
     std::function<std::vector<std::string>()> getTextureNamesCallback_;
     std::function<std::vector<std::string>()> getModelNamesCallback_;
     std::function<std::vector<std::string>()> getMaterialNamesCallback_;
+    std::function<CoroutineResourceManager::LoadTelemetry()> loadTelemetryCallback_;
+    std::function<void()> loadTelemetryExportCallback_;
     
     // Loading state tracking for individual models
     struct ModelLoadingState {
@@ -86,6 +116,10 @@ private:
     };
     std::map<std::string, ModelLoadingState> model_loading_states_;
     
+    // Log panel copy of the sink's ring, refreshed when its version changes
+    std::vector<ImGuiSink_mt::LogEntry> log_snapshot_;
+    uint64_t log_snapshot_version_ = 0;
+    
     // viewport size tracking
     int last_viewport_width_;
     int last_viewport_height_;    
@@ -94,6 +128,8 @@ private:
     void render_viewport();
     void render_controls();
     void render_log_panel();
+    void render_profiler_timeline();
+    void render_memory_panel();
     void render_resource_cache_panel();
     void setup_modern_style();
     void render_smart_layout();
@@ -1,10 +1,14 @@
 #include <stdexcept>
+#include <chrono>
 #include <filesystem>
 #include <string>
 #include <Application.h>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <CoroutineThreadPoolScheduler.h>
+#include <MemoryTracker.h>
+#include <Profiler.h>
+#include <RenderStats.h>
 #include <Model.h>
 #include <Material.h>
 #include <Renderer.h>
@@ -152,6 +156,16 @@ bool Application::initialize(){
             [this]() -> std::vector<std::string> { return this->get_model_names(); },
             [this]() -> std::vector<std::string> { return this->get_material_names(); }
         );
+
+        ui_->set_load_telemetry_callback([this]() {
+            return resource_manager_ ? resource_manager_->get_load_telemetry() : CoroutineResourceManager::LoadTelemetry();
+        });
+
+        ui_->set_load_telemetry_export_callback([this]() {
+            if (resource_manager_) {
+                resource_manager_->export_load_telemetry_json("load_telemetry.json");
+            }
+        });
         
         // Set up SSGI parameter callbacks
         ui_->set_ssgi_exposure_callback([this](float exposure) {
@@ -182,6 +196,56 @@ bool Application::initialize(){
         ui_->set_ssgi_num_samples_callback([this](int num_samples) {
             this->set_ssgi_num_samples(num_samples);
         });
+        
+        ui_->set_occlusion_culling_callback([this](bool enable) {
+            this->set_occlusion_culling(enable);
+        });
+        
+        ui_->set_tiled_lighting_callback([this](bool enable) {
+            this->set_tiled_lighting(enable);
+        });
+        
+        ui_->set_texture_array_packing_callback([this](bool enable) {
+            if (resource_manager_) {
+                resource_manager_->set_texture_array_packing_enabled(enable);
+            }
+        });
+        
+        // Set up screen-space effect resolution and timing callbacks
+        ui_->set_ssao_resolution_callback([this](int divisor) {
+            this->set_ssao_resolution(divisor);
+        });
+        
+        ui_->set_ssgi_resolution_callback([this](int divisor) {
+            this->set_ssgi_resolution(divisor);
+        });
+        
+        ui_->set_effect_timing_callback([this](const std::string& effect, int divisor) {
+            return this->get_effect_gpu_time_ms(effect, divisor);
+        });
+        
+        ui_->set_pass_timings_callback([this]() {
+            return renderer_ ? renderer_->get_pass_timings() : std::vector<RenderGraph::PassTiming>();
+        });
+        
+        ui_->set_pass_timings_export_callback([this]() {
+            if (renderer_) {
+                renderer_->export_pass_timings_csv("pass_timings.csv");
+            }
+        });
+
+        ui_->set_render_counters_callback([this]() {
+            return renderer_ ? renderer_->get_frame_counters() : RenderCounters();
+        });
+        
+        // Set up TAA callbacks
+        ui_->set_taa_callback([this](bool enable) {
+            this->set_taa_enabled(enable);
+        });
+        
+        ui_->set_taa_render_scale_callback([this](float scale) {
+            this->set_taa_render_scale(scale);
+        });
 
         setup_opengl_debug_output();
 
@@ -189,7 +253,7 @@ bool Application::initialize(){
         return true;
     }
     catch (const std::exception& e) {
-        LOG_ERROR("Application initialization failed: ", e.what());
+        LOG_ERROR("Application initialization failed: {}", e.what());
         return false;
     }
 
@@ -202,11 +266,15 @@ void Application::run() {
     }
     
     last_frame_time_ = static_cast<float>(glfwGetTime());
+    PROFILE_THREAD_NAME("Main");
 
     while (!window_->should_close()) {
         
         update_delta_time();
-        glfwPollEvents();
+        {
+            PROFILE_SCOPE("Poll events");
+            glfwPollEvents();
+        }
         
         // Process main thread coroutines
         Async::CoroutineThreadPoolScheduler::get_instance().process_main_thread_coroutines();
@@ -216,17 +284,22 @@ void Application::run() {
         
         // Process input
         if (input_manager_) {
+            PROFILE_SCOPE("Input");
             input_manager_->process_input(delta_time_);
         }
 
         // Render 
         if (resource_manager_) {
+            PROFILE_SCOPE("Render");
             try {    
                 if (!scene_->is_empty()) {
                     
                     // Get transform manager for rendering
                     TransformManager* transform_manager = input_manager_->get_transform_manager();
                     if (transform_manager) {
+                        // Sub-pixel jitter for TAA, zero when TAA is inactive
+                        camera_->set_projection_jitter(renderer_->get_projection_jitter());
+                        
                         // Use deferred rendering if enabled, otherwise use forward rendering
                         if (renderer_->is_deferred_rendering_enabled()) {
                             LOG_DEBUG("Application: Using deferred rendering");
@@ -246,14 +319,24 @@ void Application::run() {
         } else {
             LOG_WARN("Application: ResourceManager not available, skipping rendering");
         }
+        // Publish this frame's GL counters before the GUI shows them
+        RenderStats::end_frame();
+        MemoryTracker::get_instance().check_budgets();
 
         // GUI rendering
-        ui_->set_render_texture(renderer_->get_color_texture(), viewport_width_, viewport_height_);
-        ui_->begin_frame();
-        ui_->render();
-        ui_->end_frame();
+        {
+            PROFILE_SCOPE("GUI");
+            ui_->set_render_texture(renderer_->get_color_texture(), viewport_width_, viewport_height_);
+            ui_->begin_frame();
+            ui_->render();
+            ui_->end_frame();
+        }
 
-        glfwSwapBuffers(window_->get_window_ptr());
+        {
+            PROFILE_SCOPE("Swap buffers");
+            glfwSwapBuffers(window_->get_window_ptr());
+        }
+        PROFILE_FRAME_MARK();
     }
 }
 
@@ -651,7 +734,8 @@ void Application::check_pending_model_with_textures_load() {
             auto model_data = task.try_get();
             
             if (model_data.has_value() && !model_data.value().meshes.empty()) {
-                const LoadedModelData& data = model_data.value();
+                // Non-const: the vertex and index arrays are moved into the meshes
+                LoadedModelData& data = model_data.value();
                 
                 // Calculate total vertices for logging
                 size_t total_vertices = 0;
@@ -669,11 +753,15 @@ void Application::check_pending_model_with_textures_load() {
                 resource_manager_->load_model_textures(data.texture_paths);
                 
                 // Create individual Models for each mesh
+                std::chrono::steady_clock::duration mesh_upload_time{};
                 for (size_t i = 0; i < data.meshes.size(); ++i) {
-                    const auto& mesh_data = data.meshes[i];
+                    auto& mesh_data = data.meshes[i];
                     
-                    // Create mesh
-                    auto mesh = std::make_shared<Mesh>(mesh_data.vertices, mesh_data.indices);
+                    // Create mesh and upload it now, so the import telemetry includes the upload
+                    auto mesh = std::make_shared<Mesh>(std::move(mesh_data.vertices), std::move(mesh_data.indices));
+                    auto upload_start = std::chrono::steady_clock::now();
+                    mesh->ensure_setup();
+                    mesh_upload_time += std::chrono::steady_clock::now() - upload_start;
                     std::string mesh_id = current_loading_model_name_ + "_mesh_" + std::to_string(i);
                     resource_manager_->store_mesh_in_cache(mesh_id, mesh);
                     
@@ -703,6 +791,8 @@ void Application::check_pending_model_with_textures_load() {
                 
                 LOG_INFO("Application: Created Renderable '{}' with {} models from {} meshes", 
                         current_loading_model_name_, data.meshes.size(), data.meshes.size());
+                resource_manager_->add_upload_time(current_loading_model_path_,
+                                                   std::chrono::duration<double, std::milli>(mesh_upload_time).count());
                 
                 // Store Renderable in cache
                 resource_manager_->store_renderable_in_cache(current_loading_model_name_, renderable);
@@ -821,3 +911,52 @@ void Application::set_ssgi_num_samples(int num_samples) {
     }
     LOG_DEBUG("Application: SSGI num samples set to {}", num_samples);
 }
+
+void Application::set_occlusion_culling(bool enable) {
+    if (renderer_) {
+        renderer_->set_occlusion_culling_enabled(enable);
+    }
+}
+
+void Application::set_tiled_lighting(bool enable) {
+    if (renderer_) {
+        renderer_->set_tiled_lighting_enabled(enable);
+    }
+}
+
+void Application::set_ssao_resolution(int divisor) {
+    if (renderer_) {
+        renderer_->set_ssao_resolution_divisor(divisor);
+    }
+}
+
+void Application::set_ssgi_resolution(int divisor) {
+    if (renderer_) {
+        renderer_->set_ssgi_resolution_divisor(divisor);
+    }
+}
+
+float Application::get_effect_gpu_time_ms(const std::string& effect, int divisor) const {
+    if (!renderer_) {
+        return -1.0f;
+    }
+    if (effect == "SSAO") {
+        return renderer_->get_ssao_gpu_time_ms(divisor);
+    }
+    if (effect == "SSGI") {
+        return renderer_->get_ssgi_gpu_time_ms(divisor);
+    }
+    return -1.0f;
+}
+
+void Application::set_taa_enabled(bool enable) {
+    if (renderer_) {
+        renderer_->set_taa_enabled(enable);
+    }
+}
+
+void Application::set_taa_render_scale(float scale) {
+    if (renderer_) {
+        renderer_->set_taa_render_scale(scale);
+    }
+}
@@ -1,9 +1,66 @@
 #include <Application.h>
+#include <HeadlessRenderer.h>
 #include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
 #include <GLFW/glfw3.h>
 
-int main() {
+namespace {
+
+void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [--headless [options]]\n"
+              << "  --headless           Render offscreen without a window\n"
+              << "  --frames N           Frames to render (default 120)\n"
+              << "  --size WxH           Framebuffer size (default 1280x720)\n"
+              << "  --capture-every N    Also write every Nth frame (default: last frame only)\n"
+              << "  --output DIR         Directory for PNGs and pass_timings.csv (default headless_output)\n";
+}
+
+// Returns false on an unknown or malformed argument
+bool parse_headless_options(int argc, char** argv, bool& headless, HeadlessRenderer::Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (std::strcmp(arg, "--headless") == 0) {
+            headless = true;
+        } else if (std::strcmp(arg, "--frames") == 0 && value) {
+            options.frames = std::atoi(value);
+            ++i;
+        } else if (std::strcmp(arg, "--size") == 0 && value) {
+            if (std::sscanf(value, "%dx%d", &options.width, &options.height) != 2) {
+                return false;
+            }
+            ++i;
+        } else if (std::strcmp(arg, "--capture-every") == 0 && value) {
+            options.capture_interval = std::atoi(value);
+            ++i;
+        } else if (std::strcmp(arg, "--output") == 0 && value) {
+            options.output_directory = value;
+            ++i;
+        } else {
+            return false;
+        }
+    }
+    return options.frames > 0 && options.width > 0 && options.height > 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
     try {
+        bool headless = false;
+        HeadlessRenderer::Options headless_options;
+        if (!parse_headless_options(argc, argv, headless, headless_options)) {
+            print_usage(argv[0]);
+            return -1;
+        }
+
+        if (headless) {
+            HeadlessRenderer renderer;
+            return renderer.run(headless_options);
+        }
 
         Application app("Real-time Rendering Engine");
         if (!app.initialize()) {
@@ -12,9 +69,9 @@ int main() {
         }
 
         app.run();
-        
+
         return 0;
-        
+
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
         return -1;
@@ -1,61 +1,73 @@
 #version 460 core
 
 // G-Buffer outputs 
-layout (location = 0) out vec4 gPosition;      // World Position (xyz) + Material ID (w)
-layout (location = 1) out vec4 gAlbedoMetallic; // Albedo (rgb) + Metallic (a)
-layout (location = 2) out vec4 gNormalRoughness; // Normal (xyz) + Roughness (a)
-layout (location = 3) out vec4 gMotionAO;      // Motion Vector (xy) + AO (z) + unused (w)
-layout (location = 4) out vec4 gEmissive;      // Emissive Color (rgb) + intensity (a)
+// World position is not stored; lighting passes reconstruct it from depth
+layout (location = 0) out vec4 gAlbedoMetallic; // Albedo (rgb, sRGB encoded) + Metallic (a)
+layout (location = 1) out vec4 gNormalRoughness; // Octahedral Normal (rg) + Roughness (b) + unused (a)
+layout (location = 2) out vec4 gMotionAO;      // Motion Vector (xy) + AO (z) + unused (w)
+layout (location = 3) out vec4 gEmissive;      // Emissive Color (rgb) + intensity (a)
 
 in vec3 FragPos;
 in vec3 Normal;
 in vec2 TexCoords;
 in vec3 WorldPos;
 in vec3 Tangent;
-in vec4 PrevFragPos;
+in vec4 CurrClipPos;
+in vec4 PrevClipPos;
 
-// Material properties
-struct Material {
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-    float shininess;
-    vec3 emissive;
+flat in uint MaterialIndex;
+
+// Material parameters of every material drawn this frame (MaterialTable::Record)
+struct MaterialRecord {
+    vec4 ambient;
+    vec4 diffuse;
+    vec4 specularShininess;
+    vec4 emissive;
+    vec4 params;   // Metallic, roughness, AO, height scale
+    uvec4 flags;   // Texture bits (see the units below), bits of units in an array, PBR enabled, unused
+    uvec4 textureLayers[2];  // Array index << 16 | layer per unit, units 0-3 then 4-5
+};
+
+layout (std430, binding = 3) readonly buffer MaterialTable {
+    MaterialRecord materials[];
 };
 
-uniform Material material;
+// Material textures on fixed units (Material::TextureUnit)
+layout (binding = 0) uniform sampler2D albedoTexture;
+layout (binding = 1) uniform sampler2D normalTexture;
+layout (binding = 2) uniform sampler2D metallicTexture;
+layout (binding = 3) uniform sampler2D roughnessTexture;
+layout (binding = 4) uniform sampler2D aoTexture;
+layout (binding = 5) uniform sampler2D emissiveTexture;
 
-// Material textures
-uniform sampler2D albedoTexture;
-uniform sampler2D normalTexture;
-uniform sampler2D metallicTexture;
-uniform sampler2D roughnessTexture;
-uniform sampler2D aoTexture;
-uniform sampler2D emissiveTexture;
+// Packed material textures (Material::ARRAY_UNIT, MAX_TEXTURE_ARRAYS); the index comes from the
+// draw's material record, so it is dynamically uniform
+layout (binding = 6) uniform sampler2DArray textureArrays[8];
 
-// Material parameters
-uniform float materialMetallic;
-uniform float materialRoughness;
-uniform float materialAO;
-uniform int materialID;
+bool hasTexture(uint unit)
+{
+    return (materials[MaterialIndex].flags.x & (1u << unit)) != 0u;
+}
 
-// Flags to indicate if textures are available
-uniform bool hasAlbedoTexture;
-uniform bool hasNormalTexture;
-uniform bool hasMetallicTexture;
-uniform bool hasRoughnessTexture;
-uniform bool hasAOTexture;
-uniform bool hasEmissiveTexture;
+// Samples a unit's texture from its separate binding or from its texture array layer
+vec4 sampleMaterialTexture(sampler2D separateTexture, uint unit)
+{
+    if ((materials[MaterialIndex].flags.y & (1u << unit)) != 0u) {
+        uint layerRef = materials[MaterialIndex].textureLayers[unit >> 2u][unit & 3u];
+        return texture(textureArrays[layerRef >> 16u], vec3(TexCoords, float(layerRef & 0xFFFFu)));
+    }
+    return texture(separateTexture, TexCoords);
+}
 
 vec3 getNormalFromMap()
 {
     // If no normal texture is available, return the vertex normal
-    if (!hasNormalTexture) {
+    if (!hasTexture(1u)) {
         return normalize(Normal);
     }
     
     // Sample the normal map and convert from [0,1] to [-1,1]
-    vec3 normalMap = texture(normalTexture, TexCoords).rgb * 2.0 - 1.0;
+    vec3 normalMap = sampleMaterialTexture(normalTexture, 1u).rgb * 2.0 - 1.0;
     
     // Calculate the bitangent
     vec3 N = normalize(Normal);
@@ -71,64 +83,54 @@ vec3 getNormalFromMap()
     return normalize(TBN * normalMap);
 }
 
+#include "gbuffer_common.glsl"
+
+// Screen-space motion in UV units: previous UV = current UV - motion
 vec2 calculateMotionVector()
 {
-    // Calculate current screen position
-    vec4 currentPos = gl_FragCoord;
-    vec2 currentScreenPos = currentPos.xy / currentPos.w;
-    
-    // Calculate previous screen position
-    vec4 prevScreenPos = PrevFragPos;
-    prevScreenPos /= prevScreenPos.w;
-    prevScreenPos.xy = prevScreenPos.xy * 0.5 + 0.5; // Convert from [-1,1] to [0,1]
-    
-    // Current position in [0,1] range
-    vec2 screenSize = textureSize(albedoTexture, 0); // Use any available texture to get screen size
-    currentScreenPos = currentScreenPos / screenSize;
-    
-    // Motion vector is the difference between current and previous positions
-    return currentScreenPos - prevScreenPos.xy;
+    vec2 currentNDC = CurrClipPos.xy / CurrClipPos.w;
+    vec2 prevNDC = PrevClipPos.xy / PrevClipPos.w;
+    return (currentNDC - prevNDC) * 0.5;
 }
 
 void main()
 {
-    // RT0: World position //TODO: Add material ID
-    gPosition = vec4(WorldPos, 1.0); 
+    MaterialRecord material = materials[MaterialIndex];
     
-    // RT1: Albedo (RGB) + Metallic (A) 
-    vec3 albedo = material.diffuse;
-    if (hasAlbedoTexture) {
-        albedo *= texture(albedoTexture, TexCoords).rgb;
+    // RT0: Albedo (RGB) + Metallic (A) 
+    vec3 albedo = material.diffuse.rgb;
+    if (hasTexture(0u)) {
+        albedo *= sampleMaterialTexture(albedoTexture, 0u).rgb;
     }
-    float metallic = materialMetallic;
-    if (hasMetallicTexture) {
-        metallic *= texture(metallicTexture, TexCoords).r;
+    float metallic = material.params.x;
+    if (hasTexture(2u)) {
+        metallic *= sampleMaterialTexture(metallicTexture, 2u).r;
     }
     metallic = clamp(metallic, 0.0, 1.0);
     gAlbedoMetallic = vec4(albedo, metallic);
     
-    // RT2: Normal (RGB) + Roughness (A) 
+    // RT1: Octahedral Normal (RG) + Roughness (B) 
     vec3 normal = getNormalFromMap();
-    float roughness = materialRoughness;
-    if (hasRoughnessTexture) {
-        roughness *= texture(roughnessTexture, TexCoords).r;
+    float roughness = material.params.y;
+    if (hasTexture(3u)) {
+        roughness *= sampleMaterialTexture(roughnessTexture, 3u).r;
     }
     roughness = clamp(roughness, 0.0, 1.0);
-    gNormalRoughness = vec4(normal * 0.5 + 0.5, roughness); 
+    gNormalRoughness = vec4(encodeOctahedral(normal), roughness, 0.0); 
     
-    // RT3: Motion Vector (XY) + AO (Z) + unused (W)
-    float ao = materialAO;
-    if (hasAOTexture) {
-        ao *= texture(aoTexture, TexCoords).r;
+    // RT2: Motion Vector (XY) + AO (Z) + unused (W)
+    float ao = material.params.z;
+    if (hasTexture(4u)) {
+        ao *= sampleMaterialTexture(aoTexture, 4u).r;
     }
     ao = clamp(ao, 0.0, 1.0);
     vec2 motionVector = calculateMotionVector();
     gMotionAO = vec4(motionVector, ao, 0.0);
     
-    // RT4: Emissive Color (RGB) + Intensity (A)
-    vec3 emissiveColor = material.emissive;
-    if (hasEmissiveTexture) {
-        emissiveColor *= texture(emissiveTexture, TexCoords).rgb;
+    // RT3: Emissive Color (RGB) + Intensity (A)
+    vec3 emissiveColor = material.emissive.rgb;
+    if (hasTexture(5u)) {
+        emissiveColor *= sampleMaterialTexture(emissiveTexture, 5u).rgb;
     }
     float emissiveIntensity = length(emissiveColor);
     gEmissive = vec4(emissiveColor, emissiveIntensity);
@@ -9,12 +9,15 @@ out vec3 Normal;
 out vec2 TexCoords;
 out vec3 WorldPos;
 out vec3 Tangent;
-out vec4 PrevFragPos;  // For motion vectors
+out vec4 CurrClipPos;  // For motion vectors
+out vec4 PrevClipPos;
+flat out uint MaterialIndex;  // Record in MaterialTable, carried as the draw's base instance
 
 uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
-uniform mat4 prevModelViewProjection;  // Previous frame's MVP matrix
+uniform mat4 currViewProjection;  // Unjittered view-projection matrix
+uniform mat4 prevViewProjection;  // Previous frame's unjittered view-projection matrix
 
 void main()
 {
@@ -27,10 +30,12 @@ void main()
     Tangent = normalize(normalMatrix * aTangent);
     
     TexCoords = aTexCoords;
+    MaterialIndex = uint(gl_BaseInstance);
     
     // Calculate current position
     gl_Position = projection * view * vec4(WorldPos, 1.0);
     
-    // Calculate previous frame position for motion vectors
-    PrevFragPos = prevModelViewProjection * vec4(aPos, 1.0);
+    // Current and previous frame clip positions for motion vectors (camera motion)
+    CurrClipPos = currViewProjection * vec4(WorldPos, 1.0);
+    PrevClipPos = prevViewProjection * vec4(WorldPos, 1.0);
 }
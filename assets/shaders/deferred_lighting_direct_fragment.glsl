@@ -4,9 +4,8 @@ out vec4 FragColor;
 in vec2 TexCoords;
 
 // G-Buffer textures
-uniform sampler2D gPosition;      // World Position (xyz) + Material ID (w)
 uniform sampler2D gAlbedoMetallic; // Albedo (rgb) + Metallic (a)
-uniform sampler2D gNormalRoughness; // Normal (xyz) + Roughness (a)
+uniform sampler2D gNormalRoughness; // Octahedral Normal (rg) + Roughness (b)
 uniform sampler2D gMotionAO;      // Motion Vector (xy) + AO (z) + unused (w)
 uniform sampler2D gEmissive;      // Emissive Color (rgb) + intensity (a)
 uniform sampler2D gDepth;         // Depth buffer
@@ -15,6 +14,8 @@ uniform sampler2D gDepth;         // Depth buffer
 
 // Shadow map
 uniform sampler2D shadowMap;
+uniform sampler2D shadowMinMax;    // Min/max depth pyramid of the shadow map
+uniform int shadowMinMaxLevels;
 uniform bool enableShadows;
 uniform mat4 lightSpaceMatrix;
 
@@ -22,6 +23,7 @@ uniform mat4 lightSpaceMatrix;
 uniform vec3 viewPos;
 uniform mat4 view;
 uniform mat4 projection;
+uniform mat4 invViewProjection;
 
 // Lighting
 uniform int numLights;
@@ -80,33 +82,68 @@ vec3 fresnelSchlick(float cosTheta, vec3 F0)
     return F0 + (1.0 - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
 }
 
-// Blocker search for PCSS
-float findBlockerDepth(vec2 uv, float zReceiver, float searchRadius)
+// Per-pixel rotation of the Poisson disks; turns undersampling banding into fine noise
+mat2 poissonRotation(vec2 pixel)
+{
+    float noise = fract(52.9829189 * fract(dot(pixel, vec2(0.06711056, 0.00583715))));
+    float angle = 6.28318530718 * noise;
+    float s = sin(angle);
+    float c = cos(angle);
+    return mat2(c, s, -s, c);
+}
+
+// Min (x) and max (y) shadow depth over a square region, from at most four pyramid texels
+vec2 shadowDepthRange(vec2 uv, float radius)
+{
+    vec2 baseSize = vec2(textureSize(shadowMinMax, 0));
+    float footprint = 2.0 * radius * max(baseSize.x, baseSize.y);
+    int level = clamp(int(ceil(log2(max(footprint, 1.0)))), 0, shadowMinMaxLevels - 1);
+
+    ivec2 levelSize = textureSize(shadowMinMax, level);
+    ivec2 texelMin = clamp(ivec2((uv - radius) * vec2(levelSize)), ivec2(0), levelSize - 1);
+    ivec2 texelMax = clamp(ivec2((uv + radius) * vec2(levelSize)), ivec2(0), levelSize - 1);
+
+    vec2 range00 = texelFetch(shadowMinMax, texelMin, level).rg;
+    vec2 range10 = texelFetch(shadowMinMax, ivec2(texelMax.x, texelMin.y), level).rg;
+    vec2 range01 = texelFetch(shadowMinMax, ivec2(texelMin.x, texelMax.y), level).rg;
+    vec2 range11 = texelFetch(shadowMinMax, texelMax, level).rg;
+    vec2 range = vec2(min(min(range00.x, range10.x), min(range01.x, range11.x)),
+                      max(max(range00.y, range10.y), max(range01.y, range11.y)));
+
+    // Taps outside the map read the border depth (1.0)
+    if (any(lessThan(uv - radius, vec2(0.0))) || any(greaterThan(uv + radius, vec2(1.0)))) {
+        range.y = 1.0;
+    }
+    return range;
+}
+
+const vec2 poissonDisk[16] = vec2[](
+    vec2(-0.94201624, -0.39906216),
+    vec2(0.94558609, -0.76890725),
+    vec2(-0.094184101, -0.92938870),
+    vec2(0.34495938, 0.29387760),
+    vec2(-0.91588581, 0.45771432),
+    vec2(-0.81544232, -0.87912464),
+    vec2(-0.38277543, 0.27676845),
+    vec2(0.97484398, 0.75648379),
+    vec2(0.44323325, -0.97511554),
+    vec2(0.53742981, -0.47373420),
+    vec2(-0.26496911, -0.41893023),
+    vec2(0.79197514, 0.19090188),
+    vec2(-0.24188840, 0.99706507),
+    vec2(-0.81409955, 0.91437590),
+    vec2(0.19984126, 0.78641367),
+    vec2(0.14383161, -0.14100790)
+);
+
+// Blocker search for PCSS (8 rotated taps)
+float findBlockerDepth(vec2 uv, float zReceiver, float searchRadius, mat2 rotation)
 {
-    vec2 poissonDisk[16] = vec2[](
-        vec2(-0.94201624, -0.39906216),
-        vec2(0.94558609, -0.76890725),
-        vec2(-0.094184101, -0.92938870),
-        vec2(0.34495938, 0.29387760),
-        vec2(-0.91588581, 0.45771432),
-        vec2(-0.81544232, -0.87912464),
-        vec2(-0.38277543, 0.27676845),
-        vec2(0.97484398, 0.75648379),
-        vec2(0.44323325, -0.97511554),
-        vec2(0.53742981, -0.47373420),
-        vec2(-0.26496911, -0.41893023),
-        vec2(0.79197514, 0.19090188),
-        vec2(-0.24188840, 0.99706507),
-        vec2(-0.81409955, 0.91437590),
-        vec2(0.19984126, 0.78641367),
-        vec2(0.14383161, -0.14100790)
-    );
-    
     float blockerDepthSum = 0.0;
     int numBlockers = 0;
     
-    for (int i = 0; i < 16; i++) {
-        vec2 sampleUV = uv + poissonDisk[i] * searchRadius;
+    for (int i = 0; i < 8; i++) {
+        vec2 sampleUV = uv + rotation * poissonDisk[i] * searchRadius;
         float sampleDepth = texture(shadowMap, sampleUV).r;
         
         if (sampleDepth < zReceiver) {
@@ -128,39 +165,20 @@ float penumbraSize(float zReceiver, float zBlocker)
     return (zReceiver - zBlocker) / zBlocker;
 }
 
-// PCF with variable kernel size
-float PCF(vec2 uv, float zReceiver, float filterRadius)
+// PCF with variable kernel size and tap count
+float PCF(vec2 uv, float zReceiver, float filterRadius, mat2 rotation, int sampleCount)
 {
-    vec2 poissonDisk[16] = vec2[](
-        vec2(-0.94201624, -0.39906216),
-        vec2(0.94558609, -0.76890725),
-        vec2(-0.094184101, -0.92938870),
-        vec2(0.34495938, 0.29387760),
-        vec2(-0.91588581, 0.45771432),
-        vec2(-0.81544232, -0.87912464),
-        vec2(-0.38277543, 0.27676845),
-        vec2(0.97484398, 0.75648379),
-        vec2(0.44323325, -0.97511554),
-        vec2(0.53742981, -0.47373420),
-        vec2(-0.26496911, -0.41893023),
-        vec2(0.79197514, 0.19090188),
-        vec2(-0.24188840, 0.99706507),
-        vec2(-0.81409955, 0.91437590),
-        vec2(0.19984126, 0.78641367),
-        vec2(0.14383161, -0.14100790)
-    );
-    
     float shadow = 0.0;
-    for (int i = 0; i < 16; i++) {
-        vec2 sampleUV = uv + poissonDisk[i] * filterRadius;
+    for (int i = 0; i < sampleCount; i++) {
+        vec2 sampleUV = uv + rotation * poissonDisk[i] * filterRadius;
         float sampleDepth = texture(shadowMap, sampleUV).r;
         shadow += (sampleDepth >= zReceiver) ? 1.0 : 0.0;
     }
-    return shadow / 16.0;
+    return shadow / float(sampleCount);
 }
 
-// PCSS shadow calculation
-float ShadowCalculation(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir)
+// Adaptive PCSS shadow calculation
+float ShadowCalculation(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir, vec2 pixel)
 {
     vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
     projCoords = projCoords * 0.5 + 0.5;
@@ -173,10 +191,25 @@ float ShadowCalculation(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir)
     float currentDepth = projCoords.z;
     float bias = max(0.05 * (1.0 - dot(normal, lightDir)), 0.005);
     float zReceiver = currentDepth - bias;
+    float searchRadius = 0.05; // Light size parameter
+    vec2 texelSize = 1.0 / vec2(textureSize(shadowMap, 0));
+    
+    // Step 0: Classify the search region (padded for bilinear taps) from the min/max pyramid
+    vec2 depthRange = shadowDepthRange(projCoords.xy, searchRadius + max(texelSize.x, texelSize.y));
+    if (zReceiver <= depthRange.x) {
+        return 1.0; // No texel can block, fully lit
+    }
+    if (zReceiver > depthRange.y) {
+        // Every texel blocks; fully shadowed if even the nearest blocker keeps the filter inside the region
+        if (penumbraSize(zReceiver, depthRange.x) <= 1.0) {
+            return 0.0;
+        }
+    }
+    
+    mat2 rotation = poissonRotation(pixel);
     
     // Step 1: Blocker search
-    float searchRadius = 0.05; // Light size parameter
-    float avgBlockerDepth = findBlockerDepth(projCoords.xy, zReceiver, searchRadius);
+    float avgBlockerDepth = findBlockerDepth(projCoords.xy, zReceiver, searchRadius, rotation);
     
     if (avgBlockerDepth == -1.0) {
         return 1.0; // No blockers, fully lit
@@ -186,31 +219,34 @@ float ShadowCalculation(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir)
     float penumbraRatio = penumbraSize(zReceiver, avgBlockerDepth);
     float filterRadius = penumbraRatio * searchRadius;
     
-    // Step 3: PCF with estimated filter size
-    return PCF(projCoords.xy, zReceiver, filterRadius);
+    // Step 3: PCF with estimated filter size, fewer taps for narrow penumbrae
+    int sampleCount = filterRadius < 2.0 * texelSize.x ? 8 : 16;
+    return PCF(projCoords.xy, zReceiver, filterRadius, rotation, sampleCount);
 }
 
+#include "gbuffer_common.glsl"
+
 void main()
 {
     // Sample G-Buffer
-    vec4 positionData = texture(gPosition, TexCoords);
+    float depth = texture(gDepth, TexCoords).r;
     vec4 albedoMetallic = texture(gAlbedoMetallic, TexCoords);
     vec4 normalRoughness = texture(gNormalRoughness, TexCoords);
     vec4 motionAO = texture(gMotionAO, TexCoords);
     vec4 emissiveData = texture(gEmissive, TexCoords);
     
     // Skip background pixels
-    // if (positionData.w < 0.5) {
+    // if (depth >= 1.0) {
     //     FragColor = vec4(0.0, 0.0, 0.0, 1.0);
     //     return;
     // }
     
     // Extract data
-    vec3 WorldPos = positionData.xyz;
+    vec3 WorldPos = reconstructPosition(TexCoords, depth, invViewProjection);
     vec3 albedo = albedoMetallic.rgb;
     float metallic = albedoMetallic.a;
-    vec3 normal = normalize(normalRoughness.xyz * 2.0 - 1.0);
-    float roughness = normalRoughness.a;
+    vec3 normal = decodeOctahedral(normalRoughness.rg);
+    float roughness = normalRoughness.b;
     float ao = motionAO.z;
     vec3 emissiveColor = emissiveData.rgb * emissiveData.a;
     
@@ -277,7 +313,7 @@ void main()
         
         if (i == 0 && lightTypes[i] == 0) {  // Apply shadows to first directional light
             vec4 fragPosLightSpace = lightSpaceMatrix * vec4(WorldPos, 1.0);
-            shadow = ShadowCalculation(fragPosLightSpace, N, L);
+            shadow = ShadowCalculation(fragPosLightSpace, N, L, gl_FragCoord.xy);
         }
         
         Lo += (kD * albedo / PI + specular) * radiance * NdotL * shadow;
@@ -4,9 +4,8 @@ out vec4 FragColor;
 in vec2 TexCoords;
 
 // G-Buffer textures
-uniform sampler2D gPosition;      // World Position (xyz) + Material ID (w)
 uniform sampler2D gAlbedoMetallic; // Albedo (rgb) + Metallic (a)
-uniform sampler2D gNormalRoughness; // Normal (xyz) + Roughness (a)
+uniform sampler2D gNormalRoughness; // Octahedral Normal (rg) + Roughness (b)
 uniform sampler2D gMotionAO;      // Motion Vector (xy) + AO (z) + unused (w)
 uniform sampler2D gEmissive;      // Emissive Color (rgb) + intensity (a)
 uniform sampler2D gDepth;         // Depth buffer
@@ -15,6 +14,8 @@ uniform sampler2D gDepth;         // Depth buffer
 
 // Shadow map
 uniform sampler2D shadowMap;
+uniform sampler2D shadowMinMax;    // Min/max depth pyramid of the shadow map
+uniform int shadowMinMaxLevels;
 uniform bool enableShadows;
 uniform mat4 lightSpaceMatrix;
 
@@ -27,6 +28,7 @@ uniform bool useIBL;
 uniform vec3 viewPos;
 uniform mat4 view;
 uniform mat4 projection;
+uniform mat4 invViewProjection;
 
 // Lighting
 uniform vec3 ambientLight;
@@ -86,35 +88,70 @@ vec3 fresnelSchlick(float cosTheta, vec3 F0)
     return F0 + (1.0 - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
 }
 
-// Blocker search for PCSS
-float findBlockerDepth(vec2 uv, float zReceiver, float searchRadius)
+// Per-pixel rotation of the Poisson disks; turns undersampling banding into fine noise
+mat2 poissonRotation(vec2 pixel)
+{
+    float noise = fract(52.9829189 * fract(dot(pixel, vec2(0.06711056, 0.00583715))));
+    float angle = 6.28318530718 * noise;
+    float s = sin(angle);
+    float c = cos(angle);
+    return mat2(c, s, -s, c);
+}
+
+// Min (x) and max (y) shadow depth over a square region, from at most four pyramid texels
+vec2 shadowDepthRange(vec2 uv, float radius)
+{
+    vec2 baseSize = vec2(textureSize(shadowMinMax, 0));
+    float footprint = 2.0 * radius * max(baseSize.x, baseSize.y);
+    int level = clamp(int(ceil(log2(max(footprint, 1.0)))), 0, shadowMinMaxLevels - 1);
+
+    ivec2 levelSize = textureSize(shadowMinMax, level);
+    ivec2 texelMin = clamp(ivec2((uv - radius) * vec2(levelSize)), ivec2(0), levelSize - 1);
+    ivec2 texelMax = clamp(ivec2((uv + radius) * vec2(levelSize)), ivec2(0), levelSize - 1);
+
+    vec2 range00 = texelFetch(shadowMinMax, texelMin, level).rg;
+    vec2 range10 = texelFetch(shadowMinMax, ivec2(texelMax.x, texelMin.y), level).rg;
+    vec2 range01 = texelFetch(shadowMinMax, ivec2(texelMin.x, texelMax.y), level).rg;
+    vec2 range11 = texelFetch(shadowMinMax, texelMax, level).rg;
+    vec2 range = vec2(min(min(range00.x, range10.x), min(range01.x, range11.x)),
+                      max(max(range00.y, range10.y), max(range01.y, range11.y)));
+
+    // Taps outside the map read the border depth (1.0)
+    if (any(lessThan(uv - radius, vec2(0.0))) || any(greaterThan(uv + radius, vec2(1.0)))) {
+        range.y = 1.0;
+    }
+    return range;
+}
+
+const vec2 poissonDisk[16] = vec2[](
+    vec2(-0.94201624, -0.39906216),
+    vec2(0.94558609, -0.76890725),
+    vec2(-0.094184101, -0.92938870),
+    vec2(0.34495938, 0.29387760),
+    vec2(-0.91588581, 0.45771432),
+    vec2(-0.81544232, -0.87912464),
+    vec2(-0.38277543, 0.27676845),
+    vec2(0.97484398, 0.75648379),
+    vec2(0.44323325, -0.97511554),
+    vec2(0.53742981, -0.47373420),
+    vec2(-0.26496911, -0.41893023),
+    vec2(0.79197514, 0.19090188),
+    vec2(-0.24188840, 0.99706507),
+    vec2(-0.81409955, 0.91437590),
+    vec2(0.19984126, 0.78641367),
+    vec2(0.14383161, -0.14100790)
+);
+
+// Blocker search for PCSS (8 rotated taps, radius in shadow map texels)
+float findBlockerDepth(vec2 uv, float zReceiver, float searchRadius, mat2 rotation)
 {
-    vec2 poissonDisk[16] = vec2[](
-        vec2(-0.94201624, -0.39906216),
-        vec2(0.94558609, -0.76890725),
-        vec2(-0.094184101, -0.92938870),
-        vec2(0.34495938, 0.29387760),
-        vec2(-0.91588581, 0.45771432),
-        vec2(-0.81544232, -0.87912464),
-        vec2(-0.38277543, 0.27676845),
-        vec2(0.97484398, 0.75648379),
-        vec2(0.44323325, -0.97511554),
-        vec2(0.53742981, -0.47373420),
-        vec2(-0.26496911, -0.41893023),
-        vec2(0.79197514, 0.19090188),
-        vec2(-0.24188840, 0.99706507),
-        vec2(-0.81409955, 0.91437590),
-        vec2(0.19984126, 0.78641367),
-        vec2(0.14383161, -0.14100790)
-    );
-    
     vec2 texelSize = 1.0 / textureSize(shadowMap, 0);
     float blockerDepthSum = 0.0;
     int blockerCount = 0;
     
-    for(int i = 0; i < 16; ++i)
+    for(int i = 0; i < 8; ++i)
     {
-        vec2 offset = poissonDisk[i] * texelSize * searchRadius;
+        vec2 offset = rotation * poissonDisk[i] * texelSize * searchRadius;
         float shadowDepth = texture(shadowMap, uv + offset).r;
         
         if(shadowDepth < zReceiver)
@@ -138,66 +175,49 @@ float calculatePenumbraSize(float zReceiver, float zBlocker, float lightSize)
     return (zReceiver - zBlocker) * lightSize / zBlocker;
 }
 
-// PCSS Shadow calculation
-float PCSSShadowCalculation(vec4 fragPosLightSpace)
+// Adaptive PCSS shadow calculation, 1.0 = fully lit
+float PCSSShadowCalculation(vec4 fragPosLightSpace, vec2 pixel)
 {
     vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
     projCoords = projCoords * 0.5 + 0.5;
  
     if(projCoords.x < 0.0 || projCoords.x > 1.0 || projCoords.y < 0.0 || projCoords.y > 1.0 || projCoords.z > 1.0)
-        return 0.0;
+        return 1.0;
     
     float currentDepth = projCoords.z;
+    float searchRadius = 10.0;  
+    float lightSize = 5.0;
+    float bias = 0.005;
+    vec2 texelSize = 1.0 / textureSize(shadowMap, 0);
+    
+    // Classify the search region (padded for bilinear taps) from the min/max pyramid
+    vec2 depthRange = shadowDepthRange(projCoords.xy, (searchRadius + 1.0) * max(texelSize.x, texelSize.y));
+    if(currentDepth <= depthRange.x)
+        return 1.0;  // No texel can block
+    if(currentDepth - bias > depthRange.y && calculatePenumbraSize(currentDepth, depthRange.x, lightSize) <= searchRadius)
+        return 0.0;  // Every texel blocks and even the widest filter stays inside the region
+    
+    mat2 rotation = poissonRotation(pixel);
     
     // Blocker search
-    float searchRadius = 10.0;  
-    float blockerDepth = findBlockerDepth(projCoords.xy, currentDepth, searchRadius);
+    float blockerDepth = findBlockerDepth(projCoords.xy, currentDepth, searchRadius, rotation);
     
     if(blockerDepth < 0.0)
-        return 0.0;  
+        return 1.0;  
     
     // Penumbra size calculation
-    float penumbraSize = calculatePenumbraSize(currentDepth, blockerDepth, 5.0);
-    float bias = 0.005;
-    float shadow = 0.0;
-    vec2 texelSize = 1.0 / textureSize(shadowMap, 0);
+    float penumbraSize = calculatePenumbraSize(currentDepth, blockerDepth, lightSize);
     
-    // 25 samples for higher quality
-    vec2 poissonDisk[25] = vec2[](
-        vec2(-0.94201624, -0.39906216),
-        vec2(0.94558609, -0.76890725),
-        vec2(-0.094184101, -0.92938870),
-        vec2(0.34495938, 0.29387760),
-        vec2(-0.91588581, 0.45771432),
-        vec2(-0.81544232, -0.87912464),
-        vec2(-0.38277543, 0.27676845),
-        vec2(0.97484398, 0.75648379),
-        vec2(0.44323325, -0.97511554),
-        vec2(0.53742981, -0.47373420),
-        vec2(-0.26496911, -0.41893023),
-        vec2(0.79197514, 0.19090188),
-        vec2(-0.24188840, 0.99706507),
-        vec2(-0.81409955, 0.91437590),
-        vec2(0.19984126, 0.78641367),
-        vec2(0.14383161, -0.14100790),
-        vec2(-0.65465631, 0.77613958),
-        vec2(0.87912464, 0.81544232),
-        vec2(-0.47373420, -0.53742981),
-        vec2(0.41893023, 0.26496911),
-        vec2(-0.19090188, -0.79197514),
-        vec2(0.99706507, 0.24188840),
-        vec2(-0.91437590, -0.81409955),
-        vec2(0.78641367, -0.19984126),
-        vec2(0.14100790, 0.14383161)
-    );
-    
-    for(int i = 0; i < 25; ++i)
+    // Rotated taps: 8 for penumbrae up to two texels, 16 otherwise (was a fixed 25)
+    int sampleCount = penumbraSize < 2.0 ? 8 : 16;
+    float shadow = 0.0;
+    for(int i = 0; i < sampleCount; ++i)
     {
-        vec2 offset = poissonDisk[i] * texelSize * penumbraSize;
+        vec2 offset = rotation * poissonDisk[i] * texelSize * penumbraSize;
         float pcfDepth = texture(shadowMap, projCoords.xy + offset).r; 
         shadow += currentDepth - bias > pcfDepth ? 0.0 : 1.0;
     }
-    shadow /= 25.0;
+    shadow /= float(sampleCount);
     
     return shadow;
 }
@@ -205,7 +225,7 @@ float PCSSShadowCalculation(vec4 fragPosLightSpace)
 // Legacy shadow calculation (kept for compatibility)
 float ShadowCalculation(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir)
 {
-    return PCSSShadowCalculation(fragPosLightSpace);
+    return PCSSShadowCalculation(fragPosLightSpace, gl_FragCoord.xy);
 }
 
 // Light attenuation calculation
@@ -225,28 +245,30 @@ float calculateAttenuation(int lightType, vec3 lightPos, vec3 fragPos, float lig
     return max(0.0, 1.0 - distance / lightRange);
 }
 
+#include "gbuffer_common.glsl"
+
 void main()
 {
     
     // Sample G-Buffer
-    vec4 gPos = texture(gPosition, TexCoords);
+    float depth = texture(gDepth, TexCoords).r;
     vec4 gAlbedoMetal = texture(gAlbedoMetallic, TexCoords);
     vec4 gNormRough = texture(gNormalRoughness, TexCoords);
     vec4 gMotionAOData = texture(gMotionAO, TexCoords);
     vec4 gEmissiveData = texture(gEmissive, TexCoords);
 
     // Extract data from G-Buffer 
-    vec3 WorldPos = gPos.xyz;          // Position from RT0
-    vec3 albedo = gAlbedoMetal.rgb;    // Albedo from RT1.rgb
-    float metallic = gAlbedoMetal.a;   // Metallic from RT1.a
+    vec3 WorldPos = reconstructPosition(TexCoords, depth, invViewProjection);  // Position from depth
+    vec3 albedo = gAlbedoMetal.rgb;    // Albedo from RT0.rgb
+    float metallic = gAlbedoMetal.a;   // Metallic from RT0.a
     
-    // Decode normal from [0,1] to [-1,1]
-    vec3 normal = gNormRough.xyz * 2.0 - 1.0;  // Normal from RT2.rgb
-    float roughness = gNormRough.a;    // Roughness from RT2.a
+    // Decode octahedral normal
+    vec3 normal = decodeOctahedral(gNormRough.rg);  // Normal from RT1.rg
+    float roughness = gNormRough.b;    // Roughness from RT1.b
     
-    float ao = gMotionAOData.z;        // AO from RT3.z
-    vec3 emissiveColor = gEmissiveData.rgb;  // Emissive color from RT4.rgb
-    float emissiveIntensity = gEmissiveData.a;  // Emissive intensity from RT4.a
+    float ao = gMotionAOData.z;        // AO from RT2.z
+    vec3 emissiveColor = gEmissiveData.rgb;  // Emissive color from RT3.rgb
+    float emissiveIntensity = gEmissiveData.a;  // Emissive intensity from RT3.a
     
 
     
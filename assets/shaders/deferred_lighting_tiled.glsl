@@ -0,0 +1,422 @@
+#version 460 core
+// Tiled deferred direct lighting.
+// Each 16x16 workgroup shades one screen tile: it reduces the tile depth range in shared memory,
+// culls the scene lights against the tile bounds and classifies the tile as sky, unshadowed or
+// shadowed so only shadowed tiles run the PCSS path. Output matches deferred_lighting_direct_fragment.
+layout(local_size_x = 16, local_size_y = 16, local_size_z = 1) in;
+
+// G-Buffer textures
+uniform sampler2D gAlbedoMetallic; // Albedo (rgb) + Metallic (a)
+uniform sampler2D gNormalRoughness; // Octahedral Normal (rg) + Roughness (b)
+uniform sampler2D gEmissive;      // Emissive Color (rgb) + intensity (a)
+uniform sampler2D gDepth;         // Depth buffer
+
+// Output: direct lighting at render resolution
+layout(rgba16f, binding = 0) uniform writeonly image2D litSceneImage;
+
+// Shadow map
+uniform sampler2D shadowMap;
+uniform sampler2D shadowMinMax;    // Min/max depth pyramid of the shadow map
+uniform int shadowMinMaxLevels;
+uniform bool enableShadows;
+uniform mat4 lightSpaceMatrix;
+
+// Camera
+uniform vec3 viewPos;
+uniform mat4 view;
+uniform mat4 invProjection;
+uniform mat4 invViewProjection;
+
+// Lighting
+uniform int numLights;
+
+// Light arrays (max 8 lights)
+uniform vec3 lightPositions[8];
+uniform vec3 lightColors[8];
+uniform vec3 lightDirections[8];
+uniform int lightTypes[8];  // 0=directional, 1=point, 2=spot
+uniform float lightIntensities[8];
+uniform float lightRanges[8];
+uniform float lightInnerCones[8];
+uniform float lightOuterCones[8];
+
+// Tile state
+shared uint tileMinDepth;
+shared uint tileMaxDepth;
+shared uint tileShadowed;
+shared uint tileLightCount;
+shared uint tileLightIndices[8];
+shared vec3 tileBoundsMin;
+shared vec3 tileBoundsMax;
+
+// PBR constants
+const float PI = 3.14159265359;
+
+// PBR functions
+float DistributionGGX(vec3 N, vec3 H, float roughness)
+{
+    float a = roughness * roughness;
+    float a2 = a * a;
+    float NdotH = max(dot(N, H), 0.0);
+    float NdotH2 = NdotH * NdotH;
+
+    float num = a2;
+    float denom = (NdotH2 * (a2 - 1.0) + 1.0);
+    denom = PI * denom * denom;
+
+    return num / denom;
+}
+
+float GeometrySchlickGGX(float NdotV, float roughness)
+{
+    float r = (roughness + 1.0);
+    float k = (r * r) / 8.0;
+
+    float num = NdotV;
+    float denom = NdotV * (1.0 - k) + k;
+
+    return num / denom;
+}
+
+float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness)
+{
+    float NdotV = max(dot(N, V), 0.0);
+    float NdotL = max(dot(N, L), 0.0);
+    float ggx2 = GeometrySchlickGGX(NdotV, roughness);
+    float ggx1 = GeometrySchlickGGX(NdotL, roughness);
+
+    return ggx1 * ggx2;
+}
+
+vec3 fresnelSchlick(float cosTheta, vec3 F0)
+{
+    return F0 + (1.0 - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
+}
+
+// Per-pixel rotation of the Poisson disks; turns undersampling banding into fine noise
+mat2 poissonRotation(vec2 pixel)
+{
+    float noise = fract(52.9829189 * fract(dot(pixel, vec2(0.06711056, 0.00583715))));
+    float angle = 6.28318530718 * noise;
+    float s = sin(angle);
+    float c = cos(angle);
+    return mat2(c, s, -s, c);
+}
+
+// Min (x) and max (y) shadow depth over a square region, from at most four pyramid texels
+vec2 shadowDepthRange(vec2 uv, float radius)
+{
+    vec2 baseSize = vec2(textureSize(shadowMinMax, 0));
+    float footprint = 2.0 * radius * max(baseSize.x, baseSize.y);
+    int level = clamp(int(ceil(log2(max(footprint, 1.0)))), 0, shadowMinMaxLevels - 1);
+
+    ivec2 levelSize = textureSize(shadowMinMax, level);
+    ivec2 texelMin = clamp(ivec2((uv - radius) * vec2(levelSize)), ivec2(0), levelSize - 1);
+    ivec2 texelMax = clamp(ivec2((uv + radius) * vec2(levelSize)), ivec2(0), levelSize - 1);
+
+    vec2 range00 = texelFetch(shadowMinMax, texelMin, level).rg;
+    vec2 range10 = texelFetch(shadowMinMax, ivec2(texelMax.x, texelMin.y), level).rg;
+    vec2 range01 = texelFetch(shadowMinMax, ivec2(texelMin.x, texelMax.y), level).rg;
+    vec2 range11 = texelFetch(shadowMinMax, texelMax, level).rg;
+    vec2 range = vec2(min(min(range00.x, range10.x), min(range01.x, range11.x)),
+                      max(max(range00.y, range10.y), max(range01.y, range11.y)));
+
+    // Taps outside the map read the border depth (1.0)
+    if (any(lessThan(uv - radius, vec2(0.0))) || any(greaterThan(uv + radius, vec2(1.0)))) {
+        range.y = 1.0;
+    }
+    return range;
+}
+
+const vec2 poissonDisk[16] = vec2[](
+    vec2(-0.94201624, -0.39906216),
+    vec2(0.94558609, -0.76890725),
+    vec2(-0.094184101, -0.92938870),
+    vec2(0.34495938, 0.29387760),
+    vec2(-0.91588581, 0.45771432),
+    vec2(-0.81544232, -0.87912464),
+    vec2(-0.38277543, 0.27676845),
+    vec2(0.97484398, 0.75648379),
+    vec2(0.44323325, -0.97511554),
+    vec2(0.53742981, -0.47373420),
+    vec2(-0.26496911, -0.41893023),
+    vec2(0.79197514, 0.19090188),
+    vec2(-0.24188840, 0.99706507),
+    vec2(-0.81409955, 0.91437590),
+    vec2(0.19984126, 0.78641367),
+    vec2(0.14383161, -0.14100790)
+);
+
+// Blocker search for PCSS (8 rotated taps)
+float findBlockerDepth(vec2 uv, float zReceiver, float searchRadius, mat2 rotation)
+{
+    float blockerDepthSum = 0.0;
+    int numBlockers = 0;
+    
+    for (int i = 0; i < 8; i++) {
+        vec2 sampleUV = uv + rotation * poissonDisk[i] * searchRadius;
+        float sampleDepth = texture(shadowMap, sampleUV).r;
+        
+        if (sampleDepth < zReceiver) {
+            blockerDepthSum += sampleDepth;
+            numBlockers++;
+        }
+    }
+    
+    if (numBlockers == 0) {
+        return -1.0; // No blockers found
+    }
+    
+    return blockerDepthSum / float(numBlockers);
+}
+
+// PCSS penumbra estimation
+float penumbraSize(float zReceiver, float zBlocker)
+{
+    return (zReceiver - zBlocker) / zBlocker;
+}
+
+// PCF with variable kernel size and tap count
+float PCF(vec2 uv, float zReceiver, float filterRadius, mat2 rotation, int sampleCount)
+{
+    float shadow = 0.0;
+    for (int i = 0; i < sampleCount; i++) {
+        vec2 sampleUV = uv + rotation * poissonDisk[i] * filterRadius;
+        float sampleDepth = texture(shadowMap, sampleUV).r;
+        shadow += (sampleDepth >= zReceiver) ? 1.0 : 0.0;
+    }
+    return shadow / float(sampleCount);
+}
+
+// Adaptive PCSS shadow calculation
+float ShadowCalculation(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir, vec2 pixel)
+{
+    vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
+    projCoords = projCoords * 0.5 + 0.5;
+    
+    if (projCoords.z > 1.0 || projCoords.x < 0.0 || projCoords.x > 1.0 || 
+        projCoords.y < 0.0 || projCoords.y > 1.0) {
+        return 1.0; // Outside shadow map bounds
+    }
+    
+    float currentDepth = projCoords.z;
+    float bias = max(0.05 * (1.0 - dot(normal, lightDir)), 0.005);
+    float zReceiver = currentDepth - bias;
+    float searchRadius = 0.05; // Light size parameter
+    vec2 texelSize = 1.0 / vec2(textureSize(shadowMap, 0));
+    
+    // Step 0: Classify the search region (padded for bilinear taps) from the min/max pyramid
+    vec2 depthRange = shadowDepthRange(projCoords.xy, searchRadius + max(texelSize.x, texelSize.y));
+    if (zReceiver <= depthRange.x) {
+        return 1.0; // No texel can block, fully lit
+    }
+    if (zReceiver > depthRange.y) {
+        // Every texel blocks; fully shadowed if even the nearest blocker keeps the filter inside the region
+        if (penumbraSize(zReceiver, depthRange.x) <= 1.0) {
+            return 0.0;
+        }
+    }
+    
+    mat2 rotation = poissonRotation(pixel);
+    
+    // Step 1: Blocker search
+    float avgBlockerDepth = findBlockerDepth(projCoords.xy, zReceiver, searchRadius, rotation);
+    
+    if (avgBlockerDepth == -1.0) {
+        return 1.0; // No blockers, fully lit
+    }
+    
+    // Step 2: Penumbra size estimation
+    float penumbraRatio = penumbraSize(zReceiver, avgBlockerDepth);
+    float filterRadius = penumbraRatio * searchRadius;
+    
+    // Step 3: PCF with estimated filter size, fewer taps for narrow penumbrae
+    int sampleCount = filterRadius < 2.0 * texelSize.x ? 8 : 16;
+    return PCF(projCoords.xy, zReceiver, filterRadius, rotation, sampleCount);
+}
+
+#include "gbuffer_common.glsl"
+
+// View-space box around the tile between its nearest and farthest depth
+void computeTileBounds(float minDepth, float maxDepth, ivec2 screenSize)
+{
+    vec2 uvMin = vec2(gl_WorkGroupID.xy * gl_WorkGroupSize.xy) / vec2(screenSize);
+    vec2 uvMax = vec2((gl_WorkGroupID.xy + 1u) * gl_WorkGroupSize.xy) / vec2(screenSize);
+
+    vec3 boundsMin = vec3(1e30);
+    vec3 boundsMax = vec3(-1e30);
+    for (int i = 0; i < 8; ++i) {
+        vec2 uv = vec2((i & 1) != 0 ? uvMax.x : uvMin.x, (i & 2) != 0 ? uvMax.y : uvMin.y);
+        vec3 corner = reconstructPosition(uv, (i & 4) != 0 ? maxDepth : minDepth, invProjection);
+        boundsMin = min(boundsMin, corner);
+        boundsMax = max(boundsMax, corner);
+    }
+    tileBoundsMin = boundsMin;
+    tileBoundsMax = boundsMax;
+}
+
+bool lightAffectsTile(int index)
+{
+    if (lightTypes[index] == 0) {
+        return true; // Directional lights reach every tile
+    }
+
+    // Point and spot lights are cut off at their range
+    vec3 center = (view * vec4(lightPositions[index], 1.0)).xyz;
+    vec3 closest = clamp(center, tileBoundsMin, tileBoundsMax);
+    vec3 delta = center - closest;
+    return dot(delta, delta) <= lightRanges[index] * lightRanges[index];
+}
+
+void main()
+{
+    ivec2 screenSize = imageSize(litSceneImage);
+    ivec2 pixel = ivec2(gl_GlobalInvocationID.xy);
+    bool insideScreen = all(lessThan(pixel, screenSize));
+
+    if (gl_LocalInvocationIndex == 0) {
+        tileMinDepth = floatBitsToUint(1.0);
+        tileMaxDepth = 0u;
+        tileShadowed = 0u;
+        tileLightCount = 0u;
+    }
+    barrier();
+
+    // Sample G-Buffer
+    vec2 uv = (vec2(pixel) + 0.5) / vec2(screenSize);
+    float depth = insideScreen ? texelFetch(gDepth, pixel, 0).r : 1.0;
+    bool isGeometry = depth < 1.0;
+
+    vec3 WorldPos = vec3(0.0);
+    vec3 N = vec3(0.0, 0.0, 1.0);
+    bool needsShadow = false;
+
+    if (isGeometry) {
+        // Depth is non-negative, so its bit pattern orders like the float
+        atomicMin(tileMinDepth, floatBitsToUint(depth));
+        atomicMax(tileMaxDepth, floatBitsToUint(depth));
+
+        WorldPos = reconstructPosition(uv, depth, invViewProjection);
+        N = decodeOctahedral(texelFetch(gNormalRoughness, pixel, 0).rg);
+
+        // Only the first light casts shadows, and only if it is directional
+        if (enableShadows && numLights > 0 && lightTypes[0] == 0 && dot(N, -lightDirections[0]) > 0.0) {
+            vec4 fragPosLightSpace = lightSpaceMatrix * vec4(WorldPos, 1.0);
+            vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w * 0.5 + 0.5;
+            needsShadow = projCoords.z <= 1.0 && all(greaterThanEqual(projCoords.xy, vec2(0.0))) &&
+                          all(lessThanEqual(projCoords.xy, vec2(1.0)));
+        }
+        if (needsShadow) {
+            atomicOr(tileShadowed, 1u);
+        }
+    }
+    barrier();
+
+    // Sky tile: nothing to light
+    if (tileMaxDepth == 0u) {
+        if (insideScreen) {
+            imageStore(litSceneImage, pixel, vec4(0.0, 0.0, 0.0, 1.0));
+        }
+        return;
+    }
+
+    // Cull lights against the tile, one light per thread
+    if (gl_LocalInvocationIndex == 0) {
+        computeTileBounds(uintBitsToFloat(tileMinDepth), uintBitsToFloat(tileMaxDepth), screenSize);
+    }
+    barrier();
+
+    if (gl_LocalInvocationIndex < uint(min(numLights, 8)) && lightAffectsTile(int(gl_LocalInvocationIndex))) {
+        uint slot = atomicAdd(tileLightCount, 1u);
+        tileLightIndices[slot] = gl_LocalInvocationIndex;
+    }
+    barrier();
+
+    if (!insideScreen) {
+        return;
+    }
+    if (!isGeometry) {
+        imageStore(litSceneImage, pixel, vec4(0.0, 0.0, 0.0, 1.0));
+        return;
+    }
+
+    // Extract data
+    vec4 albedoMetallic = texelFetch(gAlbedoMetallic, pixel, 0);
+    vec4 normalRoughness = texelFetch(gNormalRoughness, pixel, 0);
+    vec4 emissiveData = texelFetch(gEmissive, pixel, 0);
+    vec3 albedo = albedoMetallic.rgb;
+    float metallic = albedoMetallic.a;
+    float roughness = normalRoughness.b;
+    vec3 emissiveColor = emissiveData.rgb * emissiveData.a;
+
+    vec3 V = normalize(viewPos - WorldPos);
+
+    // Calculate reflectance at normal incidence
+    vec3 F0 = vec3(0.04);
+    F0 = mix(F0, albedo, metallic);
+
+    // Shadowed tiles take the PCSS path; the branch is uniform across the workgroup
+    bool shadowedTile = tileShadowed != 0u;
+
+    vec3 Lo = vec3(0.0);
+    for (uint t = 0u; t < tileLightCount; ++t) {
+        int i = int(tileLightIndices[t]);
+        vec3 L;
+        float attenuation = 1.0;
+
+        if (lightTypes[i] == 0) { // Directional light
+            L = normalize(-lightDirections[i]);
+        } else if (lightTypes[i] == 1) { // Point light
+            L = normalize(lightPositions[i] - WorldPos);
+            float distance = length(lightPositions[i] - WorldPos);
+            attenuation = 1.0 / (1.0 + 0.09 * distance + 0.032 * distance * distance);
+            if (distance > lightRanges[i]) {
+                attenuation = 0.0;
+            }
+        } else { // Spot light
+            L = normalize(lightPositions[i] - WorldPos);
+            float distance = length(lightPositions[i] - WorldPos);
+            attenuation = 1.0 / (1.0 + 0.09 * distance + 0.032 * distance * distance);
+
+            float theta = dot(L, normalize(-lightDirections[i]));
+            float epsilon = lightInnerCones[i] - lightOuterCones[i];
+            float intensity = clamp((theta - lightOuterCones[i]) / epsilon, 0.0, 1.0);
+            attenuation *= intensity;
+
+            if (distance > lightRanges[i]) {
+                attenuation = 0.0;
+            }
+        }
+
+        float NdotL = max(dot(N, L), 0.0);
+        if (attenuation <= 0.0 || NdotL <= 0.0) {
+            continue;
+        }
+
+        vec3 H = normalize(V + L);
+        vec3 radiance = lightColors[i] * lightIntensities[i] * attenuation;
+
+        // PBR BRDF
+        float NDF = DistributionGGX(N, H, roughness);
+        float G = GeometrySmith(N, V, L, roughness);
+        vec3 F = fresnelSchlick(max(dot(H, V), 0.0), F0);
+
+        vec3 kS = F;
+        vec3 kD = vec3(1.0) - kS;
+        kD *= 1.0 - metallic;
+
+        vec3 numerator = NDF * G * F;
+        float denominator = 4.0 * max(dot(N, V), 0.0) * NdotL + 0.0001;
+        vec3 specular = numerator / denominator;
+
+        float shadow = 1.0;
+        if (shadowedTile && i == 0 && needsShadow) {
+            vec4 fragPosLightSpace = lightSpaceMatrix * vec4(WorldPos, 1.0);
+            shadow = ShadowCalculation(fragPosLightSpace, N, L, vec2(pixel));
+        }
+
+        Lo += (kD * albedo / PI + specular) * radiance * NdotL * shadow;
+    }
+
+    imageStore(litSceneImage, pixel, vec4(Lo + emissiveColor, 1.0));
+}
@@ -0,0 +1,55 @@
+// G-buffer helpers shared by the geometry, lighting, SSAO and SSGI shaders.
+// Pulled in with #include "gbuffer_common.glsl" after #version; the shader loader expands it.
+
+// Octahedral normal encoding, result in [0,1]
+vec2 encodeOctahedral(vec3 n)
+{
+    n /= (abs(n.x) + abs(n.y) + abs(n.z));
+    vec2 e = n.xy;
+    if (n.z < 0.0) {
+        e = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return e * 0.5 + 0.5;
+}
+
+// Decode octahedral-encoded normal from [0,1]
+vec3 decodeOctahedral(vec2 e)
+{
+    e = e * 2.0 - 1.0;
+    vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+    float t = clamp(-n.z, 0.0, 1.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+// Position of a depth buffer value: view space with the inverse projection,
+// world space with the inverse view-projection
+vec3 reconstructPosition(vec2 uv, float depth, mat4 inverseMatrix)
+{
+    vec4 clipPos = vec4(uv * 2.0 - 1.0, depth * 2.0 - 1.0, 1.0);
+    vec4 position = inverseMatrix * clipPos;
+    return position.xyz / position.w;
+}
+
+// View-space distance of a depth buffer value
+float linearViewDepth(vec2 uv, float depth, mat4 invProjection)
+{
+    return -reconstructPosition(uv, depth, invProjection).z;
+}
+
+// Full resolution pixel traced by a low resolution texel of the SSAO/SSGI passes. Neighbouring
+// texels take different pixels of their scale x scale block (Bayer order), so a 2x2 (half) or
+// 4x4 (quarter) neighbourhood covers every sub-pixel position between them.
+ivec2 interleavedPixel(ivec2 texel, int scale, ivec2 fullSize)
+{
+    if (scale <= 1) {
+        return texel;
+    }
+    const int bayer2[4] = int[](0, 3, 2, 1);
+    const int bayer4[16] = int[](0, 8, 2, 10, 12, 4, 14, 6, 3, 11, 1, 9, 15, 7, 13, 5);
+    int cell = scale == 2 ? bayer2[(texel.y & 1) * 2 + (texel.x & 1)]
+                          : bayer4[(texel.y & 3) * 4 + (texel.x & 3)];
+    ivec2 pixel = texel * scale + ivec2(cell % scale, cell / scale);
+    return min(pixel, fullSize - 1);
+}
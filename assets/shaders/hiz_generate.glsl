@@ -1,52 +1,164 @@
 #version 460 core
-layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+// Single-pass Hi-Z downsampler (SPD style)
+// Each 16x16 workgroup reduces a 64x64 tile of the first output level down to 1x1 through
+// shared memory (7 levels). The last workgroup to finish, detected with an atomic counter,
+// reduces the per-tile results into one more level. At most 8 levels are written per dispatch
+// so the pass stays within the minimum GL image unit count.
+layout(local_size_x = 16, local_size_y = 16, local_size_z = 1) in;
 
-// Input: previous mip level (or original depth texture for mip 0)
+// Input: G-Buffer depth (inputMipLevel < 0) or a previously written Hi-Z level
 uniform sampler2D inputDepthTexture;
+uniform int inputMipLevel;
 
-// Output: current mip level being generated
-layout(r32f, binding = 0) uniform writeonly image2D outputDepthMip;
+// Number of levels written by this dispatch (1..8), starting at outputMip0
+uniform int mipCount;
 
-// Mip level being generated (0 = copy from original, 1+ = downsample)
-uniform int currentMipLevel;
+// Output: consecutive mip levels of the Hi-Z texture
+layout(r32f, binding = 0) uniform coherent image2D outputMip0;
+layout(r32f, binding = 1) uniform writeonly image2D outputMip1;
+layout(r32f, binding = 2) uniform writeonly image2D outputMip2;
+layout(r32f, binding = 3) uniform writeonly image2D outputMip3;
+layout(r32f, binding = 4) uniform writeonly image2D outputMip4;
+layout(r32f, binding = 5) uniform writeonly image2D outputMip5;
+layout(r32f, binding = 6) uniform coherent image2D outputMip6;
+layout(r32f, binding = 7) uniform writeonly image2D outputMip7;
 
-// Input mip level to sample from (for mip > 0)
-uniform int inputMipLevel;
+// Number of finished workgroups, reset by the last one
+layout(std430, binding = 0) buffer HiZCounter {
+    uint finishedGroups;
+};
 
-void main() {
-    ivec2 outputCoord = ivec2(gl_GlobalInvocationID.xy);
-    ivec2 outputSize = imageSize(outputDepthMip);
-    
-    // Check bounds
-    if (outputCoord.x >= outputSize.x || outputCoord.y >= outputSize.y) {
+shared float tileDepth[16][16];
+shared bool isLastGroup;
+
+ivec2 mipSize(int level) {
+    ivec2 baseSize = imageSize(outputMip0);
+    return max(baseSize >> level, ivec2(1));
+}
+
+void storeMip(int level, ivec2 coord, float depth) {
+    if (level >= mipCount || any(greaterThanEqual(coord, mipSize(level)))) {
         return;
     }
-    
-    if (currentMipLevel == 0) {
-        // Mip level 0: Direct copy from original depth texture
-        vec2 uv = (vec2(outputCoord) + 0.5) / vec2(outputSize);
-        float depth = texture(inputDepthTexture, uv).r;
-        
-        // Debug: Ensure we're getting valid depth values
+    vec4 value = vec4(depth);
+    switch (level) {
+        case 0: imageStore(outputMip0, coord, value); break;
+        case 1: imageStore(outputMip1, coord, value); break;
+        case 2: imageStore(outputMip2, coord, value); break;
+        case 3: imageStore(outputMip3, coord, value); break;
+        case 4: imageStore(outputMip4, coord, value); break;
+        case 5: imageStore(outputMip5, coord, value); break;
+        case 6: imageStore(outputMip6, coord, value); break;
+        case 7: imageStore(outputMip7, coord, value); break;
+    }
+}
+
+// First output level: copy of depth, or 2x2 max of the input Hi-Z level
+float loadFirstLevel(ivec2 coord) {
+    coord = min(coord, mipSize(0) - 1);
+
+    if (inputMipLevel < 0) {
+        float depth = texelFetch(inputDepthTexture, coord, 0).r;
         // Depth should be in [0,1] range, with 1.0 being far plane
         if (depth <= 0.0 || depth > 1.0) {
             depth = 1.0; // Default to far plane if invalid
         }
-        
-        imageStore(outputDepthMip, outputCoord, vec4(depth));
-    } else {
-        // Mip level 1+: Downsample by taking maximum depth from 2x2 block        
-        ivec2 inputCoord = outputCoord * 2;  // Map to input coordinates
-        
-        // Sample 2x2 block from previous mip level
-        float depth00 = texelFetch(inputDepthTexture, inputCoord, inputMipLevel).r;
-        float depth10 = texelFetch(inputDepthTexture, inputCoord + ivec2(1, 0), inputMipLevel).r;
-        float depth01 = texelFetch(inputDepthTexture, inputCoord + ivec2(0, 1), inputMipLevel).r;
-        float depth11 = texelFetch(inputDepthTexture, inputCoord + ivec2(1, 1), inputMipLevel).r;
-        
-        // Take maximum depth (farthest point) for conservative occlusion testing
-        float maxDepth = max(max(depth00, depth10), max(depth01, depth11));
-        
-        imageStore(outputDepthMip, outputCoord, vec4(maxDepth));
+        return depth;
+    }
+
+    ivec2 inputSize = textureSize(inputDepthTexture, inputMipLevel);
+    ivec2 inputCoord = coord * 2;
+    float depth00 = texelFetch(inputDepthTexture, min(inputCoord, inputSize - 1), inputMipLevel).r;
+    float depth10 = texelFetch(inputDepthTexture, min(inputCoord + ivec2(1, 0), inputSize - 1), inputMipLevel).r;
+    float depth01 = texelFetch(inputDepthTexture, min(inputCoord + ivec2(0, 1), inputSize - 1), inputMipLevel).r;
+    float depth11 = texelFetch(inputDepthTexture, min(inputCoord + ivec2(1, 1), inputSize - 1), inputMipLevel).r;
+    return max(max(depth00, depth10), max(depth01, depth11));
+}
+
+float loadMip6(ivec2 coord) {
+    return imageLoad(outputMip6, min(coord, mipSize(6) - 1)).r;
+}
+
+void main() {
+    ivec2 localId = ivec2(gl_LocalInvocationID.xy);
+    ivec2 groupId = ivec2(gl_WorkGroupID.xy);
+
+    // Levels 0-2: each thread owns a 4x4 block of level 0
+    ivec2 blockOrigin = groupId * 64 + localId * 4;
+    float level1[4];
+    for (int y = 0; y < 2; ++y) {
+        for (int x = 0; x < 2; ++x) {
+            ivec2 quadOrigin = blockOrigin + ivec2(x, y) * 2;
+            float depth00 = loadFirstLevel(quadOrigin);
+            float depth10 = loadFirstLevel(quadOrigin + ivec2(1, 0));
+            float depth01 = loadFirstLevel(quadOrigin + ivec2(0, 1));
+            float depth11 = loadFirstLevel(quadOrigin + ivec2(1, 1));
+
+            storeMip(0, quadOrigin, depth00);
+            storeMip(0, quadOrigin + ivec2(1, 0), depth10);
+            storeMip(0, quadOrigin + ivec2(0, 1), depth01);
+            storeMip(0, quadOrigin + ivec2(1, 1), depth11);
+
+            // Take maximum depth (farthest point) for conservative occlusion testing
+            float maxDepth = max(max(depth00, depth10), max(depth01, depth11));
+            level1[y * 2 + x] = maxDepth;
+            storeMip(1, groupId * 32 + localId * 2 + ivec2(x, y), maxDepth);
+        }
+    }
+
+    float level2 = max(max(level1[0], level1[1]), max(level1[2], level1[3]));
+    storeMip(2, groupId * 16 + localId, level2);
+    tileDepth[localId.y][localId.x] = level2;
+
+    // Levels 3-6: reduce the 16x16 tile in shared memory
+    for (int level = 3; level <= 6; ++level) {
+        int activeSize = 16 >> (level - 2);
+        bool reducing = all(lessThan(localId, ivec2(activeSize)));
+
+        barrier();
+        float maxDepth = 0.0;
+        if (reducing) {
+            ivec2 src = localId * 2;
+            maxDepth = max(max(tileDepth[src.y][src.x], tileDepth[src.y][src.x + 1]),
+                           max(tileDepth[src.y + 1][src.x], tileDepth[src.y + 1][src.x + 1]));
+        }
+        barrier();
+
+        if (reducing) {
+            tileDepth[localId.y][localId.x] = maxDepth;
+            storeMip(level, groupId * activeSize + localId, maxDepth);
+        }
+    }
+
+    if (mipCount <= 7) {
+        return;
+    }
+
+    // Level 7: the last workgroup to finish reduces every tile's level 6 result
+    memoryBarrierImage();
+    barrier();
+
+    if (gl_LocalInvocationIndex == 0) {
+        uint totalGroups = gl_NumWorkGroups.x * gl_NumWorkGroups.y;
+        isLastGroup = (atomicAdd(finishedGroups, 1u) == totalGroups - 1u);
+    }
+    barrier();
+
+    if (!isLastGroup) {
+        return;
+    }
+
+    ivec2 level7Size = mipSize(7);
+    for (int index = int(gl_LocalInvocationIndex); index < level7Size.x * level7Size.y; index += 256) {
+        ivec2 coord = ivec2(index % level7Size.x, index / level7Size.x);
+        ivec2 src = coord * 2;
+        float maxDepth = max(max(loadMip6(src), loadMip6(src + ivec2(1, 0))),
+                             max(loadMip6(src + ivec2(0, 1)), loadMip6(src + ivec2(1, 1))));
+        storeMip(7, coord, maxDepth);
+    }
+
+    // Leave the counter ready for the next dispatch
+    if (gl_LocalInvocationIndex == 0) {
+        finishedGroups = 0u;
     }
 }
@@ -0,0 +1,114 @@
+#version 460 core
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+// World-space bounds of each draw item
+struct DrawBounds {
+    vec4 boundsMin;
+    vec4 boundsMax;
+};
+
+// Matches DrawElementsIndirectCommand
+struct DrawCommand {
+    uint count;
+    uint instanceCount;
+    uint firstIndex;
+    int baseVertex;
+    uint baseInstance;
+};
+
+layout(std430, binding = 0) readonly buffer DrawBoundsBuffer {
+    DrawBounds bounds[];
+};
+
+layout(std430, binding = 1) buffer DrawCommandBuffer {
+    DrawCommand commands[];
+};
+
+// 1 if the item has already been drawn this frame
+layout(std430, binding = 2) buffer VisibilityBuffer {
+    uint visibility[];
+};
+
+// Hi-Z pyramid (max depth per texel) and the view-projection it was built with
+uniform sampler2D hizTexture;
+uniform vec2 hizSize;
+uniform int hizMipLevels;
+uniform mat4 viewProjection;
+
+// 0 = early phase (previous frame's pyramid), 1 = late phase (re-test rejected items)
+uniform int phase;
+uniform int drawCount;
+
+// Returns false if the bounds are outside the frustum or behind the Hi-Z occluders
+bool isVisible(vec3 boundsMin, vec3 boundsMax) {
+    vec2 uvMin = vec2(1e30);
+    vec2 uvMax = vec2(-1e30);
+    float minDepth = 1e30;
+
+    for (int i = 0; i < 8; ++i) {
+        vec3 corner = vec3((i & 1) != 0 ? boundsMax.x : boundsMin.x,
+                           (i & 2) != 0 ? boundsMax.y : boundsMin.y,
+                           (i & 4) != 0 ? boundsMax.z : boundsMin.z);
+        vec4 clipPos = viewProjection * vec4(corner, 1.0);
+
+        // Bounds cross the near plane: cannot be tested conservatively
+        if (clipPos.w <= 0.0) {
+            return true;
+        }
+
+        vec3 ndc = clipPos.xyz / clipPos.w;
+        vec2 uv = ndc.xy * 0.5 + 0.5;
+        uvMin = min(uvMin, uv);
+        uvMax = max(uvMax, uv);
+        minDepth = min(minDepth, ndc.z * 0.5 + 0.5);
+    }
+
+    // Frustum rejection
+    if (any(greaterThan(uvMin, vec2(1.0))) || any(lessThan(uvMax, vec2(0.0))) || minDepth > 1.0) {
+        return false;
+    }
+
+    uvMin = clamp(uvMin, 0.0, 1.0);
+    uvMax = clamp(uvMax, 0.0, 1.0);
+
+    // Pick the level where the screen rectangle covers at most 2x2 texels
+    vec2 extent = (uvMax - uvMin) * hizSize;
+    int level = int(ceil(log2(max(max(extent.x, extent.y), 1.0))));
+    level = clamp(level, 0, hizMipLevels - 1);
+
+    ivec2 levelSize = textureSize(hizTexture, level);
+    ivec2 texelMin = clamp(ivec2(uvMin * vec2(levelSize)), ivec2(0), levelSize - 1);
+    ivec2 texelMax = clamp(ivec2(uvMax * vec2(levelSize)), ivec2(0), levelSize - 1);
+
+    float depth00 = texelFetch(hizTexture, texelMin, level).r;
+    float depth10 = texelFetch(hizTexture, ivec2(texelMax.x, texelMin.y), level).r;
+    float depth01 = texelFetch(hizTexture, ivec2(texelMin.x, texelMax.y), level).r;
+    float depth11 = texelFetch(hizTexture, texelMax, level).r;
+    float occluderDepth = max(max(depth00, depth10), max(depth01, depth11));
+
+    // Occluded if the nearest point of the bounds is behind the farthest occluder
+    return minDepth <= occluderDepth;
+}
+
+void main() {
+    uint index = gl_GlobalInvocationID.x;
+    if (index >= uint(drawCount)) {
+        return;
+    }
+
+    if (phase == 0) {
+        bool visible = isVisible(bounds[index].boundsMin.xyz, bounds[index].boundsMax.xyz);
+        visibility[index] = visible ? 1u : 0u;
+        commands[index].instanceCount = visible ? 1u : 0u;
+    } else {
+        // Items drawn in the early phase are already in the depth buffer
+        if (visibility[index] != 0u) {
+            commands[index].instanceCount = 0u;
+            return;
+        }
+
+        bool visible = isVisible(bounds[index].boundsMin.xyz, bounds[index].boundsMax.xyz);
+        visibility[index] = visible ? 1u : 0u;
+        commands[index].instanceCount = visible ? 1u : 0u;
+    }
+}
@@ -0,0 +1,37 @@
+#version 460 core
+// Builds one level of the shadow map min/max depth pyramid (R = min depth, G = max depth).
+// Level 0 reduces 2x2 shadow map texels; odd-sized inputs fold the last row/column into the edge texel.
+layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+
+// Input: shadow map depth (inputLevel < 0) or the previous pyramid level
+uniform sampler2D inputTexture;
+uniform int inputLevel;
+
+layout(rg32f, binding = 0) uniform writeonly image2D outputLevel;
+
+void main() {
+    ivec2 coord = ivec2(gl_GlobalInvocationID.xy);
+    ivec2 outputSize = imageSize(outputLevel);
+    if (any(greaterThanEqual(coord, outputSize))) {
+        return;
+    }
+
+    int level = max(inputLevel, 0);
+    ivec2 inputSize = textureSize(inputTexture, level);
+    ivec2 origin = coord * 2;
+
+    // Edge texels also cover the leftover row/column of an odd-sized input
+    ivec2 extent = ivec2(2) + ivec2(equal(coord, outputSize - 1)) * (inputSize - outputSize * 2);
+
+    vec2 range = vec2(1.0, 0.0);
+    for (int y = 0; y < extent.y; ++y) {
+        for (int x = 0; x < extent.x; ++x) {
+            ivec2 texel = min(origin + ivec2(x, y), inputSize - 1);
+            vec2 value = inputLevel < 0 ? vec2(texelFetch(inputTexture, texel, 0).r)
+                                        : texelFetch(inputTexture, texel, level).rg;
+            range = vec2(min(range.x, value.x), max(range.y, value.y));
+        }
+    }
+
+    imageStore(outputLevel, coord, vec4(range, 0.0, 0.0));
+}
@@ -7,19 +7,76 @@ in vec2 TexCoord;
 uniform sampler2D sceneTexture;    // Current framebuffer content
 uniform sampler2D ssaoTexture;     // SSAO texture
 uniform sampler2D gMotionAO;       // G-Buffer AO for material AO
-uniform sampler2D gPosition;       // Position to check for background
+uniform sampler2D gDepth;          // Depth to check for background
+uniform sampler2D gNormalRoughness; // Octahedral normal for upsampling
+
+// Low resolution SSAO upsampling
+uniform mat4 invProjection;
+uniform int ssaoResolutionScale;    // Full resolution pixels per SSAO texel along each axis
+
+#include "gbuffer_common.glsl"
+
+// Depth and normal aware upsample of a low resolution effect texture. The four nearest
+// texels are weighted bilinearly and by how closely the G-Buffer pixel each one was traced
+// from matches this pixel, so results do not bleed across silhouettes.
+vec4 bilateralUpsample(sampler2D lowResTexture, int scale, ivec2 pixel, float viewDepth, vec3 normal) {
+    if (scale <= 1) {
+        return texelFetch(lowResTexture, pixel, 0);
+    }
+
+    ivec2 fullSize = textureSize(gDepth, 0);
+    ivec2 lowSize = textureSize(lowResTexture, 0);
+    vec2 lowCoord = (vec2(pixel) + 0.5) / float(scale) - 0.5;
+    ivec2 baseTexel = ivec2(floor(lowCoord));
+    vec2 f = fract(lowCoord);
+
+    vec4 result = vec4(0.0);
+    float totalWeight = 0.0;
+    vec4 closestSample = vec4(0.0);
+    float closestDepthDiff = 1e30;
+
+    for (int i = 0; i < 4; ++i) {
+        ivec2 offset = ivec2(i & 1, i >> 1);
+        ivec2 texel = clamp(baseTexel + offset, ivec2(0), lowSize - 1);
+        ivec2 samplePixel = interleavedPixel(texel, scale, fullSize);
+
+        vec2 sampleUV = (vec2(samplePixel) + 0.5) / vec2(fullSize);
+        float sampleDepth = linearViewDepth(sampleUV, texelFetch(gDepth, samplePixel, 0).r, invProjection);
+        vec3 sampleNormal = decodeOctahedral(texelFetch(gNormalRoughness, samplePixel, 0).rg);
+        vec4 sampleValue = texelFetch(lowResTexture, texel, 0);
+
+        float bilinearWeight = (offset.x == 1 ? f.x : 1.0 - f.x) * (offset.y == 1 ? f.y : 1.0 - f.y);
+        float depthDiff = abs(viewDepth - sampleDepth);
+        float depthWeight = exp(-depthDiff / max(0.02 * viewDepth, 1e-3));
+        float normalWeight = pow(max(dot(normal, sampleNormal), 0.0), 8.0);
+
+        float weight = (bilinearWeight + 1e-3) * depthWeight * normalWeight;
+        result += sampleValue * weight;
+        totalWeight += weight;
+
+        if (depthDiff < closestDepthDiff) {
+            closestDepthDiff = depthDiff;
+            closestSample = sampleValue;
+        }
+    }
+
+    // No neighbour lies on this surface: fall back to the nearest one in depth
+    return totalWeight > 1e-4 ? result / totalWeight : closestSample;
+}
 
 void main() {
-    vec4 positionData = texture(gPosition, TexCoord);
+    float depth = texture(gDepth, TexCoord).r;
     
-    // Skip background pixels
-    if (positionData.w < 0.5) {
+    // Skip background pixels (depth left at the far plane)
+    if (depth >= 1.0) {
         FragColor = texture(sceneTexture, TexCoord);
         return;
     }
     
     vec3 sceneColor = texture(sceneTexture, TexCoord).rgb;
-    float ssao = texture(ssaoTexture, TexCoord).r;
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    vec3 normal = decodeOctahedral(texelFetch(gNormalRoughness, pixel, 0).rg);
+    float ssao = bilateralUpsample(ssaoTexture, ssaoResolutionScale, pixel, linearViewDepth(TexCoord, depth, invProjection), normal).r;
     float materialAO = texture(gMotionAO, TexCoord).z;
     
     // Multiply material AO with SSAO
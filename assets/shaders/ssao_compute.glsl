@@ -6,8 +6,7 @@ layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
 layout(r16f, binding = 0) uniform writeonly image2D ssao_raw_texture;
 
 // G-Buffer textures
-uniform sampler2D gPosition;      // World Position (xyz) + Material ID (w)
-uniform sampler2D gNormalRoughness; // Normal (xyz) + Roughness (a)
+uniform sampler2D gNormalRoughness; // Octahedral Normal (rg) + Roughness (b)
 uniform sampler2D gDepth;         // Depth buffer
 
 // Camera matrices
@@ -24,12 +23,17 @@ uniform float bias;
 uniform float intensity;
 uniform vec2 noiseScale;
 
+// Full resolution pixels per SSAO texel along each axis (1, 2 or 4)
+uniform int resolutionScale;
+
 // Noise texture for random sampling
 uniform sampler2D noiseTexture;
 
 // Sample kernel (uploaded as uniform)
 uniform vec3 samples[64];
 
+#include "gbuffer_common.glsl"
+
 void main() {
     ivec2 texelCoord = ivec2(gl_GlobalInvocationID.xy);
     vec2 screenSize = vec2(imageSize(ssao_raw_texture));
@@ -39,28 +43,30 @@ void main() {
         return;
     }
     
-    vec2 uv = (vec2(texelCoord) + 0.5) / screenSize;
+    // Trace from one G-Buffer pixel of this texel's block
+    ivec2 fullSize = textureSize(gDepth, 0);
+    ivec2 pixel = interleavedPixel(texelCoord, resolutionScale, fullSize);
+    vec2 uv = (vec2(pixel) + 0.5) / vec2(fullSize);
+    vec2 noiseUV = (vec2(texelCoord) + 0.5) / screenSize;
     
     // Sample G-Buffer
-    vec4 positionData = texture(gPosition, uv);
-    vec4 normalRoughness = texture(gNormalRoughness, uv);
+    float depth = texelFetch(gDepth, pixel, 0).r;
+    vec4 normalRoughness = texelFetch(gNormalRoughness, pixel, 0);
     
-    vec3 worldPos = positionData.xyz;
-    vec3 normal = normalize(normalRoughness.xyz * 2.0 - 1.0);
+    vec3 normal = decodeOctahedral(normalRoughness.rg);
     
     // Skip background pixels
-    if (positionData.w < 0.5) {
+    if (depth >= 1.0) {
         imageStore(ssao_raw_texture, texelCoord, vec4(1.0));
         return;
     }
     
     // Transform to view space
-    vec4 viewPos4 = view * vec4(worldPos, 1.0);
-    vec3 fragPos = viewPos4.xyz;
+    vec3 fragPos = reconstructPosition(uv, depth, invProjection);
     vec3 viewNormal = normalize((view * vec4(normal, 0.0)).xyz);
     
     // Get noise vector for random rotation
-    vec3 randomVec = normalize(texture(noiseTexture, uv * noiseScale).xyz);
+    vec3 randomVec = normalize(texture(noiseTexture, noiseUV * noiseScale).xyz);
     
     // Create TBN matrix for tangent space to view space transformation
     vec3 tangent = normalize(randomVec - viewNormal * dot(randomVec, viewNormal));
@@ -89,9 +95,7 @@ void main() {
         float sampleDepth = texture(gDepth, offset.xy).r;
         
         // Convert depth to view space Z
-        vec4 sampleWorldPos = texture(gPosition, offset.xy);
-        vec4 sampleViewPos = view * vec4(sampleWorldPos.xyz, 1.0);
-        float sampleZ = sampleViewPos.z;
+        float sampleZ = reconstructPosition(offset.xy, sampleDepth, invProjection).z;
         
         // Range check and accumulate occlusion
         float rangeCheck = smoothstep(0.0, 1.0, radius / abs(fragPos.z - sampleZ));
@@ -6,9 +6,9 @@ in vec2 TexCoords;
 // Input textures
 uniform sampler2D litSceneTexture;     // Direct lighting only
 uniform sampler2D ssgi_final_texture;  // Denoised SSGI (indirect lighting)
-uniform sampler2D gPosition;           // World Position for background check
+uniform sampler2D gDepth;              // Depth for background check and position reconstruction
 uniform sampler2D gAlbedoMetallic;     // Albedo for background
-uniform sampler2D gNormalRoughness;    // Normal for environment reflection
+uniform sampler2D gNormalRoughness;    // Octahedral normal for environment reflection
 uniform sampler2D gEmissive;           // Emissive color
 uniform sampler2D gMotionAO;           // AO factor
 
@@ -34,11 +34,65 @@ uniform bool enableSSGI;
 uniform float ssgiIntensity;
 uniform float exposure;
 
+// Full resolution pixels per SSGI / SSAO texel along each axis (1, 2 or 4)
+uniform int ssgiResolutionScale;
+uniform int ssaoResolutionScale;
+
 // PBR functions for environment lighting
 vec3 fresnelSchlick(float cosTheta, vec3 F0) {
     return F0 + (1.0 - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
 }
 
+#include "gbuffer_common.glsl"
+
+// Depth and normal aware upsample of a low resolution effect texture. The four nearest
+// texels are weighted bilinearly and by how closely the G-Buffer pixel each one was traced
+// from matches this pixel, so results do not bleed across silhouettes.
+vec4 bilateralUpsample(sampler2D lowResTexture, int scale, ivec2 pixel, float viewDepth, vec3 normal) {
+    if (scale <= 1) {
+        return texelFetch(lowResTexture, pixel, 0);
+    }
+
+    ivec2 fullSize = textureSize(gDepth, 0);
+    ivec2 lowSize = textureSize(lowResTexture, 0);
+    vec2 lowCoord = (vec2(pixel) + 0.5) / float(scale) - 0.5;
+    ivec2 baseTexel = ivec2(floor(lowCoord));
+    vec2 f = fract(lowCoord);
+
+    vec4 result = vec4(0.0);
+    float totalWeight = 0.0;
+    vec4 closestSample = vec4(0.0);
+    float closestDepthDiff = 1e30;
+
+    for (int i = 0; i < 4; ++i) {
+        ivec2 offset = ivec2(i & 1, i >> 1);
+        ivec2 texel = clamp(baseTexel + offset, ivec2(0), lowSize - 1);
+        ivec2 samplePixel = interleavedPixel(texel, scale, fullSize);
+
+        vec2 sampleUV = (vec2(samplePixel) + 0.5) / vec2(fullSize);
+        float sampleDepth = linearViewDepth(sampleUV, texelFetch(gDepth, samplePixel, 0).r, invProjection);
+        vec3 sampleNormal = decodeOctahedral(texelFetch(gNormalRoughness, samplePixel, 0).rg);
+        vec4 sampleValue = texelFetch(lowResTexture, texel, 0);
+
+        float bilinearWeight = (offset.x == 1 ? f.x : 1.0 - f.x) * (offset.y == 1 ? f.y : 1.0 - f.y);
+        float depthDiff = abs(viewDepth - sampleDepth);
+        float depthWeight = exp(-depthDiff / max(0.02 * viewDepth, 1e-3));
+        float normalWeight = pow(max(dot(normal, sampleNormal), 0.0), 8.0);
+
+        float weight = (bilinearWeight + 1e-3) * depthWeight * normalWeight;
+        result += sampleValue * weight;
+        totalWeight += weight;
+
+        if (depthDiff < closestDepthDiff) {
+            closestDepthDiff = depthDiff;
+            closestSample = sampleValue;
+        }
+    }
+
+    // No neighbour lies on this surface: fall back to the nearest one in depth
+    return totalWeight > 1e-4 ? result / totalWeight : closestSample;
+}
+
 vec3 ACESFitted(vec3 color) {
     // sRGB to ACEScg
     const mat3 sRGB_to_ACEScg = mat3(
@@ -70,29 +124,32 @@ void main() {
     vec2 uv = TexCoords;
     
     // Sample G-Buffer data
-    vec4 positionData = texture(gPosition, uv);
+    float depth = texture(gDepth, uv).r;
     vec4 albedoMetallic = texture(gAlbedoMetallic, uv);
     vec4 normalRoughness = texture(gNormalRoughness, uv);
     vec4 emissiveData = texture(gEmissive, uv);
     vec4 motionAO = texture(gMotionAO, uv);
     
     // Check if this is a background pixel - skip composition for background
-    if (positionData.w < 0.5) {
+    if (depth >= 1.0) {
         discard; // Let the skybox show through
     }
     
     // Extract material properties
-    vec3 worldPos = positionData.xyz;
+    vec3 worldPos = (invView * vec4(reconstructPosition(uv, depth, invProjection), 1.0)).xyz;
     vec3 albedo = albedoMetallic.rgb;
     float metallic = albedoMetallic.a;
-    vec3 normal = normalize(normalRoughness.xyz * 2.0 - 1.0);
-    float roughness = normalRoughness.a;
+    vec3 normal = decodeOctahedral(normalRoughness.rg);
+    float roughness = normalRoughness.b;
     vec3 emissiveColor = emissiveData.rgb * emissiveData.a;
     float ao = motionAO.z;
     
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    float viewDepth = linearViewDepth(uv, depth, invProjection);
+    
     // Apply SSAO if enabled
     if (enableSSAO) {
-        float ssao = texture(ssaoTexture, uv).r;
+        float ssao = bilateralUpsample(ssaoTexture, ssaoResolutionScale, pixel, viewDepth, normal).r;
         // Multiply material AO with SSAO
         ao = ao * ssao;
     }
@@ -102,7 +159,7 @@ void main() {
     vec3 indirectLighting = vec3(0.0);
     
     if (enableSSGI) {
-        indirectLighting = texture(ssgi_final_texture, uv).rgb * ssgiIntensity;
+        indirectLighting = bilateralUpsample(ssgi_final_texture, ssgiResolutionScale, pixel, viewDepth, normal).rgb * ssgiIntensity;
     }
     
     // Calculate environment lighting (ambient/IBL)
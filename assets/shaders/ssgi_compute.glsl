@@ -6,9 +6,8 @@ layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
 layout(rgba16f, binding = 0) uniform writeonly image2D ssgi_raw_texture;
 
 // G-Buffer textures
-uniform sampler2D gPosition;      // World Position (xyz) + Material ID (w)
 uniform sampler2D gAlbedoMetallic; // Albedo (rgb) + Metallic (a)
-uniform sampler2D gNormalRoughness; // Normal (xyz) + Roughness (a)
+uniform sampler2D gNormalRoughness; // Octahedral Normal (rg) + Roughness (b)
 uniform sampler2D gMotionAO;      // Motion Vector (xy) + AO (z) + unused (w)
 uniform sampler2D gDepth;         // Depth buffer
 
@@ -33,11 +32,16 @@ uniform float thickness;
 uniform float intensity;
 uniform int numSamples;
 
+// Full resolution pixels per SSGI texel along each axis (1, 2 or 4)
+uniform int resolutionScale;
+
 // Random number generation
 float random(vec2 co) {
     return fract(sin(dot(co.xy, vec2(12.9898, 78.233))) * 43758.5453);
 }
 
+#include "gbuffer_common.glsl"
+
 // Generate hemisphere sample
 vec3 generateHemisphereSample(vec2 xi, vec3 normal) {
     float cosTheta = sqrt(1.0 - xi.x);
@@ -143,24 +147,27 @@ void main() {
         return;
     }
     
-    vec2 uv = (vec2(texelCoord) + 0.5) / screenSize;
+    // Trace from one G-Buffer pixel of this texel's block
+    ivec2 fullSize = textureSize(gDepth, 0);
+    ivec2 pixel = interleavedPixel(texelCoord, resolutionScale, fullSize);
+    vec2 uv = (vec2(pixel) + 0.5) / vec2(fullSize);
     
     // Sample G-Buffer
-    vec4 positionData = texture(gPosition, uv);
-    vec4 albedoMetallic = texture(gAlbedoMetallic, uv);
-    vec4 normalRoughness = texture(gNormalRoughness, uv);
-    vec4 motionAO = texture(gMotionAO, uv);
+    float depth = texelFetch(gDepth, pixel, 0).r;
+    vec4 albedoMetallic = texelFetch(gAlbedoMetallic, pixel, 0);
+    vec4 normalRoughness = texelFetch(gNormalRoughness, pixel, 0);
+    vec4 motionAO = texelFetch(gMotionAO, pixel, 0);
     
-    vec3 worldPos = positionData.xyz;
+    vec3 worldPos = (invView * vec4(reconstructPosition(uv, depth, invProjection), 1.0)).xyz;
     vec3 albedo = albedoMetallic.rgb;
     float metallic = albedoMetallic.a;
-    vec3 normal = normalize(normalRoughness.xyz * 2.0 - 1.0);
-    float roughness = normalRoughness.a;
+    vec3 normal = decodeOctahedral(normalRoughness.rg);
+    float roughness = normalRoughness.b;
     // float ao = motionAO.z;
     float ao = 1.0;
     
     // Handle background pixels with minimal ambient
-    if (positionData.w < 0.5) {
+    if (depth >= 1.0) {
         vec3 backgroundAmbient = albedo * 0.02 * intensity; // Very small ambient for background
         imageStore(ssgi_raw_texture, texelCoord, vec4(backgroundAmbient, 1.0));
         return;
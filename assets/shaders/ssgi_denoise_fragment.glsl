@@ -1,13 +1,14 @@
 #version 460 core
 
-out vec4 FragColor;
+layout(location = 0) out vec4 FragColor;
+layout(location = 1) out vec4 GeometryOut;   // This frame's normal (rg) + linear depth (b), next frame's history
 in vec2 TexCoords;
 
 // Input textures
 uniform sampler2D ssgi_raw_texture;    // Raw noisy SSGI
-uniform sampler2D ssgi_prev_texture;   // Previous frame SSGI for temporal accumulation
-uniform sampler2D gPosition;           // World Position for depth comparison
-uniform sampler2D gNormalRoughness;    // Normal for edge detection
+uniform sampler2D ssgi_prev_texture;   // Previous frame SSGI (rgb) + history length (a)
+uniform sampler2D ssgi_prev_geometry;  // Previous frame octahedral normal (rg) + linear depth (b)
+uniform sampler2D gNormalRoughness;    // Octahedral normal for edge detection
 uniform sampler2D gMotionAO;           // Motion vectors (xy) + AO (z)
 uniform sampler2D gDepth;              // Depth buffer
 
@@ -15,17 +16,21 @@ uniform sampler2D gDepth;              // Depth buffer
 uniform float spatialSigma;
 uniform float normalSigma;
 uniform float depthSigma;
-uniform int filterRadius;
 uniform bool enableTemporalFilter;
 
 // Temporal accumulation parameters
-uniform float temporalAlpha;        // Blend factor for temporal accumulation (0.0-1.0)
-uniform float maxTemporalWeight;    // Maximum weight for temporal sample
-uniform bool isFirstFrame;          // Flag to skip temporal accumulation on first frame
+uniform bool historyValid;             // False on the first frame and after the history was reallocated
+uniform float maxHistoryLength;        // Frames after which the blend factor stops shrinking
+uniform float convergedHistoryLength;  // History length at which the small spatial filter is enough
+uniform float varianceClipGamma;       // Half-width of the history clip box in standard deviations
+uniform float historyDepthTolerance;   // Largest relative linear depth change of a surface between frames
+uniform mat4 invProjection;
 
 // Screen dimensions
 uniform vec2 screenSize;
 
+#include "gbuffer_common.glsl"
+
 // Bilateral filter weights
 float calculateSpatialWeight(vec2 offset, float sigma) {
     float distance = length(offset);
@@ -43,9 +48,9 @@ float calculateDepthWeight(float centerDepth, float sampleDepth, float sigma) {
 }
 
 // Edge-preserving bilateral filter
-vec3 bilateralFilter(vec2 uv) {
+vec3 bilateralFilter(vec2 uv, int radius) {
     vec3 centerColor = texture(ssgi_raw_texture, uv).rgb;
-    vec3 centerNormal = normalize(texture(gNormalRoughness, uv).xyz * 2.0 - 1.0);
+    vec3 centerNormal = decodeOctahedral(texture(gNormalRoughness, uv).rg);
     float centerDepth = texture(gDepth, uv).r;
     
     vec3 filteredColor = vec3(0.0);
@@ -54,8 +59,8 @@ vec3 bilateralFilter(vec2 uv) {
     vec2 texelSize = 1.0 / screenSize;
     
     // Sample in a square pattern around the center pixel
-    for (int x = -filterRadius; x <= filterRadius; x++) {
-        for (int y = -filterRadius; y <= filterRadius; y++) {
+    for (int x = -radius; x <= radius; x++) {
+        for (int y = -radius; y <= radius; y++) {
             vec2 offset = vec2(float(x), float(y));
             vec2 sampleUV = uv + offset * texelSize;
             
@@ -66,7 +71,7 @@ vec3 bilateralFilter(vec2 uv) {
             
             // Sample data
             vec3 sampleColor = texture(ssgi_raw_texture, sampleUV).rgb;
-            vec3 sampleNormal = normalize(texture(gNormalRoughness, sampleUV).xyz * 2.0 - 1.0);
+            vec3 sampleNormal = decodeOctahedral(texture(gNormalRoughness, sampleUV).rg);
             float sampleDepth = texture(gDepth, sampleUV).r;
             
             // Calculate weights
@@ -92,7 +97,7 @@ vec3 bilateralFilter(vec2 uv) {
 // A-Trous wavelet filter for additional denoising
 vec3 atrousFilter(vec2 uv, int stepSize) {
     vec3 centerColor = texture(ssgi_raw_texture, uv).rgb;
-    vec3 centerNormal = normalize(texture(gNormalRoughness, uv).xyz * 2.0 - 1.0);
+    vec3 centerNormal = decodeOctahedral(texture(gNormalRoughness, uv).rg);
     float centerDepth = texture(gDepth, uv).r;
     
     // A-Trous kernel weights
@@ -122,7 +127,7 @@ vec3 atrousFilter(vec2 uv, int stepSize) {
             
             // Sample data
             vec3 sampleColor = texture(ssgi_raw_texture, sampleUV).rgb;
-            vec3 sampleNormal = normalize(texture(gNormalRoughness, sampleUV).xyz * 2.0 - 1.0);
+            vec3 sampleNormal = decodeOctahedral(texture(gNormalRoughness, sampleUV).rg);
             float sampleDepth = texture(gDepth, sampleUV).r;
             
             // Get kernel weight
@@ -148,76 +153,101 @@ vec3 atrousFilter(vec2 uv, int stepSize) {
     }
 }
 
-// Temporal filter with motion vector reprojection
-vec3 temporalFilter(vec2 uv, vec3 currentColor) {
-    // Skip temporal accumulation on first frame
-    if (isFirstFrame) {
-        return currentColor;
+// Reproject last frame's result with the G-Buffer motion vectors.
+// Returns false when the history is off screen or belongs to a different surface.
+bool reprojectHistory(vec2 uv, vec3 currentNormal, float currentDepth, out vec3 historyColor, out float historyLength) {
+    historyColor = vec3(0.0);
+    historyLength = 0.0;
+    if (!historyValid) {
+        return false;
     }
-    
-    // Sample motion vector from G-Buffer
+
     vec2 motionVector = texture(gMotionAO, uv).xy;
-    
-    // Calculate previous frame UV coordinates
     vec2 prevUV = uv - motionVector;
-    
-    // Check if previous UV is within screen bounds
     if (prevUV.x < 0.0 || prevUV.x > 1.0 || prevUV.y < 0.0 || prevUV.y > 1.0) {
-        return currentColor;
+        return false;
     }
-    
-    // Sample previous frame SSGI
-    vec3 prevColor = texture(ssgi_prev_texture, prevUV).rgb;
-    
-    // Sample current and previous frame geometry data for validation
-    vec3 currentNormal = normalize(texture(gNormalRoughness, uv).xyz * 2.0 - 1.0);
-    float currentDepth = texture(gDepth, uv).r;
-    
-    vec3 prevNormal = normalize(texture(gNormalRoughness, prevUV).xyz * 2.0 - 1.0);
-    float prevDepth = texture(gDepth, prevUV).r;
-    
-    // Calculate temporal weight based on geometry similarity
-    float normalSimilarity = max(dot(currentNormal, prevNormal), 0.0);
-    float depthSimilarity = 1.0 - abs(currentDepth - prevDepth);
-    
-    // Combine similarity factors
-    float temporalWeight = normalSimilarity * depthSimilarity;
-    temporalWeight = clamp(temporalWeight, 0.0, maxTemporalWeight);
-    
-    // Apply exponential moving average with adaptive weight
-    float alpha = temporalAlpha * temporalWeight;
-    vec3 temporalColor = mix(currentColor, prevColor, alpha);
-    
-    // Clamp to prevent fireflies and maintain energy conservation
-    temporalColor = clamp(temporalColor, 0.0, max(length(currentColor), length(prevColor)) * 1.2);
-    
-    return temporalColor;
+
+    // Disocclusion test: the surface stored at the previous position last frame must match this one.
+    // Nearest texel, so the stored depth is not blended across a silhouette.
+    vec4 prevGeometry = texelFetch(ssgi_prev_geometry, min(ivec2(prevUV * screenSize), ivec2(screenSize) - 1), 0);
+    vec3 prevNormal = decodeOctahedral(prevGeometry.rg);
+    float prevDepth = prevGeometry.b;
+    if (prevDepth <= 0.0 || dot(currentNormal, prevNormal) < 0.9 ||
+        abs(currentDepth - prevDepth) > historyDepthTolerance * currentDepth) {
+        return false;
+    }
+
+    vec4 history = texture(ssgi_prev_texture, prevUV);
+    historyColor = history.rgb;
+    historyLength = history.a;
+    return historyLength > 0.0;
+}
+
+// Mean and standard deviation of the raw signal in a 3x3 neighbourhood
+void neighbourhoodMoments(vec2 uv, out vec3 mean, out vec3 stdDev) {
+    vec2 texelSize = 1.0 / screenSize;
+    vec3 m1 = vec3(0.0);
+    vec3 m2 = vec3(0.0);
+    for (int x = -1; x <= 1; x++) {
+        for (int y = -1; y <= 1; y++) {
+            vec3 sampleColor = texture(ssgi_raw_texture, uv + vec2(x, y) * texelSize).rgb;
+            m1 += sampleColor;
+            m2 += sampleColor * sampleColor;
+        }
+    }
+    mean = m1 / 9.0;
+    stdDev = sqrt(max(m2 / 9.0 - mean * mean, 0.0));
 }
 
 void main() {
     vec2 uv = TexCoords;
     
     // Check if this is a valid pixel (not background)
-    vec4 positionData = texture(gPosition, uv);
-    if (positionData.w < 0.5) {
-        FragColor = vec4(0.0, 0.0, 0.0, 1.0);
+    float depth = texture(gDepth, uv).r;
+    if (depth >= 1.0) {
+        FragColor = vec4(0.0);
+        GeometryOut = vec4(0.0);
         return;
     }
     
-    // Apply bilateral filter
-    vec3 denoisedColor = bilateralFilter(uv);
-    
-    // Apply A-Trous filter for additional smoothing
-    // You can adjust the step size for different levels of denoising
-    denoisedColor = atrousFilter(uv, 1);
-    
-    // Apply temporal filter if enabled
-    if (enableTemporalFilter) {
-        denoisedColor = temporalFilter(uv, denoisedColor);
+    // Kept for the next frame's disocclusion test
+    vec2 encodedNormal = texture(gNormalRoughness, uv).rg;
+    vec3 normal = decodeOctahedral(encodedNormal);
+    float linearDepth = linearViewDepth(uv, depth, invProjection);
+    GeometryOut = vec4(encodedNormal, linearDepth, 0.0);
+    
+    vec3 historyColor;
+    float historyLength;
+    bool hasHistory = enableTemporalFilter && reprojectHistory(uv, normal, linearDepth, historyColor, historyLength);
+    
+    // Pixels with converged history only need a small spatial filter: 9 taps instead of 25
+    vec3 denoisedColor = hasHistory && historyLength >= convergedHistoryLength
+        ? bilateralFilter(uv, 1)
+        : atrousFilter(uv, 1);
+    
+    if (hasHistory) {
+        // Variance clipping: history outside the local distribution of the new frame is stale
+        vec3 mean;
+        vec3 stdDev;
+        neighbourhoodMoments(uv, mean, stdDev);
+        vec3 boxMin = mean - varianceClipGamma * stdDev;
+        vec3 boxMax = mean + varianceClipGamma * stdDev;
+        vec3 clippedHistory = clamp(historyColor, boxMin, boxMax);
+        
+        // The further the history had to be moved, the less of it is trusted
+        float clipDistance = length(historyColor - clippedHistory) / (length(stdDev) + 1e-4);
+        historyLength *= clamp(1.0 - clipDistance, 0.0, 1.0);
+        
+        // Running average over the history length
+        historyLength = min(historyLength + 1.0, maxHistoryLength);
+        denoisedColor = mix(clippedHistory, denoisedColor, 1.0 / historyLength);
+    } else {
+        historyLength = 1.0;
     }
     
     // Clamp to prevent fireflies
     denoisedColor = clamp(denoisedColor, 0.0, 10.0);
     
-    FragColor = vec4(denoisedColor, 1.0);
+    FragColor = vec4(denoisedColor, historyLength);
 }
@@ -0,0 +1,101 @@
+#version 460 core
+// Temporal anti-aliasing resolve with temporal upsampling.
+// Runs at viewport resolution; the current frame may be rendered at a lower, jittered resolution.
+
+layout(location = 0) out vec4 FragColor;      // Viewport framebuffer
+layout(location = 1) out vec4 HistoryOut;     // Next frame's history, same value
+
+in vec2 TexCoord;
+
+uniform sampler2D currentColor;    // Jittered scene at render resolution
+uniform sampler2D historyColor;    // Previous resolve output at viewport resolution
+uniform sampler2D gMotionAO;       // Screen-space motion (uv delta) at render resolution
+uniform sampler2D gDepth;          // Depth at render resolution
+
+uniform vec2 jitter;               // NDC offset applied to this frame's projection
+uniform vec2 renderSize;           // Render resolution in pixels
+uniform bool historyValid;
+
+uniform float blendFactor;         // Weight of the current frame when a sample lands on the pixel centre
+uniform float minBlendFactor;      // Lower bound so history never fully freezes
+uniform float varianceClipGamma;   // Neighbourhood box size in standard deviations
+
+vec3 RGBToYCoCg(vec3 c) {
+    return vec3( 0.25 * c.r + 0.5 * c.g + 0.25 * c.b,
+                 0.5  * c.r              - 0.5  * c.b,
+                -0.25 * c.r + 0.5 * c.g - 0.25 * c.b);
+}
+
+vec3 YCoCgToRGB(vec3 c) {
+    return vec3(c.x + c.y - c.z,
+                c.x + c.z,
+                c.x - c.y - c.z);
+}
+
+// Clip the history colour towards the centre of the neighbourhood box
+vec3 clipToBox(vec3 history, vec3 boxMin, vec3 boxMax) {
+    vec3 center = 0.5 * (boxMax + boxMin);
+    vec3 extents = 0.5 * (boxMax - boxMin) + 1e-4;
+    vec3 offset = history - center;
+    vec3 units = abs(offset / extents);
+    float maxUnit = max(units.x, max(units.y, units.z));
+    return maxUnit > 1.0 ? center + offset / maxUnit : history;
+}
+
+void main() {
+    ivec2 texelLimit = ivec2(renderSize) - 1;
+
+    // Geometry moved by +jitter in NDC, so this pixel's unjittered sample sits at uv + jitter / 2
+    vec2 samplePos = (TexCoord + jitter * 0.5) * renderSize;
+    ivec2 centerTexel = clamp(ivec2(floor(samplePos)), ivec2(0), texelLimit);
+
+    // Distance to the nearest rendered sample, in render pixels
+    vec2 sampleOffset = samplePos - (vec2(centerTexel) + 0.5);
+    float sampleWeight = exp(-2.29 * dot(sampleOffset, sampleOffset));
+
+    // Neighbourhood moments and closest depth over the 3x3 render texels
+    vec3 current = RGBToYCoCg(texelFetch(currentColor, centerTexel, 0).rgb);
+    vec3 m1 = vec3(0.0);
+    vec3 m2 = vec3(0.0);
+    float closestDepth = 1.0;
+    ivec2 closestTexel = centerTexel;
+    for (int y = -1; y <= 1; ++y) {
+        for (int x = -1; x <= 1; ++x) {
+            ivec2 texel = clamp(centerTexel + ivec2(x, y), ivec2(0), texelLimit);
+            vec3 color = RGBToYCoCg(texelFetch(currentColor, texel, 0).rgb);
+            m1 += color;
+            m2 += color * color;
+
+            float depth = texelFetch(gDepth, texel, 0).r;
+            if (depth < closestDepth) {
+                closestDepth = depth;
+                closestTexel = texel;
+            }
+        }
+    }
+
+    vec3 mean = m1 / 9.0;
+    vec3 sigma = sqrt(max(m2 / 9.0 - mean * mean, vec3(0.0)));
+    vec3 boxMin = mean - varianceClipGamma * sigma;
+    vec3 boxMax = mean + varianceClipGamma * sigma;
+
+    // Motion of the closest surface keeps edges of moving objects from trailing
+    vec2 motion = texelFetch(gMotionAO, closestTexel, 0).rg;
+    vec2 historyUV = TexCoord - motion;
+
+    if (!historyValid || any(lessThan(historyUV, vec2(0.0))) || any(greaterThan(historyUV, vec2(1.0)))) {
+        FragColor = vec4(YCoCgToRGB(current), 1.0);
+        HistoryOut = FragColor;
+        return;
+    }
+
+    vec3 history = RGBToYCoCg(texture(historyColor, historyUV).rgb);
+    history = clipToBox(history, boxMin, boxMax);
+
+    // Samples far from this pixel contribute less; history fills in the rest
+    float alpha = max(blendFactor * sampleWeight, minBlendFactor);
+    vec3 result = mix(history, current, alpha);
+
+    FragColor = vec4(YCoCgToRGB(result), 1.0);
+    HistoryOut = FragColor;
+}
@@ -0,0 +1,77 @@
+// Measures what a log call costs when its level is disabled.
+//
+//   eager format   - the old LOG_DEBUG: std::vformat into a std::string, then the level check
+//   LOG_DEBUG      - runtime level check before the arguments are evaluated
+//   LOG_TRACE      - below LOG_ACTIVE_LEVEL in release builds, so no code at all
+//
+// Build with -DRENDERER_BUILD_BENCHMARKS=ON and run log_benchmark from a Release build.
+
+#include "Logger.h"
+
+#include <chrono>
+#include <cstdio>
+#include <format>
+#include <string>
+
+namespace {
+
+constexpr int kIterations = 10'000'000;
+
+// Keeps the compiler from dropping the measured loop
+volatile int g_sink = 0;
+
+std::string make_path(int i) {
+    return "assets/models/mesh_" + std::to_string(i) + ".obj";
+}
+
+template<typename F>
+double measure_ns_per_call(F&& body) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        body(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / kIterations;
+}
+
+void print_result(const char* name, double ns) {
+    std::printf("  %-16s %8.2f ns/call\n", name, ns);
+}
+
+} // namespace
+
+int main() {
+    Logger::get_instance().set_debug_enabled(false);
+    Logger::set_level(spdlog::level::info);
+
+    std::printf("Disabled log cost over %d calls (LOG_ACTIVE_LEVEL = %d)\n", kIterations, LOG_ACTIVE_LEVEL);
+
+    double baseline = measure_ns_per_call([](int i) {
+        g_sink = g_sink + i;
+    });
+    print_result("empty loop", baseline);
+
+    double eager = measure_ns_per_call([](int i) {
+        std::string path = make_path(i);
+        std::string formatted = std::vformat("Loading {} ({} of {})", std::make_format_args(path, i, kIterations));
+        if (Logger::should_log(spdlog::level::debug)) {
+            Logger::get_instance().get_raw_logger()->debug(formatted);
+        }
+        g_sink = g_sink + i;
+    });
+    print_result("eager format", eager);
+
+    double runtime_disabled = measure_ns_per_call([](int i) {
+        LOG_DEBUG("Loading {} ({} of {})", make_path(i), i, kIterations);
+        g_sink = g_sink + i;
+    });
+    print_result("LOG_DEBUG", runtime_disabled);
+
+    double compiled_out = measure_ns_per_call([](int i) {
+        LOG_TRACE("Loading {} ({} of {})", make_path(i), i, kIterations);
+        g_sink = g_sink + i;
+    });
+    print_result("LOG_TRACE", compiled_out);
+
+    return 0;
+}
@@ -0,0 +1,543 @@
+// Scripted renderer benchmark.
+//
+// Renders a scene headless along a recorded camera path: warm-up frames first, then measured
+// frames whose CPU frame time, per-pass GPU time and GL work (draw calls, state changes) are
+// reported as mean/p50/p95/p99 in JSON.
+// Given a baseline JSON from another build it compares the two and fails on a regression, so CI
+// can run it on llvmpipe, which needs the Mesa overrides for a GL 4.6 context:
+//
+//   export MESA_GL_VERSION_OVERRIDE=4.6 MESA_GLSL_VERSION_OVERRIDE=460
+//   renderer_bench --scene sponza --camera-path ../assets/camera_paths/sponza.path --output new.json
+//   renderer_bench ... --baseline old.json --threshold 10
+//
+// Scenes: "simple" (the default scene), "synthetic" (--objects cubes and --lights point lights
+// on a grid around it) or "sponza" / --model PATH (an imported model added to the default scene).
+// The renderer shades at most Renderer::MAX_LIGHTS lights, default scene's included; --lights is
+// clamped to what is left.
+// Camera path files hold one "time x y z yaw pitch" key per line; frames advance a fixed 1/60 s
+// along the path, looping, so every run sees the same views.
+// Stage timings of the imports the scene needed are reported as import_ms.* metrics alongside;
+// --load-telemetry writes the resource manager's full per-asset JSON as well.
+// Tracked memory per category is sampled every measured frame as memory_mb.* metrics.
+//
+// Needs -DRENDERER_BUILD_BENCHMARKS=ON -DRENDERER_ENABLE_HEADLESS=ON; run from the bin directory.
+
+#include "HeadlessRenderer.h"
+#include "Renderer.h"
+#include "RenderStats.h"
+#include "Camera.h"
+#include "Scene.h"
+#include "Light.h"
+#include "Renderable.h"
+#include "Transform.h"
+#include <CoroutineResourceManager.h>
+#include <TransformManager.h>
+#include <Logger.h>
+#include <MemoryTracker.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr double kPathTimeStep = 1.0 / 60.0;
+
+// Differences below these are noise whatever the threshold says, in the metric's own unit.
+// Sub-0.05 ms passes jitter by 100%; memory moves by a few KB with driver allocations.
+// Counters are exact, so any increase past the threshold counts.
+constexpr double kMinimumRegressionMs = 0.05;
+constexpr double kMinimumRegressionMb = 0.01;
+
+// Exit codes
+constexpr int kExitOk = 0;
+constexpr int kExitError = 1;
+constexpr int kExitRegression = 2;
+
+struct BenchOptions {
+    std::string scene = "simple";
+    std::string model_path;
+    float model_scale = 0.003f;
+    bool texture_arrays = false;
+    int objects = 256;
+    int lights = 6;
+    std::string camera_path;
+    int width = 1280;
+    int height = 720;
+    int warmup_frames = 30;
+    int frames = 300;
+    std::string output = "renderer_bench.json";
+    std::string baseline;
+    double threshold_percent = 10.0;
+    std::string load_telemetry;
+};
+
+struct CameraKey {
+    double time;
+    glm::vec3 position;
+    float yaw;
+    float pitch;
+};
+
+struct Summary {
+    double mean = 0.0;
+    double min = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+void print_usage(const char* program) {
+    std::printf("Usage: %s [options]\n"
+                "  --scene simple|synthetic|sponza  Scene to render (default simple)\n"
+                "  --model PATH                     Model to import instead of Sponza\n"
+                "  --model-scale S                  Uniform scale of the imported model (default 0.003)\n"
+                "  --texture-arrays on|off          Pack the model's textures into texture arrays (default off)\n"
+                "  --objects N --lights N           Synthetic scene size (default 256 / 6)\n"
+                "  --camera-path FILE               Camera keys, \"time x y z yaw pitch\" per line\n"
+                "  --size WxH                       Framebuffer size (default 1280x720)\n"
+                "  --warmup N --frames N            Unmeasured and measured frames (default 30 / 300)\n"
+                "  --output FILE                    Result JSON (default renderer_bench.json)\n"
+                "  --baseline FILE                  Result JSON of the build to compare against\n"
+                "  --threshold PCT                  Allowed p50/p95 slowdown over the baseline (default 10)\n"
+                "  --load-telemetry FILE            Also write per-asset import telemetry JSON\n",
+                program);
+}
+
+bool parse_options(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const char* value = argv[++i];
+        if (std::strcmp(arg, "--scene") == 0) {
+            options.scene = value;
+        } else if (std::strcmp(arg, "--model") == 0) {
+            options.model_path = value;
+        } else if (std::strcmp(arg, "--model-scale") == 0) {
+            options.model_scale = static_cast<float>(std::atof(value));
+        } else if (std::strcmp(arg, "--texture-arrays") == 0) {
+            options.texture_arrays = std::strcmp(value, "on") == 0;
+        } else if (std::strcmp(arg, "--objects") == 0) {
+            options.objects = std::atoi(value);
+        } else if (std::strcmp(arg, "--lights") == 0) {
+            options.lights = std::atoi(value);
+        } else if (std::strcmp(arg, "--camera-path") == 0) {
+            options.camera_path = value;
+        } else if (std::strcmp(arg, "--size") == 0) {
+            if (std::sscanf(value, "%dx%d", &options.width, &options.height) != 2) {
+                return false;
+            }
+        } else if (std::strcmp(arg, "--warmup") == 0) {
+            options.warmup_frames = std::atoi(value);
+        } else if (std::strcmp(arg, "--frames") == 0) {
+            options.frames = std::atoi(value);
+        } else if (std::strcmp(arg, "--output") == 0) {
+            options.output = value;
+        } else if (std::strcmp(arg, "--baseline") == 0) {
+            options.baseline = value;
+        } else if (std::strcmp(arg, "--threshold") == 0) {
+            options.threshold_percent = std::atof(value);
+        } else if (std::strcmp(arg, "--load-telemetry") == 0) {
+            options.load_telemetry = value;
+        } else {
+            return false;
+        }
+    }
+    if (options.scene == "sponza" && options.model_path.empty()) {
+        options.model_path = "../assets/models/sponza.obj";
+    }
+    return options.frames > 0 && options.warmup_frames >= 0 && options.width > 0 && options.height > 0;
+}
+
+bool load_camera_path(const std::string& path, std::vector<CameraKey>& keys) {
+    std::ifstream file(path);
+    if (!file) {
+        std::fprintf(stderr, "Cannot open camera path '%s'\n", path.c_str());
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream stream(line);
+        CameraKey key;
+        if (stream >> key.time >> key.position.x >> key.position.y >> key.position.z >> key.yaw >> key.pitch) {
+            keys.push_back(key);
+        }
+    }
+
+    std::sort(keys.begin(), keys.end(), [](const CameraKey& a, const CameraKey& b) { return a.time < b.time; });
+    if (keys.empty()) {
+        std::fprintf(stderr, "Camera path '%s' has no keys\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Linear interpolation between the keys around time, which wraps at the last key
+CameraKey sample_camera_path(const std::vector<CameraKey>& keys, double time) {
+    double duration = keys.back().time;
+    if (keys.size() == 1 || duration <= 0.0) {
+        return keys.front();
+    }
+    time = std::fmod(time, duration);
+
+    size_t next = 1;
+    while (next < keys.size() - 1 && keys[next].time < time) {
+        ++next;
+    }
+    const CameraKey& a = keys[next - 1];
+    const CameraKey& b = keys[next];
+    float t = b.time > a.time ? static_cast<float>((time - a.time) / (b.time - a.time)) : 0.0f;
+    t = std::clamp(t, 0.0f, 1.0f);
+
+    CameraKey key;
+    key.time = time;
+    key.position = a.position + (b.position - a.position) * t;
+    key.yaw = a.yaw + (b.yaw - a.yaw) * t;
+    key.pitch = a.pitch + (b.pitch - a.pitch) * t;
+    return key;
+}
+
+// Cubes on a grid around the origin, with point lights floating above them
+void build_synthetic_scene(HeadlessRenderer& headless, int objects, int lights) {
+    CoroutineResourceManager& resources = headless.get_resource_manager();
+    Scene& scene = headless.get_scene();
+    TransformManager& transforms = headless.get_transform_manager();
+
+    int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(objects)))));
+    float spacing = 1.5f;
+    float extent = (columns - 1) * spacing * 0.5f;
+
+    for (int i = 0; i < objects; ++i) {
+        std::string id = "bench_cube_" + std::to_string(i);
+        auto renderable = std::make_shared<Renderable>(id);
+        renderable->add_model("simple_scene_cube_model");
+        resources.store_renderable_in_cache(id, renderable);
+        scene.add_renderable_reference(id);
+
+        Transform transform;
+        transform.set_position((i % columns) * spacing - extent, -0.7f, (i / columns) * spacing - extent);
+        transform.set_scale(0.5f);
+        transforms.set_transform(id, transform);
+    }
+
+    for (int i = 0; i < lights; ++i) {
+        // Spread evenly over the grid with a golden-angle spiral
+        float angle = i * 2.39996f;
+        float radius = extent * std::sqrt((i + 0.5f) / lights);
+        glm::vec3 position(std::cos(angle) * radius, 0.8f, std::sin(angle) * radius);
+        glm::vec3 color(0.5f + 0.5f * std::cos(angle), 0.5f + 0.5f * std::cos(angle + 2.1f), 0.5f + 0.5f * std::cos(angle + 4.2f));
+
+        std::string id = "bench_light_" + std::to_string(i);
+        auto light = std::make_shared<PointLight>(position, color, 4.0f);
+        light->set_intensity(1.0f);
+        resources.store_light_in_cache(id, light);
+        scene.add_light_reference(id);
+    }
+}
+
+double percentile(const std::vector<double>& sorted, double fraction) {
+    // Nearest rank
+    size_t rank = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+Summary summarize(std::vector<double> samples) {
+    Summary summary;
+    if (samples.empty()) {
+        return summary;
+    }
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+    summary.mean = sum / samples.size();
+    summary.min = samples.front();
+    summary.p50 = percentile(samples, 0.50);
+    summary.p95 = percentile(samples, 0.95);
+    summary.p99 = percentile(samples, 0.99);
+    summary.max = samples.back();
+    return summary;
+}
+
+std::string escape_json(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+// One metric per line so read_baseline() can parse the file back without a JSON library
+bool write_results(const std::string& path, const BenchOptions& options, const std::map<std::string, Summary>& metrics) {
+    std::ofstream file(path);
+    if (!file) {
+        std::fprintf(stderr, "Cannot write '%s'\n", path.c_str());
+        return false;
+    }
+
+    char line[512];
+    file << "{\n";
+    file << "  \"scene\": \"" << escape_json(options.scene) << "\",\n";
+    file << "  \"model\": \"" << escape_json(options.model_path) << "\",\n";
+    file << "  \"camera_path\": \"" << escape_json(options.camera_path) << "\",\n";
+    file << "  \"width\": " << options.width << ",\n";
+    file << "  \"height\": " << options.height << ",\n";
+    file << "  \"warmup_frames\": " << options.warmup_frames << ",\n";
+    file << "  \"frames\": " << options.frames << ",\n";
+    file << "  \"metrics\": {\n";
+    size_t index = 0;
+    for (const auto& [name, summary] : metrics) {
+        std::snprintf(line, sizeof(line),
+                      "    \"%s\": {\"mean\": %.4f, \"min\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f}%s\n",
+                      escape_json(name).c_str(), summary.mean, summary.min, summary.p50, summary.p95, summary.p99, summary.max,
+                      ++index < metrics.size() ? "," : "");
+        file << line;
+    }
+    file << "  }\n";
+    file << "}\n";
+    return static_cast<bool>(file);
+}
+
+bool read_baseline(const std::string& path, std::map<std::string, Summary>& metrics) {
+    std::ifstream file(path);
+    if (!file) {
+        std::fprintf(stderr, "Cannot open baseline '%s'\n", path.c_str());
+        return false;
+    }
+
+    static const std::regex metric_line(R"re(^\s*"((?:[^"\\]|\\.)+)": \{(.*)\},?\s*$)re");
+    static const std::regex field(R"re("(\w+)": ([-+0-9.eE]+))re");
+
+    std::string line;
+    while (std::getline(file, line)) {
+        std::smatch match;
+        if (!std::regex_match(line, match, metric_line)) {
+            continue;
+        }
+        Summary summary;
+        std::string fields = match[2];
+        for (std::sregex_iterator it(fields.begin(), fields.end(), field), end; it != end; ++it) {
+            std::string key = (*it)[1];
+            double value = std::atof((*it)[2].str().c_str());
+            if (key == "mean") summary.mean = value;
+            else if (key == "min") summary.min = value;
+            else if (key == "p50") summary.p50 = value;
+            else if (key == "p95") summary.p95 = value;
+            else if (key == "p99") summary.p99 = value;
+            else if (key == "max") summary.max = value;
+        }
+        metrics[match[1]] = summary;
+    }
+    return !metrics.empty();
+}
+
+// Absolute tolerance of a metric, picked by its unit: "*_ms" / "*_ms.<pass>" and "memory_mb.*"
+double get_minimum_regression(const std::string& name) {
+    auto has_unit = [&](const std::string& unit) {
+        size_t pos = name.find(unit);
+        return pos != std::string::npos &&
+               (pos + unit.size() == name.size() || name[pos + unit.size()] == '.');
+    };
+    if (has_unit("_ms")) {
+        return kMinimumRegressionMs;
+    }
+    if (has_unit("_mb")) {
+        return kMinimumRegressionMb;
+    }
+    return 0.0;
+}
+
+// Compares p50 and p95 of every metric both runs have; returns the number of regressions
+int compare_with_baseline(const std::map<std::string, Summary>& current, const std::map<std::string, Summary>& baseline,
+                          double threshold_percent) {
+    std::printf("\nComparison with baseline (threshold %.1f%%)\n", threshold_percent);
+    std::printf("  %-40s %10s %10s %8s %10s %10s %8s\n", "metric", "base p50", "p50", "delta", "base p95", "p95", "delta");
+
+    int regressions = 0;
+    auto check = [&](double base, double value, double minimum) {
+        double limit = base * (1.0 + threshold_percent / 100.0);
+        return value > limit && value - base > minimum;
+    };
+    auto delta = [](double base, double value) {
+        return base > 0.0 ? (value - base) / base * 100.0 : 0.0;
+    };
+
+    for (const auto& [name, summary] : current) {
+        auto it = baseline.find(name);
+        if (it == baseline.end()) {
+            continue;
+        }
+        const Summary& base = it->second;
+        double minimum = get_minimum_regression(name);
+        bool regressed = check(base.p50, summary.p50, minimum) || check(base.p95, summary.p95, minimum);
+        regressions += regressed ? 1 : 0;
+        std::printf("  %-40s %10.3f %10.3f %+7.1f%% %10.3f %10.3f %+7.1f%%%s\n", name.c_str(),
+                    base.p50, summary.p50, delta(base.p50, summary.p50),
+                    base.p95, summary.p95, delta(base.p95, summary.p95),
+                    regressed ? "  REGRESSION" : "");
+    }
+    return regressions;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parse_options(argc, argv, options)) {
+        print_usage(argv[0]);
+        return kExitError;
+    }
+
+    std::vector<CameraKey> camera_keys;
+    if (!options.camera_path.empty() && !load_camera_path(options.camera_path, camera_keys)) {
+        return kExitError;
+    }
+
+    Logger::set_level(spdlog::level::warn);
+
+    HeadlessRenderer headless;
+    if (!headless.initialize(options.width, options.height)) {
+        return kExitError;
+    }
+
+    if (options.scene == "synthetic") {
+        // Lights past the cap would be stored but never shaded, so they cost nothing measurable
+        int scene_lights = static_cast<int>(headless.get_scene().get_light_count());
+        int max_lights = std::max(0, static_cast<int>(glRenderer::Renderer::MAX_LIGHTS) - scene_lights);
+        if (options.lights > max_lights) {
+            std::fprintf(stderr, "--lights %d: the renderer shades %zu lights and the default scene has %d, using %d\n",
+                         options.lights, glRenderer::Renderer::MAX_LIGHTS, scene_lights, max_lights);
+            options.lights = max_lights;
+        }
+        build_synthetic_scene(headless, options.objects, options.lights);
+    } else if (!options.model_path.empty()) {
+        Transform transform;
+        transform.set_position(0.0f, 0.0f, -1.5f);
+        transform.set_scale(options.model_scale);
+        headless.get_resource_manager().set_texture_array_packing_enabled(options.texture_arrays);
+        if (!headless.add_model(options.model_path, "bench_model", transform)) {
+            return kExitError;
+        }
+    } else if (options.scene != "simple") {
+        std::fprintf(stderr, "Unknown scene '%s'\n", options.scene.c_str());
+        return kExitError;
+    }
+
+    std::map<std::string, std::vector<double>> samples;
+
+    // One sample per imported asset and stage
+    CoroutineResourceManager& resources = headless.get_resource_manager();
+    for (const auto& record : resources.get_load_telemetry().imports) {
+        samples["import_ms.read"].push_back(record.read_ms);
+        samples["import_ms.parse"].push_back(record.parse_ms);
+        samples["import_ms.post_process"].push_back(record.post_process_ms);
+        samples["import_ms.upload"].push_back(record.upload_ms);
+        samples["import_ms.total"].push_back(record.total_ms);
+    }
+    if (!options.load_telemetry.empty() && !resources.export_load_telemetry_json(options.load_telemetry)) {
+        return kExitError;
+    }
+
+    int total_frames = options.warmup_frames + options.frames;
+    auto previous_start = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < total_frames; ++frame) {
+        if (!camera_keys.empty()) {
+            CameraKey key = sample_camera_path(camera_keys, frame * kPathTimeStep);
+            headless.get_camera() = Camera(key.position, glm::vec3(0.0f, 1.0f, 0.0f), key.yaw, key.pitch);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        headless.render_frame();
+        auto end = std::chrono::steady_clock::now();
+
+        if (frame >= options.warmup_frames) {
+            // Submission cost, and start-to-start time which includes any wait on the GPU
+            samples["cpu_frame_ms"].push_back(std::chrono::duration<double, std::milli>(end - start).count());
+            if (frame > options.warmup_frames) {
+                samples["frame_interval_ms"].push_back(std::chrono::duration<double, std::milli>(start - previous_start).count());
+            }
+
+            double gpu_total = 0.0;
+            bool gpu_valid = false;
+            for (const auto& timing : headless.get_renderer().get_pass_timings()) {
+                if (timing.gpu_ms >= 0.0f) {
+                    samples["gpu_pass_ms." + timing.name].push_back(timing.gpu_ms);
+                    gpu_total += timing.gpu_ms;
+                    gpu_valid = true;
+                }
+            }
+            if (gpu_valid) {
+                samples["gpu_total_ms"].push_back(gpu_total);
+            }
+
+            const RenderCounters& counters = headless.get_renderer().get_frame_counters();
+            samples["draw_calls"].push_back(static_cast<double>(counters.draw_calls));
+            samples["triangles"].push_back(static_cast<double>(counters.triangles));
+            samples["compute_dispatches"].push_back(static_cast<double>(counters.compute_dispatches));
+            samples["state_changes"].push_back(static_cast<double>(counters.program_binds + counters.texture_binds + counters.framebuffer_binds));
+            samples["uniform_uploads"].push_back(static_cast<double>(counters.uniform_uploads));
+            samples["buffer_upload_bytes"].push_back(static_cast<double>(counters.buffer_upload_bytes));
+
+            MemoryTracker::Snapshot memory = MemoryTracker::get_instance().get_snapshot();
+            for (size_t i = 0; i < MemoryTracker::CATEGORY_COUNT; ++i) {
+                std::string name = std::string("memory_mb.") + MemoryTracker::get_category_name(static_cast<MemoryCategory>(i));
+                samples[name].push_back(memory.categories[i].current_bytes / (1024.0 * 1024.0));
+            }
+            samples["memory_mb.total"].push_back(memory.total.current_bytes / (1024.0 * 1024.0));
+        }
+        previous_start = start;
+    }
+
+    std::map<std::string, Summary> metrics;
+    for (auto& [name, values] : samples) {
+        metrics[name] = summarize(std::move(values));
+    }
+
+    std::printf("renderer_bench: %s, %dx%d, %d measured frames after %d warm-up\n",
+                options.scene.c_str(), options.width, options.height, options.frames, options.warmup_frames);
+    std::printf("  %-40s %10s %10s %10s %10s\n", "metric", "mean", "p50", "p95", "p99");
+    for (const auto& [name, summary] : metrics) {
+        std::printf("  %-40s %10.3f %10.3f %10.3f %10.3f\n", name.c_str(), summary.mean, summary.p50, summary.p95, summary.p99);
+    }
+
+    if (!write_results(options.output, options, metrics)) {
+        return kExitError;
+    }
+    std::printf("Results written to %s\n", options.output.c_str());
+
+    if (!options.baseline.empty()) {
+        std::map<std::string, Summary> baseline;
+        if (!read_baseline(options.baseline, baseline)) {
+            return kExitError;
+        }
+        int regressions = compare_with_baseline(metrics, baseline, options.threshold_percent);
+        if (regressions > 0) {
+            std::printf("%d metric(s) regressed\n", regressions);
+            return kExitRegression;
+        }
+        std::printf("No regressions\n");
+    }
+
+    return kExitOk;
+}
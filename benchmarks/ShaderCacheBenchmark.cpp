@@ -0,0 +1,154 @@
+// Startup shader build time with and without the program binary cache.
+//
+//   source - cache disabled: every program compiled and linked from GLSL
+//   cold   - empty cache: compiled from GLSL, then each binary fetched and written to disk
+//   warm   - every program linked from the binaries the cold run wrote
+//
+// Each run builds the scene shader set (CoroutineResourceManager::create_scene_shaders) in a fresh
+// resource manager on one headless context. Drivers keep their own shader caches: on Mesa run with
+// MESA_SHADER_CACHE_DISABLE=true, or source and cold runs after the first look warm too. llvmpipe
+// also needs MESA_GL_VERSION_OVERRIDE=4.6 MESA_GLSL_VERSION_OVERRIDE=460 for a GL 4.6 context.
+//
+//   shader_cache_bench --runs 5 --cache-dir shader_cache_bench
+//
+// Needs -DRENDERER_BUILD_BENCHMARKS=ON -DRENDERER_ENABLE_HEADLESS=ON; run from the bin directory.
+
+#include "HeadlessContext.h"
+#include "ProgramBinaryCache.h"
+#include <CoroutineResourceManager.h>
+#include <Logger.h>
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int kExitOk = 0;
+constexpr int kExitError = 1;
+
+struct BenchOptions {
+    int runs = 5;
+    std::string cache_directory = "shader_cache_bench";
+};
+
+struct RunResult {
+    double ms = 0.0;
+    ProgramBinaryCache::Stats stats;
+    bool all_created = false;
+};
+
+void print_usage(const char* program) {
+    std::printf("Usage: %s [options]\n"
+                "  --runs N           Source and warm runs, the median is reported (default 5)\n"
+                "  --cache-dir DIR    Cache directory, emptied first (default shader_cache_bench)\n",
+                program);
+}
+
+bool parse_options(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const char* value = argv[++i];
+        if (std::strcmp(arg, "--runs") == 0) {
+            options.runs = std::max(1, std::atoi(value));
+        } else if (std::strcmp(arg, "--cache-dir") == 0) {
+            options.cache_directory = value;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+RunResult run_once(const BenchOptions& options, bool cache_enabled) {
+    // A fresh manager, so no program is found by name
+    auto resources = std::make_unique<CoroutineResourceManager>();
+    ProgramBinaryCache& cache = resources->get_program_binary_cache();
+    cache.set_directory(options.cache_directory);
+    cache.set_enabled(cache_enabled);
+
+    RunResult result;
+    auto start = std::chrono::steady_clock::now();
+    result.all_created = resources->create_scene_shaders();
+    // Binaries load and link asynchronously on some drivers; count until they are usable
+    glFinish();
+    auto end = std::chrono::steady_clock::now();
+
+    result.ms = std::chrono::duration<double, std::milli>(end - start).count();
+    result.stats = cache.get_stats();
+    return result;
+}
+
+double median_ms(std::vector<RunResult> results) {
+    std::sort(results.begin(), results.end(), [](const RunResult& a, const RunResult& b) { return a.ms < b.ms; });
+    return results[results.size() / 2].ms;
+}
+
+void print_result(const char* name, double ms, const ProgramBinaryCache::Stats* stats) {
+    if (!stats) {
+        std::printf("  %-8s %9.1f ms\n", name, ms);
+        return;
+    }
+    std::printf("  %-8s %9.1f ms   %3u linked from cache, %3u compiled, %3u stored\n",
+                name, ms, stats->hits, stats->misses, stats->stores);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parse_options(argc, argv, options)) {
+        print_usage(argv[0]);
+        return kExitError;
+    }
+
+    Logger::set_level(spdlog::level::warn);
+
+    HeadlessContext context;
+    if (!context.initialize() || !gladLoadGLLoader(&HeadlessContext::get_proc_address)) {
+        std::fprintf(stderr, "Failed to create a headless GL context\n");
+        return kExitError;
+    }
+
+    std::vector<RunResult> source_runs;
+    for (int i = 0; i < options.runs; ++i) {
+        source_runs.push_back(run_once(options, false));
+    }
+
+    ProgramBinaryCache(options.cache_directory).clear();
+    RunResult cold = run_once(options, true);
+
+    std::vector<RunResult> warm_runs;
+    for (int i = 0; i < options.runs; ++i) {
+        warm_runs.push_back(run_once(options, true));
+    }
+
+    if (!cold.all_created) {
+        std::fprintf(stderr, "Some scene shaders failed to build; run from the bin directory\n");
+        return kExitError;
+    }
+
+    std::printf("Scene shader build time on %s (%d runs, median)\n",
+                reinterpret_cast<const char*>(glGetString(GL_RENDERER)), options.runs);
+    print_result("source", median_ms(source_runs), nullptr);
+    print_result("cold", cold.ms, &cold.stats);
+    print_result("warm", median_ms(warm_runs), &warm_runs.front().stats);
+
+    if (warm_runs.front().stats.hits == 0) {
+        std::printf("No program was linked from the cache; the driver offers no usable binary formats\n");
+    } else {
+        std::printf("Warm start is %.1fx faster than compiling from source\n",
+                    median_ms(source_runs) / std::max(median_ms(warm_runs), 1e-3));
+    }
+    return kExitOk;
+}